@@ -0,0 +1,88 @@
+#include "../src/rational_geometry/BoundingVolumeHierarchy.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "benchmark.hpp"
+
+#include <array>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace rational_geometry {
+namespace benchmark {
+namespace {
+
+
+typedef FixedRational<long long, 1000> Rat;
+typedef BoundingVolumeHierarchy<Rat, 3> Bvh;
+typedef Bvh::BoxT Box;
+typedef Bvh::PointT P;
+
+/// A corner uniformly random over [0, 1000]^3, in thousandths.
+///
+P random_corner(std::mt19937_64& generator)
+{
+  P ret;
+  for (size_t i = 0; i < 3; ++i) {
+    ret[i] = Rat(static_cast<long long>(generator() % 1000001), 1000LL);
+  }
+  return ret;
+}
+
+/// Boxes up to a unit wide, as of the faces of a finely meshed scene.
+///
+std::vector<Box> make_boxes(size_t count, std::mt19937_64& generator)
+{
+  std::vector<Box> ret;
+  ret.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    auto corner = random_corner(generator);
+    P size;
+    for (size_t j = 0; j < 3; ++j) {
+      size[j] = Rat(static_cast<long long>(generator() % 1000), 1000LL);
+    }
+    ret.push_back(Box{corner, corner + size});
+  }
+  return ret;
+}
+
+void bench_bounding_volume_hierarchy(Reporter& reporter)
+{
+  auto generator = make_generator();
+  auto threads   = std::max<size_t>(std::thread::hardware_concurrency(), 2);
+
+  auto boxes = make_boxes(reporter.scaled(1000000), generator);
+
+  Bvh tree;
+  reporter.time("build, 1 thread, boxes", boxes.size(),
+      [&] { tree = Bvh{boxes}; });
+  reporter.report("  nodes", tree.node_count(), "nodes");
+  reporter.report("  depth", tree.depth(), "nodes");
+  reporter.time("build, " + std::to_string(threads) + " threads, boxes",
+      boxes.size(), [&] { tree = Bvh{boxes, threads}; });
+
+  auto queries = make_boxes(reporter.scaled(100000), generator);
+  std::vector<std::vector<size_t>> found;
+  reporter.time("overlapping(), boxes", queries.size(),
+      [&] { found = tree.overlapping(queries); });
+  keep(found);
+
+  std::vector<std::array<P, 2>> rays;
+  for (size_t i = 0; i < reporter.scaled(10000); ++i) {
+    rays.push_back({random_corner(generator),
+        random_corner(generator) - random_corner(generator)});
+  }
+  reporter.time("hit_by(), rays", rays.size(),
+      [&] { found = tree.hit_by(rays); });
+  keep(found);
+}
+
+const Registration bounding_volume_hierarchy(
+    "BoundingVolumeHierarchy", bench_bounding_volume_hierarchy);
+
+
+} // namespace
+} // namespace benchmark
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
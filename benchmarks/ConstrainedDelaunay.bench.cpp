@@ -0,0 +1,85 @@
+
+#include "../src/rational_geometry/ConstrainedDelaunay.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "benchmark.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace rational_geometry {
+namespace benchmark {
+namespace {
+
+
+typedef FixedRational<long long, 1000> Rat;
+typedef Point<Rat, 2> P;
+
+/// Random points over [0, 1000]², in thousandths.
+///
+std::vector<P> make_scatter(size_t count, std::mt19937_64& generator)
+{
+  std::vector<P> ret(count);
+  for (auto& point : ret) {
+    point = P{Rat(static_cast<long long>(generator() % 1000001), 1000LL),
+        Rat(static_cast<long long>(generator() % 1000001), 1000LL)};
+  }
+  return ret;
+}
+
+/// The outlines of square parcels in a grid over [0, 1000]², as constraints,
+/// with their corners appended to points.
+///
+std::vector<std::pair<size_t, size_t>> add_parcels(
+    size_t per_side, std::vector<P>& points)
+{
+  std::vector<std::pair<size_t, size_t>> ret;
+  auto pitch = 1000000 / static_cast<long long>(per_side);
+  for (size_t i = 0; i < per_side; ++i) {
+    for (size_t j = 0; j < per_side; ++j) {
+      auto x     = static_cast<long long>(i) * pitch + pitch / 8;
+      auto y     = static_cast<long long>(j) * pitch + pitch / 8;
+      auto first = points.size();
+      auto side  = pitch * 3 / 4;
+      points.push_back(P{Rat(x, 1000LL), Rat(y, 1000LL)});
+      points.push_back(P{Rat(x + side, 1000LL), Rat(y, 1000LL)});
+      points.push_back(P{Rat(x + side, 1000LL), Rat(y + side, 1000LL)});
+      points.push_back(P{Rat(x, 1000LL), Rat(y + side, 1000LL)});
+      for (size_t k = 0; k < 4; ++k) {
+        ret.emplace_back(first + k, first + (k + 1) % 4);
+      }
+    }
+  }
+  return ret;
+}
+
+void bench_constrained_delaunay(Reporter& reporter)
+{
+  typedef ConstrainedDelaunay<Rat> CdtT;
+
+  auto generator = make_generator();
+
+  auto size   = reporter.scaled(1000000);
+  auto points = make_scatter(size, generator);
+
+  CdtT cdt{{}};
+  reporter.time("Delaunay, points", size, [&] { cdt = CdtT{points}; });
+  reporter.report("  triangles", cdt.triangles().size(), "triangles");
+
+  // Parcel outlines, as of a site plan, forced through the scatter.
+  auto per_side    = reporter.scaled(10000) / 100 + 1;
+  auto constraints = add_parcels(per_side, points);
+  reporter.time("constrained, points", points.size(),
+      [&] { cdt = CdtT{points, constraints}; });
+  reporter.report("  constraints", constraints.size(), "edges");
+}
+
+const Registration constrained_delaunay(
+    "ConstrainedDelaunay", bench_constrained_delaunay);
+
+
+} // namespace
+} // namespace benchmark
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
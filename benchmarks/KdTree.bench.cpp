@@ -0,0 +1,67 @@
+#include "../src/rational_geometry/KdTree.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "benchmark.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace rational_geometry {
+namespace benchmark {
+namespace {
+
+
+typedef FixedRational<long long, 1000> Rat;
+typedef KdTree<Rat, 3> Tree;
+typedef Tree::PointT P;
+
+/// A point uniformly random over [0, 1000]^3, in thousandths.
+///
+P random_point(std::mt19937_64& generator)
+{
+  P ret;
+  for (size_t i = 0; i < 3; ++i) {
+    ret[i] = Rat(static_cast<long long>(generator() % 1000001), 1000LL);
+  }
+  return ret;
+}
+
+void bench_kd_tree(Reporter& reporter)
+{
+  auto generator = make_generator();
+  auto threads   = std::max<size_t>(std::thread::hardware_concurrency(), 2);
+
+  std::vector<P> points(reporter.scaled(1000000));
+  for (auto& point : points) {
+    point = random_point(generator);
+  }
+
+  Tree tree;
+  reporter.time("build, 1 thread, points", points.size(),
+      [&] { tree = Tree{points}; });
+  reporter.time("build, " + std::to_string(threads) + " threads, points",
+      points.size(), [&] { tree = Tree{points, threads}; });
+
+  std::vector<P> queries(reporter.scaled(100000));
+  for (auto& query : queries) {
+    query = random_point(generator);
+  }
+
+  std::vector<std::vector<size_t>> found;
+  reporter.time("nearest(), 8 each, queries", queries.size(),
+      [&] { found = tree.nearest(queries, 8); });
+  keep(found);
+  reporter.time("within(), radius 10, queries", queries.size(),
+      [&] { found = tree.within(queries, Rat(10)); });
+  keep(found);
+}
+
+const Registration kd_tree("KdTree", bench_kd_tree);
+
+
+} // namespace
+} // namespace benchmark
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
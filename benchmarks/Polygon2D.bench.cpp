@@ -0,0 +1,85 @@
+
+#include "../src/rational_geometry/Polygon2D.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "benchmark.hpp"
+
+#include <vector>
+
+namespace rational_geometry {
+namespace benchmark {
+namespace {
+
+
+typedef FixedRational<long long, 1000> Rat;
+typedef Polygon2D<Rat> PolygonT;
+typedef PolygonT::PointT P;
+
+/// A footprint with a ragged top edge, as of a rectilinear survey boundary:
+/// columns of random height along x, starting from offset.
+///
+PolygonT make_skyline(size_t columns, Rat offset, std::mt19937_64& generator)
+{
+  PolygonT::RingT ring;
+  ring.reserve(2 * columns + 2);
+  for (size_t i = 0; i < columns; ++i) {
+    auto x      = offset + Rat(static_cast<long long>(i));
+    auto height = Rat(static_cast<long long>(generator() % 64000) + 1000,
+        1000LL);
+    ring.push_back(P{x, height});
+    ring.push_back(P{x + Rat(1), height});
+  }
+  ring.push_back(P{offset + Rat(static_cast<long long>(columns)), Rat(0)});
+  ring.push_back(P{offset, Rat(0)});
+  return PolygonT{{ring}};
+}
+
+/// Square parcels in a grid, one ring each, with gaps between them.
+///
+PolygonT make_parcels(size_t per_side)
+{
+  PolygonT ret;
+  for (size_t i = 0; i < per_side; ++i) {
+    for (size_t j = 0; j < per_side; ++j) {
+      auto x = Rat(static_cast<long long>(4 * i)) + Rat(1LL, 2LL);
+      auto y = Rat(static_cast<long long>(4 * j)) + Rat(1LL, 4LL);
+      ret.add_ring({P{x, y}, P{x + Rat(3), y}, P{x + Rat(3), y + Rat(3)},
+          P{x, y + Rat(3)}});
+    }
+  }
+  return ret;
+}
+
+void bench_polygon2d(Reporter& reporter)
+{
+  auto generator = make_generator();
+
+  auto columns = reporter.scaled(100000);
+  auto a       = make_skyline(columns, Rat(0), generator);
+  auto b       = make_skyline(columns, Rat(1LL, 2LL), generator);
+  auto items   = a.vertex_count() + b.vertex_count();
+
+  PolygonT result;
+  reporter.time("skyline | skyline, vertices", items, [&] { result = a | b; });
+  reporter.report("  result vertices", result.vertex_count(), "vertices");
+  reporter.time("skyline & skyline, vertices", items, [&] { result = a & b; });
+  reporter.time("skyline - skyline, vertices", items, [&] { result = a - b; });
+
+  // A parcel map clipped to a boundary: many small rings against one large.
+  auto per_side = reporter.scaled(12800) / 128 + 1;
+  auto parcels  = make_parcels(per_side);
+  auto limit    = make_skyline(4 * per_side, Rat(0), generator);
+  items         = parcels.vertex_count() + limit.vertex_count();
+  reporter.time("parcels & skyline, vertices", items,
+      [&] { result = parcels & limit; });
+  reporter.report("  result rings", result.rings().size(), "rings");
+}
+
+const Registration polygon2d("Polygon2D", bench_polygon2d);
+
+
+} // namespace
+} // namespace benchmark
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
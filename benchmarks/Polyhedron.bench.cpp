@@ -0,0 +1,138 @@
+
+#include "../src/rational_geometry/Polyhedron.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "benchmark.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace rational_geometry {
+namespace benchmark {
+namespace {
+
+
+typedef FixedRational<long long, 1000> Rat;
+typedef Polyhedron<Rat> PolyhedronT;
+typedef PolyhedronT::PointT P;
+
+/// A cube from a corner, with each side tiled by unit square faces, as of a
+/// finely meshed solid.
+///
+PolyhedronT make_tiled_cube(const P& lower, size_t per_side)
+{
+  auto size    = Rat(static_cast<long long>(per_side));
+  auto corners = make_box(lower, lower + P{size, size, size});
+
+  // The unit step along an edge of the cube.
+  auto step = [&corners](size_t from, size_t to) {
+    auto edge = corners.vertices()[to] - corners.vertices()[from];
+    P ret;
+    for (size_t i = 0; i < 3; ++i) {
+      ret[i] = Rat((Rat(0) < edge[i]) - (edge[i] < Rat(0)));
+    }
+    return ret;
+  };
+
+  std::vector<P> vertices;
+  std::vector<PolyhedronT::FaceT> faces;
+  for (const auto& face : corners.faces()) {
+    const auto& ring   = face.front();
+    const auto& origin = corners.vertices()[ring[0]];
+    auto u_step        = step(ring[0], ring[1]);
+    auto v_step        = step(ring[0], ring[3]);
+
+    for (size_t u = 0; u < per_side; ++u) {
+      for (size_t v = 0; v < per_side; ++v) {
+        auto corner = origin + u_step * Rat(static_cast<long long>(u))
+                      + v_step * Rat(static_cast<long long>(v));
+        auto first = vertices.size();
+        vertices.insert(vertices.end(), {corner, corner + u_step,
+            corner + u_step + v_step, corner + v_step});
+        faces.push_back({{first, first + 1, first + 2, first + 3}});
+      }
+    }
+  }
+  return PolyhedronT{vertices, faces};
+}
+
+void bench_polyhedron(Reporter& reporter)
+{
+  auto per_side = reporter.scaled(12800) / 100 + 2;
+  auto size     = static_cast<long long>(per_side);
+  auto a        = make_tiled_cube(P{Rat(0), Rat(0), Rat(0)}, per_side);
+  auto items    = 2 * a.faces().size();
+
+  // Two finely meshed cubes overlapping at a corner: most faces lie beyond
+  // the other's bounds.
+  auto corner =
+      make_tiled_cube(P{Rat(size - 2), Rat(size - 3), Rat(size - 5)}, per_side);
+
+  PolyhedronT result;
+  reporter.time("tiled | tiled at a corner, faces", items,
+      [&] { result = a | corner; });
+  reporter.report("  result faces", result.faces().size(), "faces");
+  reporter.time("tiled - tiled at a corner, faces", items,
+      [&] { result = a - corner; });
+
+  // Overlapping by half: many faces lie within the other's bounds, but clear
+  // of its faces, and are kept or dropped whole.
+  auto half = make_tiled_cube(
+      P{Rat(size / 2), Rat(size / 2 + 1), Rat(size / 2 - 1)}, per_side);
+  reporter.time("tiled | tiled by half, faces", items,
+      [&] { result = a | half; });
+  reporter.time("tiled & tiled by half, faces", items,
+      [&] { result = a & half; });
+  reporter.time("tiled ^ tiled by half, faces", items,
+      [&] { result = a ^ half; });
+  reporter.report("  result faces", result.faces().size(), "faces");
+
+  // A small cavity inside a meshed cube touches none of its faces.
+  auto cavity = make_box(P{Rat(1), Rat(1), Rat(1)}, P{Rat(2), Rat(2), Rat(2)});
+  reporter.time("tiled - cavity, faces", a.faces().size(),
+      [&] { result = a - cavity; });
+  keep(result);
+}
+
+void bench_bsp_tree(Reporter& reporter)
+{
+  // Scattered cubes, split by the balanced heuristic, which gives the large
+  // splits that build on separate threads.
+  auto generator = make_generator();
+  auto cubes     = reporter.scaled(20000);
+
+  auto quarter = Rat(1LL, 4LL);
+  std::vector<PlanarRegion<Rat>> regions;
+  for (size_t i = 0; i < cubes; ++i) {
+    P lower;
+    for (size_t j = 0; j < 3; ++j) {
+      lower[j] = Rat(static_cast<long long>(generator() % 100000), 100LL);
+    }
+    auto cube_regions =
+        regions_of(make_box(lower, lower + P{quarter, quarter, quarter}));
+    regions.insert(regions.end(), cube_regions.begin(), cube_regions.end());
+  }
+
+  BspSplitHeuristic balanced;
+  balanced.candidate_count_ = 16;
+
+  auto threads = std::max<size_t>(std::thread::hardware_concurrency(), 2);
+  BspTree<Rat> tree;
+  reporter.time("build, 1 thread, regions", regions.size(),
+      [&] { tree = BspTree<Rat>{regions, balanced}; });
+  reporter.report("  nodes", tree.node_count(), "nodes");
+  reporter.time("build, " + std::to_string(threads) + " threads, regions",
+      regions.size(), [&] { tree = BspTree<Rat>{regions, balanced, threads}; });
+  keep(tree);
+}
+
+const Registration polyhedron("Polyhedron", bench_polyhedron);
+const Registration bsp_tree("BspTree", bench_bsp_tree);
+
+
+} // namespace
+} // namespace benchmark
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
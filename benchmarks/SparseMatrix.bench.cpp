@@ -0,0 +1,113 @@
+
+#include "../src/rational_geometry/SparseLU.hpp"
+#include "../src/rational_geometry/SparseMatrix.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "benchmark.hpp"
+
+#include <vector>
+
+namespace rational_geometry {
+namespace benchmark {
+namespace {
+
+
+/// Difference constraints x_i - x_parent(i) = b_i over a random tree, with the
+/// rows shuffled. The matrix is totally unimodular, so every minor, and so
+/// every fraction-free intermediate, is -1, 0 or 1 however large it grows.
+///
+template <typename RatT>
+SparseMatrix<RatT> make_constraints(size_t size, std::mt19937_64& generator)
+{
+  std::vector<size_t> order(size);
+  for (size_t i = 0; i < size; ++i) {
+    order[i] = i;
+  }
+  std::shuffle(order.begin(), order.end(), generator);
+
+  std::vector<SparseEntry<RatT>> entries;
+  entries.reserve(2 * size);
+  for (size_t i = 0; i < size; ++i) {
+    entries.push_back({order[i], i, RatT(1)});
+    if (i > 0) {
+      auto parent = i - 1 - generator() % std::min<size_t>(i, 16);
+      entries.push_back({order[i], parent, RatT(-1)});
+    }
+  }
+
+  return SparseMatrix<RatT>(size, size, std::move(entries));
+}
+
+void bench_sparse_matrix(Reporter& reporter)
+{
+  typedef FixedRational<long long, 1000> Rat;
+
+  auto generator = make_generator();
+
+  auto size = reporter.scaled(1000000);
+  SparseMatrix<Rat> a;
+  reporter.time("assemble CSR, rows", size,
+      [&] { a = make_constraints<Rat>(size, generator); });
+
+  reporter.report("CSR footprint", a.memory_footprint(), "bytes");
+  reporter.report("  dense equivalent",
+      static_cast<double>(a.height()) * a.width() * sizeof(Rat), "bytes");
+  reporter.report("  per non-zero",
+      static_cast<double>(a.memory_footprint()) / a.nonzero_count(), "bytes");
+
+  SparseMatrix<Rat> a_t;
+  reporter.time("transposed(), non-zeros", a.nonzero_count(),
+      [&] { a_t = a.transposed(); });
+  keep(a_t);
+
+  DynamicPoint<Rat> x(size);
+  for (auto& value : x) {
+    value = Rat(static_cast<long long>(generator() % 2001) - 1000, 1000LL);
+  }
+
+  const int kProducts = 10;
+  DynamicPoint<Rat> y;
+  reporter.time("operator*(), non-zeros", kProducts * a.nonzero_count(), [&] {
+    for (int i = 0; i < kProducts; ++i) {
+      y = a * x;
+    }
+  });
+  keep(y);
+}
+
+void bench_sparse_lu(Reporter& reporter)
+{
+  auto generator = make_generator();
+
+  auto size = reporter.scaled(20000);
+  auto a    = make_constraints<long long>(size, generator);
+
+  auto lu = SparseLU<long long>(SparseMatrix<long long>{});
+  reporter.time("factor, rows", size, [&] { lu = SparseLU<long long>(a); });
+
+  reporter.report("matrix non-zeros", a.nonzero_count(), "entries");
+  reporter.report("factor non-zeros", lu.nonzero_count(), "entries");
+  reporter.report("factor footprint", lu.memory_footprint(), "bytes");
+
+  DynamicPoint<long long> b(size);
+  for (auto& value : b) {
+    value = static_cast<long long>(generator() % 201) - 100;
+  }
+
+  DynamicPoint<long long> x;
+  reporter.time("solve(), factor non-zeros", lu.nonzero_count(),
+      [&] { x = lu.solve(b); });
+  keep(x);
+
+  keep(lu.determinant());
+}
+
+const Registration sparse_matrix("SparseMatrix", bench_sparse_matrix);
+const Registration sparse_lu("SparseLU", bench_sparse_lu);
+
+
+} // namespace
+} // namespace benchmark
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,82 @@
+#include "../src/rational_geometry/SpatialHash.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "benchmark.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace rational_geometry {
+namespace benchmark {
+namespace {
+
+
+typedef FixedRational<long long, 1000000> Rat;
+typedef Point<Rat, 3> P;
+
+/// The corners of a triangulated height field's triangles, listed triangle by
+/// triangle as in an unindexed mesh file: inner vertices appear six times.
+/// The field lies near (-5000, -5000, 5000), in millimetre steps.
+///
+std::vector<P> make_triangle_soup(size_t corners, std::mt19937_64& generator)
+{
+  auto side = static_cast<size_t>(std::sqrt(corners / 6.0)) + 2;
+
+  std::vector<P> grid;
+  grid.reserve(side * side);
+  for (size_t i = 0; i < side; ++i) {
+    for (size_t j = 0; j < side; ++j) {
+      auto height = static_cast<long long>(generator() % 1000000);
+      grid.push_back(P{Rat(static_cast<long long>(i) * 1000 - 5000000000LL,
+                           1000000LL),
+          Rat(static_cast<long long>(j) * 1000 - 5000000000LL, 1000000LL),
+          Rat(height + 5000000000LL, 1000000LL)});
+    }
+  }
+
+  std::vector<P> ret;
+  ret.reserve(6 * (side - 1) * (side - 1));
+  for (size_t i = 0; i + 1 < side; ++i) {
+    for (size_t j = 0; j + 1 < side; ++j) {
+      auto corner = i * side + j;
+      for (auto offset : {size_t(0), side, side + 1, size_t(0), side + 1,
+               size_t(1)}) {
+        ret.push_back(grid[corner + offset]);
+      }
+    }
+  }
+  return ret;
+}
+
+void bench_spatial_hash(Reporter& reporter)
+{
+  auto generator = make_generator();
+
+  auto soup = make_triangle_soup(reporter.scaled(10000000), generator);
+  WeldedPoints<Rat, 3> welded;
+  reporter.time("weld(), vertices", soup.size(), [&] { welded = weld(soup); });
+  reporter.report("  distinct", welded.points_.size(), "vertices");
+
+  SpatialHash<Rat, 3> hash{Rat(1LL, 100LL)};
+  reporter.time("insert(), points", welded.points_.size(),
+      [&] { hash.insert(welded.points_); });
+  reporter.report("  cells", hash.cell_count(), "cells");
+
+  std::vector<P> centers;
+  for (size_t i = 0; i < reporter.scaled(100000); ++i) {
+    centers.push_back(welded.points_[generator() % welded.points_.size()]);
+  }
+  std::vector<std::vector<size_t>> found;
+  reporter.time("within(), radius 1/100, queries", centers.size(),
+      [&] { found = hash.within(centers, Rat(1LL, 100LL)); });
+  keep(found);
+}
+
+const Registration spatial_hash("SpatialHash", bench_spatial_hash);
+
+
+} // namespace
+} // namespace benchmark
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
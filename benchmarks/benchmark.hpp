@@ -0,0 +1,181 @@
+/// \file    benchmark.hpp
+/// \author  Tim Holt
+///
+/// A minimal harness for timing the library over large inputs.
+///
+/// Each benchmark is a function taking a Reporter, registered by name with a
+/// Registration at namespace scope. The benchmark program runs them all, or
+/// those named on its command line, and prints one line per measurement.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_BENCHMARK_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_BENCHMARK_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+namespace benchmark {
+
+// Class Declarations
+//--------------------
+
+/// \brief  Times and prints measurements for a benchmark.
+///
+/// Input sizes are given at full scale and passed through scaled(), so that a
+/// quick run (e.g. as a smoke test) exercises the same code over less data.
+///
+class Reporter
+{
+ protected:
+  // INTERNAL STATE
+  std::ostream* out_;
+  size_t divisor_;
+
+ public:
+  // CONSTRUCTORS
+  Reporter(std::ostream& out, size_t divisor);
+
+  // ACCESSORS
+  size_t scaled(size_t full_size) const;
+
+  // OTHER METHODS
+  template <typename FunctionT>
+  double time(const std::string& label, size_t items, FunctionT function);
+
+  void report(
+      const std::string& label, double value, const std::string& unit);
+};
+
+typedef void (*BenchmarkFunction)(Reporter&);
+
+/// \brief  Adds a benchmark to registry() when constructed.
+///
+struct Registration
+{
+  Registration(const char* name, BenchmarkFunction function);
+};
+
+// Function Declarations
+//-----------------------
+
+std::vector<std::pair<std::string, BenchmarkFunction>>& registry();
+
+template <typename ValueT>
+void keep(const ValueT& value);
+
+inline std::mt19937_64 make_generator();
+
+// Class Definitions
+//-------------------
+//   Constructors
+//  --------------
+
+inline Reporter::Reporter(std::ostream& out, size_t divisor)
+    : out_{&out}, divisor_{std::max<size_t>(divisor, 1)}
+{
+}
+
+inline Registration::Registration(const char* name, BenchmarkFunction function)
+{
+  registry().emplace_back(name, function);
+}
+
+//   Accessors
+//  -----------
+
+/// \returns  The input size to use in place of a full-scale full_size.
+///
+inline size_t Reporter::scaled(size_t full_size) const
+{
+  return std::max<size_t>(full_size / divisor_, 1);
+}
+
+//   Other Methods
+//  ---------------
+
+/// Runs a function once, printing its time and its rate over some items.
+///
+/// \returns  The time taken, in seconds.
+///
+template <typename FunctionT>
+double Reporter::time(
+    const std::string& label, size_t items, FunctionT function)
+{
+  using namespace std::chrono;
+
+  auto start   = steady_clock::now();
+  function();
+  auto stop    = steady_clock::now();
+  auto seconds = duration<double>(stop - start).count();
+
+  *out_ << "  " << std::left << std::setw(48) << label << std::right
+        << std::setw(12) << std::fixed << std::setprecision(4) << seconds
+        << " s";
+  if (seconds > 0) {
+    *out_ << std::setw(14) << std::setprecision(0) << items / seconds
+          << " items/s";
+  }
+  *out_ << "\n";
+
+  return seconds;
+}
+
+/// Prints a measurement other than a time, such as a size in bytes.
+///
+inline void Reporter::report(
+    const std::string& label, double value, const std::string& unit)
+{
+  *out_ << "  " << std::left << std::setw(48) << label << std::right
+        << std::setw(12) << std::fixed << std::setprecision(0) << value << " "
+        << unit << "\n";
+}
+
+// Function Definitions
+//----------------------
+
+/// \returns  The registered benchmarks, in registration order.
+///
+inline std::vector<std::pair<std::string, BenchmarkFunction>>& registry()
+{
+  static std::vector<std::pair<std::string, BenchmarkFunction>> benchmarks;
+  return benchmarks;
+}
+
+/// Keeps the compiler from discarding a result that is otherwise unused.
+///
+template <typename ValueT>
+void keep(const ValueT& value)
+{
+  static const void* volatile sink;
+  sink = &value;
+}
+
+/// \returns  A generator with a fixed seed, so every run times the same input.
+///
+inline std::mt19937_64 make_generator()
+{
+  return std::mt19937_64{0x5eed};
+}
+
+} // namespace benchmark
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_BENCHMARK_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,91 @@
+#include "../src/rational_geometry/clipping.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "benchmark.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace rational_geometry {
+namespace benchmark {
+namespace {
+
+
+typedef FixedRational<long long, 1000> Rat;
+typedef Point<Rat, 2> P;
+
+/// Small rectangles scattered over [0, 1000]^2, as of building footprints,
+/// each up to a unit across. Axis-parallel and 45 degree boundaries cut them
+/// on the thousandths' lattice.
+///
+PolygonBuffer<Rat, 2> make_footprints(
+    size_t count, std::mt19937_64& generator)
+{
+  PolygonBuffer<Rat, 2> ret;
+  ret.offsets_.reserve(count + 1);
+  ret.vertices_.reserve(4 * count);
+  for (size_t i = 0; i < count; ++i) {
+    auto x      = static_cast<long long>(generator() % 999000);
+    auto y      = static_cast<long long>(generator() % 999000);
+    auto width  = static_cast<long long>(generator() % 1000) + 1;
+    auto height = static_cast<long long>(generator() % 1000) + 1;
+    ret.vertices_.push_back(P{Rat(x, 1000LL), Rat(y, 1000LL)});
+    ret.vertices_.push_back(P{Rat(x + width, 1000LL), Rat(y, 1000LL)});
+    ret.vertices_.push_back(
+        P{Rat(x + width, 1000LL), Rat(y + height, 1000LL)});
+    ret.vertices_.push_back(P{Rat(x, 1000LL), Rat(y + height, 1000LL)});
+    ret.offsets_.push_back(ret.vertices_.size());
+  }
+  return ret;
+}
+
+void bench_clipping(Reporter& reporter)
+{
+  auto generator = make_generator();
+  auto threads   = std::max<size_t>(std::thread::hardware_concurrency(), 2);
+
+  auto footprints = make_footprints(reporter.scaled(1000000), generator);
+  auto count      = footprints.offsets_.size() - 1;
+
+  // An 8 x 8 grid of map tiles, each 125 units on a side.
+  std::vector<AABB<Rat, 2>> tiles;
+  for (long long i = 0; i < 8; ++i) {
+    for (long long j = 0; j < 8; ++j) {
+      tiles.push_back(AABB<Rat, 2>{P{Rat(i * 125), Rat(j * 125)},
+          P{Rat((i + 1) * 125), Rat((j + 1) * 125)}});
+    }
+  }
+
+  std::vector<PolygonBuffer<Rat, 2>> tiled;
+  reporter.time("64 tiles, 1 thread, polygons", count,
+      [&] { tiled = clip(footprints, tiles); });
+  size_t pieces = 0;
+  for (const auto& tile : tiled) {
+    for (size_t i = 0; i + 1 < tile.offsets_.size(); ++i) {
+      pieces += tile.offsets_[i] != tile.offsets_[i + 1];
+    }
+  }
+  reporter.report("  pieces", pieces, "polygons");
+  reporter.time(
+      "64 tiles, " + std::to_string(threads) + " threads, polygons", count,
+      [&] { tiled = clip(footprints, tiles, threads); });
+  keep(tiled);
+
+  // A diamond window across the middle, cutting at off-axis edges.
+  std::vector<P> window{P{Rat(500), Rat(100)}, P{Rat(900), Rat(500)},
+      P{Rat(500), Rat(900)}, P{Rat(100), Rat(500)}};
+  PolygonBuffer<Rat, 2> windowed;
+  reporter.time("diamond window, polygons", count,
+      [&] { windowed = clip(footprints, window); });
+  keep(windowed);
+}
+
+const Registration clipping("clipping", bench_clipping);
+
+
+} // namespace
+} // namespace benchmark
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
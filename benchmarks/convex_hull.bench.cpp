@@ -0,0 +1,74 @@
+
+#include "../src/rational_geometry/convex_hull.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "benchmark.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace rational_geometry {
+namespace benchmark {
+namespace {
+
+
+typedef FixedRational<long long, 1000> Rat;
+
+/// A coordinate uniformly random over [-500, 500], in thousandths; within
+/// orient3d()'s long long filter.
+///
+Rat random_coordinate(std::mt19937_64& generator)
+{
+  return Rat(static_cast<long long>(generator() % 1000001) - 500000, 1000LL);
+}
+
+void bench_convex_hull(Reporter& reporter)
+{
+  typedef Point<Rat, 2> P2;
+  typedef Point<Rat, 3> P3;
+
+  auto generator = make_generator();
+  auto threads   = std::max<size_t>(std::thread::hardware_concurrency(), 2);
+  auto threaded  = ", " + std::to_string(threads) + " threads, points";
+
+  // Above the default parallel minimum at full scale.
+  auto size = reporter.scaled(20000000);
+  std::vector<P2> points_2d(size);
+  for (auto& point : points_2d) {
+    point = P2{random_coordinate(generator), random_coordinate(generator)};
+  }
+
+  std::vector<P2> hull_2d;
+  reporter.time("2D, 1 thread, points", size,
+      [&] { hull_2d = convex_hull(points_2d); });
+  reporter.report("  hull corners", hull_2d.size(), "points");
+  reporter.time("2D" + threaded, size, [&] {
+    hull_2d = convex_hull(points_2d, threads, reporter.scaled(10000000));
+  });
+  keep(hull_2d);
+
+  size = reporter.scaled(1000000);
+  std::vector<P3> points_3d(size);
+  for (auto& point : points_3d) {
+    point = P3{random_coordinate(generator), random_coordinate(generator),
+        random_coordinate(generator)};
+  }
+
+  Polyhedron<Rat> hull_3d;
+  reporter.time("3D, 1 thread, points", size,
+      [&] { hull_3d = convex_hull(points_3d); });
+  reporter.report("  hull faces", hull_3d.faces().size(), "faces");
+  reporter.time("3D" + threaded, size,
+      [&] { hull_3d = convex_hull(points_3d, threads); });
+  keep(hull_3d);
+}
+
+const Registration convex_hull_benchmark("convex_hull", bench_convex_hull);
+
+
+} // namespace
+} // namespace benchmark
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,44 @@
+// main.cpp
+//
+// Runs the registered benchmarks: all of them, or those named as arguments.
+// With --quick, every input is a hundredth of its full size.
+
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[])
+{
+  using namespace rational_geometry::benchmark;
+
+  size_t divisor = 1;
+  std::vector<std::string> names;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--quick") == 0) {
+      divisor = 100;
+    } else {
+      names.emplace_back(argv[i]);
+    }
+  }
+
+  Reporter reporter{std::cout, divisor};
+  for (const auto& benchmark : registry()) {
+    if (!names.empty()
+        && std::find(names.begin(), names.end(), benchmark.first)
+               == names.end()) {
+      continue;
+    }
+
+    std::cout << benchmark.first << "\n";
+    benchmark.second(reporter);
+    std::cout << std::endl;
+  }
+
+  return 0;
+}
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,117 @@
+#include "../src/rational_geometry/minkowski.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace rational_geometry {
+namespace benchmark {
+namespace {
+
+
+typedef FixedRational<long long, 1000> Rat;
+typedef Point<Rat, 2> P;
+typedef FixedRational<long long, 720720> FineRat;
+typedef Point<FineRat, 2> FineP;
+
+/// A strictly convex polygon of about the given number of vertices, with its
+/// edges a random half of the short primitive lattice vectors pointing up,
+/// and their opposites, in thousandths.
+///
+std::vector<P> make_convex(size_t vertices, std::mt19937_64& generator)
+{
+  // About 6/pi^2 of the lattice vectors in the upper half of the square are
+  // primitive, and half of those are taken, with their opposites.
+  auto radius = static_cast<long long>(std::sqrt(vertices * 0.8)) + 1;
+
+  std::vector<std::pair<long long, long long>> edges;
+  for (long long x = -radius; x <= radius; ++x) {
+    for (long long y = 0; y <= radius; ++y) {
+      bool is_up = 0 < y || 0 < x;
+      if (is_up && std::gcd(x, y) == 1 && generator() % 2 == 0) {
+        edges.emplace_back(x, y);
+      }
+    }
+  }
+  std::sort(edges.begin(), edges.end(), [](const auto& l_op, const auto& r_op) {
+    return std::atan2(l_op.second, l_op.first)
+           < std::atan2(r_op.second, r_op.first);
+  });
+  auto half = edges.size();
+  for (size_t i = 0; i < half; ++i) {
+    edges.emplace_back(-edges[i].first, -edges[i].second);
+  }
+
+  std::vector<P> ret;
+  ret.reserve(edges.size());
+  long long x = 0;
+  long long y = 0;
+  for (const auto& edge : edges) {
+    ret.push_back(P{Rat(x, 1000LL), Rat(y, 1000LL)});
+    x += edge.first;
+    y += edge.second;
+  }
+  return ret;
+}
+
+/// A comb: a bar along x with teeth of random whole heights, each a unit
+/// wide. The bar has a vertex at each unit along its base, so its pieces'
+/// edges are short lattice vectors, and where their sums cross has a
+/// denominator dividing FineRat's.
+///
+template <typename RatT>
+Polygon2D<RatT> make_comb(size_t teeth, std::mt19937_64& generator)
+{
+  typedef Point<RatT, 2> PointT;
+
+  std::vector<PointT> ring;
+  for (auto x = 2 * static_cast<long long>(teeth) + 1; 0 <= x; --x) {
+    ring.push_back(PointT{RatT(x), RatT(0)});
+  }
+  for (size_t i = 0; i < teeth; ++i) {
+    auto x      = RatT(2 * static_cast<long long>(i) + 1);
+    auto height = RatT(static_cast<long long>(generator() % 4) + 2);
+    ring.push_back(PointT{x, RatT(1)});
+    ring.push_back(PointT{x, height});
+    ring.push_back(PointT{x + RatT(1), height});
+    ring.push_back(PointT{x + RatT(1), RatT(1)});
+  }
+  return Polygon2D<RatT>{{ring}};
+}
+
+void bench_minkowski(Reporter& reporter)
+{
+  auto generator = make_generator();
+
+  auto l_op = make_convex(reporter.scaled(100000), generator);
+  auto r_op = make_convex(reporter.scaled(100000), generator);
+  std::vector<P> sum;
+  reporter.time("convex, vertices", l_op.size() + r_op.size(),
+      [&] { sum = minkowski_sum(l_op, r_op); });
+  reporter.report("  sum", sum.size(), "vertices");
+  keep(sum);
+
+  // A non-convex polygon grown by a square, as in buffering an outline by a
+  // tool's shape.
+  auto comb = make_comb<FineRat>(reporter.scaled(10000) / 4, generator);
+  Polygon2D<FineRat> square{{FineP{FineRat(0), FineRat(0)},
+      FineP{FineRat(1), FineRat(0)}, FineP{FineRat(1), FineRat(1)},
+      FineP{FineRat(0), FineRat(1)}}};
+  Polygon2D<FineRat> grown;
+  reporter.time("comb by square, vertices", comb.vertex_count(),
+      [&] { grown = minkowski_sum(comb, square); });
+  reporter.report("  sum", grown.vertex_count(), "vertices");
+}
+
+const Registration minkowski("minkowski", bench_minkowski);
+
+
+} // namespace
+} // namespace benchmark
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
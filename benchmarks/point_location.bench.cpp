@@ -0,0 +1,149 @@
+#include "../src/rational_geometry/point_location.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "benchmark.hpp"
+
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace rational_geometry {
+namespace benchmark {
+namespace {
+
+
+typedef FixedRational<long long, 1000> Rat;
+typedef Point<Rat, 2> P2;
+typedef Point<Rat, 3> P3;
+
+/// A footprint with a ragged top edge, as of a rectilinear survey boundary:
+/// columns of random height along x.
+///
+Polygon2D<Rat> make_skyline(size_t columns, std::mt19937_64& generator)
+{
+  std::vector<P2> ring;
+  ring.reserve(2 * columns + 2);
+  for (size_t i = 0; i < columns; ++i) {
+    auto x      = Rat(static_cast<long long>(i));
+    auto height = Rat(static_cast<long long>(generator() % 64000) + 1000,
+        1000LL);
+    ring.push_back(P2{x, height});
+    ring.push_back(P2{x + Rat(1), height});
+  }
+  ring.push_back(P2{Rat(static_cast<long long>(columns)), Rat(0)});
+  ring.push_back(P2{Rat(0), Rat(0)});
+  return Polygon2D<Rat>{{ring}};
+}
+
+/// A block of terrain: a triangulated height field over a square grid of
+/// side by side vertices, with upright walls down to a flat base, so it is
+/// closed.
+///
+Polyhedron<Rat> make_terrain(size_t side, std::mt19937_64& generator)
+{
+  // The surface's vertices, row by row, then the base's below the rim.
+  std::vector<P3> points;
+  for (size_t i = 0; i < side; ++i) {
+    for (size_t j = 0; j < side; ++j) {
+      points.push_back(P3{Rat(static_cast<long long>(i)),
+          Rat(static_cast<long long>(j)),
+          Rat(static_cast<long long>(generator() % 1000) + 1000, 1000LL)});
+    }
+  }
+  auto surface = [side](size_t i, size_t j) { return i * side + j; };
+
+  std::vector<Polyhedron<Rat>::FaceT> faces;
+  for (size_t i = 0; i + 1 < side; ++i) {
+    for (size_t j = 0; j + 1 < side; ++j) {
+      faces.push_back({{surface(i, j), surface(i + 1, j),
+          surface(i + 1, j + 1)}});
+      faces.push_back({{surface(i, j), surface(i + 1, j + 1),
+          surface(i, j + 1)}});
+    }
+  }
+
+  // The rim, counter-clockwise from above.
+  std::vector<size_t> rim;
+  for (size_t i = 0; i + 1 < side; ++i) {
+    rim.push_back(surface(i, 0));
+  }
+  for (size_t j = 0; j + 1 < side; ++j) {
+    rim.push_back(surface(side - 1, j));
+  }
+  for (size_t i = side - 1; 0 < i; --i) {
+    rim.push_back(surface(i, side - 1));
+  }
+  for (size_t j = side - 1; 0 < j; --j) {
+    rim.push_back(surface(0, j));
+  }
+
+  std::vector<size_t> base;
+  for (auto vertex : rim) {
+    base.push_back(points.size());
+    points.push_back(P3{points[vertex][0], points[vertex][1], Rat(0)});
+  }
+  for (size_t k = 0; k < rim.size(); ++k) {
+    auto next = (k + 1) % rim.size();
+    faces.push_back({{base[k], base[next], rim[next], rim[k]}});
+  }
+  faces.push_back({std::vector<size_t>(base.rbegin(), base.rend())});
+  return Polyhedron<Rat>{points, faces};
+}
+
+void bench_point_location(Reporter& reporter)
+{
+  auto generator = make_generator();
+  auto threads   = std::max<size_t>(std::thread::hardware_concurrency(), 2);
+
+  auto columns = reporter.scaled(100000);
+  auto polygon = make_skyline(columns, generator);
+  PolygonLocator<Rat> skyline;
+  reporter.time("PolygonLocator, build, vertices", polygon.vertex_count(),
+      [&] { skyline = PolygonLocator<Rat>{polygon}; });
+
+  std::vector<P2> points(reporter.scaled(1000000));
+  for (auto& point : points) {
+    point = P2{Rat(static_cast<long long>(generator() % (1000 * columns)),
+                   1000LL),
+        Rat(static_cast<long long>(generator() % 66000), 1000LL)};
+  }
+  std::vector<Location> found;
+  reporter.time("PolygonLocator, 1 thread, points", points.size(),
+      [&] { found = skyline.locate(points); });
+  reporter.time(
+      "PolygonLocator, " + std::to_string(threads) + " threads, points",
+      points.size(), [&] { found = skyline.locate(points, threads); });
+  keep(found);
+
+  auto side    = static_cast<size_t>(
+      std::sqrt(static_cast<double>(reporter.scaled(100000))));
+  auto terrain = make_terrain(side, generator);
+  PolyhedronLocator<Rat> block;
+  reporter.time("PolyhedronLocator, build, faces", terrain.faces().size(),
+      [&] { block = PolyhedronLocator<Rat>{terrain}; });
+
+  // Points over the grid, from below the base to above the surface.
+  auto extent = static_cast<long long>(side - 1) * 1000;
+  std::vector<P3> samples(reporter.scaled(100000));
+  for (auto& sample : samples) {
+    sample = P3{Rat(static_cast<long long>(generator() % extent), 1000LL),
+        Rat(static_cast<long long>(generator() % extent), 1000LL),
+        Rat(static_cast<long long>(generator() % 2500), 1000LL)};
+  }
+  reporter.time("PolyhedronLocator, 1 thread, points", samples.size(),
+      [&] { found = block.locate(samples); });
+  reporter.time(
+      "PolyhedronLocator, " + std::to_string(threads) + " threads, points",
+      samples.size(), [&] { found = block.locate(samples, threads); });
+  keep(found);
+}
+
+const Registration point_location("point_location", bench_point_location);
+
+
+} // namespace
+} // namespace benchmark
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
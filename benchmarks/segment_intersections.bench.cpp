@@ -0,0 +1,102 @@
+
+#include "../src/rational_geometry/segment_intersections.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace rational_geometry {
+namespace benchmark {
+namespace {
+
+
+typedef FixedRational<long long, 1000> Rat;
+typedef Point<Rat, 2> P;
+
+/// Short segments scattered over [0, 1000]², in thousandths, as of a road
+/// network: each up to a unit long, and running in one of eight directions,
+/// so many share ends, overlap along a line or cross.
+///
+/// Diagonals start where the numerators' sum is even, so every crossing lies
+/// on the thousandths' lattice.
+///
+std::vector<std::array<P, 2>> make_roads(
+    size_t count, std::mt19937_64& generator)
+{
+  std::vector<std::array<P, 2>> ret;
+  ret.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    auto x      = static_cast<long long>(generator() % 1000000);
+    auto y      = static_cast<long long>(generator() % 1000000);
+    auto length = static_cast<long long>(generator() % 1000) + 1;
+    if (generator() % 4 == 0) {
+      // Snapped to a grid line, like a straight street.
+      x -= x % 100;
+    }
+
+    auto dx = length;
+    auto dy = length;
+    switch (generator() % 4) {
+      case 0: dy = 0; break;
+      case 1: dx = 0; break;
+      case 2: dy = -length; break;
+      default: break;
+    }
+    if (dx != 0 && dy != 0) {
+      y += (x + y) % 2;
+    }
+    ret.push_back({P{Rat(x, 1000LL), Rat(y, 1000LL)},
+        P{Rat(x + dx, 1000LL), Rat(y + dy, 1000LL)}});
+  }
+  return ret;
+}
+
+/// Long east-west streets, one to each thousandth of northing, starting at
+/// random across the first unit: the sweep line crosses nearly all of them at
+/// once, so the status is as tall as the input.
+///
+std::vector<std::array<P, 2>> make_streets(
+    size_t count, std::mt19937_64& generator)
+{
+  std::vector<std::array<P, 2>> ret;
+  ret.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    auto x = static_cast<long long>(generator() % 1000);
+    auto y = static_cast<long long>(i);
+    ret.push_back({P{Rat(x, 1000LL), Rat(y, 1000LL)},
+        P{Rat(x + 999000, 1000LL), Rat(y, 1000LL)}});
+  }
+  std::shuffle(ret.begin(), ret.end(), generator);
+  return ret;
+}
+
+void bench_segment_intersections(Reporter& reporter)
+{
+  auto generator = make_generator();
+
+  auto size  = reporter.scaled(1000000);
+  auto roads = make_roads(size, generator);
+
+  std::vector<SegmentCrossing<Rat>> crossings;
+  reporter.time("roads, segments", size,
+      [&] { crossings = segment_intersections(roads); });
+  reporter.report("  crossings", crossings.size(), "points");
+
+  auto streets = make_streets(reporter.scaled(200000), generator);
+  reporter.time("streets, segments", streets.size(),
+      [&] { crossings = segment_intersections(streets); });
+  keep(crossings);
+}
+
+const Registration segment_intersections_benchmark(
+    "segment_intersections", bench_segment_intersections);
+
+
+} // namespace
+} // namespace benchmark
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
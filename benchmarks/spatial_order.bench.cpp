@@ -0,0 +1,119 @@
+#include "../src/rational_geometry/spatial_order.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "../src/rational_geometry/predicates.hpp"
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace rational_geometry {
+namespace benchmark {
+namespace {
+
+
+typedef FixedRational<long long, 1000> Rat;
+typedef Point<Rat, 3> P;
+
+/// A triangulated height field, as of terrain, with its vertices stored in a
+/// random order, as meshes merged from many sources often are.
+///
+struct Mesh
+{
+  std::vector<P> vertices_;
+  std::vector<size_t> corners_;
+};
+
+Mesh make_shuffled_terrain(size_t vertices, std::mt19937_64& generator)
+{
+  auto side = static_cast<size_t>(std::sqrt(static_cast<double>(vertices)));
+
+  std::vector<P> grid;
+  grid.reserve(side * side);
+  for (size_t i = 0; i < side; ++i) {
+    for (size_t j = 0; j < side; ++j) {
+      grid.push_back(P{Rat(static_cast<long long>(i)),
+          Rat(static_cast<long long>(j)),
+          Rat(static_cast<long long>(generator() % 100000), 1000LL)});
+    }
+  }
+
+  std::vector<size_t> corners;
+  corners.reserve(6 * side * side);
+  for (size_t i = 0; i + 1 < side; ++i) {
+    for (size_t j = 0; j + 1 < side; ++j) {
+      auto corner = i * side + j;
+      for (auto offset : {size_t(0), side, side + 1, size_t(0), side + 1,
+               size_t(1)}) {
+        corners.push_back(corner + offset);
+      }
+    }
+  }
+
+  std::vector<size_t> shuffle(grid.size());
+  for (size_t i = 0; i < shuffle.size(); ++i) {
+    shuffle[i] = i;
+  }
+  std::shuffle(shuffle.begin(), shuffle.end(), generator);
+  return Mesh{reorder(grid, shuffle), reindex(corners, shuffle)};
+}
+
+/// Sum the squared lengths of the mesh's edges, a pass that gathers each
+/// triangle's vertices as most mesh processing does.
+///
+long long edge_length_sum(const Mesh& mesh)
+{
+  long long ret = 0;
+  for (size_t i = 0; i < mesh.corners_.size(); i += 3) {
+    const auto& a = mesh.vertices_[mesh.corners_[i]];
+    const auto& b = mesh.vertices_[mesh.corners_[i + 1]];
+    const auto& c = mesh.vertices_[mesh.corners_[i + 2]];
+    ret += static_cast<long long>(scaled_squared_distance(a, b)
+                                  + scaled_squared_distance(b, c)
+                                  + scaled_squared_distance(c, a));
+  }
+  return ret;
+}
+
+void bench_spatial_order(Reporter& reporter)
+{
+  auto generator = make_generator();
+  auto threads   = std::max<size_t>(std::thread::hardware_concurrency(), 2);
+
+  auto mesh = make_shuffled_terrain(reporter.scaled(4000000), generator);
+  auto size = mesh.vertices_.size();
+
+  std::vector<size_t> order;
+  reporter.time("morton_order(), 1 thread, points", size,
+      [&] { order = morton_order(mesh.vertices_); });
+  reporter.time("hilbert_order(), 1 thread, points", size,
+      [&] { order = hilbert_order(mesh.vertices_); });
+  reporter.time(
+      "hilbert_order(), " + std::to_string(threads) + " threads, points",
+      size, [&] { order = hilbert_order(mesh.vertices_, threads); });
+
+  Mesh sorted{reorder(mesh.vertices_, order), reindex(mesh.corners_, order)};
+
+  // The locality gain: the same pass over the same triangles, with their
+  // vertices stored shuffled and then along the Hilbert curve.
+  auto triangles = mesh.corners_.size() / 3;
+  long long sum  = 0;
+  reporter.time("edge pass, shuffled, triangles", triangles,
+      [&] { sum = edge_length_sum(mesh); });
+  keep(sum);
+  reporter.time("edge pass, Hilbert order, triangles", triangles,
+      [&] { sum = edge_length_sum(sorted); });
+  keep(sum);
+}
+
+const Registration spatial_order("spatial_order", bench_spatial_order);
+
+
+} // namespace
+} // namespace benchmark
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,84 @@
+#include "../src/rational_geometry/triangulation.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "benchmark.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace rational_geometry {
+namespace benchmark {
+namespace {
+
+
+typedef FixedRational<long long, 1000> Rat;
+typedef Polygon2D<Rat> PolygonT;
+typedef PolygonT::PointT P;
+
+/// A star-shaped outline, as of a traced blob: vertices at evenly stepped
+/// angles around the origin, at random radii between 500 and 1000, in
+/// thousandths. Each step turns further than rounding can move a vertex, so
+/// the ring stays simple.
+///
+PolygonT make_star(size_t vertices, std::mt19937_64& generator)
+{
+  const double kTurn = 6.283185307179586;
+
+  PolygonT::RingT ring;
+  ring.reserve(vertices);
+  for (size_t i = 0; i < vertices; ++i) {
+    auto angle  = kTurn * static_cast<double>(i) / vertices;
+    auto radius = 500.0 + static_cast<double>(generator() % 500000) / 1000;
+    ring.push_back(
+        P{Rat(std::llround(radius * std::cos(angle) * 1000), 1000LL),
+            Rat(std::llround(radius * std::sin(angle) * 1000), 1000LL)});
+  }
+  return PolygonT{{ring}};
+}
+
+/// A square plate pierced by a grid of square holes, as of a perforated
+/// sheet.
+///
+PolygonT make_perforated(size_t holes_per_side)
+{
+  auto side = static_cast<long long>(2 * holes_per_side + 1);
+  PolygonT ret{{P{Rat(0), Rat(0)}, P{Rat(side), Rat(0)},
+      P{Rat(side), Rat(side)}, P{Rat(0), Rat(side)}}};
+  for (size_t i = 0; i < holes_per_side; ++i) {
+    for (size_t j = 0; j < holes_per_side; ++j) {
+      auto x = Rat(2 * static_cast<long long>(i) + 1);
+      auto y = Rat(2 * static_cast<long long>(j) + 1);
+      ret.add_ring({P{x, y}, P{x, y + Rat(1)}, P{x + Rat(1), y + Rat(1)},
+          P{x + Rat(1), y}});
+    }
+  }
+  return ret;
+}
+
+void bench_triangulation(Reporter& reporter)
+{
+  auto generator = make_generator();
+
+  auto star = make_star(reporter.scaled(1000000), generator);
+  std::vector<size_t> triangles;
+  reporter.time("star, vertices", star.vertex_count(),
+      [&] { triangles = triangulate(star); });
+  reporter.report("  triangles", triangles.size() / 3, "triangles");
+
+  auto holes_per_side = static_cast<size_t>(
+      std::sqrt(static_cast<double>(reporter.scaled(1000000) / 4)));
+  auto perforated = make_perforated(holes_per_side);
+  reporter.time("perforated plate, vertices", perforated.vertex_count(),
+      [&] { triangles = triangulate(perforated); });
+  reporter.report("  triangles", triangles.size() / 3, "triangles");
+  keep(triangles);
+}
+
+const Registration triangulation("triangulation", bench_triangulation);
+
+
+} // namespace
+} // namespace benchmark
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,343 @@
+/// \file     AABB.hpp
+/// \author   Tim Holt
+///
+/// An exact axis-aligned bounding box class.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_AABB_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_AABB_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "Point.hpp"
+#include "predicates.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <ostream>
+#include <type_traits>
+#include <typeinfo>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Helper Functions
+//------------------
+
+/// Test whether one fraction of RatT values is less than another, without
+/// dividing.
+///
+/// \note  Both denominators must be positive. FixedRationals are compared by
+///        their numerators' products, as integers wide enough to hold them,
+///        so no product need be representable as a FixedRational.
+///
+template <typename RatT>
+bool is_fraction_less(const RatT& l_numerator,
+    const RatT& l_denominator,
+    const RatT& r_numerator,
+    const RatT& r_denominator)
+{
+  typedef typename NumeratorType<RatT>::type IntT;
+  typedef typename WidenedInt<IntT>::type WideT;
+
+  // Numerators under 2^31 have products that fit in long long.
+  if constexpr (std::is_integral<IntT>::value) {
+    auto a = numerator_of(l_numerator);
+    auto b = numerator_of(r_denominator);
+    auto c = numerator_of(r_numerator);
+    auto d = numerator_of(l_denominator);
+    if (is_within_bits(a, 31) && is_within_bits(b, 31)
+        && is_within_bits(c, 31) && is_within_bits(d, 31)) {
+      return static_cast<long long>(a) * b < static_cast<long long>(c) * d;
+    }
+  }
+  return WideT(numerator_of(l_numerator)) * numerator_of(r_denominator)
+         < WideT(numerator_of(r_numerator)) * numerator_of(l_denominator);
+}
+
+// Class Template Declaration
+//----------------------------
+
+/// \brief  The closed box of points between a lower and an upper corner, with
+///         sides parallel to the axes.
+///
+/// A default constructed box is empty: it holds no points, and extending it by
+/// a point gives that point's box.
+///
+template <typename RatT, size_t kDimension>
+class AABB
+{
+ public:
+  // TYPES
+  typedef Point<RatT, kDimension> PointT;
+
+ protected:
+  // INTERNAL STATE
+  PointT lower_;
+  PointT upper_;
+  bool is_empty_;
+
+ public:
+  // CONSTRUCTORS
+  AABB();
+  explicit AABB(const PointT& point);
+  AABB(const PointT& a, const PointT& b);
+
+  // ACCESSORS
+  const PointT& lower() const;
+  const PointT& upper() const;
+  bool empty() const;
+  PointT doubled_center() const;
+
+  bool contains(const PointT& point) const;
+  bool contains(const AABB& box) const;
+  bool overlaps(const AABB& box) const;
+  bool is_hit_by(const PointT& origin, const PointT& direction) const;
+
+  // MUTATORS
+  AABB& extend(const PointT& point);
+  AABB& extend(const AABB& box);
+
+  // OPERATORS
+  AABB operator|(const AABB& r_op) const;
+  AABB operator&(const AABB& r_op) const;
+  bool operator==(const AABB& r_op) const;
+  bool operator!=(const AABB& r_op) const;
+};
+
+// Class Template Definitions
+//----------------------------
+//   Constructors
+//  --------------
+
+/// Creates an empty box.
+///
+template <typename RatT, size_t kDimension>
+AABB<RatT, kDimension>::AABB() : lower_(), upper_(), is_empty_(true)
+{
+}
+
+/// Creates the box of a single point.
+///
+template <typename RatT, size_t kDimension>
+AABB<RatT, kDimension>::AABB(const PointT& point)
+    : lower_(point), upper_(point), is_empty_(false)
+{
+}
+
+/// Creates the box with two opposite corners, in either order.
+///
+template <typename RatT, size_t kDimension>
+AABB<RatT, kDimension>::AABB(const PointT& a, const PointT& b) : AABB(a)
+{
+  extend(b);
+}
+
+//   Accessors
+//  -----------
+
+template <typename RatT, size_t kDimension>
+auto AABB<RatT, kDimension>::lower() const -> const PointT&
+{
+  return lower_;
+}
+
+template <typename RatT, size_t kDimension>
+auto AABB<RatT, kDimension>::upper() const -> const PointT&
+{
+  return upper_;
+}
+
+template <typename RatT, size_t kDimension>
+bool AABB<RatT, kDimension>::empty() const
+{
+  return is_empty_;
+}
+
+/// Get twice the box's center, which, unlike the center, is exact in any
+/// RatT.
+///
+template <typename RatT, size_t kDimension>
+auto AABB<RatT, kDimension>::doubled_center() const -> PointT
+{
+  return lower_ + upper_;
+}
+
+template <typename RatT, size_t kDimension>
+bool AABB<RatT, kDimension>::contains(const PointT& point) const
+{
+  if (is_empty_) return false;
+  for (size_t i = 0; i < kDimension; ++i) {
+    if (point[i] < lower_[i] || upper_[i] < point[i]) return false;
+  }
+  return true;
+}
+
+template <typename RatT, size_t kDimension>
+bool AABB<RatT, kDimension>::contains(const AABB& box) const
+{
+  return box.is_empty_ || (contains(box.lower_) && contains(box.upper_));
+}
+
+/// Test whether two boxes share any point, including on their boundaries.
+///
+template <typename RatT, size_t kDimension>
+bool AABB<RatT, kDimension>::overlaps(const AABB& box) const
+{
+  if (is_empty_ || box.is_empty_) return false;
+  for (size_t i = 0; i < kDimension; ++i) {
+    if (box.upper_[i] < lower_[i] || upper_[i] < box.lower_[i]) return false;
+  }
+  return true;
+}
+
+/// Test whether a ray, from an origin along a direction, meets the box.
+///
+/// This is the slab test: each axis limits the ray's parameter to an
+/// interval, and the ray hits if their intersection is not empty. The
+/// interval ends are fractions, compared without dividing, so the test is
+/// exact.
+///
+template <typename RatT, size_t kDimension>
+bool AABB<RatT, kDimension>::is_hit_by(
+    const PointT& origin, const PointT& direction) const
+{
+  if (is_empty_) return false;
+
+  // The ray's parameter interval, [0, infinity) to start.
+  RatT enter_numerator(0);
+  RatT enter_denominator(1);
+  RatT exit_numerator(0);
+  RatT exit_denominator(0);
+
+  for (size_t i = 0; i < kDimension; ++i) {
+    if (direction[i] == RatT(0)) {
+      if (origin[i] < lower_[i] || upper_[i] < origin[i]) return false;
+      continue;
+    }
+
+    // Along a falling axis, the slab is entered at its upper side.
+    bool is_rising   = RatT(0) < direction[i];
+    auto near        = is_rising ? lower_[i] : upper_[i];
+    auto far         = is_rising ? upper_[i] : lower_[i];
+    auto denominator = is_rising ? direction[i] : -direction[i];
+    auto enter       = is_rising ? near - origin[i] : origin[i] - near;
+    auto exit        = is_rising ? far - origin[i] : origin[i] - far;
+
+    if (is_fraction_less(
+            enter_numerator, enter_denominator, enter, denominator)) {
+      enter_numerator   = enter;
+      enter_denominator = denominator;
+    }
+    if (exit_denominator == RatT(0)
+        || is_fraction_less(
+            exit, denominator, exit_numerator, exit_denominator)) {
+      exit_numerator   = exit;
+      exit_denominator = denominator;
+    }
+  }
+
+  return exit_denominator == RatT(0)
+         || !is_fraction_less(exit_numerator, exit_denominator, enter_numerator,
+                enter_denominator);
+}
+
+//   Mutators
+//  ----------
+
+/// Grow the box to hold a point.
+///
+template <typename RatT, size_t kDimension>
+auto AABB<RatT, kDimension>::extend(const PointT& point) -> AABB&
+{
+  if (is_empty_) {
+    *this = AABB{point};
+    return *this;
+  }
+  for (size_t i = 0; i < kDimension; ++i) {
+    lower_[i] = std::min(lower_[i], point[i]);
+    upper_[i] = std::max(upper_[i], point[i]);
+  }
+  return *this;
+}
+
+/// Grow the box to hold another.
+///
+template <typename RatT, size_t kDimension>
+auto AABB<RatT, kDimension>::extend(const AABB& box) -> AABB&
+{
+  if (!box.is_empty_) {
+    extend(box.lower_);
+    extend(box.upper_);
+  }
+  return *this;
+}
+
+//   Operators
+//  -----------
+
+/// Get the least box holding both boxes.
+///
+template <typename RatT, size_t kDimension>
+auto AABB<RatT, kDimension>::operator|(const AABB& r_op) const -> AABB
+{
+  auto ret = *this;
+  return ret.extend(r_op);
+}
+
+/// Get the box of the points in both boxes.
+///
+template <typename RatT, size_t kDimension>
+auto AABB<RatT, kDimension>::operator&(const AABB& r_op) const -> AABB
+{
+  if (!overlaps(r_op)) return AABB{};
+
+  AABB ret = *this;
+  for (size_t i = 0; i < kDimension; ++i) {
+    ret.lower_[i] = std::max(lower_[i], r_op.lower_[i]);
+    ret.upper_[i] = std::min(upper_[i], r_op.upper_[i]);
+  }
+  return ret;
+}
+
+/// Test whether two boxes hold the same points; all empty boxes are equal.
+///
+template <typename RatT, size_t kDimension>
+bool AABB<RatT, kDimension>::operator==(const AABB& r_op) const
+{
+  if (is_empty_ || r_op.is_empty_) return is_empty_ == r_op.is_empty_;
+  return lower_ == r_op.lower_ && upper_ == r_op.upper_;
+}
+
+template <typename RatT, size_t kDimension>
+bool AABB<RatT, kDimension>::operator!=(const AABB& r_op) const
+{
+  return !(*this == r_op);
+}
+
+// Related Functions
+//-------------------
+
+template <typename RatT, size_t kDimension>
+std::ostream& operator<<(
+    std::ostream& the_stream, const AABB<RatT, kDimension>& the_box)
+{
+  the_stream << typeid(the_box).name() << ":";
+  if (the_box.empty()) return the_stream << "()";
+  return the_stream << "(" << the_box.lower() << ", " << the_box.upper()
+                    << ")";
+}
+
+//-------------------
+// Related Functions
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_AABB_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
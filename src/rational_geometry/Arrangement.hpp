@@ -0,0 +1,619 @@
+/// \file     Arrangement.hpp
+/// \author   Tim Holt
+///
+/// The exact planar arrangement of segments: the vertices, edges and faces
+/// they cut the plane into, with labels carried from the segments to the faces.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_ARRANGEMENT_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_ARRANGEMENT_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "Point.hpp"
+#include "Polygon2D.hpp"
+#include "angular_order.hpp"
+#include "predicates.hpp"
+#include "segment_intersections.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Class Template Declaration
+//----------------------------
+
+/// \brief  The subdivision of the plane by a set of segments, as a doubly
+///         connected edge list, with each face labelled from each layer of
+///         segments.
+///
+/// The segments are split wherever they meet (by segment_intersections()), and
+/// overlapping pieces merged, into edges that only meet at their ends. Each
+/// edge is two half-edges, each with the face on its left: half-edge 2e runs
+/// along edge e from its lexicographically least end, and 2e + 1 runs back, so
+/// a half-edge's twin is found by flipping its lowest bit. Previous half-edges
+/// are not stored. Everything is kept in flat arrays, referring by index.
+///
+/// Face 0 is the unbounded face. Every other face has one outer boundary,
+/// counter-clockwise; a face may also have inner boundaries, clockwise, one
+/// for each separate group of edges lying within it.
+///
+/// Each segment belongs to a layer, and names the faces on its left and right
+/// within that layer, as with one layer's map in a map overlay. Every face of
+/// the arrangement then takes, for each layer, the label given by that
+/// layer's segments on its boundary, or else the label of a neighbouring face
+/// across an edge that layer has no segment on. Labels not found that way are
+/// kNone.
+///
+template <typename RatT>
+class Arrangement
+{
+ public:
+  // TYPES
+  typedef Point<RatT, 2> PointT;
+
+  // CONSTANTS
+  static constexpr size_t kNone = static_cast<size_t>(-1);
+
+  /// An input segment, its layer, and its layer's labels for the faces on its
+  /// left and right, looking from start_ to end_.
+  struct Segment
+  {
+    PointT start_;
+    PointT end_;
+    size_t layer_       = 0;
+    size_t left_label_  = kNone;
+    size_t right_label_ = kNone;
+  };
+
+  struct HalfEdge
+  {
+    size_t origin_;
+    size_t next_;
+    size_t face_;
+  };
+
+ protected:
+  // INTERNAL STATE
+  std::vector<PointT> vertices_;
+  std::vector<HalfEdge> half_edges_;
+
+  /// The input segments lying along each edge, edge e's being
+  /// edge_segments_[edge_segment_offsets_[e]] up to edge_segment_offsets_[e +
+  /// 1].
+  std::vector<size_t> edge_segment_offsets_{0};
+  std::vector<size_t> edge_segments_;
+
+  /// A half-edge on each face's outer boundary (kNone for the unbounded face),
+  /// and one on each of its inner boundaries, indexed like the edge segments.
+  std::vector<size_t> face_outer_half_edges_;
+  std::vector<size_t> face_hole_offsets_;
+  std::vector<size_t> face_holes_;
+
+  /// Face f's label in layer l is face_labels_[f * layer_count_ + l].
+  size_t layer_count_ = 0;
+  std::vector<size_t> face_labels_;
+
+  // HELPER FUNCTIONS
+  void build_edges(const std::vector<Segment>& segments);
+  void link_half_edges();
+  void find_faces();
+  void label_faces(const std::vector<Segment>& segments);
+
+ public:
+  // CONSTRUCTORS
+  Arrangement();
+  explicit Arrangement(const std::vector<Segment>& segments);
+
+  // ACCESSORS
+  const std::vector<PointT>& vertices() const;
+  const std::vector<HalfEdge>& half_edges() const;
+  size_t edge_count() const;
+  size_t face_count() const;
+  size_t layer_count() const;
+
+  size_t twin(size_t half_edge) const;
+  size_t destination(size_t half_edge) const;
+  std::vector<size_t> edge_segments(size_t edge) const;
+  std::vector<size_t> boundary_vertices(size_t half_edge) const;
+
+  size_t outer_half_edge(size_t face) const;
+  std::vector<size_t> inner_half_edges(size_t face) const;
+  size_t label(size_t face, size_t layer) const;
+};
+
+// Class Template Definitions
+//----------------------------
+//   Constructors
+//  --------------
+
+/// Creates an empty arrangement, of only the unbounded face.
+///
+template <typename RatT>
+Arrangement<RatT>::Arrangement()
+    : face_outer_half_edges_{kNone}, face_hole_offsets_{0, 0}
+{
+}
+
+/// Creates the arrangement of segments.
+///
+/// Segments of zero length are left out.
+///
+/// \throws  unrepresentable_operation_error if RatT is a FixedRational that
+///          cannot represent a point where segments cross.
+///
+/// \note  Overflow is not detected.
+///
+template <typename RatT>
+Arrangement<RatT>::Arrangement(const std::vector<Segment>& segments)
+{
+  build_edges(segments);
+  link_half_edges();
+  find_faces();
+  label_faces(segments);
+}
+
+//   Helper Functions
+//  ------------------
+
+/// Split the segments where they meet, and make an edge of each distinct
+/// piece.
+///
+/// Vertices are sorted lexicographically, so a segment's vertices are in
+/// order along it, and the edges come out sorted by their least ends.
+///
+template <typename RatT>
+void Arrangement<RatT>::build_edges(const std::vector<Segment>& segments)
+{
+  using namespace std;
+
+  vector<array<PointT, 2>> ends;
+  vector<size_t> kept;
+  for (size_t i = 0; i < segments.size(); ++i) {
+    if (segments[i].start_ != segments[i].end_) {
+      ends.push_back({segments[i].start_, segments[i].end_});
+      kept.push_back(i);
+    }
+  }
+  auto crossings = segment_intersections(ends);
+
+  for (const auto& end_points : ends) {
+    vertices_.insert(vertices_.end(), end_points.begin(), end_points.end());
+  }
+  for (const auto& crossing : crossings) {
+    vertices_.push_back(crossing.point_);
+  }
+  sort(begin(vertices_), end(vertices_));
+  vertices_.erase(unique(begin(vertices_), end(vertices_)), end(vertices_));
+  vertices_.shrink_to_fit();
+
+  auto vertex_of = [this](const PointT& point) {
+    return static_cast<size_t>(
+        lower_bound(begin(vertices_), end(vertices_), point)
+        - begin(vertices_));
+  };
+
+  // Each segment's vertices, and the pieces between them.
+  vector<pair<size_t, size_t>> along;
+  for (size_t i = 0; i < ends.size(); ++i) {
+    along.emplace_back(i, vertex_of(ends[i][0]));
+    along.emplace_back(i, vertex_of(ends[i][1]));
+  }
+  for (const auto& crossing : crossings) {
+    auto vertex = vertex_of(crossing.point_);
+    for (auto segment : crossing.segments_) {
+      along.emplace_back(segment, vertex);
+    }
+  }
+  sort(begin(along), end(along));
+  along.erase(unique(begin(along), end(along)), end(along));
+
+  vector<array<size_t, 3>> pieces;
+  for (size_t i = 0; i + 1 < along.size(); ++i) {
+    if (along[i].first == along[i + 1].first) {
+      pieces.push_back(
+          {along[i].second, along[i + 1].second, kept[along[i].first]});
+    }
+  }
+  sort(begin(pieces), end(pieces));
+
+  for (size_t i = 0; i < pieces.size(); ++i) {
+    bool is_new = i == 0 || pieces[i][0] != pieces[i - 1][0]
+                  || pieces[i][1] != pieces[i - 1][1];
+    if (is_new) {
+      if (i != 0) edge_segment_offsets_.push_back(edge_segments_.size());
+      half_edges_.push_back(HalfEdge{pieces[i][0], kNone, kNone});
+      half_edges_.push_back(HalfEdge{pieces[i][1], kNone, kNone});
+    }
+    edge_segments_.push_back(pieces[i][2]);
+  }
+  if (!pieces.empty()) edge_segment_offsets_.push_back(edge_segments_.size());
+}
+
+/// Link each half-edge to the next around its face.
+///
+/// The half-edges leaving each vertex are sorted counter-clockwise by
+/// compare_angles(); a half-edge's next is then the one leaving its end just
+/// clockwise of its twin, which keeps the face on the left.
+///
+template <typename RatT>
+void Arrangement<RatT>::link_half_edges()
+{
+  using namespace std;
+  typedef typename WidenedInt<typename NumeratorType<RatT>::type>::type WideT;
+
+  vector<size_t> offsets(vertices_.size() + 1, 0);
+  for (const auto& half_edge : half_edges_) {
+    ++offsets[half_edge.origin_ + 1];
+  }
+  partial_sum(begin(offsets), end(offsets), begin(offsets));
+
+  vector<size_t> outgoing(half_edges_.size());
+  auto cursors = offsets;
+  for (size_t i = 0; i < half_edges_.size(); ++i) {
+    outgoing[cursors[half_edges_[i].origin_]++] = i;
+  }
+
+  auto delta = [this](size_t half_edge, size_t axis) {
+    return WideT(numerator_of(vertices_[destination(half_edge)][axis]))
+           - numerator_of(vertices_[half_edges_[half_edge].origin_][axis]);
+  };
+  for (size_t vertex = 0; vertex < vertices_.size(); ++vertex) {
+    auto first = begin(outgoing) + offsets[vertex];
+    auto last  = begin(outgoing) + offsets[vertex + 1];
+    sort(first, last, [&delta](size_t l_op, size_t r_op) {
+      return compare_angles(
+                 delta(l_op, 0), delta(l_op, 1), delta(r_op, 0), delta(r_op, 1))
+             < 0;
+    });
+  }
+
+  vector<size_t> positions(half_edges_.size());
+  for (size_t i = 0; i < outgoing.size(); ++i) {
+    positions[outgoing[i]] = i;
+  }
+  for (size_t i = 0; i < half_edges_.size(); ++i) {
+    auto back   = twin(i);
+    auto vertex = half_edges_[back].origin_;
+    auto first  = offsets[vertex];
+    auto degree = offsets[vertex + 1] - first;
+    half_edges_[i].next_ =
+        outgoing[first + (positions[back] - first + degree - 1) % degree];
+  }
+}
+
+/// Trace the boundaries, and find the face each one bounds.
+///
+/// A boundary is inner if, at its least vertex, it turns clockwise or back on
+/// itself. Outer boundaries each bound a new face. Inner ones lie in the face
+/// just below their least vertex, found by a sweep over the vertices in order
+/// holding the edges under the sweep line bottom to top; that face's own
+/// boundary has an edge further left, so has already been placed.
+///
+template <typename RatT>
+void Arrangement<RatT>::find_faces()
+{
+  using namespace std;
+
+  auto count = half_edges_.size();
+  vector<size_t> cycles(count, kNone);
+  vector<size_t> cycle_starts;
+  for (size_t i = 0; i < count; ++i) {
+    if (cycles[i] != kNone) continue;
+    auto half_edge = i;
+    do {
+      cycles[half_edge] = cycle_starts.size();
+      half_edge         = half_edges_[half_edge].next_;
+    } while (half_edge != i);
+    cycle_starts.push_back(i);
+  }
+
+  vector<size_t> least(cycle_starts.size(), kNone);
+  for (size_t i = 0; i < count; ++i) {
+    least[cycles[i]] = min(least[cycles[i]], half_edges_[i].origin_);
+  }
+  vector<bool> is_inner(cycle_starts.size(), false);
+  for (size_t i = 0; i < count; ++i) {
+    auto vertex = destination(i);
+    if (vertex == least[cycles[i]]
+        && orient2d(vertices_[half_edges_[i].origin_], vertices_[vertex],
+               vertices_[destination(half_edges_[i].next_)])
+               <= 0) {
+      is_inner[cycles[i]] = true;
+    }
+  }
+
+  face_outer_half_edges_ = {kNone};
+  vector<size_t> cycle_faces(cycle_starts.size(), kNone);
+  vector<size_t> inner;
+  for (size_t i = 0; i < cycle_starts.size(); ++i) {
+    if (is_inner[i]) {
+      inner.push_back(i);
+    }
+    else {
+      cycle_faces[i] = face_outer_half_edges_.size();
+      face_outer_half_edges_.push_back(cycle_starts[i]);
+    }
+  }
+  stable_sort(begin(inner), end(inner),
+      [&least](size_t l_op, size_t r_op) { return least[l_op] < least[r_op]; });
+
+  vector<size_t> status;
+  size_t next_inner = 0;
+  size_t next_edge  = 0;
+  for (size_t vertex = 0; vertex < vertices_.size(); ++vertex) {
+    const auto& point = vertices_[vertex];
+    auto side         = [this, &point](size_t edge) {
+      return orient2d(vertices_[half_edges_[2 * edge].origin_],
+          vertices_[half_edges_[2 * edge + 1].origin_], point);
+    };
+
+    // Edges ending here lie between those below and above.
+    auto first = partition_point(begin(status), end(status),
+        [&side](size_t edge) { return side(edge) > 0; });
+    auto last  = partition_point(
+        first, end(status), [&side](size_t edge) { return side(edge) == 0; });
+    first = status.erase(first, last);
+
+    for (; next_inner < inner.size() && least[inner[next_inner]] == vertex;
+         ++next_inner) {
+      cycle_faces[inner[next_inner]] =
+          first == begin(status) ? 0 : cycle_faces[cycles[2 * *prev(first)]];
+    }
+
+    // Edges starting here go in bottom to top.
+    vector<size_t> starting;
+    for (; next_edge < edge_count()
+           && half_edges_[2 * next_edge].origin_ == vertex;
+         ++next_edge) {
+      starting.push_back(next_edge);
+    }
+    sort(begin(starting), end(starting),
+        [this, &point](size_t l_op, size_t r_op) {
+          return orient2d(point, vertices_[destination(2 * l_op)],
+                     vertices_[destination(2 * r_op)])
+                 > 0;
+        });
+    status.insert(first, begin(starting), end(starting));
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    half_edges_[i].face_ = cycle_faces[cycles[i]];
+  }
+
+  face_hole_offsets_.assign(face_count() + 1, 0);
+  for (auto cycle : inner) {
+    ++face_hole_offsets_[cycle_faces[cycle] + 1];
+  }
+  partial_sum(begin(face_hole_offsets_), end(face_hole_offsets_),
+      begin(face_hole_offsets_));
+  face_holes_.resize(inner.size());
+  auto cursors = face_hole_offsets_;
+  for (auto cycle : inner) {
+    face_holes_[cursors[cycle_faces[cycle]]++] = cycle_starts[cycle];
+  }
+}
+
+/// Give each face its labels, from the segments on its boundary, then spread
+/// them across edges with no segment of their layer.
+///
+template <typename RatT>
+void Arrangement<RatT>::label_faces(const std::vector<Segment>& segments)
+{
+  using namespace std;
+
+  layer_count_ = 0;
+  for (const auto& segment : segments) {
+    layer_count_ = max(layer_count_, segment.layer_ + 1);
+  }
+  face_labels_.assign(face_count() * layer_count_, kNone);
+  vector<bool> is_known(face_labels_.size(), false);
+
+  auto give = [this, &is_known](size_t face, size_t layer, size_t label) {
+    auto i = face * layer_count_ + layer;
+    if (!is_known[i]) face_labels_[i] = label;
+    is_known[i] = true;
+  };
+  for (size_t edge = 0; edge < edge_count(); ++edge) {
+    for (auto i = edge_segment_offsets_[edge];
+         i < edge_segment_offsets_[edge + 1]; ++i) {
+      const auto& segment = segments[edge_segments_[i]];
+      bool is_along       = segment.start_ < segment.end_;
+      give(half_edges_[2 * edge].face_, segment.layer_,
+          is_along ? segment.left_label_ : segment.right_label_);
+      give(half_edges_[2 * edge + 1].face_, segment.layer_,
+          is_along ? segment.right_label_ : segment.left_label_);
+    }
+  }
+  for (size_t layer = 0; layer < layer_count_; ++layer) {
+    is_known[layer] = true;
+  }
+
+  vector<size_t> offsets(face_count() + 1, 0);
+  for (const auto& half_edge : half_edges_) {
+    ++offsets[half_edge.face_ + 1];
+  }
+  partial_sum(begin(offsets), end(offsets), begin(offsets));
+  vector<size_t> bounding(half_edges_.size());
+  auto cursors = offsets;
+  for (size_t i = 0; i < half_edges_.size(); ++i) {
+    bounding[cursors[half_edges_[i].face_]++] = i;
+  }
+
+  auto has_layer = [this, &segments](size_t edge, size_t layer) {
+    for (auto i = edge_segment_offsets_[edge];
+         i < edge_segment_offsets_[edge + 1]; ++i) {
+      if (segments[edge_segments_[i]].layer_ == layer) return true;
+    }
+    return false;
+  };
+
+  vector<size_t> pending(face_count());
+  iota(begin(pending), end(pending), size_t(0));
+  while (!pending.empty()) {
+    auto face = pending.back();
+    pending.pop_back();
+    for (auto i = offsets[face]; i < offsets[face + 1]; ++i) {
+      auto half_edge = bounding[i];
+      auto other     = half_edges_[twin(half_edge)].face_;
+      for (size_t layer = 0; layer < layer_count_; ++layer) {
+        auto from = face * layer_count_ + layer;
+        auto to   = other * layer_count_ + layer;
+        if (is_known[from] && !is_known[to]
+            && !has_layer(half_edge / 2, layer)) {
+          face_labels_[to] = face_labels_[from];
+          is_known[to]     = true;
+          pending.push_back(other);
+        }
+      }
+    }
+  }
+}
+
+//   Accessors
+//  -----------
+
+template <typename RatT>
+auto Arrangement<RatT>::vertices() const -> const std::vector<PointT>&
+{
+  return vertices_;
+}
+
+template <typename RatT>
+auto Arrangement<RatT>::half_edges() const -> const std::vector<HalfEdge>&
+{
+  return half_edges_;
+}
+
+template <typename RatT>
+size_t Arrangement<RatT>::edge_count() const
+{
+  return half_edges_.size() / 2;
+}
+
+/// Get how many faces there are, including the unbounded face.
+///
+template <typename RatT>
+size_t Arrangement<RatT>::face_count() const
+{
+  return face_outer_half_edges_.size();
+}
+
+template <typename RatT>
+size_t Arrangement<RatT>::layer_count() const
+{
+  return layer_count_;
+}
+
+template <typename RatT>
+size_t Arrangement<RatT>::twin(size_t half_edge) const
+{
+  return half_edge ^ 1;
+}
+
+template <typename RatT>
+size_t Arrangement<RatT>::destination(size_t half_edge) const
+{
+  return half_edges_[twin(half_edge)].origin_;
+}
+
+/// Get the indices of the input segments lying along an edge.
+///
+template <typename RatT>
+std::vector<size_t> Arrangement<RatT>::edge_segments(size_t edge) const
+{
+  auto first = edge_segments_.begin();
+  return std::vector<size_t>(first + edge_segment_offsets_[edge],
+      first + edge_segment_offsets_[edge + 1]);
+}
+
+/// Get the vertices of the boundary a half-edge is on, in order along it.
+///
+template <typename RatT>
+std::vector<size_t> Arrangement<RatT>::boundary_vertices(
+    size_t half_edge) const
+{
+  std::vector<size_t> ret;
+  auto current = half_edge;
+  do {
+    ret.push_back(half_edges_[current].origin_);
+    current = half_edges_[current].next_;
+  } while (current != half_edge);
+  return ret;
+}
+
+/// Get a half-edge on a face's outer boundary, or kNone for the unbounded
+/// face.
+///
+template <typename RatT>
+size_t Arrangement<RatT>::outer_half_edge(size_t face) const
+{
+  return face_outer_half_edges_[face];
+}
+
+/// Get a half-edge on each of a face's inner boundaries.
+///
+template <typename RatT>
+std::vector<size_t> Arrangement<RatT>::inner_half_edges(size_t face) const
+{
+  return std::vector<size_t>(face_holes_.begin() + face_hole_offsets_[face],
+      face_holes_.begin() + face_hole_offsets_[face + 1]);
+}
+
+/// Get a face's label in a layer, or kNone if it has none.
+///
+template <typename RatT>
+size_t Arrangement<RatT>::label(size_t face, size_t layer) const
+{
+  return face_labels_[face * layer_count_ + layer];
+}
+
+// Related Functions
+//-------------------
+
+/// Overlay polygons, one layer each.
+///
+/// Each polygon is first put in the form given by the boolean operations, so
+/// its inside is on the left of every ring.
+///
+/// \return  The arrangement of the polygons' edges, in which a face's label in
+///          a layer is 0 if it lies inside that layer's polygon, and kNone if
+///          not.
+///
+template <typename RatT>
+Arrangement<RatT> overlay(const std::vector<Polygon2D<RatT>>& layers)
+{
+  typedef typename Arrangement<RatT>::Segment SegmentT;
+
+  std::vector<SegmentT> segments;
+  for (size_t layer = 0; layer < layers.size(); ++layer) {
+    auto normalized = layers[layer] | Polygon2D<RatT>{};
+    for (const auto& ring : normalized.rings()) {
+      for (size_t i = 0; i < ring.size(); ++i) {
+        segments.push_back(SegmentT{ring[i], ring[(i + 1) % ring.size()],
+            layer, 0, Arrangement<RatT>::kNone});
+      }
+    }
+  }
+  return Arrangement<RatT>{segments};
+}
+
+//-------------------
+// Related Functions
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_ARRANGEMENT_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
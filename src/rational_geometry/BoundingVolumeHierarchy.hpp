@@ -0,0 +1,537 @@
+/// \file     BoundingVolumeHierarchy.hpp
+/// \author   Tim Holt
+///
+/// A bounding volume hierarchy of exact axis-aligned boxes.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_BOUNDINGVOLUMEHIERARCHY_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_BOUNDINGVOLUMEHIERARCHY_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "AABB.hpp"
+#include "Point.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <future>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Helper Functions
+//------------------
+
+/// Estimate half a box's surface area (its perimeter in 2D, its length in 1D),
+/// in proportion to the chance a random ray or box meets it.
+///
+template <typename RatT, size_t kDimension>
+long double approximate_half_area(const AABB<RatT, kDimension>& box)
+{
+  if (box.empty()) return 0;
+
+  long double extents[kDimension];
+  for (size_t i = 0; i < kDimension; ++i) {
+    extents[i] = approximate(box.upper()[i] - box.lower()[i]);
+  }
+  if (kDimension == 1) return extents[0];
+
+  long double ret = 0;
+  for (size_t i = 0; i < kDimension; ++i) {
+    for (size_t j = i + 1; j < kDimension; ++j) {
+      ret += kDimension == 2 ? extents[i] + extents[j]
+                             : extents[i] * extents[j];
+    }
+  }
+  return ret;
+}
+
+// Class Template Declaration
+//----------------------------
+
+/// \brief  A tree of boxes, each bounding the items below it, for finding
+///         quickly which items' boxes a box or ray meets.
+///
+/// The tree is built top down by the surface area heuristic (SAH): each node's
+/// items are sorted into bins along its widest axis by their centers, and
+/// split at the bin boundary that minimises the expected cost of a query. The
+/// costs are only estimated, in long double; the boxes themselves, and every
+/// query, are exact.
+///
+/// Nodes are kept in one array in depth-first order, so a node's first child
+/// follows it directly, and items in another, each leaf holding a contiguous
+/// run. Queries walk the tree with an explicit stack.
+///
+/// Given more than one thread, the constructor builds the two halves of each
+/// large split on threads of their own, each reordering only its own run of
+/// items, and then joins their nodes. The tree is the same as a single thread
+/// builds.
+///
+template <typename RatT, size_t kDimension>
+class BoundingVolumeHierarchy
+{
+ public:
+  // TYPES
+  typedef AABB<RatT, kDimension> BoxT;
+  typedef Point<RatT, kDimension> PointT;
+
+  // CONSTANTS
+  static constexpr size_t kNone     = static_cast<size_t>(-1);
+  static constexpr size_t kLeafSize = 4;
+  static constexpr size_t kBinCount = 16;
+
+  /// The fewest items in a run for its halves to be built on separate
+  /// threads.
+  static constexpr size_t kParallelMinimum = 4096;
+
+ protected:
+  // TYPES
+  struct Node
+  {
+    BoxT box_;
+
+    /// The run of items_ in a leaf; count_ is zero for an inner node.
+    size_t first_;
+    size_t count_;
+
+    /// An inner node's second child; its first is the next node.
+    size_t second_child_;
+  };
+
+  // INTERNAL STATE
+  std::vector<BoxT> boxes_;
+  std::vector<size_t> items_;
+  std::vector<Node> nodes_;
+
+  // HELPER FUNCTIONS
+  std::vector<Node> build(size_t first, size_t count, size_t thread_count);
+  size_t split(size_t first, size_t count);
+
+ public:
+  // CONSTRUCTORS
+  BoundingVolumeHierarchy();
+  explicit BoundingVolumeHierarchy(
+      std::vector<BoxT> boxes, size_t thread_count = 1);
+
+  // ACCESSORS
+  const std::vector<BoxT>& boxes() const;
+  size_t node_count() const;
+  size_t depth() const;
+
+  std::vector<size_t> overlapping(const BoxT& box) const;
+  std::vector<std::vector<size_t>> overlapping(
+      const std::vector<BoxT>& boxes) const;
+  std::vector<std::pair<size_t, size_t>> overlapping(
+      const BoundingVolumeHierarchy& other) const;
+
+  std::vector<size_t> hit_by(
+      const PointT& origin, const PointT& direction) const;
+  std::vector<std::vector<size_t>> hit_by(
+      const std::vector<std::array<PointT, 2>>& rays) const;
+};
+
+// Class Template Definitions
+//----------------------------
+//   Constructors
+//  --------------
+
+/// Creates a hierarchy of no items.
+///
+template <typename RatT, size_t kDimension>
+BoundingVolumeHierarchy<RatT, kDimension>::BoundingVolumeHierarchy()
+{
+}
+
+/// Creates a hierarchy over items with the given boxes, indexed as given.
+///
+/// \param  thread_count  How many threads may build subtrees at once.
+///
+template <typename RatT, size_t kDimension>
+BoundingVolumeHierarchy<RatT, kDimension>::BoundingVolumeHierarchy(
+    std::vector<BoxT> boxes, size_t thread_count)
+    : boxes_(std::move(boxes)), items_(boxes_.size())
+{
+  for (size_t i = 0; i < items_.size(); ++i) {
+    items_[i] = i;
+  }
+  if (items_.empty()) return;
+
+  nodes_ = build(0, items_.size(), thread_count);
+}
+
+//   Helper Functions
+//  ------------------
+
+/// Build the subtree over a run of items, reordering only that run.
+///
+/// \return  The subtree's nodes, in depth-first order, their children
+///          indexed from its root.
+///
+template <typename RatT, size_t kDimension>
+auto BoundingVolumeHierarchy<RatT, kDimension>::build(
+    size_t first, size_t count, size_t thread_count) -> std::vector<Node>
+{
+  std::vector<Node> ret;
+
+  // Each pending run of items, and the node whose second child it becomes
+  // (kNone for a first child, which is simply the next node made).
+  struct Pending
+  {
+    size_t first_;
+    size_t count_;
+    size_t parent_;
+  };
+  std::vector<Pending> pending{{first, count, kNone}};
+
+  while (!pending.empty()) {
+    auto run = pending.back();
+    pending.pop_back();
+
+    auto index = ret.size();
+    if (run.parent_ != kNone) ret[run.parent_].second_child_ = index;
+
+    BoxT bounds;
+    for (size_t i = run.first_; i < run.first_ + run.count_; ++i) {
+      bounds.extend(boxes_[items_[i]]);
+    }
+    ret.push_back(Node{bounds, run.first_, run.count_, kNone});
+    if (run.count_ <= kLeafSize) continue;
+
+    auto first_count  = split(run.first_, run.count_);
+    ret[index].count_ = 0;
+
+    if (thread_count > 1 && run.count_ >= kParallelMinimum) {
+      // The halves' runs are disjoint, so each may be reordered apart.
+      auto share  = thread_count / 2;
+      auto second = std::async(std::launch::async, [&, share] {
+        return build(run.first_ + first_count, run.count_ - first_count,
+            thread_count - share);
+      });
+      auto first_part  = build(run.first_, first_count, share);
+      auto second_part = second.get();
+
+      for (auto part : {&first_part, &second_part}) {
+        auto offset = ret.size();
+        if (part == &second_part) ret[index].second_child_ = offset;
+        for (auto node : *part) {
+          if (node.count_ == 0) node.second_child_ += offset;
+          ret.push_back(std::move(node));
+        }
+      }
+      continue;
+    }
+
+    pending.push_back({run.first_ + first_count, run.count_ - first_count,
+        index});
+    pending.push_back({run.first_, first_count, kNone});
+  }
+
+  return ret;
+}
+
+/// Reorder a run of items into two, by the binned surface area heuristic.
+///
+/// \return  How many items go in the first part; never none nor all.
+///
+template <typename RatT, size_t kDimension>
+size_t BoundingVolumeHierarchy<RatT, kDimension>::split(
+    size_t first, size_t count)
+{
+  auto begin = items_.begin() + first;
+  auto end   = begin + count;
+
+  BoxT centers;
+  for (auto it = begin; it != end; ++it) {
+    if (!boxes_[*it].empty()) centers.extend(boxes_[*it].doubled_center());
+  }
+
+  size_t axis = 0;
+  if (!centers.empty()) {
+    for (size_t i = 1; i < kDimension; ++i) {
+      if (centers.upper()[axis] - centers.lower()[axis]
+          < centers.upper()[i] - centers.lower()[i]) {
+        axis = i;
+      }
+    }
+  }
+
+  // Items all centered together (or empty) are split in half.
+  auto halve = [&]() {
+    std::nth_element(begin, begin + count / 2, end,
+        [this, axis](size_t l_op, size_t r_op) {
+          if (boxes_[l_op].empty() || boxes_[r_op].empty()) {
+            return boxes_[l_op].empty() && !boxes_[r_op].empty();
+          }
+          return boxes_[l_op].doubled_center()[axis]
+                 < boxes_[r_op].doubled_center()[axis];
+        });
+    return count / 2;
+  };
+  if (centers.empty() || centers.lower()[axis] == centers.upper()[axis]) {
+    return halve();
+  }
+
+  auto low   = approximate(centers.lower()[axis]);
+  auto width = approximate(centers.upper()[axis]) - low;
+
+  auto bin_of = [&](size_t item) -> size_t {
+    if (boxes_[item].empty()) return 0;
+    auto offset = approximate(boxes_[item].doubled_center()[axis]) - low;
+    auto bin    = static_cast<long long>(kBinCount * offset / width);
+    return std::min<size_t>(kBinCount - 1, std::max<long long>(0, bin));
+  };
+
+  std::array<BoxT, kBinCount> bin_boxes{};
+  std::array<size_t, kBinCount> bin_counts{};
+  for (auto it = begin; it != end; ++it) {
+    auto bin = bin_of(*it);
+    bin_boxes[bin].extend(boxes_[*it]);
+    ++bin_counts[bin];
+  }
+
+  // The cost of splitting after each bin, from the boxes and counts below and
+  // above it.
+  std::array<long double, kBinCount> below_costs{};
+  BoxT below;
+  size_t below_count = 0;
+  for (size_t bin = 0; bin + 1 < kBinCount; ++bin) {
+    below.extend(bin_boxes[bin]);
+    below_count += bin_counts[bin];
+    below_costs[bin] = approximate_half_area(below) * below_count;
+  }
+
+  size_t best_bin = kNone;
+  auto best_cost  = std::numeric_limits<long double>::infinity();
+  BoxT above;
+  size_t above_count = 0;
+  for (size_t bin = kBinCount - 1; bin > 0; --bin) {
+    above.extend(bin_boxes[bin]);
+    above_count += bin_counts[bin];
+    if (above_count == 0 || above_count == count) continue;
+
+    auto cost =
+        below_costs[bin - 1] + approximate_half_area(above) * above_count;
+    if (cost < best_cost) {
+      best_cost = cost;
+      best_bin  = bin - 1;
+    }
+  }
+  if (best_bin == kNone) return halve();
+
+  auto middle = std::partition(
+      begin, end, [&](size_t item) { return bin_of(item) <= best_bin; });
+  return static_cast<size_t>(middle - begin);
+}
+
+//   Accessors
+//  -----------
+
+/// Get the items' boxes, indexed as given.
+///
+template <typename RatT, size_t kDimension>
+auto BoundingVolumeHierarchy<RatT, kDimension>::boxes() const
+    -> const std::vector<BoxT>&
+{
+  return boxes_;
+}
+
+template <typename RatT, size_t kDimension>
+size_t BoundingVolumeHierarchy<RatT, kDimension>::node_count() const
+{
+  return nodes_.size();
+}
+
+/// Get the number of nodes on the longest path from the root to a leaf.
+///
+template <typename RatT, size_t kDimension>
+size_t BoundingVolumeHierarchy<RatT, kDimension>::depth() const
+{
+  size_t ret = 0;
+  std::vector<std::pair<size_t, size_t>> pending;
+  if (!nodes_.empty()) pending.emplace_back(0, 1);
+
+  while (!pending.empty()) {
+    auto index = pending.back().first;
+    auto level = pending.back().second;
+    pending.pop_back();
+
+    ret = std::max(ret, level);
+    if (nodes_[index].count_ == 0) {
+      pending.emplace_back(index + 1, level + 1);
+      pending.emplace_back(nodes_[index].second_child_, level + 1);
+    }
+  }
+  return ret;
+}
+
+/// Find the items whose boxes overlap a box.
+///
+/// \return  The items' indices, in increasing order.
+///
+template <typename RatT, size_t kDimension>
+std::vector<size_t> BoundingVolumeHierarchy<RatT, kDimension>::overlapping(
+    const BoxT& box) const
+{
+  std::vector<size_t> ret;
+  std::vector<size_t> pending;
+  if (!nodes_.empty()) pending.push_back(0);
+
+  while (!pending.empty()) {
+    const auto& node = nodes_[pending.back()];
+    auto index       = pending.back();
+    pending.pop_back();
+    if (!node.box_.overlaps(box)) continue;
+
+    if (node.count_ == 0) {
+      pending.push_back(node.second_child_);
+      pending.push_back(index + 1);
+      continue;
+    }
+    for (size_t i = node.first_; i < node.first_ + node.count_; ++i) {
+      if (boxes_[items_[i]].overlaps(box)) ret.push_back(items_[i]);
+    }
+  }
+
+  std::sort(ret.begin(), ret.end());
+  return ret;
+}
+
+/// Find the items whose boxes overlap each of many boxes.
+///
+template <typename RatT, size_t kDimension>
+std::vector<std::vector<size_t>>
+BoundingVolumeHierarchy<RatT, kDimension>::overlapping(
+    const std::vector<BoxT>& boxes) const
+{
+  std::vector<std::vector<size_t>> ret;
+  ret.reserve(boxes.size());
+  for (const auto& box : boxes) {
+    ret.push_back(overlapping(box));
+  }
+  return ret;
+}
+
+/// Find every pair of items, one from each hierarchy, whose boxes overlap.
+///
+/// Both trees are descended together, so only pairs of overlapping nodes are
+/// ever visited.
+///
+/// \return  Pairs of this hierarchy's item and the other's, in increasing
+///          order.
+///
+template <typename RatT, size_t kDimension>
+std::vector<std::pair<size_t, size_t>>
+BoundingVolumeHierarchy<RatT, kDimension>::overlapping(
+    const BoundingVolumeHierarchy& other) const
+{
+  std::vector<std::pair<size_t, size_t>> ret;
+  std::vector<std::pair<size_t, size_t>> pending;
+  if (!nodes_.empty() && !other.nodes_.empty()) pending.emplace_back(0, 0);
+
+  while (!pending.empty()) {
+    auto l_index = pending.back().first;
+    auto r_index = pending.back().second;
+    pending.pop_back();
+
+    const auto& l_node = nodes_[l_index];
+    const auto& r_node = other.nodes_[r_index];
+    if (!l_node.box_.overlaps(r_node.box_)) continue;
+
+    bool is_l_leaf = l_node.count_ != 0;
+    bool is_r_leaf = r_node.count_ != 0;
+    if (is_l_leaf && is_r_leaf) {
+      for (size_t i = l_node.first_; i < l_node.first_ + l_node.count_; ++i) {
+        const auto& l_box = boxes_[items_[i]];
+        for (size_t j = r_node.first_; j < r_node.first_ + r_node.count_;
+             ++j) {
+          if (l_box.overlaps(other.boxes_[other.items_[j]])) {
+            ret.emplace_back(items_[i], other.items_[j]);
+          }
+        }
+      }
+      continue;
+    }
+
+    // Descend the larger node, or the only inner one.
+    if (is_r_leaf
+        || (!is_l_leaf
+               && approximate_half_area(r_node.box_)
+                      <= approximate_half_area(l_node.box_))) {
+      pending.emplace_back(l_node.second_child_, r_index);
+      pending.emplace_back(l_index + 1, r_index);
+    }
+    else {
+      pending.emplace_back(l_index, r_node.second_child_);
+      pending.emplace_back(l_index, r_index + 1);
+    }
+  }
+
+  std::sort(ret.begin(), ret.end());
+  return ret;
+}
+
+/// Find the items whose boxes a ray, from an origin along a direction, meets.
+///
+/// \return  The items' indices, in increasing order.
+///
+template <typename RatT, size_t kDimension>
+std::vector<size_t> BoundingVolumeHierarchy<RatT, kDimension>::hit_by(
+    const PointT& origin, const PointT& direction) const
+{
+  std::vector<size_t> ret;
+  std::vector<size_t> pending;
+  if (!nodes_.empty()) pending.push_back(0);
+
+  while (!pending.empty()) {
+    const auto& node = nodes_[pending.back()];
+    auto index       = pending.back();
+    pending.pop_back();
+    if (!node.box_.is_hit_by(origin, direction)) continue;
+
+    if (node.count_ == 0) {
+      pending.push_back(node.second_child_);
+      pending.push_back(index + 1);
+      continue;
+    }
+    for (size_t i = node.first_; i < node.first_ + node.count_; ++i) {
+      if (boxes_[items_[i]].is_hit_by(origin, direction)) {
+        ret.push_back(items_[i]);
+      }
+    }
+  }
+
+  std::sort(ret.begin(), ret.end());
+  return ret;
+}
+
+/// Find the items whose boxes each of many rays meets, each ray given as its
+/// origin and direction.
+///
+template <typename RatT, size_t kDimension>
+std::vector<std::vector<size_t>>
+BoundingVolumeHierarchy<RatT, kDimension>::hit_by(
+    const std::vector<std::array<PointT, 2>>& rays) const
+{
+  std::vector<std::vector<size_t>> ret;
+  ret.reserve(rays.size());
+  for (const auto& ray : rays) {
+    ret.push_back(hit_by(ray[0], ray[1]));
+  }
+  return ret;
+}
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_BOUNDINGVOLUMEHIERARCHY_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,919 @@
+/// \file     BspTree.hpp
+/// \author   Tim Holt
+///
+/// An exact binary space partitioning tree of planar regions, and boolean
+/// operations between the solids such trees bound.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_BSPTREE_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_BSPTREE_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "Direction.hpp"
+#include "FixedRational.hpp"
+#include "clipping.hpp"
+#include "Plane.hpp"
+#include "Point.hpp"
+#include "Polygon2D.hpp"
+#include "predicates.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Helper Types
+//--------------
+
+/// \brief  The plane of a region of RatT points: a Direction normal, with an
+///         offset of the points' own type.
+///
+template <typename RatT>
+using RegionPlane = Plane<typename NumeratorType<RatT>::type, RatT>;
+
+/// \brief  A planar piece of a solid's surface, as kept in a BspTree.
+///
+/// The region is stored projected onto the coordinate plane most nearly
+/// parallel to it (dropping the axis of the normal's largest component), where
+/// the 2D boolean operations can split and merge it exactly.
+///
+template <typename RatT>
+struct PlanarRegion
+{
+  /// Outward plane of the region.
+  RegionPlane<RatT> plane_;
+
+  size_t axis_;
+  Polygon2D<RatT> region_;
+
+  /// Bounding box, in 3D.
+  Point<RatT, 3> lower_;
+  Point<RatT, 3> upper_;
+};
+
+/// Which side of a plane a region lies on.
+///
+enum class RegionSide
+{
+  kCoplanarFront,
+  kCoplanarBack,
+  kFront,
+  kBack,
+  kSpanning
+};
+
+/// \brief  The line where a plane crosses a region's plane, as a*u + b*v + c
+///         in the region's projected coordinates.
+///
+/// It is positive where the plane's front lies. It is taken over the points'
+/// numerators, as integers wide enough that no product overflows, so its
+/// values are the true ones scaled by RatT's common denominator.
+///
+template <typename RatT>
+struct RegionLine
+{
+  typedef typename NumeratorType<RatT>::type IntT;
+  typedef typename WidenedInt<IntT>::type CoefficientT;
+  typedef typename ProductInt<IntT, CoefficientT>::type ValueT;
+
+  CoefficientT a_;
+  CoefficientT b_;
+  ValueT c_;
+
+  /// Whether the coefficients are small enough for side() to work in long
+  /// long, at points of small numerators.
+  bool is_small_;
+
+  ValueT operator()(const Point<RatT, 2>& point) const;
+  int side(const Point<RatT, 2>& point) const;
+  RegionLine operator-() const;
+};
+
+/// \brief  How a BspTree picks the plane splitting each of its nodes.
+///
+/// The planes of up to candidate_count_ of the node's regions, evenly spaced
+/// through them, are tried. The one chosen has the least
+/// split_weight_ * (regions split) + balance_weight_ * |front - back|, where
+/// front and back count the regions on either side. Weighting splits favours
+/// fewer, larger regions; weighting balance favours a shallower tree.
+///
+/// A candidate_count_ of 1 always takes the first region's plane, which is
+/// fastest to build.
+///
+struct BspSplitHeuristic
+{
+  size_t candidate_count_ = 1;
+  size_t split_weight_    = 8;
+  size_t balance_weight_  = 1;
+};
+
+// Helper Functions
+//------------------
+
+template <typename RatT>
+auto RegionLine<RatT>::operator()(const Point<RatT, 2>& point) const -> ValueT
+{
+  return ValueT(numerator_of(point[0])) * ValueT(a_)
+         + ValueT(numerator_of(point[1])) * ValueT(b_) + c_;
+}
+
+/// Get the sign of the line's value at a point.
+///
+template <typename RatT>
+int RegionLine<RatT>::side(const Point<RatT, 2>& point) const
+{
+  // The sum is below 2^62, so it fits.
+  if (is_small_ && is_within_bits(numerator_of(point[0]), 30)
+      && is_within_bits(numerator_of(point[1]), 30)) {
+    auto value = static_cast<long long>(numerator_of(point[0]))
+                     * static_cast<long long>(a_)
+                 + static_cast<long long>(numerator_of(point[1]))
+                       * static_cast<long long>(b_)
+                 + static_cast<long long>(c_);
+    return (value > 0) - (value < 0);
+  }
+  return sign((*this)(point));
+}
+
+template <typename RatT>
+RegionLine<RatT> RegionLine<RatT>::operator-() const
+{
+  return {-a_, -b_, -c_, is_small_};
+}
+
+/// Find the axis of a plane's normal's largest component.
+///
+template <typename RatT>
+size_t dominant_axis(const RegionPlane<RatT>& plane)
+{
+  const auto& n  = plane.normal().get();
+  auto magnitude = [&n](size_t i) { return n[i] < 0 ? -n[i] : n[i]; };
+
+  size_t ret = 0;
+  for (size_t i = 1; i < 3; ++i) {
+    if (magnitude(ret) < magnitude(i)) ret = i;
+  }
+  return ret;
+}
+
+/// Project a point onto the coordinate plane that drops an axis.
+///
+/// The remaining axes are taken in cyclic order, so the projection keeps the
+/// winding of anything seen from the positive side of the dropped axis.
+///
+template <typename RatT>
+Point<RatT, 2> project(const Point<RatT, 3>& point, size_t axis)
+{
+  return {point[(axis + 1) % 3], point[(axis + 2) % 3]};
+}
+
+/// Find the point of a region's plane that projects to a given point.
+///
+/// The missing coordinate is found over numerators and divided once, so only
+/// it need be representable.
+///
+template <typename RatT>
+Point<RatT, 3> lift(
+    const PlanarRegion<RatT>& region, const Point<RatT, 2>& point)
+{
+  typedef typename WidenedInt<typename NumeratorType<RatT>::type>::type WideT;
+
+  const auto& n = region.plane_.normal().get();
+  auto axis     = region.axis_;
+  auto first    = (axis + 1) % 3;
+  auto second   = (axis + 2) % 3;
+
+  Point<RatT, 3> ret;
+  ret[first]  = point[0];
+  ret[second] = point[1];
+
+  // Terms below 2^60 are summed in long long.
+  auto offset = numerator_of(region.plane_.offset());
+  auto u      = numerator_of(point[0]);
+  auto v      = numerator_of(point[1]);
+  if (is_within_bits(offset, 60) && is_within_bits(u, 30)
+      && is_within_bits(v, 30) && is_within_bits(n[first], 30)
+      && is_within_bits(n[second], 30)) {
+    ret[axis] = from_numerator_ratio<RatT>(
+        static_cast<long long>(offset) - static_cast<long long>(u) * n[first]
+            - static_cast<long long>(v) * n[second],
+        static_cast<long long>(n[axis]));
+    return ret;
+  }
+
+  ret[axis] = from_numerator_ratio<RatT>(
+      WideT(offset) - WideT(u) * WideT(n[first]) - WideT(v) * WideT(n[second]),
+      WideT(n[axis]));
+  return ret;
+}
+
+/// Create a region from its plane and its projection, finding its bounds.
+///
+template <typename RatT>
+PlanarRegion<RatT> make_region(
+    const RegionPlane<RatT>& plane, Polygon2D<RatT> projected)
+{
+  PlanarRegion<RatT> ret{plane, dominant_axis(plane), std::move(projected),
+      Point<RatT, 3>{}, {}};
+
+  bool is_first = true;
+  for (const auto& ring : ret.region_.rings()) {
+    for (const auto& point : ring) {
+      auto lifted = lift(ret, point);
+      for (size_t i = 0; i < 3; ++i) {
+        if (is_first || lifted[i] < ret.lower_[i]) ret.lower_[i] = lifted[i];
+        if (is_first || ret.upper_[i] < lifted[i]) ret.upper_[i] = lifted[i];
+      }
+      is_first = false;
+    }
+  }
+  return ret;
+}
+
+/// Turn a region to face the other way.
+///
+template <typename RatT>
+void flip(PlanarRegion<RatT>& region)
+{
+  region.plane_ = region.plane_.flipped();
+}
+
+/// Find where a plane crosses a region's plane.
+///
+/// Within the region's plane, dot(normal, x) - offset is a linear function of
+/// the projected coordinates, scaled by the region normal's dominant
+/// component; this is that function, with the scale's sign removed.
+///
+template <typename RatT>
+RegionLine<RatT> region_line(
+    const PlanarRegion<RatT>& region, const RegionPlane<RatT>& plane)
+{
+  typedef typename RegionLine<RatT>::CoefficientT CoefficientT;
+  typedef typename RegionLine<RatT>::ValueT ValueT;
+
+  const auto& n = region.plane_.normal().get();
+  const auto& m = plane.normal().get();
+  auto axis     = region.axis_;
+  auto first    = (axis + 1) % 3;
+  auto second   = (axis + 2) % 3;
+
+  auto region_offset = numerator_of(region.plane_.offset());
+  auto plane_offset  = numerator_of(plane.offset());
+  int scale_sign     = n[axis] < 0 ? -1 : 1;
+
+  // Normals and offsets below 2^30 give coefficients and a constant that fit
+  // in long long.
+  bool is_small = is_within_bits(region_offset, 30)
+                  && is_within_bits(plane_offset, 30);
+  for (size_t i = 0; i < 3; ++i) {
+    is_small = is_small && is_within_bits(n[i], 30)
+               && is_within_bits(m[i], 30);
+  }
+  if (is_small) {
+    auto coefficient = [&n, &m, axis, scale_sign](size_t i) {
+      return scale_sign
+             * (static_cast<long long>(n[axis]) * m[i]
+                 - static_cast<long long>(m[axis]) * n[i]);
+    };
+    auto a = coefficient(first);
+    auto b = coefficient(second);
+    auto c = scale_sign
+             * (static_cast<long long>(region_offset) * m[axis]
+                 - static_cast<long long>(plane_offset) * n[axis]);
+    return {CoefficientT(a), CoefficientT(b), ValueT(c),
+        is_within_bits(a, 29) && is_within_bits(b, 29)
+            && is_within_bits(c, 61)};
+  }
+
+  auto coefficient = [&n, &m, axis](size_t i) {
+    return CoefficientT(n[axis]) * CoefficientT(m[i])
+           - CoefficientT(m[axis]) * CoefficientT(n[i]);
+  };
+  RegionLine<RatT> ret{coefficient(first), coefficient(second),
+      ValueT(region_offset) * ValueT(m[axis])
+          - ValueT(plane_offset) * ValueT(n[axis]),
+      false};
+  ret.is_small_ = is_within_bits(ret.a_, 29) && is_within_bits(ret.b_, 29)
+                  && is_within_bits(ret.c_, 61);
+  return scale_sign < 0 ? -ret : ret;
+}
+
+/// Find which side of a plane a region lies on.
+///
+template <typename RatT>
+RegionSide region_side(
+    const PlanarRegion<RatT>& region, const RegionPlane<RatT>& plane)
+{
+  typedef typename RegionLine<RatT>::CoefficientT CoefficientT;
+
+  auto line = region_line(region, plane);
+
+  if (line.a_ == CoefficientT(0) && line.b_ == CoefficientT(0)) {
+    if (sign(line.c_) > 0) return RegionSide::kFront;
+    if (sign(line.c_) < 0) return RegionSide::kBack;
+    return region.plane_.normal() == plane.normal()
+               ? RegionSide::kCoplanarFront
+               : RegionSide::kCoplanarBack;
+  }
+
+  bool has_front = false;
+  bool has_back  = false;
+  for (const auto& ring : region.region_.rings()) {
+    for (const auto& point : ring) {
+      auto side = line.side(point);
+      has_front = has_front || side > 0;
+      has_back  = has_back || side < 0;
+    }
+  }
+
+  if (!has_back) return RegionSide::kFront;
+  if (!has_front) return RegionSide::kBack;
+  return RegionSide::kSpanning;
+}
+
+/// Get the part of a projected region where a line is non-negative.
+///
+/// Each ring is clipped to the line's side exactly (see clip_polygon()), and
+/// the even-odd rule then gives the clipped region.
+///
+template <typename RatT>
+Polygon2D<RatT> clip_region(
+    const Polygon2D<RatT>& region, const RegionLine<RatT>& line)
+{
+  auto height = [&line](size_t, const Point<RatT, 2>& point) {
+    return line(point);
+  };
+
+  Polygon2D<RatT> ret;
+  typename Polygon2D<RatT>::RingT clipped;
+  typename Polygon2D<RatT>::RingT scratch;
+  for (const auto& ring : region.rings()) {
+    clipped = ring;
+    clip_polygon(clipped, scratch, 1, height);
+    if (!clipped.empty()) ret.add_ring(clipped);
+  }
+  return ret | Polygon2D<RatT>{};
+}
+
+/// \brief  Sort a region by which side of a plane it lies on, splitting it if
+///         it lies on both.
+///
+template <typename RatT>
+void split_region(const PlanarRegion<RatT>& region,
+    const RegionPlane<RatT>& plane,
+    std::vector<PlanarRegion<RatT>>& coplanar_front,
+    std::vector<PlanarRegion<RatT>>& coplanar_back,
+    std::vector<PlanarRegion<RatT>>& front,
+    std::vector<PlanarRegion<RatT>>& back)
+{
+  switch (region_side(region, plane)) {
+    case RegionSide::kCoplanarFront:
+      coplanar_front.push_back(region);
+      break;
+
+    case RegionSide::kCoplanarBack:
+      coplanar_back.push_back(region);
+      break;
+
+    case RegionSide::kFront:
+      front.push_back(region);
+      break;
+
+    case RegionSide::kBack:
+      back.push_back(region);
+      break;
+
+    case RegionSide::kSpanning:
+    default:
+      auto line       = region_line(region, plane);
+      auto front_part = clip_region(region.region_, line);
+      auto back_part  = clip_region(region.region_, -line);
+      if (!front_part.empty()) {
+        front.push_back(make_region(region.plane_, front_part));
+      }
+      if (!back_part.empty()) {
+        back.push_back(make_region(region.plane_, back_part));
+      }
+      break;
+  }
+}
+
+// Class Template Declaration
+//----------------------------
+
+/// \brief  A binary space partitioning tree of the regions bounding a solid.
+///
+/// This follows the well known csg.js scheme: each node splits space by one
+/// of its regions' planes, keeping the regions in that plane, and the solid is
+/// what lies behind them. Planes are canonical (see Plane), and every split is
+/// exact.
+///
+/// Nodes are allocated from one contiguous pool, linked by index, and every
+/// traversal is iterative, so deep trees cannot overflow the stack.
+///
+/// Given more than one thread, build() hands the two halves of each large
+/// split to threads of their own, each building a separate tree that is then
+/// grafted on. The tree is the same as a single thread builds, but for the
+/// order of its nodes.
+///
+/// \sa  https://github.com/evanw/csg.js
+///
+template <typename RatT>
+class BspTree
+{
+ public:
+  // TYPES
+  typedef PlanarRegion<RatT> RegionT;
+  typedef RegionPlane<RatT> PlaneT;
+
+  // CONSTANTS
+  static constexpr size_t kNone = static_cast<size_t>(-1);
+
+  /// The fewest regions on each side of a split for its halves to be built
+  /// on separate threads.
+  static constexpr size_t kParallelMinimum = 256;
+
+ protected:
+  // TYPES
+  struct Node
+  {
+    PlaneT plane_;
+    std::vector<RegionT> regions_;
+    size_t front_;
+    size_t back_;
+  };
+
+  // INTERNAL STATE
+  std::vector<Node> nodes_;
+  BspSplitHeuristic heuristic_;
+
+  /// Bounds of every region ever added, and whether the tree now represents
+  /// the complement of its solid.
+  Point<RatT, 3> lower_;
+  Point<RatT, 3> upper_;
+  bool is_inverted_;
+
+  // HELPER FUNCTIONS
+  size_t add_node(const std::vector<RegionT>& regions);
+  size_t graft(BspTree subtree);
+  bool is_outside_bounds(const RegionT& region) const;
+
+ public:
+  // CONSTRUCTORS
+  BspTree();
+  explicit BspTree(std::vector<RegionT> regions,
+      BspSplitHeuristic heuristic = {},
+      size_t thread_count         = 1);
+
+  // ACCESSORS
+  std::vector<RegionT> all_regions() const;
+  size_t node_count() const;
+  size_t depth() const;
+  bool is_inverted() const;
+
+  PlaneT choose_plane(const std::vector<RegionT>& regions) const;
+
+  // MUTATORS
+  void build(std::vector<RegionT> regions, size_t thread_count = 1);
+  void invert();
+  void clip_to(const BspTree& other);
+
+  template <typename PredicateT>
+  std::vector<RegionT> take_regions(const PredicateT& predicate);
+
+  // OTHER METHODS
+  std::vector<RegionT> clip_regions(std::vector<RegionT> regions) const;
+};
+
+// Class Template Definitions
+//----------------------------
+//   Constructors
+//  --------------
+
+/// Creates a tree of no regions, which bounds nothing.
+///
+template <typename RatT>
+BspTree<RatT>::BspTree() : is_inverted_{false}
+{
+}
+
+template <typename RatT>
+BspTree<RatT>::BspTree(std::vector<RegionT> regions,
+    BspSplitHeuristic heuristic,
+    size_t thread_count)
+    : heuristic_{heuristic}, is_inverted_{false}
+{
+  build(std::move(regions), thread_count);
+}
+
+//   Helper Functions
+//  ------------------
+
+/// Add a node for some regions, splitting by the plane the heuristic picks.
+///
+template <typename RatT>
+size_t BspTree<RatT>::add_node(const std::vector<RegionT>& regions)
+{
+  nodes_.push_back(Node{choose_plane(regions), {}, kNone, kNone});
+  return nodes_.size() - 1;
+}
+
+/// Append another tree's nodes to this one's.
+///
+/// \return  The index of the other tree's root, which nothing yet links to.
+///
+template <typename RatT>
+size_t BspTree<RatT>::graft(BspTree subtree)
+{
+  auto offset = nodes_.size();
+  for (auto& node : subtree.nodes_) {
+    if (node.front_ != kNone) node.front_ += offset;
+    if (node.back_ != kNone) node.back_ += offset;
+    nodes_.push_back(std::move(node));
+  }
+  return offset;
+}
+
+/// Determine if a region lies entirely outside the solid's bounding box.
+///
+template <typename RatT>
+bool BspTree<RatT>::is_outside_bounds(const RegionT& region) const
+{
+  if (nodes_.empty()) return true;
+  for (size_t i = 0; i < 3; ++i) {
+    if (region.upper_[i] < lower_[i] || upper_[i] < region.lower_[i]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+//   Accessors
+//  -----------
+
+template <typename RatT>
+auto BspTree<RatT>::all_regions() const -> std::vector<RegionT>
+{
+  std::vector<RegionT> ret;
+  for (const auto& node : nodes_) {
+    ret.insert(std::end(ret), std::cbegin(node.regions_),
+        std::cend(node.regions_));
+  }
+  return ret;
+}
+
+template <typename RatT>
+size_t BspTree<RatT>::node_count() const
+{
+  return nodes_.size();
+}
+
+/// Get the number of nodes on the longest path from the root to a leaf.
+///
+template <typename RatT>
+size_t BspTree<RatT>::depth() const
+{
+  if (nodes_.empty()) return 0;
+
+  size_t ret = 0;
+  std::vector<std::pair<size_t, size_t>> pending{{0, 1}};
+  while (!pending.empty()) {
+    auto index = pending.back().first;
+    auto level = pending.back().second;
+    pending.pop_back();
+
+    ret = std::max(ret, level);
+    for (auto child : {nodes_[index].front_, nodes_[index].back_}) {
+      if (child != kNone) pending.emplace_back(child, level + 1);
+    }
+  }
+  return ret;
+}
+
+template <typename RatT>
+bool BspTree<RatT>::is_inverted() const
+{
+  return is_inverted_;
+}
+
+/// Pick the plane to split some regions by, as set by the BspSplitHeuristic.
+///
+template <typename RatT>
+auto BspTree<RatT>::choose_plane(const std::vector<RegionT>& regions) const
+    -> PlaneT
+{
+  auto count = std::min(heuristic_.candidate_count_, regions.size());
+  if (count <= 1) return regions.front().plane_;
+
+  PlaneT ret;
+  size_t best_score = 0;
+  for (size_t candidate = 0; candidate < count; ++candidate) {
+    const auto& plane = regions[candidate * regions.size() / count].plane_;
+
+    size_t front  = 0;
+    size_t back   = 0;
+    size_t splits = 0;
+    for (const auto& region : regions) {
+      switch (region_side(region, plane)) {
+        case RegionSide::kFront:
+          ++front;
+          break;
+        case RegionSide::kBack:
+          ++back;
+          break;
+        case RegionSide::kSpanning:
+          ++front;
+          ++back;
+          ++splits;
+          break;
+        default:
+          break;
+      }
+    }
+
+    auto imbalance = front < back ? back - front : front - back;
+    auto score     = heuristic_.split_weight_ * splits
+                 + heuristic_.balance_weight_ * imbalance;
+    if (candidate == 0 || score < best_score) {
+      ret        = plane;
+      best_score = score;
+    }
+  }
+  return ret;
+}
+
+//   Mutators
+//  ----------
+
+/// Add regions to the tree, extending it with new nodes where needed.
+///
+/// \param  thread_count  How many threads may build new subtrees at once.
+///
+template <typename RatT>
+void BspTree<RatT>::build(std::vector<RegionT> regions, size_t thread_count)
+{
+  if (regions.empty()) return;
+
+  bool is_first = nodes_.empty();
+  for (const auto& region : regions) {
+    for (size_t i = 0; i < 3; ++i) {
+      if (is_first || region.lower_[i] < lower_[i]) {
+        lower_[i] = region.lower_[i];
+      }
+      if (is_first || upper_[i] < region.upper_[i]) {
+        upper_[i] = region.upper_[i];
+      }
+    }
+    is_first = false;
+  }
+  if (nodes_.empty()) add_node(regions);
+
+  std::vector<std::pair<size_t, std::vector<RegionT>>> pending;
+  pending.emplace_back(0, std::move(regions));
+
+  // Splits whose halves both start new subtrees, large enough to build apart.
+  struct Detached
+  {
+    size_t index_;
+    std::vector<RegionT> front_;
+    std::vector<RegionT> back_;
+  };
+  std::vector<Detached> detached;
+
+  while (!pending.empty()) {
+    auto index = pending.back().first;
+    auto list  = std::move(pending.back().second);
+    pending.pop_back();
+
+    std::vector<RegionT> front;
+    std::vector<RegionT> back;
+    for (const auto& region : list) {
+      split_region(region, nodes_[index].plane_, nodes_[index].regions_,
+          nodes_[index].regions_, front, back);
+    }
+
+    if (thread_count > 1 && nodes_[index].front_ == kNone
+        && nodes_[index].back_ == kNone && front.size() >= kParallelMinimum
+        && back.size() >= kParallelMinimum) {
+      detached.push_back({index, std::move(front), std::move(back)});
+      continue;
+    }
+
+    if (!front.empty()) {
+      if (nodes_[index].front_ == kNone) {
+        auto child           = add_node(front);
+        nodes_[index].front_ = child;
+      }
+      pending.emplace_back(nodes_[index].front_, std::move(front));
+    }
+    if (!back.empty()) {
+      if (nodes_[index].back_ == kNone) {
+        auto child          = add_node(back);
+        nodes_[index].back_ = child;
+      }
+      pending.emplace_back(nodes_[index].back_, std::move(back));
+    }
+  }
+
+  if (detached.empty()) return;
+
+  auto share = std::max<size_t>(thread_count / (2 * detached.size()), 1);
+  auto build_apart = [this, share](std::vector<RegionT>& list) {
+    return std::async(std::launch::async,
+        [heuristic = heuristic_, share, list = std::move(list)]() mutable {
+          BspTree ret;
+          ret.heuristic_ = heuristic;
+          ret.build(std::move(list), share);
+          return ret;
+        });
+  };
+
+  std::vector<std::future<BspTree>> subtrees;
+  for (auto& split : detached) {
+    subtrees.push_back(build_apart(split.front_));
+    subtrees.push_back(build_apart(split.back_));
+  }
+  for (size_t i = 0; i < detached.size(); ++i) {
+    auto front                        = graft(subtrees[2 * i].get());
+    auto back                         = graft(subtrees[2 * i + 1].get());
+    nodes_[detached[i].index_].front_ = front;
+    nodes_[detached[i].index_].back_  = back;
+  }
+}
+
+/// Turn the solid inside out, so the tree represents its complement.
+///
+template <typename RatT>
+void BspTree<RatT>::invert()
+{
+  for (auto& node : nodes_) {
+    for (auto& region : node.regions_) {
+      flip(region);
+    }
+    node.plane_ = node.plane_.flipped();
+    std::swap(node.front_, node.back_);
+  }
+  is_inverted_ = !is_inverted_;
+}
+
+/// Remove the parts of this tree's regions that lie inside another solid.
+///
+template <typename RatT>
+void BspTree<RatT>::clip_to(const BspTree& other)
+{
+  for (auto& node : nodes_) {
+    node.regions_ = other.clip_regions(std::move(node.regions_));
+  }
+}
+
+/// Remove the regions a predicate picks, keeping the planes that split space.
+///
+/// The tree still bounds the same solid, so regions may be set aside this way
+/// wherever it is known that clipping would not change them.
+///
+/// \return  The regions removed.
+///
+template <typename RatT>
+template <typename PredicateT>
+auto BspTree<RatT>::take_regions(const PredicateT& predicate)
+    -> std::vector<RegionT>
+{
+  std::vector<RegionT> ret;
+  for (auto& node : nodes_) {
+    auto taken = std::stable_partition(std::begin(node.regions_),
+        std::end(node.regions_),
+        [&predicate](const RegionT& region) { return !predicate(region); });
+    ret.insert(std::end(ret), std::make_move_iterator(taken),
+        std::make_move_iterator(std::end(node.regions_)));
+    node.regions_.erase(taken, std::end(node.regions_));
+  }
+  return ret;
+}
+
+//   Other Methods
+//  ---------------
+
+/// Remove the parts of regions that lie inside this solid.
+///
+template <typename RatT>
+auto BspTree<RatT>::clip_regions(std::vector<RegionT> regions) const
+    -> std::vector<RegionT>
+{
+  std::vector<RegionT> ret;
+
+  // Regions clear of the bounding box are wholly outside the solid, or wholly
+  // inside its complement.
+  std::vector<RegionT> near;
+  for (auto& region : regions) {
+    if (!is_outside_bounds(region)) {
+      near.push_back(std::move(region));
+    }
+    else if (!is_inverted_) {
+      ret.push_back(std::move(region));
+    }
+  }
+  if (near.empty()) return ret;
+
+  std::vector<std::pair<size_t, std::vector<RegionT>>> pending;
+  pending.emplace_back(0, std::move(near));
+
+  while (!pending.empty()) {
+    auto index = pending.back().first;
+    auto list  = std::move(pending.back().second);
+    pending.pop_back();
+
+    const auto& node = nodes_[index];
+    std::vector<RegionT> front;
+    std::vector<RegionT> back;
+    for (const auto& region : list) {
+      split_region(region, node.plane_, front, back, front, back);
+    }
+
+    if (node.front_ != kNone) {
+      pending.emplace_back(node.front_, std::move(front));
+    }
+    else {
+      ret.insert(std::end(ret), std::make_move_iterator(std::begin(front)),
+          std::make_move_iterator(std::end(front)));
+    }
+    if (node.back_ != kNone) {
+      pending.emplace_back(node.back_, std::move(back));
+    }
+  }
+
+  return ret;
+}
+
+// Related Functions
+//-------------------
+
+/// Perform an exact boolean operation between the solids of two trees.
+///
+/// \return  A tree bounding the resulting solid.
+///
+template <typename RatT>
+BspTree<RatT> boolean_operation(
+    BspTree<RatT> a, BspTree<RatT> b, BooleanOperation operation)
+{
+  switch (operation) {
+    case BooleanOperation::kUnion:
+      a.clip_to(b);
+      b.clip_to(a);
+      b.invert();
+      b.clip_to(a);
+      b.invert();
+      a.build(b.all_regions());
+      break;
+
+    case BooleanOperation::kIntersection:
+      a.invert();
+      b.clip_to(a);
+      b.invert();
+      a.clip_to(b);
+      b.clip_to(a);
+      a.build(b.all_regions());
+      a.invert();
+      break;
+
+    case BooleanOperation::kDifference:
+      a.invert();
+      a.clip_to(b);
+      b.clip_to(a);
+      b.invert();
+      b.clip_to(a);
+      b.invert();
+      a.build(b.all_regions());
+      a.invert();
+      break;
+
+    case BooleanOperation::kSymmetricDifference:
+    default:
+      auto b_minus_a = boolean_operation(b, a, BooleanOperation::kDifference);
+      auto a_minus_b = boolean_operation(
+          std::move(a), std::move(b), BooleanOperation::kDifference);
+      return boolean_operation(std::move(a_minus_b), std::move(b_minus_a),
+          BooleanOperation::kUnion);
+  }
+
+  return a;
+}
+
+//-------------------
+// Related Functions
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_BSPTREE_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,670 @@
+/// \file     ConstrainedDelaunay.hpp
+/// \author   Tim Holt
+///
+/// An exact constrained Delaunay triangulation of points in the plane.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_CONSTRAINEDDELAUNAY_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_CONSTRAINEDDELAUNAY_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "Point.hpp"
+#include "predicates.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Class Template Declaration
+//----------------------------
+
+/// \brief  A triangulation of points in the plane, with some edges required,
+///         whose triangles' circumcircles hold no point visible to them.
+///
+/// Triangles are kept in flat arrays: each is three vertex indices, wound
+/// counter-clockwise, along with the three triangles across its edges (edge i
+/// runs from vertex i to vertex i + 1). No triangle is allocated on its own.
+///
+/// Vertex indices are those of the points given, so a repeated point's later
+/// copies are simply left out of the triangulation.
+///
+/// The triangulation is built by a sweep outward from its middle, each point
+/// kept Delaunay as it goes in by flipping edges (Lawson's algorithm), every
+/// test done by the exact orient2d() and incircle(). Each constraint is then
+/// forced in by flipping the edges it crosses (Sloan's algorithm), found by
+/// walking from its start, and the Delaunay property restored around it.
+///
+/// \sa  https://en.wikipedia.org/wiki/Constrained_Delaunay_triangulation
+///
+template <typename RatT>
+class ConstrainedDelaunay
+{
+ public:
+  // TYPES
+  typedef Point<RatT, 2> PointT;
+  typedef std::array<size_t, 3> TriangleT;
+
+  // CONSTANTS
+  static constexpr size_t kNone = static_cast<size_t>(-1);
+
+ protected:
+  // INTERNAL STATE
+  std::vector<PointT> vertices_;
+  std::vector<TriangleT> triangles_;
+  std::vector<TriangleT> neighbors_;
+  std::vector<std::array<bool, 3>> is_constrained_;
+
+  /// The vertex each point was merged with, and a triangle touching each
+  /// vertex (or kNone).
+  std::vector<size_t> canonical_;
+  std::vector<size_t> vertex_triangle_;
+
+  // HELPER FUNCTIONS
+  size_t add_triangle(size_t a, size_t b, size_t c);
+  void link(size_t triangle, size_t edge, size_t other, size_t other_edge);
+  size_t edge_of(size_t triangle, size_t from, size_t to) const;
+  std::pair<size_t, size_t> find_edge(size_t from, size_t to) const;
+
+  void triangulate();
+  void flip(size_t triangle, size_t edge);
+  void make_delaunay(std::vector<std::pair<size_t, size_t>> edges);
+
+ public:
+  // CONSTRUCTORS
+  explicit ConstrainedDelaunay(std::vector<PointT> points,
+      const std::vector<std::pair<size_t, size_t>>& constraints = {});
+
+  // ACCESSORS
+  const std::vector<PointT>& vertices() const;
+  const std::vector<TriangleT>& triangles() const;
+  const std::vector<TriangleT>& neighbors() const;
+  bool is_constrained(size_t triangle, size_t edge) const;
+
+  // MUTATORS
+  void add_constraint(size_t from, size_t to);
+};
+
+// Class Template Definitions
+//----------------------------
+//   Constructors
+//  --------------
+
+/// Triangulates points, with edges required between pairs of them.
+///
+/// \throws  std::invalid_argument if two constraints cross.
+///
+template <typename RatT>
+ConstrainedDelaunay<RatT>::ConstrainedDelaunay(std::vector<PointT> points,
+    const std::vector<std::pair<size_t, size_t>>& constraints)
+    : vertices_(std::move(points)),
+      canonical_(vertices_.size()),
+      vertex_triangle_(vertices_.size(), kNone)
+{
+  triangulate();
+  for (const auto& constraint : constraints) {
+    add_constraint(constraint.first, constraint.second);
+  }
+}
+
+//   Helper Functions
+//  ------------------
+
+template <typename RatT>
+size_t ConstrainedDelaunay<RatT>::add_triangle(size_t a, size_t b, size_t c)
+{
+  triangles_.push_back(TriangleT{a, b, c});
+  neighbors_.push_back(TriangleT{kNone, kNone, kNone});
+  is_constrained_.push_back({false, false, false});
+  for (auto vertex : {a, b, c}) {
+    vertex_triangle_[vertex] = triangles_.size() - 1;
+  }
+  return triangles_.size() - 1;
+}
+
+/// Make two triangles neighbours, across the given edges.
+///
+template <typename RatT>
+void ConstrainedDelaunay<RatT>::link(
+    size_t triangle, size_t edge, size_t other, size_t other_edge)
+{
+  neighbors_[triangle][edge] = other;
+  if (other != kNone) neighbors_[other][other_edge] = triangle;
+}
+
+/// Find which edge of a triangle runs between two vertices, or kNone.
+///
+template <typename RatT>
+size_t ConstrainedDelaunay<RatT>::edge_of(
+    size_t triangle, size_t from, size_t to) const
+{
+  const auto& tri = triangles_[triangle];
+  for (size_t i = 0; i < 3; ++i) {
+    if (tri[i] == from && tri[(i + 1) % 3] == to) return i;
+  }
+  return kNone;
+}
+
+/// Find the triangle, and its edge, running from one vertex to another.
+///
+/// \return  {kNone, kNone} if there is no such edge.
+///
+template <typename RatT>
+std::pair<size_t, size_t> ConstrainedDelaunay<RatT>::find_edge(
+    size_t from, size_t to) const
+{
+  auto start = vertex_triangle_[from];
+  if (start == kNone) return {kNone, kNone};
+
+  // Turn around the vertex one way, and then, if a boundary stops us, the
+  // other way.
+  for (size_t direction : {2, 0}) {
+    auto triangle = start;
+    do {
+      const auto& tri = triangles_[triangle];
+      size_t corner   = 0;
+      while (tri[corner] != from) ++corner;
+
+      if (tri[(corner + 1) % 3] == to) return {triangle, corner};
+      triangle = neighbors_[triangle][(corner + direction) % 3];
+    } while (triangle != kNone && triangle != start);
+
+    if (triangle == start) break;
+  }
+  return {kNone, kNone};
+}
+
+/// Build a Delaunay triangulation of the distinct points.
+///
+/// The points are swept outward from the one nearest the middle, in order of
+/// their distance from it, so each lies strictly outside the hull of those
+/// before it. Each is joined to the hull edges it can see, found through a
+/// hash of the hull's vertices by their angle about the first triangle, and
+/// the edges it faces are then flipped until the triangulation is Delaunay
+/// again. Points go in near their predecessors, so the flips stay local, and
+/// so within the predicates' long long filters.
+///
+template <typename RatT>
+void ConstrainedDelaunay<RatT>::triangulate()
+{
+  using namespace std;
+
+  if (vertices_.empty()) return;
+
+  // The point nearest the middle of the bounding box, by estimate.
+  long double low[2]  = {approximate(vertices_[0][0]),
+      approximate(vertices_[0][1])};
+  long double high[2] = {low[0], low[1]};
+  for (const auto& vertex : vertices_) {
+    for (size_t i = 0; i < 2; ++i) {
+      low[i]  = min(low[i], approximate(vertex[i]));
+      high[i] = max(high[i], approximate(vertex[i]));
+    }
+  }
+  size_t center     = 0;
+  auto nearest_area = numeric_limits<long double>::infinity();
+  for (size_t i = 0; i < vertices_.size(); ++i) {
+    auto dx   = approximate(vertices_[i][0]) - (low[0] + high[0]) / 2;
+    auto dy   = approximate(vertices_[i][1]) - (low[1] + high[1]) / 2;
+    auto area = dx * dx + dy * dy;
+    if (area < nearest_area) {
+      nearest_area = area;
+      center       = i;
+    }
+  }
+
+  typedef decltype(scaled_squared_distance(vertices_[0], vertices_[0]))
+      DistanceT;
+  vector<DistanceT> distances;
+  distances.reserve(vertices_.size());
+  for (const auto& vertex : vertices_) {
+    distances.push_back(scaled_squared_distance(vertices_[center], vertex));
+  }
+
+  // Equal points are equally distant, and so kept together by the tie-break.
+  vector<size_t> order(vertices_.size());
+  iota(begin(order), end(order), 0);
+  stable_sort(begin(order), end(order), [&](size_t l_op, size_t r_op) {
+    if (distances[l_op] < distances[r_op]) return true;
+    if (distances[r_op] < distances[l_op]) return false;
+    return vertices_[l_op] < vertices_[r_op];
+  });
+
+  vector<size_t> distinct;
+  for (auto index : order) {
+    if (!distinct.empty() && vertices_[distinct.back()] == vertices_[index]) {
+      canonical_[index] = distinct.back();
+    }
+    else {
+      canonical_[index] = index;
+      distinct.push_back(index);
+    }
+  }
+
+  // Leading collinear points, put in order along their line, are fanned to
+  // the first point off it.
+  size_t first_off = 2;
+  while (first_off < distinct.size()
+         && orient2d(vertices_[distinct[0]], vertices_[distinct[1]],
+                vertices_[distinct[first_off]])
+                == 0) {
+    ++first_off;
+  }
+  if (first_off >= distinct.size()) return;
+  sort(begin(distinct), next(begin(distinct), first_off),
+      [this](size_t l_op, size_t r_op) {
+        return vertices_[l_op] < vertices_[r_op];
+      });
+
+  // The hull, counter-clockwise, as a linked list of vertices; vertices off
+  // it have no next.
+  vector<size_t> hull_next(vertices_.size(), kNone);
+  vector<size_t> hull_prev(vertices_.size(), kNone);
+  auto connect = [&](size_t from, size_t to) {
+    hull_next[from] = to;
+    hull_prev[to]   = from;
+  };
+
+  auto apex    = distinct[first_off];
+  bool is_left = orient2d(vertices_[distinct[0]],
+                     vertices_[distinct[first_off - 1]], vertices_[apex])
+                 > 0;
+  for (size_t i = 0; i + 1 < first_off; ++i) {
+    auto a = distinct[i];
+    auto b = distinct[i + 1];
+    auto t = is_left ? add_triangle(a, b, apex) : add_triangle(b, a, apex);
+    if (i > 0) {
+      if (is_left) {
+        link(t, 2, t - 1, 1);
+      }
+      else {
+        link(t, 1, t - 1, 2);
+      }
+    }
+    if (is_left) {
+      connect(a, b);
+    }
+    else {
+      connect(b, a);
+    }
+  }
+  auto first = distinct[0];
+  auto last  = distinct[first_off - 1];
+  if (is_left) {
+    connect(last, apex);
+    connect(apex, first);
+  }
+  else {
+    connect(first, apex);
+    connect(apex, last);
+  }
+
+  // Hull vertices are hashed by a pseudo-angle about the first triangle's
+  // centroid, increasing with the angle, so a point's slot is near those of
+  // the hull vertices it can see. It only guides the search for them.
+  auto hash_size = static_cast<size_t>(sqrt(distinct.size())) + 1;
+  vector<size_t> hull_hash(hash_size, kNone);
+  long double middle[2];
+  for (size_t i = 0; i < 2; ++i) {
+    middle[i] = (approximate(vertices_[first][i])
+                    + approximate(vertices_[last][i])
+                    + approximate(vertices_[apex][i]))
+                / 3;
+  }
+  auto hash_key = [&](size_t vertex) {
+    auto dx       = approximate(vertices_[vertex][0]) - middle[0];
+    auto dy       = approximate(vertices_[vertex][1]) - middle[1];
+    auto distance = fabs(dx) + fabs(dy);
+    if (!(distance > 0)) return size_t{0};
+    auto angle = (dy > 0 ? 3 - dx / distance : 1 + dx / distance) / 4;
+    return min(static_cast<size_t>(angle * hash_size), hash_size - 1);
+  };
+  for (size_t i = 0; i <= first_off; ++i) {
+    hull_hash[hash_key(distinct[i])] = distinct[i];
+  }
+
+  vector<pair<size_t, size_t>> faced;
+  for (size_t i = first_off + 1; i < distinct.size(); ++i) {
+    auto point        = distinct[i];
+    const auto& where = vertices_[point];
+    auto is_visible   = [&](size_t from) {
+      return orient2d(vertices_[from], vertices_[hull_next[from]], where) < 0;
+    };
+
+    auto key     = hash_key(point);
+    size_t start = kNone;
+    for (size_t j = 0; j < hash_size; ++j) {
+      start = hull_hash[(key + j) % hash_size];
+      if (start != kNone && hull_next[start] != kNone) break;
+    }
+
+    // Some edge is visible, as the point is outside the hull; the visible
+    // edges then run contiguously either side of it.
+    start = hull_prev[start];
+    while (!is_visible(start)) {
+      start = hull_next[start];
+    }
+    auto stop = hull_next[start];
+    while (is_visible(hull_prev[start])) {
+      start = hull_prev[start];
+    }
+    while (is_visible(stop)) {
+      stop = hull_next[stop];
+    }
+
+    size_t fan_previous = kNone;
+    size_t fan_first    = kNone;
+    faced.clear();
+    for (auto from = start; from != stop;) {
+      auto to    = hull_next[from];
+      auto outer = find_edge(from, to);
+      auto t     = add_triangle(to, from, point);
+      link(t, 0, outer.first, outer.second);
+      if (fan_previous != kNone) link(t, 1, fan_previous, 2);
+      if (fan_first == kNone) fan_first = t;
+      fan_previous = t;
+      faced.emplace_back(to, from);
+
+      if (from != start) hull_next[from] = kNone;
+      from = to;
+    }
+
+    connect(start, point);
+    connect(point, stop);
+    hull_hash[hash_key(start)] = start;
+    hull_hash[hash_key(stop)]  = stop;
+    hull_hash[key]             = point;
+
+    make_delaunay(faced);
+  }
+}
+
+/// Flip an edge between two triangles to the quadrilateral's other diagonal.
+///
+/// The triangles keep their indices: for triangles (a, b, c) and (b, a, d)
+/// across the edge ab, they become (c, a, d) and (d, b, c).
+///
+template <typename RatT>
+void ConstrainedDelaunay<RatT>::flip(size_t triangle, size_t edge)
+{
+  auto other    = neighbors_[triangle][edge];
+  auto a        = triangles_[triangle][edge];
+  auto b        = triangles_[triangle][(edge + 1) % 3];
+  auto c        = triangles_[triangle][(edge + 2) % 3];
+  auto other_ab = edge_of(other, b, a);
+  auto d        = triangles_[other][(other_ab + 2) % 3];
+
+  auto outside = [this](size_t t, size_t e) {
+    return std::make_pair(neighbors_[t][e], is_constrained_[t][e]);
+  };
+  auto bc = outside(triangle, (edge + 1) % 3);
+  auto ca = outside(triangle, (edge + 2) % 3);
+  auto ad = outside(other, (other_ab + 1) % 3);
+  auto db = outside(other, (other_ab + 2) % 3);
+
+  triangles_[triangle]      = TriangleT{c, a, d};
+  triangles_[other]         = TriangleT{d, b, c};
+  is_constrained_[triangle] = {ca.second, ad.second, false};
+  is_constrained_[other]    = {db.second, bc.second, false};
+
+  auto relink = [this](size_t t, size_t e, size_t neighbor, size_t from,
+                    size_t to) {
+    link(t, e, neighbor, neighbor == kNone ? 0 : edge_of(neighbor, to, from));
+  };
+  relink(triangle, 0, ca.first, c, a);
+  relink(triangle, 1, ad.first, a, d);
+  link(triangle, 2, other, 2);
+  relink(other, 0, db.first, d, b);
+  relink(other, 1, bc.first, b, c);
+
+  vertex_triangle_[a] = triangle;
+  vertex_triangle_[b] = other;
+  vertex_triangle_[c] = triangle;
+  vertex_triangle_[d] = other;
+}
+
+/// Flip edges, from those given outward, until none is illegal.
+///
+/// An edge is illegal if it is not constrained and its quadrilateral's fourth
+/// point lies strictly within the circumcircle of one of its triangles.
+///
+template <typename RatT>
+void ConstrainedDelaunay<RatT>::make_delaunay(
+    std::vector<std::pair<size_t, size_t>> edges)
+{
+  while (!edges.empty()) {
+    auto edge = edges.back();
+    edges.pop_back();
+
+    auto found = find_edge(edge.first, edge.second);
+    if (found.first == kNone) continue;
+    auto triangle = found.first;
+    auto index    = found.second;
+    auto other    = neighbors_[triangle][index];
+    if (other == kNone || is_constrained_[triangle][index]) continue;
+
+    const auto& tri = triangles_[triangle];
+    auto d =
+        triangles_[other][(edge_of(other, edge.second, edge.first) + 2) % 3];
+    if (incircle(vertices_[tri[0]], vertices_[tri[1]], vertices_[tri[2]],
+            vertices_[d])
+        <= 0) {
+      continue;
+    }
+
+    auto c = tri[(index + 2) % 3];
+    flip(triangle, index);
+    edges.emplace_back(c, edge.first);
+    edges.emplace_back(edge.first, d);
+    edges.emplace_back(d, edge.second);
+    edges.emplace_back(edge.second, c);
+  }
+}
+
+//   Accessors
+//  -----------
+
+/// Get the points triangulated, as given.
+///
+template <typename RatT>
+auto ConstrainedDelaunay<RatT>::vertices() const -> const std::vector<PointT>&
+{
+  return vertices_;
+}
+
+/// Get each triangle's vertex indices, wound counter-clockwise.
+///
+template <typename RatT>
+auto ConstrainedDelaunay<RatT>::triangles() const
+    -> const std::vector<TriangleT>&
+{
+  return triangles_;
+}
+
+/// Get the triangles across each triangle's edges, or kNone on the hull.
+///
+/// Edge i of a triangle runs from its vertex i to its vertex i + 1.
+///
+template <typename RatT>
+auto ConstrainedDelaunay<RatT>::neighbors() const
+    -> const std::vector<TriangleT>&
+{
+  return neighbors_;
+}
+
+template <typename RatT>
+bool ConstrainedDelaunay<RatT>::is_constrained(
+    size_t triangle, size_t edge) const
+{
+  return is_constrained_[triangle][edge];
+}
+
+//   Mutators
+//  ----------
+
+/// Require an edge between two of the points.
+///
+/// A constraint passing through other points is split at them. Constraints
+/// between collinear points only, which no triangle can hold, are ignored.
+///
+/// \throws  std::invalid_argument if the edge would cross an existing
+///          constraint.
+///
+template <typename RatT>
+void ConstrainedDelaunay<RatT>::add_constraint(size_t from, size_t to)
+{
+  using namespace std;
+
+  vector<pair<size_t, size_t>> pending{{canonical_[from], canonical_[to]}};
+  while (!pending.empty()) {
+    auto a = pending.back().first;
+    auto b = pending.back().second;
+    pending.pop_back();
+    if (a == b || vertex_triangle_[a] == kNone) continue;
+
+    const auto& a_point = vertices_[a];
+    const auto& b_point = vertices_[b];
+
+    auto mark = [this](size_t u, size_t v) {
+      auto found = find_edge(u, v);
+      if (found.first == kNone) return false;
+      is_constrained_[found.first][found.second] = true;
+      auto twin = find_edge(v, u);
+      if (twin.first != kNone) is_constrained_[twin.first][twin.second] = true;
+      return true;
+    };
+    if (mark(a, b) || mark(b, a)) continue;
+
+    // A vertex exactly on ab splits the constraint there.
+    auto is_on_ab = [&](size_t vertex) {
+      const auto& point = vertices_[vertex];
+      return orient2d(a_point, b_point, point) == 0
+             && (a_point < point) == (point < b_point);
+    };
+
+    // Turn around a, one way and then, if a boundary stops us, the other, for
+    // the triangle ab leaves it through, or a vertex on ab.
+    pair<size_t, size_t> current{kNone, kNone};
+    size_t splitter = kNone;
+    auto start      = vertex_triangle_[a];
+    for (size_t direction : {2, 0}) {
+      auto triangle = start;
+      do {
+        const auto& tri = triangles_[triangle];
+        size_t corner   = 0;
+        while (tri[corner] != a) ++corner;
+
+        auto right = tri[(corner + 1) % 3];
+        auto left  = tri[(corner + 2) % 3];
+        if (is_on_ab(right)) {
+          splitter = right;
+        }
+        else if (is_on_ab(left)) {
+          splitter = left;
+        }
+        else if (orient2d(a_point, b_point, vertices_[right]) < 0
+                 && orient2d(a_point, b_point, vertices_[left]) > 0) {
+          current = {triangle, (corner + 1) % 3};
+        }
+        if (splitter != kNone || current.first != kNone) break;
+        triangle = neighbors_[triangle][(corner + direction) % 3];
+      } while (triangle != kNone && triangle != start);
+
+      if (triangle != kNone) break;
+    }
+
+    // Walk from a toward b, gathering the edges crossed, which are kept
+    // directed from the right of ab to its left.
+    deque<pair<size_t, size_t>> crossing;
+    while (splitter == kNone) {
+      auto triangle = current.first;
+      auto edge     = current.second;
+      if (is_constrained_[triangle][edge]) {
+        throw invalid_argument("Constraint crosses another constraint");
+      }
+
+      auto right = triangles_[triangle][edge];
+      auto left  = triangles_[triangle][(edge + 1) % 3];
+      crossing.emplace_back(right, left);
+
+      auto next      = neighbors_[triangle][edge];
+      auto next_edge = edge_of(next, left, right);
+      auto far       = triangles_[next][(next_edge + 2) % 3];
+      if (far == b) break;
+
+      auto side = orient2d(a_point, b_point, vertices_[far]);
+      if (side == 0) {
+        splitter = far;
+      }
+      else if (side > 0) {
+        current = {next, edge_of(next, right, far)};
+      }
+      else {
+        current = {next, edge_of(next, far, left)};
+      }
+    }
+    if (splitter != kNone) {
+      pending.emplace_back(splitter, b);
+      pending.emplace_back(a, splitter);
+      continue;
+    }
+
+    // Flip crossing edges whose quadrilaterals are convex, until none cross.
+    vector<pair<size_t, size_t>> created;
+    while (!crossing.empty()) {
+      auto edge = crossing.front();
+      crossing.pop_front();
+
+      auto found    = find_edge(edge.first, edge.second);
+      auto triangle = found.first;
+      auto index    = found.second;
+      auto other    = neighbors_[triangle][index];
+      auto c        = triangles_[triangle][(index + 2) % 3];
+      auto d =
+          triangles_[other][(edge_of(other, edge.second, edge.first) + 2) % 3];
+
+      const auto& c_point = vertices_[c];
+      const auto& d_point = vertices_[d];
+      if (orient2d(c_point, d_point, vertices_[edge.first])
+              * orient2d(c_point, d_point, vertices_[edge.second])
+          >= 0) {
+        crossing.push_back(edge);
+        continue;
+      }
+
+      flip(triangle, index);
+      auto c_side = orient2d(a_point, b_point, c_point);
+      auto d_side = orient2d(a_point, b_point, d_point);
+      if (c_side * d_side < 0) {
+        crossing.emplace_back(c_side < 0 ? c : d, c_side < 0 ? d : c);
+      }
+      else {
+        created.emplace_back(c, d);
+      }
+    }
+
+    mark(a, b);
+    make_delaunay(move(created));
+  }
+}
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_CONSTRAINEDDELAUNAY_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
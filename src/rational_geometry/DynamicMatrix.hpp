@@ -0,0 +1,495 @@
+/// \file    DynamicMatrix.hpp
+/// \author  Tim Holt
+///
+/// A Matrix class whose dimensions are chosen at run time, and its related
+/// functions.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_DYNAMICMATRIX_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_DYNAMICMATRIX_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "DynamicPoint.hpp"
+#include "Matrix.hpp"
+
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Class Template Declaration
+//----------------------------
+
+/// \brief  A matrix with rational members whose size is only known at run
+///         time.
+///
+/// This is the counterpart of Matrix<> for problems whose size depends on the
+/// input, such as linear programs and constraint systems with tens to hundreds
+/// of rows. Entries are stored in a single contiguous row-major buffer, and the
+/// allocator may be swapped for one drawing from an arena (e.g.
+/// std::pmr::polymorphic_allocator).
+///
+/// Operators mirror those of Matrix<>; operands of mismatched size throw
+/// std::invalid_argument rather than failing to compile.
+///
+template <typename RatT, typename AllocatorT = std::allocator<RatT>>
+class DynamicMatrix
+{
+ public:
+  // TYPES
+  typedef AllocatorT allocator_type;
+
+  // CONSTANTS
+
+  /// Edge length of the square tiles that multiplication works through.
+  static constexpr size_t kBlockSize = 64;
+
+ protected:
+  // INTERNAL STATE
+  size_t height_;
+  size_t width_;
+
+  /// Conceptually, this is a sequence of <i>rows</i>.
+  std::vector<RatT, AllocatorT> values_;
+
+ public:
+  // CONSTRUCTORS
+  explicit DynamicMatrix(const AllocatorT& allocator = AllocatorT{});
+  DynamicMatrix(
+      size_t height, size_t width, const AllocatorT& allocator = AllocatorT{});
+  DynamicMatrix(std::initializer_list<std::initializer_list<RatT>> values,
+      const AllocatorT& allocator = AllocatorT{});
+
+  template <size_t kHeight, size_t kWidth>
+  explicit DynamicMatrix(const Matrix<RatT, kHeight, kWidth>& fixed,
+      const AllocatorT& allocator = AllocatorT{});
+
+  // ACCESSORS
+  size_t height() const;
+  size_t width() const;
+
+  RatT& operator()(size_t row, size_t column);
+  const RatT& operator()(size_t row, size_t column) const;
+
+  RatT* data();
+  const RatT* data() const;
+
+  AllocatorT get_allocator() const;
+
+  template <size_t kHeight, size_t kWidth>
+  Matrix<RatT, kHeight, kWidth> as_fixed() const;
+
+  // GETTERS
+  DynamicPoint<RatT, AllocatorT> get_row(size_t which) const;
+  DynamicPoint<RatT, AllocatorT> get_column(size_t which) const;
+
+  // SETTERS
+  DynamicMatrix& set_row(
+      size_t which, const DynamicPoint<RatT, AllocatorT>& values);
+  DynamicMatrix& set_column(
+      size_t which, const DynamicPoint<RatT, AllocatorT>& values);
+};
+
+// Class Template Definitions
+//----------------------------
+//   Constructors
+//  --------------
+
+/// Creates an empty (0x0) matrix.
+///
+template <typename RatT, typename AllocatorT>
+DynamicMatrix<RatT, AllocatorT>::DynamicMatrix(const AllocatorT& allocator)
+    : height_{0}, width_{0}, values_(allocator)
+{
+}
+
+/// Initialize a matrix of the given size to an identity matrix.
+///
+template <typename RatT, typename AllocatorT>
+DynamicMatrix<RatT, AllocatorT>::DynamicMatrix(
+    size_t height, size_t width, const AllocatorT& allocator)
+    : height_{height}
+    , width_{width}
+    , values_(height * width, RatT(0), allocator)
+{
+  for (size_t i = 0; i < std::min(height_, width_); ++i) {
+    (*this)(i, i) = RatT(1);
+  }
+}
+
+/// Initialize a matrix row by row.
+///
+/// The width is that of the widest row; entries left unspecified are 0.
+///
+template <typename RatT, typename AllocatorT>
+DynamicMatrix<RatT, AllocatorT>::DynamicMatrix(
+    std::initializer_list<std::initializer_list<RatT>> values,
+    const AllocatorT& allocator)
+    : height_{values.size()}, width_{0}, values_(allocator)
+{
+  for (const auto& row : values) {
+    width_ = std::max(width_, row.size());
+  }
+
+  values_.assign(height_ * width_, RatT(0));
+
+  size_t row = 0;
+  for (const auto& in_row : values) {
+    std::copy(std::cbegin(in_row), std::cend(in_row),
+        std::begin(values_) + row * width_);
+    ++row;
+  }
+}
+
+/// Converts from a fixed-size Matrix.
+///
+template <typename RatT, typename AllocatorT>
+template <size_t kHeight, size_t kWidth>
+DynamicMatrix<RatT, AllocatorT>::DynamicMatrix(
+    const Matrix<RatT, kHeight, kWidth>& fixed, const AllocatorT& allocator)
+    : height_{kHeight}, width_{kWidth}, values_(allocator)
+{
+  values_.reserve(kHeight * kWidth);
+  for (const auto& row : fixed.values_) {
+    values_.insert(std::end(values_), std::cbegin(row), std::cend(row));
+  }
+}
+
+//   Accessors
+//  -----------
+
+template <typename RatT, typename AllocatorT>
+size_t DynamicMatrix<RatT, AllocatorT>::height() const
+{
+  return height_;
+}
+
+template <typename RatT, typename AllocatorT>
+size_t DynamicMatrix<RatT, AllocatorT>::width() const
+{
+  return width_;
+}
+
+/// \todo  Consider bounds checking.
+///
+template <typename RatT, typename AllocatorT>
+RatT& DynamicMatrix<RatT, AllocatorT>::operator()(size_t row, size_t column)
+{
+  return values_[row * width_ + column];
+}
+
+template <typename RatT, typename AllocatorT>
+const RatT& DynamicMatrix<RatT, AllocatorT>::operator()(
+    size_t row, size_t column) const
+{
+  return values_[row * width_ + column];
+}
+
+/// Get the row-major buffer of entries.
+///
+template <typename RatT, typename AllocatorT>
+RatT* DynamicMatrix<RatT, AllocatorT>::data()
+{
+  return values_.data();
+}
+
+template <typename RatT, typename AllocatorT>
+const RatT* DynamicMatrix<RatT, AllocatorT>::data() const
+{
+  return values_.data();
+}
+
+template <typename RatT, typename AllocatorT>
+AllocatorT DynamicMatrix<RatT, AllocatorT>::get_allocator() const
+{
+  return values_.get_allocator();
+}
+
+/// Converts to a fixed-size Matrix.
+///
+/// \throws  std::invalid_argument if the dimensions don't match.
+///
+template <typename RatT, typename AllocatorT>
+template <size_t kHeight, size_t kWidth>
+Matrix<RatT, kHeight, kWidth> DynamicMatrix<RatT, AllocatorT>::as_fixed()
+    const
+{
+  if (height_ != kHeight || width_ != kWidth) {
+    throw std::invalid_argument(
+        "DynamicMatrix converted to a Matrix of different size");
+  }
+
+  Matrix<RatT, kHeight, kWidth> ret;
+  for (size_t row = 0; row < kHeight; ++row) {
+    for (size_t column = 0; column < kWidth; ++column) {
+      ret.values_[row][column] = (*this)(row, column);
+    }
+  }
+  return ret;
+}
+
+//   Getters
+//  ---------
+
+template <typename RatT, typename AllocatorT>
+DynamicPoint<RatT, AllocatorT> DynamicMatrix<RatT, AllocatorT>::get_row(
+    size_t which) const
+{
+  DynamicPoint<RatT, AllocatorT> ret(get_allocator());
+
+  auto row_begin = std::cbegin(values_) + which * width_;
+  ret.assign(row_begin, row_begin + width_);
+
+  return ret;
+}
+
+template <typename RatT, typename AllocatorT>
+DynamicPoint<RatT, AllocatorT> DynamicMatrix<RatT, AllocatorT>::get_column(
+    size_t which) const
+{
+  DynamicPoint<RatT, AllocatorT> ret(height_, get_allocator());
+  for (size_t i = 0; i < height_; ++i) {
+    ret[i] = (*this)(i, which);
+  }
+  return ret;
+}
+
+//   Setters
+//  ---------
+
+/// \throws  std::invalid_argument if the row is the wrong size.
+///
+template <typename RatT, typename AllocatorT>
+DynamicMatrix<RatT, AllocatorT>& DynamicMatrix<RatT, AllocatorT>::set_row(
+    size_t which, const DynamicPoint<RatT, AllocatorT>& values)
+{
+  if (values.dimension() != width_) {
+    throw std::invalid_argument("DynamicMatrix row set to wrong size");
+  }
+
+  std::copy(std::cbegin(values), std::cend(values),
+      std::begin(values_) + which * width_);
+
+  return *this;
+}
+
+/// \throws  std::invalid_argument if the column is the wrong size.
+///
+template <typename RatT, typename AllocatorT>
+DynamicMatrix<RatT, AllocatorT>& DynamicMatrix<RatT, AllocatorT>::set_column(
+    size_t which, const DynamicPoint<RatT, AllocatorT>& values)
+{
+  if (values.dimension() != height_) {
+    throw std::invalid_argument("DynamicMatrix column set to wrong size");
+  }
+
+  for (size_t i = 0; i < height_; ++i) {
+    (*this)(i, which) = values[i];
+  }
+
+  return *this;
+}
+
+// Related Operators
+//-------------------
+//   Comparison Operators
+//  ----------------------
+
+/// Test equality of two matrices.
+///
+/// Matrices of different sizes are never equal.
+///
+template <typename RatT_l,
+    typename AllocatorT_l,
+    typename RatT_r,
+    typename AllocatorT_r>
+bool operator==(const DynamicMatrix<RatT_l, AllocatorT_l>& l_op,
+    const DynamicMatrix<RatT_r, AllocatorT_r>& r_op)
+{
+  if (l_op.height() != r_op.height() || l_op.width() != r_op.width()) {
+    return false;
+  }
+
+  auto size = l_op.height() * l_op.width();
+  return std::equal(l_op.data(), l_op.data() + size, r_op.data());
+}
+
+template <typename RatT_l,
+    typename AllocatorT_l,
+    typename RatT_r,
+    typename AllocatorT_r>
+bool operator!=(const DynamicMatrix<RatT_l, AllocatorT_l>& l_op,
+    const DynamicMatrix<RatT_r, AllocatorT_r>& r_op)
+{
+  return !(l_op == r_op);
+}
+
+/// Determine if the left DynamicMatrix is lexicographically lesser.
+///
+/// Smaller matrices (by height, then width) come first. This serves no
+/// practical purpose other than use in the stl.
+///
+template <typename RatT_l,
+    typename AllocatorT_l,
+    typename RatT_r,
+    typename AllocatorT_r>
+bool operator<(const DynamicMatrix<RatT_l, AllocatorT_l>& l_op,
+    const DynamicMatrix<RatT_r, AllocatorT_r>& r_op)
+{
+  if (l_op.height() != r_op.height()) return l_op.height() < r_op.height();
+  if (l_op.width() != r_op.width()) return l_op.width() < r_op.width();
+
+  auto size = l_op.height() * l_op.width();
+  return std::lexicographical_compare(
+      l_op.data(), l_op.data() + size, r_op.data(), r_op.data() + size);
+}
+
+//   Other Operators
+//  -----------------
+
+/// Multiply two DynamicMatrices.
+///
+/// The product is accumulated one kBlockSize-square tile at a time, walking
+/// each tile row-wise, so that the working set of both operands stays in cache
+/// even when the matrices as a whole do not.
+///
+/// \throws  std::invalid_argument if the inner dimensions don't match.
+///
+template <typename RatT_l,
+    typename AllocatorT_l,
+    typename RatT_r,
+    typename AllocatorT_r>
+auto operator*(const DynamicMatrix<RatT_l, AllocatorT_l>& l_op,
+    const DynamicMatrix<RatT_r, AllocatorT_r>& r_op)
+{
+  if (l_op.width() != r_op.height()) {
+    throw std::invalid_argument(
+        "Multiplied DynamicMatrices of incompatible sizes");
+  }
+
+  using std::declval;
+  // clang-format off
+  typedef decltype(declval<RatT_l>() * declval<RatT_r>()
+                   +
+                   declval<RatT_l>() * declval<RatT_r>()) RetBaseT;
+  // clang-format on
+  typedef typename std::allocator_traits<AllocatorT_l>::template rebind_alloc<
+      RetBaseT>
+      RetAllocatorT;
+
+  const auto kBlock = DynamicMatrix<RatT_l, AllocatorT_l>::kBlockSize;
+
+  const auto height = l_op.height();
+  const auto common = l_op.width();
+  const auto width  = r_op.width();
+
+  DynamicMatrix<RetBaseT, RetAllocatorT> ret(
+      height, width, RetAllocatorT(l_op.get_allocator()));
+  std::fill(ret.data(), ret.data() + height * width, RetBaseT(0));
+
+  for (size_t i_block = 0; i_block < height; i_block += kBlock) {
+    const auto i_end = std::min(i_block + kBlock, height);
+
+    for (size_t k_block = 0; k_block < common; k_block += kBlock) {
+      const auto k_end = std::min(k_block + kBlock, common);
+
+      for (size_t j_block = 0; j_block < width; j_block += kBlock) {
+        const auto j_end = std::min(j_block + kBlock, width);
+
+        for (size_t i = i_block; i < i_end; ++i) {
+          for (size_t k = k_block; k < k_end; ++k) {
+            const auto& l_entry = l_op(i, k);
+            if (l_entry == 0) continue;
+
+            for (size_t j = j_block; j < j_end; ++j) {
+              ret(i, j) += l_entry * r_op(k, j);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return ret;
+}
+
+/// Multiply a DynamicPoint by a DynamicMatrix.
+///
+/// \throws  std::invalid_argument if the sizes don't match.
+///
+template <typename RatT_l,
+    typename AllocatorT_l,
+    typename RatT_r,
+    typename AllocatorT_r>
+auto operator*(const DynamicMatrix<RatT_l, AllocatorT_l>& l_op,
+    const DynamicPoint<RatT_r, AllocatorT_r>& r_op)
+{
+  if (l_op.width() != r_op.dimension()) {
+    throw std::invalid_argument(
+        "Multiplied a DynamicMatrix by a DynamicPoint of the wrong dimension");
+  }
+
+  using std::declval;
+  // clang-format off
+  typedef decltype(declval<RatT_l>() * declval<RatT_r>()
+                   +
+                   declval<RatT_l>() * declval<RatT_r>()) RetBaseT;
+  // clang-format on
+  typedef typename std::allocator_traits<AllocatorT_r>::template rebind_alloc<
+      RetBaseT>
+      RetAllocatorT;
+
+  DynamicPoint<RetBaseT, RetAllocatorT> ret(
+      l_op.height(), RetAllocatorT(r_op.get_allocator()));
+
+  // Rows are contiguous, so this is already cache friendly.
+  for (size_t i = 0; i < l_op.height(); ++i) {
+    const auto* row = l_op.data() + i * l_op.width();
+    for (size_t j = 0; j < l_op.width(); ++j) {
+      ret[i] += row[j] * r_op[j];
+    }
+  }
+
+  return ret;
+}
+
+// Related Functions
+//-------------------
+
+template <typename RatT, typename AllocatorT>
+std::ostream& operator<<(std::ostream& the_stream,
+    const DynamicMatrix<RatT, AllocatorT>& the_matrix)
+{
+  the_stream << typeid(the_matrix).name();
+  the_stream << ":\n[\n";
+  for (size_t row = 0; row < the_matrix.height(); ++row) {
+    for (size_t column = 0; column < the_matrix.width(); ++column) {
+      the_stream << " " << the_matrix(row, column) << ", ";
+    }
+    the_stream << "\n";
+  }
+  the_stream << "]";
+  return the_stream;
+}
+
+//-------------------
+// Related Functions
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_DYNAMICMATRIX_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
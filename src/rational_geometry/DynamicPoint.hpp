@@ -0,0 +1,307 @@
+/// \file     DynamicPoint.hpp
+/// \author   Tim Holt
+///
+/// A Point class whose dimension is chosen at run time, and its related
+/// functions.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_DYNAMICPOINT_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_DYNAMICPOINT_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "Point.hpp"
+
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Class Template Declaration
+//----------------------------
+
+/// \brief  A geometric point (or vector) in n-space with rational number
+///         coordinates, where n is only known at run time.
+///
+/// This is the counterpart of Point<> for problems such as linear programs,
+/// whose number of dimensions depends on the input. The coordinates are stored
+/// contiguously, and the allocator may be swapped for one drawing from an
+/// arena (e.g. std::pmr::polymorphic_allocator).
+///
+/// \note  As with Point<> and std::array<>, it is safe for this class to
+///        inherit from std::vector<>, because this subclass adds no new member
+///        fields.
+///
+template <typename RatT, typename AllocatorT = std::allocator<RatT>>
+class DynamicPoint : public std::vector<RatT, AllocatorT>
+{
+ public:
+  // CONSTRUCTORS
+  DynamicPoint();
+  explicit DynamicPoint(const AllocatorT& allocator);
+  explicit DynamicPoint(
+      size_t dimension, const AllocatorT& allocator = AllocatorT{});
+  DynamicPoint(const std::initializer_list<RatT>& values,
+      const AllocatorT& allocator = AllocatorT{});
+
+  template <size_t kDimension>
+  explicit DynamicPoint(const Point<RatT, kDimension>& fixed,
+      const AllocatorT& allocator = AllocatorT{});
+
+  // ACCESSORS
+  size_t dimension() const;
+
+  template <size_t kDimension>
+  Point<RatT, kDimension> as_fixed() const;
+};
+
+// Class Template Definitions
+//----------------------------
+//   Constructors
+//  --------------
+
+/// Creates a DynamicPoint with no dimensions.
+///
+template <typename RatT, typename AllocatorT>
+DynamicPoint<RatT, AllocatorT>::DynamicPoint()
+    : std::vector<RatT, AllocatorT>()
+{
+}
+
+template <typename RatT, typename AllocatorT>
+DynamicPoint<RatT, AllocatorT>::DynamicPoint(const AllocatorT& allocator)
+    : std::vector<RatT, AllocatorT>(allocator)
+{
+}
+
+/// Creates a DynamicPoint with the given number of dimensions, all values at 0.
+///
+template <typename RatT, typename AllocatorT>
+DynamicPoint<RatT, AllocatorT>::DynamicPoint(
+    size_t dimension, const AllocatorT& allocator)
+    : std::vector<RatT, AllocatorT>(dimension, RatT(0), allocator)
+{
+}
+
+/// Creates a DynamicPoint with as many dimensions as values given.
+///
+template <typename RatT, typename AllocatorT>
+DynamicPoint<RatT, AllocatorT>::DynamicPoint(
+    const std::initializer_list<RatT>& values, const AllocatorT& allocator)
+    : std::vector<RatT, AllocatorT>(values, allocator)
+{
+}
+
+/// Converts from a fixed-size Point.
+///
+template <typename RatT, typename AllocatorT>
+template <size_t kDimension>
+DynamicPoint<RatT, AllocatorT>::DynamicPoint(
+    const Point<RatT, kDimension>& fixed, const AllocatorT& allocator)
+    : std::vector<RatT, AllocatorT>(
+          std::cbegin(fixed), std::cend(fixed), allocator)
+{
+}
+
+//   Accessors
+//  -----------
+
+template <typename RatT, typename AllocatorT>
+size_t DynamicPoint<RatT, AllocatorT>::dimension() const
+{
+  return this->size();
+}
+
+/// Converts to a fixed-size Point.
+///
+/// \throws  std::invalid_argument if the dimensions don't match.
+///
+template <typename RatT, typename AllocatorT>
+template <size_t kDimension>
+Point<RatT, kDimension> DynamicPoint<RatT, AllocatorT>::as_fixed() const
+{
+  if (dimension() != kDimension) {
+    throw std::invalid_argument(
+        "DynamicPoint converted to a Point of different dimension");
+  }
+
+  Point<RatT, kDimension> ret;
+  std::copy(this->cbegin(), this->cend(), std::begin(ret));
+  return ret;
+}
+
+// Related Operators
+//-------------------
+//   Comparison Operators
+//  ----------------------
+
+/// Test equality of two points.
+///
+/// Points of different dimension are never equal.
+///
+template <typename RatT_l,
+    typename AllocatorT_l,
+    typename RatT_r,
+    typename AllocatorT_r>
+bool operator==(const DynamicPoint<RatT_l, AllocatorT_l>& l_op,
+    const DynamicPoint<RatT_r, AllocatorT_r>& r_op)
+{
+  // see note in Point's operator==. Find it by searching "over-complex".
+  using namespace std;
+  return equal(cbegin(l_op), cend(l_op), cbegin(r_op), cend(r_op));
+}
+
+template <typename RatT_l,
+    typename AllocatorT_l,
+    typename RatT_r,
+    typename AllocatorT_r>
+bool operator!=(const DynamicPoint<RatT_l, AllocatorT_l>& l_op,
+    const DynamicPoint<RatT_r, AllocatorT_r>& r_op)
+{
+  return !(l_op == r_op);
+}
+
+/// Test whether a point is less than another, lexicographically.
+///
+/// The same caveats apply as for Point's operator<.
+///
+template <typename RatT_l,
+    typename AllocatorT_l,
+    typename RatT_r,
+    typename AllocatorT_r>
+bool operator<(const DynamicPoint<RatT_l, AllocatorT_l>& l_op,
+    const DynamicPoint<RatT_r, AllocatorT_r>& r_op)
+{
+  using namespace std;
+  return lexicographical_compare(
+      cbegin(l_op), cend(l_op), cbegin(r_op), cend(r_op));
+}
+
+//   Other Operators
+//  -----------------
+
+/// Add two vectors
+///
+/// \throws  std::invalid_argument if the dimensions don't match.
+///
+template <typename RatT_l,
+    typename AllocatorT_l,
+    typename RatT_r,
+    typename AllocatorT_r>
+auto operator+(const DynamicPoint<RatT_l, AllocatorT_l>& l_op,
+    const DynamicPoint<RatT_r, AllocatorT_r>& r_op)
+{
+  if (l_op.dimension() != r_op.dimension()) {
+    throw std::invalid_argument("Added DynamicPoints of different dimension");
+  }
+
+  using std::declval;
+  typedef decltype(declval<RatT_l>() + declval<RatT_r>()) RetBaseT;
+  typedef typename std::allocator_traits<AllocatorT_l>::template rebind_alloc<
+      RetBaseT>
+      RetAllocatorT;
+
+  DynamicPoint<RetBaseT, RetAllocatorT> ret(
+      l_op.dimension(), RetAllocatorT(l_op.get_allocator()));
+  for (size_t i = 0; i < l_op.dimension(); ++i) {
+    ret[i] = l_op[i] + r_op[i];
+  }
+  return ret;
+}
+
+/// Scale a vector by a scalar.
+///
+template <typename RatT_l, typename AllocatorT_l, typename RatT_r>
+auto operator*(
+    const DynamicPoint<RatT_l, AllocatorT_l>& l_op, const RatT_r& r_op)
+{
+  using std::declval;
+  typedef decltype(declval<RatT_l>() * r_op) RetBaseT;
+  typedef typename std::allocator_traits<AllocatorT_l>::template rebind_alloc<
+      RetBaseT>
+      RetAllocatorT;
+
+  DynamicPoint<RetBaseT, RetAllocatorT> ret(
+      l_op.dimension(), RetAllocatorT(l_op.get_allocator()));
+  for (size_t i = 0; i < l_op.dimension(); ++i) {
+    ret[i] = l_op[i] * r_op;
+  }
+  return ret;
+}
+
+/// Scale a vector by a scalar.
+///
+template <typename RatT_l, typename RatT_r, typename AllocatorT_r>
+auto operator*(RatT_l l_op, const DynamicPoint<RatT_r, AllocatorT_r>& r_op)
+{
+  // commutative
+  return r_op * l_op;
+}
+
+// Related Functions
+//-------------------
+
+/// Find the dot product (<i>scalar</i> product) between two vectors.
+///
+/// \throws  std::invalid_argument if the dimensions don't match.
+///
+/// \sa  dot() in Operations.hpp, for fixed-size containers.
+///
+template <typename RatT_l,
+    typename AllocatorT_l,
+    typename RatT_r,
+    typename AllocatorT_r>
+auto dot(const DynamicPoint<RatT_l, AllocatorT_l>& l_op,
+    const DynamicPoint<RatT_r, AllocatorT_r>& r_op)
+{
+  if (l_op.dimension() != r_op.dimension()) {
+    throw std::invalid_argument(
+        "dot() of DynamicPoints of different dimension");
+  }
+
+  using std::declval;
+  // clang-format off
+  decltype(declval<RatT_l>() * declval<RatT_r>()
+           +
+           declval<RatT_l>() * declval<RatT_r>()) sum{0};
+  // clang-format on
+  for (size_t i = 0; i < l_op.dimension(); ++i) {
+    sum += l_op[i] * r_op[i];
+  }
+
+  return sum;
+}
+
+template <typename RatT, typename AllocatorT>
+std::ostream& operator<<(
+    std::ostream& the_stream, const DynamicPoint<RatT, AllocatorT>& the_point)
+{
+  the_stream << typeid(the_point).name();
+  the_stream << ":(";
+  for (const auto& coordinate : the_point) {
+    the_stream << coordinate << ", ";
+  }
+  the_stream << ")";
+  return the_stream;
+}
+
+//-------------------
+// Related Functions
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_DYNAMICPOINT_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
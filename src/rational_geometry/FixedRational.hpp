@@ -237,6 +237,11 @@ class FixedRational
   FixedRational operator--(int);
 
   FixedRational operator-() const;
+
+  FixedRational& operator+=(const FixedRational& r_op);
+  FixedRational& operator-=(const FixedRational& r_op);
+  FixedRational& operator*=(const FixedRational& r_op);
+  FixedRational& operator/=(const FixedRational& r_op);
 };
 
 // Class Template Definitions
@@ -286,7 +291,7 @@ FixedRational<SignedIntT, kDenominator, kDoThrowOnInexact>::FixedRational(
 
   auto result = partial_division({numerator, kDenominator}, denominator);
 
-  if (kDoThrowOnInexact && result.remaining_divisor_ != 1) {
+  if (kDoThrowOnInexact && abs(result.remaining_divisor_) != 1) {
     std::stringstream what_error;
     what_error << "Inexact construction of a FixedRational<"
                << typeid(SignedIntT).name() << ", " << kDenominator << ">";
@@ -428,6 +433,48 @@ FixedRational<SignedIntT, kDenominator, kDoThrowOnInexact>::operator-() const
       FixedRational<SignedIntT, kDenominator, kDoThrowOnInexact>*>(&ret);
 }
 
+/// Compound assignment operators.
+///
+/// These simply defer to their binary counterparts (defined below), so they
+/// carry the same rounding detection. They exist so that FixedRational may be
+/// accumulated into, as in dot().
+///
+template <typename SignedIntT, SignedIntT kDenominator, bool kDoThrowOnInexact>
+FixedRational<SignedIntT, kDenominator, kDoThrowOnInexact>&
+FixedRational<SignedIntT, kDenominator, kDoThrowOnInexact>::operator+=(
+    const FixedRational& r_op)
+{
+  *this = *this + r_op;
+  return *this;
+}
+
+template <typename SignedIntT, SignedIntT kDenominator, bool kDoThrowOnInexact>
+FixedRational<SignedIntT, kDenominator, kDoThrowOnInexact>&
+FixedRational<SignedIntT, kDenominator, kDoThrowOnInexact>::operator-=(
+    const FixedRational& r_op)
+{
+  *this = *this - r_op;
+  return *this;
+}
+
+template <typename SignedIntT, SignedIntT kDenominator, bool kDoThrowOnInexact>
+FixedRational<SignedIntT, kDenominator, kDoThrowOnInexact>&
+FixedRational<SignedIntT, kDenominator, kDoThrowOnInexact>::operator*=(
+    const FixedRational& r_op)
+{
+  *this = *this * r_op;
+  return *this;
+}
+
+template <typename SignedIntT, SignedIntT kDenominator, bool kDoThrowOnInexact>
+FixedRational<SignedIntT, kDenominator, kDoThrowOnInexact>&
+FixedRational<SignedIntT, kDenominator, kDoThrowOnInexact>::operator/=(
+    const FixedRational& r_op)
+{
+  *this = *this / r_op;
+  return *this;
+}
+
 // Related Operators
 //-------------------
 //   Comparison
@@ -737,7 +784,7 @@ auto operator/(
 {
   auto result = partial_division<decltype(l_op.numerator() / r_op)>(
       l_op.numerator(), r_op);
-  if (kDoThrowOnInexact && result.remaining_divisor_ != 1) {
+  if (kDoThrowOnInexact && abs(result.remaining_divisor_) != 1) {
     std::stringstream what_error;
     // clang-format off
     what_error << "Inexact operation in ("
@@ -766,7 +813,7 @@ auto operator/(IntT_l l_op,
 {
   auto result =
       partial_division({l_op, kDenominator, kDenominator}, r_op.numerator());
-  if (kDoThrowOnInexact && result.remaining_divisor_ != 1) {
+  if (kDoThrowOnInexact && abs(result.remaining_divisor_) != 1) {
     std::stringstream what_error;
     // clang-format off
     what_error << "Inexact operation in ("
@@ -791,7 +838,7 @@ FixedRational<SignedIntT, kDenominator, kDoThrowOnInexact> operator/(
 {
   auto result =
       partial_division({l_op.numerator(), kDenominator}, r_op.numerator());
-  if (kDoThrowOnInexact && result.remaining_divisor_ != 1) {
+  if (kDoThrowOnInexact && abs(result.remaining_divisor_) != 1) {
     std::stringstream what_error;
     // clang-format off
     what_error << "Inexact operation in ("
@@ -0,0 +1,502 @@
+/// \file     HalfEdgeMesh.hpp
+/// \author   Tim Holt
+///
+/// A half-edge mesh of planar faces over rational vertices.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_HALFEDGEMESH_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_HALFEDGEMESH_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "BspTree.hpp"
+#include "Direction.hpp"
+#include "Operations.hpp"
+#include "Point.hpp"
+#include "Polyhedron.hpp"
+#include "predicates.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Class Template Declaration
+//----------------------------
+
+/// \brief  A surface of faces, each a loop of half-edges, with every half-edge
+///         linked to the one running the other way along its edge.
+///
+/// Vertices, half-edges and faces are kept in contiguous arrays and refer to
+/// each other by index, so every adjacency (a half-edge's twin, next, previous,
+/// origin and face; a face's or vertex's first half-edge) is a single lookup.
+/// A half-edge on the surface's boundary has no twin (kNone).
+///
+/// Each face also keeps its normal as a Direction, found exactly by Newell's
+/// method, so coplanar faces can be recognised by comparing normals.
+///
+/// Faces can be added and removed; removal leaves gaps in the arrays, which
+/// compact() closes.
+///
+/// \note  The surface must be manifold where faces are added: no directed edge
+///        may appear in two faces.
+///
+template <typename RatT>
+class HalfEdgeMesh
+{
+ public:
+  // TYPES
+  typedef Point<RatT, 3> PointT;
+  typedef Direction<typename NumeratorType<RatT>::type, 3> DirectionT;
+
+  struct HalfEdge
+  {
+    size_t origin_;
+    size_t twin_;
+    size_t next_;
+    size_t prev_;
+    size_t face_;
+  };
+
+  // CONSTANTS
+  static constexpr size_t kNone = static_cast<size_t>(-1);
+
+ protected:
+  // INTERNAL STATE
+  std::vector<PointT> vertices_;
+  std::vector<size_t> vertex_half_edges_;
+  std::vector<HalfEdge> half_edges_;
+  std::vector<size_t> face_half_edges_;
+  std::vector<DirectionT> face_normals_;
+
+  // HELPER FUNCTIONS
+  size_t add_loop(const std::vector<size_t>& ring);
+  DirectionT newell_normal(size_t face) const;
+
+ public:
+  // CONSTRUCTORS
+  HalfEdgeMesh();
+  HalfEdgeMesh(std::vector<PointT> vertices,
+      const std::vector<std::vector<size_t>>& faces);
+  explicit HalfEdgeMesh(const Polyhedron<RatT>& polyhedron);
+
+  // ACCESSORS
+  const std::vector<PointT>& vertices() const;
+  const std::vector<HalfEdge>& half_edges() const;
+  size_t face_count() const;
+
+  size_t vertex_half_edge(size_t vertex) const;
+  size_t face_half_edge(size_t face) const;
+  const DirectionT& face_normal(size_t face) const;
+  std::vector<size_t> face_vertices(size_t face) const;
+
+  size_t destination(size_t half_edge) const;
+  bool is_boundary(size_t half_edge) const;
+  size_t find_half_edge(size_t from, size_t to) const;
+
+  Polyhedron<RatT> polyhedron() const;
+
+  // MUTATORS
+  size_t add_face(const std::vector<size_t>& ring);
+  void remove_face(size_t face);
+  void compact();
+};
+
+// Class Template Definitions
+//----------------------------
+//   Constructors
+//  --------------
+
+/// Creates an empty mesh.
+///
+template <typename RatT>
+HalfEdgeMesh<RatT>::HalfEdgeMesh()
+{
+}
+
+/// Creates a mesh from its vertices and faces, each face a ring of vertex
+/// indices, counter-clockwise seen from the front.
+///
+/// Twins are matched in one pass, by sorting all the half-edges by their
+/// endpoints.
+///
+/// \throws  std::invalid_argument if a directed edge appears twice.
+///
+template <typename RatT>
+HalfEdgeMesh<RatT>::HalfEdgeMesh(
+    std::vector<PointT> vertices, const std::vector<std::vector<size_t>>& faces)
+    : vertices_(std::move(vertices)),
+      vertex_half_edges_(vertices_.size(), kNone)
+{
+  using namespace std;
+
+  size_t half_edge_count = 0;
+  for (const auto& ring : faces) {
+    half_edge_count += ring.size();
+  }
+  half_edges_.reserve(half_edge_count);
+  face_half_edges_.reserve(faces.size());
+  face_normals_.reserve(faces.size());
+
+  for (const auto& ring : faces) {
+    add_loop(ring);
+  }
+
+  // Each edge's key is its lesser endpoint, its greater, then its direction.
+  vector<tuple<size_t, size_t, bool, size_t>> keys;
+  keys.reserve(half_edges_.size());
+  for (size_t i = 0; i < half_edges_.size(); ++i) {
+    auto from = half_edges_[i].origin_;
+    auto to   = destination(i);
+    keys.emplace_back(min(from, to), max(from, to), to < from, i);
+  }
+  sort(begin(keys), end(keys));
+
+  for (size_t i = 0; i < keys.size();) {
+    auto j = i + 1;
+    while (j < keys.size() && get<0>(keys[j]) == get<0>(keys[i])
+           && get<1>(keys[j]) == get<1>(keys[i])) {
+      ++j;
+    }
+    if (j - i > 2 || (j - i == 2 && get<2>(keys[i]) == get<2>(keys[i + 1]))) {
+      throw invalid_argument("Directed edge in two faces");
+    }
+    if (j - i == 2) {
+      half_edges_[get<3>(keys[i])].twin_     = get<3>(keys[i + 1]);
+      half_edges_[get<3>(keys[i + 1])].twin_ = get<3>(keys[i]);
+    }
+    i = j;
+  }
+}
+
+/// Creates a mesh of a polyhedron's faces.
+///
+/// \throws  std::invalid_argument if a face has holes, or the polyhedron's
+///          surface is not manifold.
+///
+template <typename RatT>
+HalfEdgeMesh<RatT>::HalfEdgeMesh(const Polyhedron<RatT>& polyhedron)
+    : HalfEdgeMesh(polyhedron.vertices(), [&polyhedron]() {
+        std::vector<std::vector<size_t>> ret;
+        for (const auto& face : polyhedron.faces()) {
+          if (face.size() != 1) {
+            throw std::invalid_argument("Face with holes");
+          }
+          ret.push_back(face.front());
+        }
+        return ret;
+      }())
+{
+}
+
+//   Helper Functions
+//  ------------------
+
+/// Add a face's half-edges, linked in a loop but not to their twins.
+///
+template <typename RatT>
+size_t HalfEdgeMesh<RatT>::add_loop(const std::vector<size_t>& ring)
+{
+  auto face  = face_half_edges_.size();
+  auto first = half_edges_.size();
+  auto count = ring.size();
+  for (size_t i = 0; i < count; ++i) {
+    half_edges_.push_back(HalfEdge{ring[i], kNone, first + (i + 1) % count,
+        first + (i + count - 1) % count, face});
+    if (vertex_half_edges_[ring[i]] == kNone) {
+      vertex_half_edges_[ring[i]] = first + i;
+    }
+  }
+  face_half_edges_.push_back(count == 0 ? kNone : first);
+  face_normals_.push_back(newell_normal(face));
+  return face;
+}
+
+/// Find a face's normal by Newell's method, summed over the vertices'
+/// numerators in a wide type and reduced before it is narrowed, so it is
+/// exact wherever the face's Direction is representable.
+///
+/// \throws  std::overflow_error if the reduced normal's components are beyond
+///          the numerators' range.
+///
+template <typename RatT>
+auto HalfEdgeMesh<RatT>::newell_normal(size_t face) const -> DirectionT
+{
+  typedef typename NumeratorType<RatT>::type IntT;
+
+  if (face_half_edges_[face] == kNone) return DirectionT{};
+  return reduced_direction<IntT>(
+      scaled_newell_normal(vertices_, face_vertices(face)));
+}
+
+//   Accessors
+//  -----------
+
+template <typename RatT>
+auto HalfEdgeMesh<RatT>::vertices() const -> const std::vector<PointT>&
+{
+  return vertices_;
+}
+
+/// Get all the half-edges, including any removed (with origin kNone).
+///
+template <typename RatT>
+auto HalfEdgeMesh<RatT>::half_edges() const -> const std::vector<HalfEdge>&
+{
+  return half_edges_;
+}
+
+/// Get how many faces there are, including any removed.
+///
+template <typename RatT>
+size_t HalfEdgeMesh<RatT>::face_count() const
+{
+  return face_half_edges_.size();
+}
+
+/// Get a half-edge leaving a vertex, or kNone if it is in no face.
+///
+/// For a vertex on the boundary, this is not necessarily the boundary's.
+///
+template <typename RatT>
+size_t HalfEdgeMesh<RatT>::vertex_half_edge(size_t vertex) const
+{
+  return vertex_half_edges_[vertex];
+}
+
+/// Get the first half-edge of a face, or kNone if it has been removed.
+///
+template <typename RatT>
+size_t HalfEdgeMesh<RatT>::face_half_edge(size_t face) const
+{
+  return face_half_edges_[face];
+}
+
+/// Get a face's normal, the null Direction for a degenerate face.
+///
+template <typename RatT>
+auto HalfEdgeMesh<RatT>::face_normal(size_t face) const -> const DirectionT&
+{
+  return face_normals_[face];
+}
+
+/// Get a face's vertices, in order around it.
+///
+template <typename RatT>
+std::vector<size_t> HalfEdgeMesh<RatT>::face_vertices(size_t face) const
+{
+  std::vector<size_t> ret;
+  auto first = face_half_edges_[face];
+  if (first == kNone) return ret;
+
+  auto half_edge = first;
+  do {
+    ret.push_back(half_edges_[half_edge].origin_);
+    half_edge = half_edges_[half_edge].next_;
+  } while (half_edge != first);
+  return ret;
+}
+
+template <typename RatT>
+size_t HalfEdgeMesh<RatT>::destination(size_t half_edge) const
+{
+  return half_edges_[half_edges_[half_edge].next_].origin_;
+}
+
+template <typename RatT>
+bool HalfEdgeMesh<RatT>::is_boundary(size_t half_edge) const
+{
+  return half_edges_[half_edge].twin_ == kNone;
+}
+
+/// Find the half-edge running from one vertex to another, or kNone.
+///
+/// The half-edges leaving the vertex are visited by turning around it, each
+/// way if a boundary stops the turn.
+///
+template <typename RatT>
+size_t HalfEdgeMesh<RatT>::find_half_edge(size_t from, size_t to) const
+{
+  auto start = vertex_half_edges_[from];
+  if (start == kNone) return kNone;
+
+  auto half_edge = start;
+  do {
+    if (destination(half_edge) == to) return half_edge;
+    half_edge = half_edges_[half_edges_[half_edge].prev_].twin_;
+  } while (half_edge != kNone && half_edge != start);
+  if (half_edge == start) return kNone;
+
+  half_edge = half_edges_[start].twin_;
+  while (half_edge != kNone) {
+    half_edge = half_edges_[half_edge].next_;
+    if (destination(half_edge) == to) return half_edge;
+    half_edge = half_edges_[half_edge].twin_;
+  }
+  return kNone;
+}
+
+/// Get the mesh's faces as a polyhedron, over the same vertices.
+///
+template <typename RatT>
+Polyhedron<RatT> HalfEdgeMesh<RatT>::polyhedron() const
+{
+  std::vector<typename Polyhedron<RatT>::FaceT> faces;
+  for (size_t face = 0; face < face_count(); ++face) {
+    if (face_half_edges_[face] != kNone) {
+      faces.push_back({face_vertices(face)});
+    }
+  }
+  return Polyhedron<RatT>{vertices_, faces};
+}
+
+//   Mutators
+//  ----------
+
+/// Add a face, linking it to the faces already beside it.
+///
+/// \return  The new face's index.
+///
+/// \throws  std::invalid_argument if one of its directed edges is already in
+///          another face.
+///
+template <typename RatT>
+size_t HalfEdgeMesh<RatT>::add_face(const std::vector<size_t>& ring)
+{
+  for (size_t i = 0; i < ring.size(); ++i) {
+    if (find_half_edge(ring[i], ring[(i + 1) % ring.size()]) != kNone) {
+      throw std::invalid_argument("Directed edge in two faces");
+    }
+  }
+
+  auto face  = add_loop(ring);
+  auto first = face_half_edges_[face];
+  for (size_t i = 0; i < ring.size(); ++i) {
+    auto twin = find_half_edge(ring[(i + 1) % ring.size()], ring[i]);
+    if (twin != kNone) {
+      half_edges_[first + i].twin_ = twin;
+      half_edges_[twin].twin_      = first + i;
+    }
+  }
+  return face;
+}
+
+/// Remove a face, leaving its neighbours' edges on the boundary.
+///
+/// The face's index, and those of its half-edges, stay unused until compact().
+///
+template <typename RatT>
+void HalfEdgeMesh<RatT>::remove_face(size_t face)
+{
+  auto first = face_half_edges_[face];
+  if (first == kNone) return;
+
+  auto half_edge = first;
+  do {
+    const auto& removed = half_edges_[half_edge];
+
+    // Hand the vertex another half-edge leaving it, if there is one.
+    if (vertex_half_edges_[removed.origin_] == half_edge) {
+      auto other = half_edges_[removed.prev_].twin_;
+      if (other == kNone && removed.twin_ != kNone) {
+        other = half_edges_[removed.twin_].next_;
+      }
+      vertex_half_edges_[removed.origin_] = other;
+    }
+    if (removed.twin_ != kNone) half_edges_[removed.twin_].twin_ = kNone;
+    half_edge = removed.next_;
+  } while (half_edge != first);
+
+  do {
+    auto next              = half_edges_[half_edge].next_;
+    half_edges_[half_edge] = HalfEdge{kNone, kNone, kNone, kNone, kNone};
+    half_edge              = next;
+  } while (half_edge != first);
+
+  face_half_edges_[face] = kNone;
+  face_normals_[face]    = DirectionT{};
+}
+
+/// Close the gaps left by removed faces and their half-edges, and drop
+/// vertices no longer in any face.
+///
+/// All indices may change.
+///
+template <typename RatT>
+void HalfEdgeMesh<RatT>::compact()
+{
+  auto remap = [](const std::vector<bool>& is_kept) {
+    std::vector<size_t> ret(is_kept.size(), kNone);
+    size_t next = 0;
+    for (size_t i = 0; i < is_kept.size(); ++i) {
+      if (is_kept[i]) ret[i] = next++;
+    }
+    return ret;
+  };
+  auto moved = [](const std::vector<size_t>& indices, size_t index) {
+    return index == kNone ? kNone : indices[index];
+  };
+
+  std::vector<bool> is_kept_vertex(vertices_.size(), false);
+  std::vector<bool> is_kept_half_edge(half_edges_.size(), false);
+  std::vector<bool> is_kept_face(face_half_edges_.size(), false);
+  for (size_t i = 0; i < half_edges_.size(); ++i) {
+    if (half_edges_[i].origin_ != kNone) {
+      is_kept_half_edge[i]                   = true;
+      is_kept_vertex[half_edges_[i].origin_] = true;
+      is_kept_face[half_edges_[i].face_]     = true;
+    }
+  }
+  auto new_vertex    = remap(is_kept_vertex);
+  auto new_half_edge = remap(is_kept_half_edge);
+  auto new_face      = remap(is_kept_face);
+
+  size_t kept = 0;
+  for (size_t i = 0; i < vertices_.size(); ++i) {
+    if (!is_kept_vertex[i]) continue;
+    vertices_[kept]          = vertices_[i];
+    vertex_half_edges_[kept] = moved(new_half_edge, vertex_half_edges_[i]);
+    ++kept;
+  }
+  vertices_.resize(kept);
+  vertex_half_edges_.resize(kept);
+
+  kept = 0;
+  for (size_t i = 0; i < half_edges_.size(); ++i) {
+    if (!is_kept_half_edge[i]) continue;
+    const auto& old   = half_edges_[i];
+    half_edges_[kept] = HalfEdge{moved(new_vertex, old.origin_),
+        moved(new_half_edge, old.twin_), moved(new_half_edge, old.next_),
+        moved(new_half_edge, old.prev_), moved(new_face, old.face_)};
+    ++kept;
+  }
+  half_edges_.resize(kept);
+
+  kept = 0;
+  for (size_t i = 0; i < face_half_edges_.size(); ++i) {
+    if (!is_kept_face[i]) continue;
+    face_half_edges_[kept] = moved(new_half_edge, face_half_edges_[i]);
+    face_normals_[kept]    = face_normals_[i];
+    ++kept;
+  }
+  face_half_edges_.resize(kept);
+  face_normals_.resize(kept);
+}
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_HALFEDGEMESH_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,387 @@
+/// \file     KdTree.hpp
+/// \author   Tim Holt
+///
+/// A kd-tree of exact points, for nearest neighbour and radius queries.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_KDTREE_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_KDTREE_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "Point.hpp"
+#include "predicates.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Class Template Declaration
+//----------------------------
+
+/// \brief  A balanced binary tree of points, each node splitting its points
+///         about an axis, for finding quickly which points are nearest to a
+///         point.
+///
+/// The tree is implicit: the points are kept in one array, each node's run of
+/// it holding its splitting point in the middle, the points below it before,
+/// and those above after. So no links are stored, only each node's axis.
+///
+/// Distances are compared exactly, squared, over the coordinates' numerators,
+/// and equally distant points by index, so every answer is deterministic.
+///
+/// Given more than one thread, the constructor builds the two sides of each
+/// large node on threads of their own; as their runs of the array are
+/// disjoint, the tree is the same as a single thread builds.
+///
+template <typename RatT, size_t kDimension>
+class KdTree
+{
+ public:
+  // TYPES
+  typedef Point<RatT, kDimension> PointT;
+  typedef typename WidenedInt<typename NumeratorType<RatT>::type>::type
+      DistanceT;
+
+  // CONSTANTS
+  static constexpr size_t kNone = static_cast<size_t>(-1);
+
+  /// The fewest points in a node for its sides to be built on separate
+  /// threads.
+  static constexpr size_t kParallelMinimum = 16384;
+
+ protected:
+  // TYPES
+  /// A run of items_ still to be searched, and the least scaled squared
+  /// distance any of its points may be from the query.
+  struct Pending
+  {
+    size_t first_;
+    size_t last_;
+    DistanceT bound_;
+  };
+
+  // INTERNAL STATE
+  std::vector<PointT> points_;
+  std::vector<size_t> items_;
+  std::vector<size_t> axes_;
+
+  // HELPER FUNCTIONS
+  void build(size_t first, size_t last, size_t thread_count);
+  void push_children(std::vector<Pending>& pending,
+      const Pending& node,
+      const PointT& query) const;
+
+ public:
+  // CONSTRUCTORS
+  KdTree();
+  explicit KdTree(std::vector<PointT> points, size_t thread_count = 1);
+
+  // ACCESSORS
+  const std::vector<PointT>& points() const;
+  size_t depth() const;
+
+  size_t nearest(const PointT& query) const;
+  std::vector<size_t> nearest(const PointT& query, size_t count) const;
+  std::vector<std::vector<size_t>> nearest(
+      const std::vector<PointT>& queries, size_t count) const;
+
+  std::vector<size_t> within(const PointT& query, const RatT& radius) const;
+  std::vector<std::vector<size_t>> within(
+      const std::vector<PointT>& queries, const RatT& radius) const;
+};
+
+// Class Template Definitions
+//----------------------------
+//   Constructors
+//  --------------
+
+/// Creates a tree of no points.
+///
+template <typename RatT, size_t kDimension>
+KdTree<RatT, kDimension>::KdTree()
+{
+}
+
+/// Creates a tree over the given points, indexed as given.
+///
+/// Each node splits along its points' widest axis, at their median, found by
+/// selection rather than sorting.
+///
+/// \param  thread_count  How many threads may build subtrees at once.
+///
+template <typename RatT, size_t kDimension>
+KdTree<RatT, kDimension>::KdTree(
+    std::vector<PointT> points, size_t thread_count)
+    : points_(std::move(points)), items_(points_.size()), axes_(points_.size())
+{
+  for (size_t i = 0; i < items_.size(); ++i) {
+    items_[i] = i;
+  }
+  build(0, items_.size(), thread_count);
+}
+
+//   Helper Functions
+//  ------------------
+
+/// Build the subtree over a run of items, reordering only that run.
+///
+template <typename RatT, size_t kDimension>
+void KdTree<RatT, kDimension>::build(
+    size_t first, size_t last, size_t thread_count)
+{
+  std::vector<std::pair<size_t, size_t>> pending;
+  if (first < last) pending.emplace_back(first, last);
+
+  while (!pending.empty()) {
+    first = pending.back().first;
+    last  = pending.back().second;
+    pending.pop_back();
+
+    auto lower = points_[items_[first]];
+    auto upper = lower;
+    for (size_t i = first + 1; i < last; ++i) {
+      const auto& point = points_[items_[i]];
+      for (size_t j = 0; j < kDimension; ++j) {
+        lower[j] = std::min(lower[j], point[j]);
+        upper[j] = std::max(upper[j], point[j]);
+      }
+    }
+    size_t axis = 0;
+    for (size_t i = 1; i < kDimension; ++i) {
+      if (upper[axis] - lower[axis] < upper[i] - lower[i]) axis = i;
+    }
+
+    auto middle = first + (last - first) / 2;
+    std::nth_element(items_.begin() + first, items_.begin() + middle,
+        items_.begin() + last, [this, axis](size_t l_op, size_t r_op) {
+          const auto& l_value = points_[l_op][axis];
+          const auto& r_value = points_[r_op][axis];
+          return l_value < r_value || (l_value == r_value && l_op < r_op);
+        });
+    axes_[middle] = axis;
+
+    if (thread_count > 1 && last - first >= kParallelMinimum) {
+      auto share = thread_count / 2;
+      auto above = std::async(std::launch::async,
+          [this, middle, last, share, thread_count] {
+            build(middle + 1, last, thread_count - share);
+          });
+      build(first, middle, share);
+      above.get();
+      continue;
+    }
+
+    if (middle + 1 < last) pending.emplace_back(middle + 1, last);
+    if (first < middle) pending.emplace_back(first, middle);
+  }
+}
+
+/// Queue a node's two children, the one on the query's far side of the
+/// splitting plane first, so the near one is searched first.
+///
+template <typename RatT, size_t kDimension>
+void KdTree<RatT, kDimension>::push_children(std::vector<Pending>& pending,
+    const Pending& node,
+    const PointT& query) const
+{
+  auto middle = node.first_ + (node.last_ - node.first_) / 2;
+  auto axis   = axes_[middle];
+
+  // The query's offset from the plane, squared, in long long where it fits.
+  auto l_op     = numerator_of(query[axis]);
+  auto r_op     = numerator_of(points_[items_[middle]][axis]);
+  bool is_small = false;
+  bool is_below = false;
+  DistanceT squared;
+  if constexpr (std::is_integral<decltype(l_op)>::value) {
+    is_small = is_within_bits(l_op, 62) && is_within_bits(r_op, 62)
+               && is_within_bits(static_cast<long long>(l_op) - r_op, 31);
+    if (is_small) {
+      auto offset = static_cast<long long>(l_op) - r_op;
+      is_below    = offset < 0;
+      squared     = DistanceT(offset * offset);
+    }
+  }
+  if (!is_small) {
+    auto offset = DistanceT(l_op) - DistanceT(r_op);
+    is_below    = offset < DistanceT(0);
+    squared     = offset * offset;
+  }
+  auto far_bound = std::max(node.bound_, squared);
+
+  Pending below{node.first_, middle, node.bound_};
+  Pending above{middle + 1, node.last_, node.bound_};
+  if (is_below) {
+    above.bound_ = far_bound;
+    pending.push_back(above);
+    pending.push_back(below);
+  }
+  else {
+    below.bound_ = far_bound;
+    pending.push_back(below);
+    pending.push_back(above);
+  }
+}
+
+//   Accessors
+//  -----------
+
+/// Get the points, indexed as given.
+///
+template <typename RatT, size_t kDimension>
+auto KdTree<RatT, kDimension>::points() const -> const std::vector<PointT>&
+{
+  return points_;
+}
+
+/// Get the number of nodes on the longest path from the root to a leaf.
+///
+template <typename RatT, size_t kDimension>
+size_t KdTree<RatT, kDimension>::depth() const
+{
+  size_t ret = 0;
+  for (auto count = points_.size(); count != 0; count /= 2) {
+    ++ret;
+  }
+  return ret;
+}
+
+/// Find the point nearest to a point, the least indexed if several are.
+///
+/// \return  The point's index, or kNone if the tree is empty.
+///
+template <typename RatT, size_t kDimension>
+size_t KdTree<RatT, kDimension>::nearest(const PointT& query) const
+{
+  auto found = nearest(query, 1);
+  return found.empty() ? kNone : found.front();
+}
+
+/// Find the given number of points nearest to a point, breaking ties by
+/// index.
+///
+/// \return  The points' indices, nearest first, or all of them, if there are
+///          too few.
+///
+template <typename RatT, size_t kDimension>
+std::vector<size_t> KdTree<RatT, kDimension>::nearest(
+    const PointT& query, size_t count) const
+{
+  // The best found so far, as a max-heap of distance and index.
+  std::vector<std::pair<DistanceT, size_t>> best;
+  if (count == 0) return {};
+
+  std::vector<Pending> pending;
+  if (!items_.empty()) pending.push_back({0, items_.size(), DistanceT(0)});
+
+  while (!pending.empty()) {
+    auto node = pending.back();
+    pending.pop_back();
+    if (node.first_ == node.last_) continue;
+    if (best.size() == count && best.front().first < node.bound_) continue;
+
+    auto index = items_[node.first_ + (node.last_ - node.first_) / 2];
+    std::pair<DistanceT, size_t> candidate{
+        scaled_squared_distance(points_[index], query), index};
+    if (best.size() < count) {
+      best.push_back(candidate);
+      std::push_heap(best.begin(), best.end());
+    }
+    else if (candidate < best.front()) {
+      std::pop_heap(best.begin(), best.end());
+      best.back() = candidate;
+      std::push_heap(best.begin(), best.end());
+    }
+
+    push_children(pending, node, query);
+  }
+
+  std::sort_heap(best.begin(), best.end());
+  std::vector<size_t> ret;
+  ret.reserve(best.size());
+  for (const auto& found : best) {
+    ret.push_back(found.second);
+  }
+  return ret;
+}
+
+/// Find the given number of points nearest to each of many points.
+///
+template <typename RatT, size_t kDimension>
+std::vector<std::vector<size_t>> KdTree<RatT, kDimension>::nearest(
+    const std::vector<PointT>& queries, size_t count) const
+{
+  std::vector<std::vector<size_t>> ret;
+  ret.reserve(queries.size());
+  for (const auto& query : queries) {
+    ret.push_back(nearest(query, count));
+  }
+  return ret;
+}
+
+/// Find the points within a distance of a point, including those at exactly
+/// that distance.
+///
+/// \return  The points' indices, in increasing order.
+///
+template <typename RatT, size_t kDimension>
+std::vector<size_t> KdTree<RatT, kDimension>::within(
+    const PointT& query, const RatT& radius) const
+{
+  std::vector<size_t> ret;
+  if (radius < RatT(0)) return ret;
+
+  DistanceT limit = numerator_of(radius);
+  limit *= limit;
+
+  std::vector<Pending> pending;
+  if (!items_.empty()) pending.push_back({0, items_.size(), DistanceT(0)});
+
+  while (!pending.empty()) {
+    auto node = pending.back();
+    pending.pop_back();
+    if (node.first_ == node.last_ || limit < node.bound_) continue;
+
+    auto index = items_[node.first_ + (node.last_ - node.first_) / 2];
+    if (scaled_squared_distance(points_[index], query) <= limit) {
+      ret.push_back(index);
+    }
+
+    push_children(pending, node, query);
+  }
+
+  std::sort(ret.begin(), ret.end());
+  return ret;
+}
+
+/// Find the points within a distance of each of many points.
+///
+template <typename RatT, size_t kDimension>
+std::vector<std::vector<size_t>> KdTree<RatT, kDimension>::within(
+    const std::vector<PointT>& queries, const RatT& radius) const
+{
+  std::vector<std::vector<size_t>> ret;
+  ret.reserve(queries.size());
+  for (const auto& query : queries) {
+    ret.push_back(within(query, radius));
+  }
+  return ret;
+}
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_KDTREE_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -10,7 +10,9 @@
 /// comments because knowledge of the subject (or ability to research it) is
 /// assumed.
 ///
-/// \todo  Make as many functions constexpr as possible.
+/// The class, its operators, and the make_*() factories are constexpr, so a
+/// fixed stack of transforms with literal element types (e.g. int) can be
+/// folded into a single Matrix at compile time.
 ///
 /// \todo  change code style to put return type on its own line in definitions.
 ///
@@ -28,10 +30,13 @@
 #include "Operations.hpp"
 #include "Point.hpp"
 
+#include <algorithm>
 #include <array>
 #include <initializer_list>
 #include <ostream>
+#include <stdexcept>
 #include <typeinfo>
+#include <utility>
 
 //----------
 // Includes
@@ -66,16 +71,17 @@ class Matrix
   std::array<std::array<RatT, kWidth>, kHeight> values_;
 
   // CONSTRUCTORS
-  Matrix();
-  Matrix(std::initializer_list<std::initializer_list<RatT>> values);
+  constexpr Matrix();
+  constexpr Matrix(std::initializer_list<std::initializer_list<RatT>> values);
 
   // GETTERS
-  Point<RatT, kWidth> get_row(size_t which) const;
-  Point<RatT, kHeight> get_column(size_t which) const;
+  constexpr Point<RatT, kWidth> get_row(size_t which) const;
+  constexpr Point<RatT, kHeight> get_column(size_t which) const;
 
   // SETTERS
-  Matrix& set_row(size_t which, const Point<RatT, kWidth>& values);
-  Matrix& set_column(size_t which, const Point<RatT, kHeight>& values);
+  constexpr Matrix& set_row(size_t which, const Point<RatT, kWidth>& values);
+  constexpr Matrix& set_column(
+      size_t which, const Point<RatT, kHeight>& values);
 };
 
 // Class Template Definitions
@@ -86,25 +92,32 @@ class Matrix
 /// Initialize a matrix to an identity matrix.
 ///
 template <typename RatT, size_t kHeight, size_t kWidth>
-Matrix<RatT, kHeight, kWidth>::Matrix()
+constexpr Matrix<RatT, kHeight, kWidth>::Matrix() : values_{}
 {
-  for (int row = 0; row < kHeight; ++row) {
-    for (int column = 0; column < kWidth; ++column) {
-      values_[row][column] = (row == column) ? 1 : 0;
+  for (size_t row = 0; row < kHeight; ++row) {
+    for (size_t column = 0; column < kWidth; ++column) {
+      values_[row][column] = RatT((row == column) ? 1 : 0);
     }
   }
 }
 
+/// Initialize a matrix row by row.
+///
+/// Entries (or rows) left unspecified are value-initialized, i.e. 0.
+///
 template <typename RatT, size_t kHeight, size_t kWidth>
-Matrix<RatT, kHeight, kWidth>::Matrix(
+constexpr Matrix<RatT, kHeight, kWidth>::Matrix(
     std::initializer_list<std::initializer_list<RatT>> values)
+    : values_{}
 {
-  using namespace std;
-
-  auto in_row = cbegin(values);
-  for (auto& row : values_) {
-    copy(cbegin(*in_row), cend(*in_row), begin(row));
-    ++in_row;
+  auto in_row = std::cbegin(values);
+  for (size_t row = 0; row < std::min(values.size(), kHeight);
+       ++row, ++in_row) {
+    auto in_entry = std::cbegin(*in_row);
+    for (size_t column = 0; column < std::min(in_row->size(), kWidth);
+         ++column, ++in_entry) {
+      values_[row][column] = *in_entry;
+    }
   }
 }
 
@@ -112,22 +125,18 @@ Matrix<RatT, kHeight, kWidth>::Matrix(
 //  ---------
 
 template <typename RatT, size_t kHeight, size_t kWidth>
-Point<RatT, kWidth> Matrix<RatT, kHeight, kWidth>::get_row(size_t which) const
+constexpr Point<RatT, kWidth> Matrix<RatT, kHeight, kWidth>::get_row(
+    size_t which) const
 {
-  Point<RatT, kWidth> ret;
-
-  using namespace std;
-  copy(cbegin(values_[which]), cend(values_[which]), begin(ret));
-
-  return ret;
+  return Point<RatT, kWidth>(values_[which]);
 }
 
 template <typename RatT, size_t kHeight, size_t kWidth>
-Point<RatT, kHeight> Matrix<RatT, kHeight, kWidth>::get_column(
+constexpr Point<RatT, kHeight> Matrix<RatT, kHeight, kWidth>::get_column(
     size_t which) const
 {
   Point<RatT, kHeight> ret;
-  for (int i = 0; i < kHeight; ++i) {
+  for (size_t i = 0; i < kHeight; ++i) {
     ret[i] = values_[i][which];
   }
   return ret;
@@ -139,11 +148,13 @@ Point<RatT, kHeight> Matrix<RatT, kHeight, kWidth>::get_column(
 /// \todo  Implement bounds checking.
 ///
 template <typename RatT, size_t kHeight, size_t kWidth>
-Matrix<RatT, kHeight, kWidth>& Matrix<RatT, kHeight, kWidth>::set_row(
+constexpr Matrix<RatT, kHeight, kWidth>&
+Matrix<RatT, kHeight, kWidth>::set_row(
     size_t which, const Point<RatT, kWidth>& values)
 {
-  using namespace std;
-  copy(cbegin(values), cend(values), begin(values_[which]));
+  for (size_t i = 0; i < kWidth; ++i) {
+    values_[which][i] = values[i];
+  }
 
   return *this;
 }
@@ -151,10 +162,11 @@ Matrix<RatT, kHeight, kWidth>& Matrix<RatT, kHeight, kWidth>::set_row(
 /// \todo  Implement bounds checking.
 ///
 template <typename RatT, size_t kHeight, size_t kWidth>
-Matrix<RatT, kHeight, kWidth>& Matrix<RatT, kHeight, kWidth>::set_column(
+constexpr Matrix<RatT, kHeight, kWidth>&
+Matrix<RatT, kHeight, kWidth>::set_column(
     size_t which, const Point<RatT, kHeight>& values)
 {
-  for (int i = 0; i < kHeight; ++i) {
+  for (size_t i = 0; i < kHeight; ++i) {
     values_[i][which] = values[i];
   }
 
@@ -167,24 +179,21 @@ Matrix<RatT, kHeight, kWidth>& Matrix<RatT, kHeight, kWidth>::set_column(
 //  ----------------------
 
 template <typename RatT_l, typename RatT_r, size_t kHeight, size_t kWidth>
-bool operator==(const Matrix<RatT_l, kHeight, kWidth>& l_op,
+constexpr bool operator==(const Matrix<RatT_l, kHeight, kWidth>& l_op,
     const Matrix<RatT_r, kHeight, kWidth>& r_op)
 {
-  using namespace std;
-
-  auto l_row = cbegin(l_op.values_);
-  auto r_row = cbegin(r_op.values_);
-
-  for (; l_row != cend(l_op.values_); ++l_row, ++r_row) {
-    if (!equal(cbegin(*l_row), cend(*l_row), cbegin(*r_row))) {
-      return false;
+  for (size_t row = 0; row < kHeight; ++row) {
+    for (size_t column = 0; column < kWidth; ++column) {
+      if (!(l_op.values_[row][column] == r_op.values_[row][column])) {
+        return false;
+      }
     }
   }
   return true;
 }
 
 template <typename RatT_l, typename RatT_r, size_t kHeight, size_t kWidth>
-bool operator!=(const Matrix<RatT_l, kHeight, kWidth>& l_op,
+constexpr bool operator!=(const Matrix<RatT_l, kHeight, kWidth>& l_op,
     const Matrix<RatT_r, kHeight, kWidth>& r_op)
 {
   return !(l_op == r_op);
@@ -195,23 +204,18 @@ bool operator!=(const Matrix<RatT_l, kHeight, kWidth>& l_op,
 /// This serves no practical purpose other than use in the stl.
 ///
 template <typename RatT_l, typename RatT_r, size_t kHeight, size_t kWidth>
-bool operator<(const Matrix<RatT_l, kHeight, kWidth>& l_op,
+constexpr bool operator<(const Matrix<RatT_l, kHeight, kWidth>& l_op,
     const Matrix<RatT_r, kHeight, kWidth>& r_op)
 {
-  using namespace std;
-
-  auto l_row = cbegin(l_op.values_);
-  auto r_row = cbegin(r_op.values_);
-
-  for (; l_row != cend(l_op.values_); ++l_row, ++r_row) {
-    auto l_entry = cbegin(*l_row);
-    auto r_entry = cbegin(*r_row);
+  for (size_t row = 0; row < kHeight; ++row) {
+    for (size_t column = 0; column < kWidth; ++column) {
+      const auto& l_entry = l_op.values_[row][column];
+      const auto& r_entry = r_op.values_[row][column];
 
-    for (; l_entry != cend(*l_row); ++l_entry, ++r_entry) {
-      if (*l_entry < *r_entry) {
+      if (l_entry < r_entry) {
         return true;
       }
-      else if (*r_entry < *l_entry) {
+      else if (r_entry < l_entry) {
         return false;
       }
       // Continue to test, this entry is equal.
@@ -233,7 +237,8 @@ template <typename RatT_l,
     size_t kl_Height,
     size_t kCommon_Dimension,
     size_t kr_Width>
-auto operator*(const Matrix<RatT_l, kl_Height, kCommon_Dimension>& l_op,
+constexpr auto operator*(
+    const Matrix<RatT_l, kl_Height, kCommon_Dimension>& l_op,
     const Matrix<RatT_r, kCommon_Dimension, kr_Width>& r_op)
 {
   using std::declval;
@@ -248,8 +253,8 @@ auto operator*(const Matrix<RatT_l, kl_Height, kCommon_Dimension>& l_op,
 
   // copying the values is slower than ideal, but we're just trying to get a
   // working algorithm to begin with.
-  for (int i = 0; i < kl_Height; ++i) {
-    for (int j = 0; j < kr_Width; ++j) {
+  for (size_t i = 0; i < kl_Height; ++i) {
+    for (size_t j = 0; j < kr_Width; ++j) {
       ret.values_[i][j] = dot(l_op.get_row(i), r_op.get_column(j));
     }
   }
@@ -260,7 +265,7 @@ auto operator*(const Matrix<RatT_l, kl_Height, kCommon_Dimension>& l_op,
 /// Multiply a Point by a Matrix.
 ///
 template <typename RatT_l, typename RatT_r, size_t kHeight, size_t kWidth>
-auto operator*(const Matrix<RatT_l, kHeight, kWidth>& l_op,
+constexpr auto operator*(const Matrix<RatT_l, kHeight, kWidth>& l_op,
     const Point<RatT_r, kWidth>& r_op)
 {
   // Width of l_op is height of r_op_matrix.
@@ -291,7 +296,7 @@ std::ostream& operator<<(
 }
 
 template <typename RatT, size_t kDimensions>
-auto make_translation(Point<RatT, kDimensions> new_origin)
+constexpr auto make_translation(Point<RatT, kDimensions> new_origin)
 {
   Matrix<RatT, kDimensions + 1, kDimensions + 1> ret{};
 
@@ -309,7 +314,7 @@ auto make_translation(Point<RatT, kDimensions> new_origin)
 /// \sa  https://en.wikipedia.org/wiki/Versor_(physics)
 ///
 template <typename RatT, size_t kDimension>
-auto make_rotation(
+constexpr auto make_rotation(
     const std::array<Point<RatT, kDimension>, kDimension>& transformed_versors)
 {
   Matrix<RatT, kDimension + 1> ret{};
@@ -317,7 +322,7 @@ auto make_rotation(
   auto versor         = std::cbegin(transformed_versors);
   auto number_to_copy = std::min(kDimension, transformed_versors.size());
 
-  for (int i = 0; i < number_to_copy; ++i, ++versor) {
+  for (size_t i = 0; i < number_to_copy; ++i, ++versor) {
     ret.set_column(i, versor->as_vector());
   }
 
@@ -330,12 +335,12 @@ auto make_rotation(
 ///        may be called by specifying size without having to specify type.
 ///
 template <size_t kDimension, typename RatT>
-auto make_scale(RatT scalar)
+constexpr auto make_scale(RatT scalar)
 {
   Matrix<RatT, kDimension + 1> ret{}; // identity matrix
 
   // Not off by 1, last column left alone. Really.
-  for (int i = 0; i < kDimension; ++i) {
+  for (size_t i = 0; i < kDimension; ++i) {
     ret.set_column(i, scalar * ret.get_column(i));
   }
 
@@ -348,7 +353,7 @@ auto make_scale(RatT scalar)
 ///        may be called by specifying size without having to specify type.
 ///
 template <size_t kDimension, typename RatT>
-auto make_stretch(size_t which_dimension, RatT scalar)
+constexpr auto make_stretch(size_t which_dimension, RatT scalar)
 {
   Matrix<RatT, kDimension + 1> ret{}; // identity matrix
 
@@ -360,6 +365,344 @@ auto make_stretch(size_t which_dimension, RatT scalar)
   return ret;
 }
 
+//   Linear Algebra
+//  ----------------
+
+/// Find the determinant of the leading size x size block of a square array
+/// using fraction-free (Bareiss) elimination.
+///
+/// Every intermediate value is itself a minor of the input, so with integer
+/// element types the division at each step is exact and intermediate growth is
+/// bounded as for the determinant itself.
+///
+/// \note  This does not carry over to FixedRational: a minor of entries n / D
+///        need not be a multiple of 1 / D, so an intermediate step may throw
+///        unrepresentable_operation_error (or round) even where the
+///        determinant itself is representable.
+///
+/// \note  The array is taken by value because it is overwritten.
+///
+/// \sa  https://en.wikipedia.org/wiki/Bareiss_algorithm
+///
+template <typename RatT, size_t kSize>
+RatT bareiss_determinant(
+    std::array<std::array<RatT, kSize>, kSize> values, size_t size = kSize)
+{
+  RatT previous_pivot{1};
+  bool negate = false;
+
+  for (size_t k = 0; k < size; ++k) {
+    size_t pivot_row = k;
+    while (pivot_row < size && values[pivot_row][k] == 0) {
+      ++pivot_row;
+    }
+    if (pivot_row == size) {
+      return RatT{0};
+    }
+    if (pivot_row != k) {
+      std::swap(values[pivot_row], values[k]);
+      negate = !negate;
+    }
+
+    const RatT pivot = values[k][k];
+    for (size_t i = k + 1; i < size; ++i) {
+      const RatT factor = values[i][k];
+      for (size_t j = k + 1; j < size; ++j) {
+        values[i][j] =
+            (pivot * values[i][j] - factor * values[k][j]) / previous_pivot;
+      }
+    }
+    previous_pivot = pivot;
+  }
+
+  return negate ? -previous_pivot : previous_pivot;
+}
+
+/// Perform fraction-free Gauss-Jordan elimination on an augmented matrix.
+///
+/// The leftmost kSize columns are reduced to a multiple of the identity. On
+/// success, that multiple is returned and every augmented column has been
+/// multiplied by it and by the inverse of the left block. If the left block is
+/// singular, 0 is returned and the rows are left partially reduced.
+///
+/// \param negated  set to whether an odd number of row swaps occurred. The
+///                 returned value is the determinant of the left block, negated
+///                 if this is set.
+///
+template <typename RatT, size_t kSize, size_t kWidth>
+RatT fraction_free_gauss_jordan(
+    std::array<std::array<RatT, kWidth>, kSize>& rows, bool& negated)
+{
+  static_assert(kWidth >= kSize, "augmented matrix must be at least square");
+
+  RatT previous_pivot{1};
+  negated = false;
+
+  for (size_t k = 0; k < kSize; ++k) {
+    size_t pivot_row = k;
+    while (pivot_row < kSize && rows[pivot_row][k] == 0) {
+      ++pivot_row;
+    }
+    if (pivot_row == kSize) {
+      return RatT{0};
+    }
+    if (pivot_row != k) {
+      std::swap(rows[pivot_row], rows[k]);
+      negated = !negated;
+    }
+
+    // Rows above the pivot are eliminated too. Their diagonal entries simply
+    // become the new pivot, keeping the left block a multiple of the identity.
+    const RatT pivot = rows[k][k];
+    for (size_t i = 0; i < kSize; ++i) {
+      if (i == k) continue;
+
+      const RatT factor = rows[i][k];
+      for (size_t j = 0; j < kWidth; ++j) {
+        rows[i][j] =
+            (pivot * rows[i][j] - factor * rows[k][j]) / previous_pivot;
+      }
+    }
+    previous_pivot = pivot;
+  }
+
+  return previous_pivot;
+}
+
+/// Find the determinant of a square matrix.
+///
+/// Sizes up to 4 use closed-form expressions; larger matrices use fraction-free
+/// (Bareiss) elimination. No division is performed in the closed forms, so any
+/// ring type may be used for them.
+///
+template <typename RatT, size_t kSize>
+RatT determinant(const Matrix<RatT, kSize, kSize>& matrix)
+{
+  const auto& m = matrix.values_;
+
+  if constexpr (kSize == 0) {
+    return RatT{1};
+  }
+  else if constexpr (kSize == 1) {
+    return m[0][0];
+  }
+  else if constexpr (kSize == 2) {
+    return m[0][0] * m[1][1] - m[0][1] * m[1][0];
+  }
+  else if constexpr (kSize == 3) {
+    return dot(matrix.get_row(0), cross(matrix.get_row(1), matrix.get_row(2)));
+  }
+  else if constexpr (kSize == 4) {
+    // Laplace expansion along the top two rows.
+    const RatT s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+    const RatT s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+    const RatT s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+    const RatT s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+    const RatT s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+    const RatT s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+
+    const RatT c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+    const RatT c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+    const RatT c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+    const RatT c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+    const RatT c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+    const RatT c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+
+    return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+  }
+  else {
+    return bareiss_determinant(m);
+  }
+}
+
+/// Find the adjugate (transposed cofactor matrix) of a square matrix.
+///
+/// The adjugate exists for singular matrices too, and for integer element
+/// types it is always representable, unlike the inverse. For a non-singular
+/// matrix, A * adjugate(A) == determinant(A) * I.
+///
+/// \sa  https://en.wikipedia.org/wiki/Adjugate_matrix
+///
+template <typename RatT, size_t kSize>
+Matrix<RatT, kSize, kSize> adjugate(const Matrix<RatT, kSize, kSize>& matrix)
+{
+  const auto& m = matrix.values_;
+  Matrix<RatT, kSize, kSize> ret{};
+
+  if constexpr (kSize <= 1) {
+    // The adjugate of a 1x1 matrix is the identity, as is the default value.
+  }
+  else if constexpr (kSize == 2) {
+    ret.values_[0][0] = m[1][1];
+    ret.values_[0][1] = -m[0][1];
+    ret.values_[1][0] = -m[1][0];
+    ret.values_[1][1] = m[0][0];
+  }
+  else if constexpr (kSize == 3) {
+    // The columns of the adjugate are the cross products of pairs of rows.
+    const auto row_0 = matrix.get_row(0);
+    const auto row_1 = matrix.get_row(1);
+    const auto row_2 = matrix.get_row(2);
+
+    ret.set_column(0, cross(row_1, row_2));
+    ret.set_column(1, cross(row_2, row_0));
+    ret.set_column(2, cross(row_0, row_1));
+  }
+  else if constexpr (kSize == 4) {
+    const RatT s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+    const RatT s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+    const RatT s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+    const RatT s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+    const RatT s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+    const RatT s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+
+    const RatT c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+    const RatT c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+    const RatT c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+    const RatT c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+    const RatT c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+    const RatT c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+
+    auto& r = ret.values_;
+    // clang-format off
+    r[0][0] =  m[1][1] * c5 - m[1][2] * c4 + m[1][3] * c3;
+    r[0][1] = -m[0][1] * c5 + m[0][2] * c4 - m[0][3] * c3;
+    r[0][2] =  m[3][1] * s5 - m[3][2] * s4 + m[3][3] * s3;
+    r[0][3] = -m[2][1] * s5 + m[2][2] * s4 - m[2][3] * s3;
+
+    r[1][0] = -m[1][0] * c5 + m[1][2] * c2 - m[1][3] * c1;
+    r[1][1] =  m[0][0] * c5 - m[0][2] * c2 + m[0][3] * c1;
+    r[1][2] = -m[3][0] * s5 + m[3][2] * s2 - m[3][3] * s1;
+    r[1][3] =  m[2][0] * s5 - m[2][2] * s2 + m[2][3] * s1;
+
+    r[2][0] =  m[1][0] * c4 - m[1][1] * c2 + m[1][3] * c0;
+    r[2][1] = -m[0][0] * c4 + m[0][1] * c2 - m[0][3] * c0;
+    r[2][2] =  m[3][0] * s4 - m[3][1] * s2 + m[3][3] * s0;
+    r[2][3] = -m[2][0] * s4 + m[2][1] * s2 - m[2][3] * s0;
+
+    r[3][0] = -m[1][0] * c3 + m[1][1] * c1 - m[1][2] * c0;
+    r[3][1] =  m[0][0] * c3 - m[0][1] * c1 + m[0][2] * c0;
+    r[3][2] = -m[3][0] * s3 + m[3][1] * s1 - m[3][2] * s0;
+    r[3][3] =  m[2][0] * s3 - m[2][1] * s1 + m[2][2] * s0;
+    // clang-format on
+  }
+  else {
+    std::array<std::array<RatT, 2 * kSize>, kSize> augmented{};
+    for (size_t i = 0; i < kSize; ++i) {
+      for (size_t j = 0; j < kSize; ++j) {
+        augmented[i][j]         = m[i][j];
+        augmented[i][kSize + j] = RatT((i == j) ? 1 : 0);
+      }
+    }
+
+    bool negated;
+    if (fraction_free_gauss_jordan(augmented, negated) != 0) {
+      for (size_t i = 0; i < kSize; ++i) {
+        for (size_t j = 0; j < kSize; ++j) {
+          const RatT& entry = augmented[i][kSize + j];
+          ret.values_[i][j] = negated ? -entry : entry;
+        }
+      }
+      return ret;
+    }
+
+    // Singular: fall back on the definition, one minor per entry.
+    std::array<std::array<RatT, kSize>, kSize> minor{};
+    for (size_t i = 0; i < kSize; ++i) {
+      for (size_t j = 0; j < kSize; ++j) {
+        for (size_t row = 0, minor_row = 0; row < kSize; ++row) {
+          if (row == i) continue;
+          for (size_t column = 0, minor_column = 0; column < kSize; ++column) {
+            if (column == j) continue;
+            minor[minor_row][minor_column++] = m[row][column];
+          }
+          ++minor_row;
+        }
+
+        const RatT cofactor = bareiss_determinant(minor, kSize - 1);
+        ret.values_[j][i]   = ((i + j) % 2 == 0) ? cofactor : -cofactor;
+      }
+    }
+  }
+
+  return ret;
+}
+
+/// Find the inverse of a square matrix.
+///
+/// \throws  std::domain_error if the matrix is singular.
+///
+/// \note  The inverse is the adjugate divided by the determinant, so RatT must
+///        be able to represent the quotient (a FixedRational throws
+///        unrepresentable_operation_error if it can't). For integer types, use
+///        adjugate() and determinant() directly.
+///
+template <typename RatT, size_t kSize>
+Matrix<RatT, kSize, kSize> inverse(const Matrix<RatT, kSize, kSize>& matrix)
+{
+  const RatT the_determinant = determinant(matrix);
+  if (the_determinant == 0) {
+    throw std::domain_error("Cannot invert a singular Matrix");
+  }
+
+  auto ret = adjugate(matrix);
+  for (auto& row : ret.values_) {
+    for (auto& entry : row) {
+      entry = entry / the_determinant;
+    }
+  }
+  return ret;
+}
+
+/// Solve the linear system matrix * x == values for x.
+///
+/// Elimination is fraction-free; the only division is the final one, by the
+/// determinant, of each coordinate.
+///
+/// \throws  std::domain_error if the matrix is singular.
+///
+/// \note  The same caveats about RatT apply as for inverse().
+///
+template <typename RatT, size_t kSize>
+Point<RatT, kSize> solve(
+    const Matrix<RatT, kSize, kSize>& matrix, const Point<RatT, kSize>& values)
+{
+  Point<RatT, kSize> ret;
+
+  if constexpr (kSize <= 4) {
+    const RatT the_determinant = determinant(matrix);
+    if (the_determinant == 0) {
+      throw std::domain_error("Cannot solve a singular linear system");
+    }
+
+    const auto scaled = adjugate(matrix) * values;
+    for (size_t i = 0; i < kSize; ++i) {
+      ret[i] = scaled[i] / the_determinant;
+    }
+  }
+  else {
+    std::array<std::array<RatT, kSize + 1>, kSize> augmented{};
+    for (size_t i = 0; i < kSize; ++i) {
+      for (size_t j = 0; j < kSize; ++j) {
+        augmented[i][j] = matrix.values_[i][j];
+      }
+      augmented[i][kSize] = values[i];
+    }
+
+    bool negated;
+    const RatT scale = fraction_free_gauss_jordan(augmented, negated);
+    if (scale == 0) {
+      throw std::domain_error("Cannot solve a singular linear system");
+    }
+
+    for (size_t i = 0; i < kSize; ++i) {
+      ret[i] = augmented[i][kSize] / scale;
+    }
+  }
+
+  return ret;
+}
+
 //-------------------
 // Related Functions
 
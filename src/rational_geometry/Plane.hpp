@@ -0,0 +1,364 @@
+/// \file     Plane.hpp
+/// \author   Tim Holt
+///
+/// An exact plane class, built on Direction, and its related functions.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_PLANE_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_PLANE_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "Direction.hpp"
+#include "FixedRational.hpp"
+#include "Operations.hpp"
+#include "Point.hpp"
+#include "predicates.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Class Template Declaration
+//----------------------------
+
+/// \brief  The points x in 3-space where dot(normal, x) == offset, for a
+///         Direction normal and an integer (or rational) offset.
+///
+/// Since a Direction is kept in lowest terms, every plane has exactly one
+/// representation per facing, so planes can be compared and ordered exactly.
+/// Points where dot(normal, x) is greater than the offset are "above" the
+/// plane.
+///
+/// An integer offset suffices for planes through the integer lattice. Any
+/// plane through rational points has an integer normal, but may need an
+/// OffsetT of rational type.
+///
+template <typename SignedIntT, typename OffsetT = SignedIntT>
+class Plane
+{
+ public:
+  // TYPES
+  typedef Direction<SignedIntT, 3> DirectionT;
+
+ protected:
+  // INTERNAL STATE
+  DirectionT normal_;
+  OffsetT offset_;
+
+ public:
+  // CONSTRUCTORS
+  Plane();
+  Plane(const DirectionT& normal, OffsetT offset);
+  Plane(const Point<SignedIntT, 3>& a,
+      const Point<SignedIntT, 3>& b,
+      const Point<SignedIntT, 3>& c);
+
+  // ACCESSORS
+  const DirectionT& normal() const;
+  const OffsetT& offset() const;
+
+  Plane flipped() const;
+
+  template <typename RatT>
+  int classify(const Point<RatT, 3>& point) const;
+  template <typename RatT>
+  std::vector<int> classify(const std::vector<Point<RatT, 3>>& points) const;
+
+  template <typename IntT, IntT kDenominator, bool kDoThrowOnInexact>
+  std::vector<int> classify(
+      const std::vector<Point<FixedRational<IntT, kDenominator,
+                                  kDoThrowOnInexact>,
+          3>>& points) const;
+
+  // OPERATORS
+  bool operator==(const Plane& r_op) const;
+  bool operator!=(const Plane& r_op) const;
+  bool operator<(const Plane& r_op) const;
+};
+
+// Class Template Definitions
+//----------------------------
+//   Constructors
+//  --------------
+
+/// Creates a null plane, with no normal.
+///
+template <typename SignedIntT, typename OffsetT>
+Plane<SignedIntT, OffsetT>::Plane() : normal_(), offset_(0)
+{
+}
+
+/// Creates a plane from its normal and offset, used as they are.
+///
+/// \note  The offset is taken relative to the normal in lowest terms, as
+///        normal() returns it.
+///
+template <typename SignedIntT, typename OffsetT>
+Plane<SignedIntT, OffsetT>::Plane(const DirectionT& normal, OffsetT offset)
+    : normal_(normal), offset_(offset)
+{
+}
+
+/// Creates the plane through three integer points.
+///
+/// The plane is above a, b and c where they appear counter-clockwise, so
+/// orient3d(a, b, c, x) is the negation of classify(x).
+///
+/// \throws  std::invalid_argument if the points are collinear.
+///
+template <typename SignedIntT, typename OffsetT>
+Plane<SignedIntT, OffsetT>::Plane(const Point<SignedIntT, 3>& a,
+    const Point<SignedIntT, 3>& b,
+    const Point<SignedIntT, 3>& c)
+{
+  auto normal = cross(b - a, c - a);
+  normal_     = DirectionT{std::array<SignedIntT, 3>{SignedIntT(normal[0]),
+      SignedIntT(normal[1]), SignedIntT(normal[2])}};
+  if (normal_ == DirectionT{}) {
+    throw std::invalid_argument("Plane through collinear points");
+  }
+  offset_ = OffsetT(dot(normal_.get(), a));
+}
+
+//   Accessors
+//  -----------
+
+template <typename SignedIntT, typename OffsetT>
+auto Plane<SignedIntT, OffsetT>::normal() const -> const DirectionT&
+{
+  return normal_;
+}
+
+template <typename SignedIntT, typename OffsetT>
+const OffsetT& Plane<SignedIntT, OffsetT>::offset() const
+{
+  return offset_;
+}
+
+/// Get the same plane, facing the other way.
+///
+template <typename SignedIntT, typename OffsetT>
+auto Plane<SignedIntT, OffsetT>::flipped() const -> Plane
+{
+  auto normal = normal_.get();
+  for (auto& component : normal) {
+    component = -component;
+  }
+  return Plane{DirectionT{normal}, -offset_};
+}
+
+/// Find which side of the plane a point lies on.
+///
+/// \return  1 if the point is above the plane, -1 if below, 0 if on it.
+///
+template <typename SignedIntT, typename OffsetT>
+template <typename RatT>
+int Plane<SignedIntT, OffsetT>::classify(const Point<RatT, 3>& point) const
+{
+  // Multiplying by the integer components directly keeps a FixedRational's
+  // intermediate products as small as they can be.
+  RatT height(0);
+  for (std::size_t i = 0; i < 3; ++i) {
+    height += point[i] * normal_.get(i);
+  }
+  return sign(height - RatT(offset_));
+}
+
+/// Find which side of the plane each of a group of points lies on.
+///
+/// \return  The sides of the points, in order, as classify() gives them.
+///
+template <typename SignedIntT, typename OffsetT>
+template <typename RatT>
+std::vector<int> Plane<SignedIntT, OffsetT>::classify(
+    const std::vector<Point<RatT, 3>>& points) const
+{
+  std::vector<int> ret;
+  ret.reserve(points.size());
+  for (const auto& point : points) {
+    ret.push_back(classify(point));
+  }
+  return ret;
+}
+
+/// Find which side of the plane each of a group of FixedRational points lies
+/// on.
+///
+/// A FixedRational is its numerator over a common denominator, so each side is
+/// found from one integer dot product of the normal with the numerators,
+/// against the offset scaled by the denominator. Points with numerators too
+/// large for that are classified in FixedRational arithmetic instead.
+///
+template <typename SignedIntT, typename OffsetT>
+template <typename IntT, IntT kDenominator, bool kDoThrowOnInexact>
+std::vector<int> Plane<SignedIntT, OffsetT>::classify(
+    const std::vector<Point<FixedRational<IntT, kDenominator,
+                                kDoThrowOnInexact>,
+        3>>& points) const
+{
+  typedef typename WidenedInt<
+      typename std::conditional<(sizeof(IntT) < sizeof(SignedIntT)),
+          SignedIntT,
+          IntT>::type>::type WideT;
+
+  // Each of the four terms must stay within a quarter of WideT's range.
+  static constexpr WideT kQuarter = std::numeric_limits<WideT>::max() / 4;
+
+  WideT largest_component = 1;
+  for (auto component : normal_.get()) {
+    largest_component = std::max<WideT>(
+        largest_component, component < 0 ? -WideT(component) : component);
+  }
+  WideT bound = kQuarter / largest_component;
+
+  // The offset, as a numerator over the points' denominator.
+  bool is_offset_safe = true;
+  WideT scaled_offset = 0;
+  if constexpr (std::is_integral<OffsetT>::value) {
+    WideT magnitude = offset_ < 0 ? -WideT(offset_) : offset_;
+    is_offset_safe  = magnitude <= kQuarter / kDenominator;
+    if (is_offset_safe) scaled_offset = WideT(offset_) * kDenominator;
+  }
+  else {
+    WideT numerator = FixedRational<IntT, kDenominator, kDoThrowOnInexact>(
+        offset_).numerator();
+    is_offset_safe = -kQuarter <= numerator && numerator <= kQuarter;
+    scaled_offset  = numerator;
+  }
+
+  std::vector<int> ret;
+  ret.reserve(points.size());
+  for (const auto& point : points) {
+    const auto& n = normal_.get();
+    WideT x       = point[0].numerator();
+    WideT y       = point[1].numerator();
+    WideT z       = point[2].numerator();
+
+    if (is_offset_safe && -bound <= x && x <= bound && -bound <= y
+        && y <= bound && -bound <= z && z <= bound) {
+      WideT height = n[0] * x + n[1] * y + n[2] * z - scaled_offset;
+      ret.push_back((0 < height) - (height < 0));
+    }
+    else {
+      ret.push_back(classify(point));
+    }
+  }
+  return ret;
+}
+
+//   Operators
+//  -----------
+
+template <typename SignedIntT, typename OffsetT>
+bool Plane<SignedIntT, OffsetT>::operator==(const Plane& r_op) const
+{
+  return normal_ == r_op.normal_ && offset_ == r_op.offset_;
+}
+
+template <typename SignedIntT, typename OffsetT>
+bool Plane<SignedIntT, OffsetT>::operator!=(const Plane& r_op) const
+{
+  return !(*this == r_op);
+}
+
+/// Tests order of two planes
+///
+/// \note  As with Direction, this is only meant for ordered containers.
+///
+template <typename SignedIntT, typename OffsetT>
+bool Plane<SignedIntT, OffsetT>::operator<(const Plane& r_op) const
+{
+  if (normal_ < r_op.normal_) return true;
+  if (r_op.normal_ < normal_) return false;
+  return offset_ < r_op.offset_;
+}
+
+// Related Functions
+//-------------------
+
+/// Detects if two planes are parallel, facing the same way or not.
+///
+template <typename SignedIntT, typename OffsetT>
+bool are_parallel(const Plane<SignedIntT, OffsetT>& l_op,
+    const Plane<SignedIntT, OffsetT>& r_op)
+{
+  return are_parallel(l_op.normal(), r_op.normal());
+}
+
+/// Detects if two planes hold the same points, facing the same way or not.
+///
+template <typename SignedIntT, typename OffsetT>
+bool are_coincident(const Plane<SignedIntT, OffsetT>& l_op,
+    const Plane<SignedIntT, OffsetT>& r_op)
+{
+  return l_op == r_op || l_op == r_op.flipped();
+}
+
+/// Find the single point where three planes meet.
+///
+/// This is Cramer's rule, with the point's coordinates given in RatT.
+///
+/// \throws  std::domain_error if any two of the planes are parallel, or all
+///          three share a line.
+///
+template <typename RatT, typename SignedIntT, typename OffsetT>
+Point<RatT, 3> intersection_point(const Plane<SignedIntT, OffsetT>& a,
+    const Plane<SignedIntT, OffsetT>& b,
+    const Plane<SignedIntT, OffsetT>& c)
+{
+  auto as_point = [](const Plane<SignedIntT, OffsetT>& plane) {
+    const auto& n = plane.normal().get();
+    return Point<RatT, 3>{RatT(n[0]), RatT(n[1]), RatT(n[2])};
+  };
+  auto a_n = as_point(a);
+  auto b_n = as_point(b);
+  auto c_n = as_point(c);
+
+  auto b_c         = cross(b_n, c_n);
+  auto denominator = dot(a_n, b_c);
+  if (denominator == RatT(0)) {
+    throw std::domain_error("Planes do not meet in a single point");
+  }
+
+  auto numerator = b_c * RatT(a.offset()) + cross(c_n, a_n) * RatT(b.offset())
+                   + cross(a_n, b_n) * RatT(c.offset());
+  for (auto& coordinate : numerator) {
+    coordinate = coordinate / denominator;
+  }
+  return numerator;
+}
+
+template <typename SignedIntT, typename OffsetT>
+std::ostream& operator<<(
+    std::ostream& the_stream, const Plane<SignedIntT, OffsetT>& the_plane)
+{
+  const auto& n = the_plane.normal().get();
+  the_stream << typeid(the_plane).name();
+  the_stream << ":(" << n[0] << ", " << n[1] << ", " << n[2] << "; "
+             << the_plane.offset() << ")";
+  return the_stream;
+}
+
+//-------------------
+// Related Functions
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_PLANE_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -4,7 +4,8 @@
 /// A Point class and its related functions. The class is templatized so that
 /// any rational type may be used for the point coordinates.
 ///
-/// \todo  Make as many functions constexpr as possible.
+/// Everything but stream output is constexpr, so Points of literal coordinate
+/// types (e.g. int) may be built and combined at compile time.
 ///
 /// This code is under the MIT license, please see LICENSE.txt for more
 /// information
@@ -15,6 +16,7 @@
 // Includes
 //----------
 
+#include <algorithm>
 #include <array>
 #include <initializer_list>
 #include <ostream>
@@ -54,18 +56,18 @@ class Point : public std::array<RatT, kDimension>
 {
  protected:
   // CONSTRUCTORS
-  Point(const Point<RatT, kDimension - 1>& smaller_point, RatT last);
+  constexpr Point(const Point<RatT, kDimension - 1>& smaller_point, RatT last);
 
  public:
   // CONSTRUCTORS
-  Point();
-  Point(const std::initializer_list<RatT>& values);
-  explicit Point(const std::array<RatT, kDimension>& values);
+  constexpr Point();
+  constexpr Point(const std::initializer_list<RatT>& values);
+  constexpr explicit Point(const std::array<RatT, kDimension>& values);
 
   // ACCESSORS
-  Point<RatT, kDimension + 1> as_point() const;
-  Point<RatT, kDimension + 1> as_vector() const;
-  Point<RatT, kDimension - 1> as_simpler() const;
+  constexpr Point<RatT, kDimension + 1> as_point() const;
+  constexpr Point<RatT, kDimension + 1> as_vector() const;
+  constexpr Point<RatT, kDimension - 1> as_simpler() const;
 
   // FRIENDS
   friend Point<RatT, kDimension - 1>;
@@ -91,22 +93,27 @@ using Point2D = Point<RatT, 2>;
 /// Creates a Point with kDimension dimensions, with all values at 0.
 ///
 template <typename RatT, size_t kDimension>
-Point<RatT, kDimension>::Point() : std::array<RatT, kDimension>()
+constexpr Point<RatT, kDimension>::Point() : std::array<RatT, kDimension>()
 {
 }
 
 /// Creates a Point with kDimension dimensions, fills with the initializer_list
 ///
 template <typename RatT, size_t kDimension>
-Point<RatT, kDimension>::Point(const std::initializer_list<RatT>& values)
+constexpr Point<RatT, kDimension>::Point(
+    const std::initializer_list<RatT>& values)
     : Point<RatT, kDimension>()
 {
-  std::copy(std::cbegin(values),
-      std::cbegin(values) + std::min(values.size(), kDimension), begin());
+  auto value = std::cbegin(values);
+  for (std::size_t i = 0; i < std::min(values.size(), kDimension);
+       ++i, ++value) {
+    (*this)[i] = *value;
+  }
 }
 
 template <typename RatT, size_t kDimension>
-Point<RatT, kDimension>::Point(const std::array<RatT, kDimension>& values)
+constexpr Point<RatT, kDimension>::Point(
+    const std::array<RatT, kDimension>& values)
     : std::array<RatT, kDimension>(values)
 {
 }
@@ -118,11 +125,14 @@ Point<RatT, kDimension>::Point(const std::array<RatT, kDimension>& values)
 ///         higher dimension.
 ///
 template <typename RatT, size_t kDimension>
-Point<RatT, kDimension>::Point(
+constexpr Point<RatT, kDimension>::Point(
     const Point<RatT, kDimension - 1>& smaller_point, RatT last)
+    : Point<RatT, kDimension>()
 {
-  std::copy(std::begin(smaller_point), std::end(smaller_point), begin());
-  *rbegin() = last;
+  for (std::size_t i = 0; i < kDimension - 1; ++i) {
+    (*this)[i] = smaller_point[i];
+  }
+  (*this)[kDimension - 1] = last;
 }
 
 //   Accessors
@@ -136,7 +146,7 @@ Point<RatT, kDimension>::Point(
 /// location, and not just scale/rotate/skew it.
 ///
 template <typename RatT, size_t kDimension>
-Point<RatT, kDimension + 1> Point<RatT, kDimension>::as_point() const
+constexpr Point<RatT, kDimension + 1> Point<RatT, kDimension>::as_point() const
 {
   return {*this, 1};
 }
@@ -148,7 +158,8 @@ Point<RatT, kDimension + 1> Point<RatT, kDimension>::as_point() const
 /// to be a location, but actually just represents a direction and magnitude.
 ///
 template <typename RatT, size_t kDimension>
-Point<RatT, kDimension + 1> Point<RatT, kDimension>::as_vector() const
+constexpr Point<RatT, kDimension + 1> Point<RatT, kDimension>::as_vector()
+    const
 {
   return {*this, 0};
 }
@@ -161,12 +172,14 @@ Point<RatT, kDimension + 1> Point<RatT, kDimension>::as_vector() const
 /// \return  The Point without its last element.
 ///
 template <typename RatT, size_t kDimension>
-Point<RatT, kDimension - 1> Point<RatT, kDimension>::as_simpler() const
+constexpr Point<RatT, kDimension - 1> Point<RatT, kDimension>::as_simpler()
+    const
 {
   Point<RatT, kDimension - 1> ret;
 
-  using namespace std;
-  std::copy(cbegin(), cend() - 1, std::begin(ret));
+  for (std::size_t i = 0; i < kDimension - 1; ++i) {
+    ret[i] = (*this)[i];
+  }
 
   return ret;
 }
@@ -184,20 +197,24 @@ Point<RatT, kDimension - 1> Point<RatT, kDimension>::as_simpler() const
 /// <i>approximate</i> equality due to rounding errors.
 ///
 template <typename RatT_l, typename RatT_r, std::size_t kDimension>
-bool operator==(const Point<RatT_l, kDimension>& l_op,
+constexpr bool operator==(const Point<RatT_l, kDimension>& l_op,
     const Point<RatT_r, kDimension>& r_op)
 {
   // note: std::array comparison with its built-in operator= requires the types
   // contained to be the same. It's fine with me if they're different if they
   // really do compare equal. Hence this over-complex reimplimentation.
-  using namespace std;
-  return equal(cbegin(l_op), cend(l_op), cbegin(r_op));
+  for (std::size_t i = 0; i < kDimension; ++i) {
+    if (!(l_op[i] == r_op[i])) {
+      return false;
+    }
+  }
+  return true;
 }
 
 /// Test for inequality
 ///
 template <typename RatT_l, typename RatT_r, std::size_t kDimension>
-bool operator!=(const Point<RatT_l, kDimension>& l_op,
+constexpr bool operator!=(const Point<RatT_l, kDimension>& l_op,
     const Point<RatT_r, kDimension>& r_op)
 {
   return !(l_op == r_op);
@@ -210,31 +227,37 @@ bool operator!=(const Point<RatT_l, kDimension>& l_op,
 /// Don't use it for any other kind of point comparison.
 ///
 template <typename RatT_l, typename RatT_r, std::size_t kDimension>
-bool operator<(const Point<RatT_l, kDimension>& l_op,
+constexpr bool operator<(const Point<RatT_l, kDimension>& l_op,
     const Point<RatT_r, kDimension>& r_op)
 {
   // see note in operator==. Find it by searching "over-complex".
-  using namespace std;
-  return lexicographical_compare(
-      cbegin(l_op), cend(l_op), cbegin(r_op), cend(r_op));
+  for (std::size_t i = 0; i < kDimension; ++i) {
+    if (l_op[i] < r_op[i]) {
+      return true;
+    }
+    if (r_op[i] < l_op[i]) {
+      return false;
+    }
+  }
+  return false;
 }
 
 template <typename RatT_l, typename RatT_r, std::size_t kDimension>
-bool operator<=(const Point<RatT_l, kDimension>& l_op,
+constexpr bool operator<=(const Point<RatT_l, kDimension>& l_op,
     const Point<RatT_r, kDimension>& r_op)
 {
   return !(r_op < l_op);
 }
 
 template <typename RatT_l, typename RatT_r, std::size_t kDimension>
-bool operator>(const Point<RatT_l, kDimension>& l_op,
+constexpr bool operator>(const Point<RatT_l, kDimension>& l_op,
     const Point<RatT_r, kDimension>& r_op)
 {
   return r_op < l_op;
 }
 
 template <typename RatT_l, typename RatT_r, std::size_t kDimension>
-bool operator>=(const Point<RatT_l, kDimension>& l_op,
+constexpr bool operator>=(const Point<RatT_l, kDimension>& l_op,
     const Point<RatT_r, kDimension>& r_op)
 {
   return !(l_op < r_op);
@@ -246,7 +269,7 @@ bool operator>=(const Point<RatT_l, kDimension>& l_op,
 /// Add two vectors
 ///
 template <typename RatT_l, typename RatT_r, std::size_t kDimension>
-auto operator+(const Point<RatT_l, kDimension>& l_op,
+constexpr auto operator+(const Point<RatT_l, kDimension>& l_op,
     const Point<RatT_r, kDimension>& r_op)
 {
   using std::declval;
@@ -258,10 +281,28 @@ auto operator+(const Point<RatT_l, kDimension>& l_op,
   return ret;
 }
 
+/// Subtract one vector from another.
+///
+/// For two locations, this is the vector from r_op to l_op.
+///
+template <typename RatT_l, typename RatT_r, std::size_t kDimension>
+constexpr auto operator-(const Point<RatT_l, kDimension>& l_op,
+    const Point<RatT_r, kDimension>& r_op)
+{
+  using std::declval;
+  Point<decltype(declval<RatT_l>() - declval<RatT_r>()), kDimension> ret;
+
+  for (std::size_t i = 0; i < kDimension; ++i) {
+    ret[i] = l_op[i] - r_op[i];
+  }
+  return ret;
+}
+
 /// Scale a vector by a scalar.
 ///
 template <typename RatT_l, typename RatT_r, std::size_t kDimension>
-auto operator*(const Point<RatT_l, kDimension>& l_op, const RatT_r& r_op)
+constexpr auto operator*(
+    const Point<RatT_l, kDimension>& l_op, const RatT_r& r_op)
 {
   using std::declval;
   Point<decltype(declval<RatT_l>() * r_op), kDimension> ret;
@@ -275,7 +316,7 @@ auto operator*(const Point<RatT_l, kDimension>& l_op, const RatT_r& r_op)
 /// Scale a vector by a scalar.
 ///
 template <typename RatT_l, typename RatT_r, std::size_t kDimension>
-auto operator*(RatT_l l_op, const Point<RatT_r, kDimension>& r_op)
+constexpr auto operator*(RatT_l l_op, const Point<RatT_r, kDimension>& r_op)
 {
   // commutative
   return r_op * l_op;
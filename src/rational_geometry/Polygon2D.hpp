@@ -0,0 +1,571 @@
+/// \file    Polygon2D.hpp
+/// \author  Tim Holt
+///
+/// A polygon class (possibly with holes and several pieces), and exact boolean
+/// operations between polygons.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_POLYGON2D_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_POLYGON2D_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "Point.hpp"
+#include "predicates.hpp"
+#include "segment_intersections.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <initializer_list>
+#include <map>
+#include <ostream>
+#include <set>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Class Template Declaration
+//----------------------------
+
+/// \brief  A region of the plane bounded by any number of closed rings of
+///         rational points.
+///
+/// A point is inside the polygon if a ray from it crosses the rings an odd
+/// number of times (the even-odd rule), so holes are simply rings lying inside
+/// other rings, whatever their winding. Rings are implicitly closed: the last
+/// point connects back to the first.
+///
+/// Polygons produced by the boolean operations below have counter-clockwise
+/// outer rings and clockwise holes, no two rings crossing, no collinear
+/// vertices, each ring starting at its least point, and rings in order.
+///
+template <typename RatT>
+class Polygon2D
+{
+ public:
+  // TYPES
+  typedef Point<RatT, 2> PointT;
+  typedef std::vector<PointT> RingT;
+
+ protected:
+  // INTERNAL STATE
+  std::vector<RingT> rings_;
+
+ public:
+  // CONSTRUCTORS
+  Polygon2D();
+  Polygon2D(std::initializer_list<RingT> rings);
+  explicit Polygon2D(std::vector<RingT> rings);
+
+  // ACCESSORS
+  const std::vector<RingT>& rings() const;
+  bool empty() const;
+  size_t vertex_count() const;
+
+  RatT signed_area() const;
+
+  // MUTATORS
+  Polygon2D& add_ring(RingT ring);
+};
+
+/// The boolean operations that can be performed between two Polygon2Ds.
+///
+enum class BooleanOperation
+{
+  kUnion,
+  kIntersection,
+  kDifference,
+  kSymmetricDifference
+};
+
+// Class Template Definitions
+//----------------------------
+//   Constructors
+//  --------------
+
+/// Creates an empty polygon.
+///
+template <typename RatT>
+Polygon2D<RatT>::Polygon2D()
+{
+}
+
+template <typename RatT>
+Polygon2D<RatT>::Polygon2D(std::initializer_list<RingT> rings)
+    : rings_(rings)
+{
+}
+
+template <typename RatT>
+Polygon2D<RatT>::Polygon2D(std::vector<RingT> rings)
+    : rings_(std::move(rings))
+{
+}
+
+//   Accessors
+//  -----------
+
+template <typename RatT>
+auto Polygon2D<RatT>::rings() const -> const std::vector<RingT>&
+{
+  return rings_;
+}
+
+template <typename RatT>
+bool Polygon2D<RatT>::empty() const
+{
+  return rings_.empty();
+}
+
+template <typename RatT>
+size_t Polygon2D<RatT>::vertex_count() const
+{
+  size_t ret = 0;
+  for (const auto& ring : rings_) {
+    ret += ring.size();
+  }
+  return ret;
+}
+
+/// Get the sum of the rings' signed areas (positive when counter-clockwise).
+///
+/// For polygons produced by the boolean operations, this is the area.
+///
+template <typename RatT>
+RatT Polygon2D<RatT>::signed_area() const
+{
+  RatT twice_area(0);
+  for (const auto& ring : rings_) {
+    for (size_t i = 0; i < ring.size(); ++i) {
+      const auto& current = ring[i];
+      const auto& next    = ring[(i + 1) % ring.size()];
+      twice_area += current[0] * next[1] - current[1] * next[0];
+    }
+  }
+  return twice_area / RatT(2);
+}
+
+//   Mutators
+//  ----------
+
+template <typename RatT>
+Polygon2D<RatT>& Polygon2D<RatT>::add_ring(RingT ring)
+{
+  rings_.push_back(std::move(ring));
+  return *this;
+}
+
+// Boolean Operation Helpers
+//---------------------------
+
+/// \brief  A boundary segment, ordered left (lexicographically least) to right,
+///         as used by boolean_operation().
+///
+template <typename RatT>
+struct PolygonSegment
+{
+  Point<RatT, 2> left_;
+  Point<RatT, 2> right_;
+
+  /// Whether the segment bounds each operand an odd number of times.
+  std::array<bool, 2> parity_;
+
+  /// Whether the region just below the segment is inside each operand.
+  std::array<bool, 2> inside_below_;
+};
+
+/// Collect both operands' edges as segments, dropping degenerate ones.
+///
+template <typename RatT>
+std::vector<PolygonSegment<RatT>> collect_segments(
+    const Polygon2D<RatT>& l_op, const Polygon2D<RatT>& r_op)
+{
+  std::vector<PolygonSegment<RatT>> ret;
+
+  const Polygon2D<RatT>* operands[] = {&l_op, &r_op};
+  for (size_t owner = 0; owner < 2; ++owner) {
+    for (const auto& ring : operands[owner]->rings()) {
+      for (size_t i = 0; i < ring.size(); ++i) {
+        auto start = ring[i];
+        auto end   = ring[(i + 1) % ring.size()];
+        if (start == end) continue;
+        if (end < start) std::swap(start, end);
+
+        PolygonSegment<RatT> segment{start, end, {{false, false}}, {}};
+        segment.parity_[owner] = true;
+        ret.push_back(segment);
+      }
+    }
+  }
+
+  return ret;
+}
+
+/// Split segments wherever they meet, so that none cross or partly overlap.
+///
+/// The meeting points are found by segment_intersections()'s sweep, which
+/// reports each with every segment through it.
+///
+/// \throws  unrepresentable_operation_error if RatT is a FixedRational that
+///          cannot represent a crossing point.
+///
+template <typename RatT>
+std::vector<PolygonSegment<RatT>> split_segments(
+    std::vector<PolygonSegment<RatT>> segments)
+{
+  using namespace std;
+
+  vector<array<Point<RatT, 2>, 2>> ends;
+  ends.reserve(segments.size());
+  for (const auto& segment : segments) {
+    ends.push_back({{segment.left_, segment.right_}});
+  }
+
+  vector<vector<Point<RatT, 2>>> splits(segments.size());
+  for (const auto& crossing : segment_intersections(move(ends))) {
+    for (auto i : crossing.segments_) {
+      const auto& segment = segments[i];
+      if (segment.left_ < crossing.point_ && crossing.point_ < segment.right_) {
+        splits[i].push_back(crossing.point_);
+      }
+    }
+  }
+
+  vector<PolygonSegment<RatT>> ret;
+  for (size_t i = 0; i < segments.size(); ++i) {
+    auto& points = splits[i];
+    points.push_back(segments[i].left_);
+    points.push_back(segments[i].right_);
+    sort(begin(points), end(points));
+    points.erase(unique(begin(points), end(points)), end(points));
+
+    for (size_t j = 0; j + 1 < points.size(); ++j) {
+      ret.push_back(
+          {points[j], points[j + 1], segments[i].parity_, {{false, false}}});
+    }
+  }
+
+  return ret;
+}
+
+/// Combine coincident segments, dropping any that bound neither operand.
+///
+template <typename RatT>
+std::vector<PolygonSegment<RatT>> merge_segments(
+    std::vector<PolygonSegment<RatT>> segments)
+{
+  using namespace std;
+
+  auto key = [](const PolygonSegment<RatT>& segment) {
+    return make_pair(segment.left_, segment.right_);
+  };
+  sort(begin(segments), end(segments),
+      [&key](const PolygonSegment<RatT>& l_op,
+          const PolygonSegment<RatT>& r_op) { return key(l_op) < key(r_op); });
+
+  vector<PolygonSegment<RatT>> ret;
+  for (const auto& segment : segments) {
+    if (!ret.empty() && key(ret.back()) == key(segment)) {
+      ret.back().parity_[0] = ret.back().parity_[0] != segment.parity_[0];
+      ret.back().parity_[1] = ret.back().parity_[1] != segment.parity_[1];
+    }
+    else {
+      ret.push_back(segment);
+    }
+  }
+
+  ret.erase(remove_if(begin(ret), end(ret),
+                [](const PolygonSegment<RatT>& segment) {
+                  return !segment.parity_[0] && !segment.parity_[1];
+                }),
+      end(ret));
+  return ret;
+}
+
+/// \brief  Sweep a vertical line across non-crossing segments, finding which
+///         operands the region just below each one lies within.
+///
+/// The status structure holds the segments under the sweep line, bottom to
+/// top. A segment's region below is the region above its lower neighbour when
+/// it is inserted.
+///
+template <typename RatT>
+void classify_segments(std::vector<PolygonSegment<RatT>>& segments)
+{
+  using namespace std;
+
+  auto is_below = [&segments](size_t l_op, size_t r_op) {
+    if (l_op == r_op) return false;
+    const auto& s = segments[l_op];
+    const auto& t = segments[r_op];
+
+    if (s.left_ == t.left_) {
+      return orient2d(s.left_, s.right_, t.right_) > 0;
+    }
+    if (s.left_ < t.left_) {
+      int side = orient2d(s.left_, s.right_, t.left_);
+      return side != 0 ? side > 0 : orient2d(s.left_, s.right_, t.right_) > 0;
+    }
+    int side = orient2d(t.left_, t.right_, s.left_);
+    return side != 0 ? side < 0 : orient2d(t.left_, t.right_, s.right_) < 0;
+  };
+
+  // Events are (segment, is_left). At a point, right ends come before left
+  // ends, and left ends go from bottom to top.
+  vector<pair<size_t, bool>> events;
+  for (size_t i = 0; i < segments.size(); ++i) {
+    events.emplace_back(i, true);
+    events.emplace_back(i, false);
+  }
+  auto event_point = [&segments](const pair<size_t, bool>& event) {
+    const auto& segment = segments[event.first];
+    return event.second ? segment.left_ : segment.right_;
+  };
+  sort(begin(events), end(events),
+      [&](const pair<size_t, bool>& l_op, const pair<size_t, bool>& r_op) {
+        const auto& l_point = event_point(l_op);
+        const auto& r_point = event_point(r_op);
+        if (l_point != r_point) return l_point < r_point;
+        if (l_op.second != r_op.second) return r_op.second;
+        return l_op.second && is_below(l_op.first, r_op.first);
+      });
+
+  set<size_t, decltype(is_below)> status(is_below);
+  vector<typename set<size_t, decltype(is_below)>::iterator> positions(
+      segments.size());
+
+  for (const auto& event : events) {
+    auto index = event.first;
+    if (!event.second) {
+      status.erase(positions[index]);
+      continue;
+    }
+
+    auto position    = status.insert(index).first;
+    positions[index] = position;
+
+    auto& segment = segments[index];
+    if (position == cbegin(status)) {
+      segment.inside_below_ = {{false, false}};
+    }
+    else {
+      const auto& below = segments[*prev(position)];
+      for (size_t owner = 0; owner < 2; ++owner) {
+        segment.inside_below_[owner] =
+            below.inside_below_[owner] != below.parity_[owner];
+      }
+    }
+  }
+}
+
+/// \brief  Choose, from the outgoing directions at a vertex, the first one
+///         clockwise from a reference direction.
+///
+/// \return  Whether l_op comes before r_op, turning clockwise from reference.
+///
+template <typename RatT>
+bool precedes_clockwise(const Point<RatT, 2>& reference,
+    const Point<RatT, 2>& l_op,
+    const Point<RatT, 2>& r_op)
+{
+  const Point<RatT, 2> origin{};
+
+  // 0 for directions at most a half turn clockwise, 1 for the rest.
+  auto half = [&](const Point<RatT, 2>& direction) {
+    int side = orient2d(origin, reference, direction);
+    if (side != 0) return side < 0 ? 0 : 1;
+    bool is_opposite = sign(reference[0]) == -sign(direction[0])
+                       && sign(reference[1]) == -sign(direction[1]);
+    return is_opposite ? 0 : 1;
+  };
+
+  int l_half = half(l_op);
+  int r_half = half(r_op);
+  if (l_half != r_half) return l_half < r_half;
+  return orient2d(origin, l_op, r_op) < 0;
+}
+
+/// Link directed boundary edges into rings, each with its inside on the left.
+///
+template <typename RatT>
+std::vector<std::vector<Point<RatT, 2>>> trace_rings(
+    const std::vector<std::pair<Point<RatT, 2>, Point<RatT, 2>>>& edges)
+{
+  using namespace std;
+
+  map<Point<RatT, 2>, vector<size_t>> outgoing;
+  for (size_t i = 0; i < edges.size(); ++i) {
+    outgoing[edges[i].first].push_back(i);
+  }
+
+  vector<bool> is_used(edges.size(), false);
+  vector<vector<Point<RatT, 2>>> ret;
+
+  for (size_t first = 0; first < edges.size(); ++first) {
+    if (is_used[first]) continue;
+
+    vector<Point<RatT, 2>> ring;
+    auto current = first;
+    do {
+      assert(!is_used[current]);
+      is_used[current] = true;
+      ring.push_back(edges[current].first);
+
+      // Keep the inside on the left by taking the sharpest left turn, i.e.
+      // the first outgoing edge clockwise from the way back.
+      const auto& vertex   = edges[current].second;
+      const auto reference = edges[current].first - vertex;
+      const auto& choices  = outgoing[vertex];
+
+      current = *min_element(cbegin(choices), cend(choices),
+          [&](size_t l_op, size_t r_op) {
+            return precedes_clockwise(reference, edges[l_op].second - vertex,
+                edges[r_op].second - vertex);
+          });
+    } while (current != first);
+
+    // Remove the vertices left over from splitting collinear edges.
+    for (size_t i = 0; ring.size() > 3 && i < ring.size();) {
+      const auto& before = ring[(i + ring.size() - 1) % ring.size()];
+      const auto& after  = ring[(i + 1) % ring.size()];
+      if (orient2d(before, ring[i], after) == 0) {
+        ring.erase(begin(ring) + i);
+      }
+      else {
+        ++i;
+      }
+    }
+
+    rotate(begin(ring), min_element(begin(ring), end(ring)), end(ring));
+    ret.push_back(move(ring));
+  }
+
+  sort(begin(ret), end(ret));
+  return ret;
+}
+
+// Related Functions
+//-------------------
+
+/// Perform an exact boolean operation between two polygons.
+///
+/// Every edge is split at every point where it meets another, coincident pieces
+/// are merged, and then a sweep line finds which side of each piece lies within
+/// each operand. The pieces whose sides differ in the result are its boundary.
+/// Overlapping edges, shared vertices and other degenerate configurations are
+/// all resolved exactly.
+///
+/// \throws  unrepresentable_operation_error if RatT is a FixedRational that
+///          cannot represent an edge crossing point or an orientation.
+///
+template <typename RatT>
+Polygon2D<RatT> boolean_operation(const Polygon2D<RatT>& l_op,
+    const Polygon2D<RatT>& r_op,
+    BooleanOperation operation)
+{
+  auto segments =
+      merge_segments(split_segments(collect_segments(l_op, r_op)));
+  classify_segments(segments);
+
+  auto is_inside = [operation](bool in_l_op, bool in_r_op) {
+    switch (operation) {
+      case BooleanOperation::kUnion: return in_l_op || in_r_op;
+      case BooleanOperation::kIntersection: return in_l_op && in_r_op;
+      case BooleanOperation::kDifference: return in_l_op && !in_r_op;
+      case BooleanOperation::kSymmetricDifference: return in_l_op != in_r_op;
+    }
+    return false;
+  };
+
+  std::vector<std::pair<Point<RatT, 2>, Point<RatT, 2>>> edges;
+  for (const auto& segment : segments) {
+    const auto& below = segment.inside_below_;
+    bool is_inside_below = is_inside(below[0], below[1]);
+    bool is_inside_above = is_inside(
+        below[0] != segment.parity_[0], below[1] != segment.parity_[1]);
+
+    if (is_inside_above && !is_inside_below) {
+      edges.emplace_back(segment.left_, segment.right_);
+    }
+    else if (is_inside_below && !is_inside_above) {
+      edges.emplace_back(segment.right_, segment.left_);
+    }
+  }
+
+  return Polygon2D<RatT>(trace_rings(edges));
+}
+
+template <typename RatT>
+Polygon2D<RatT> operator|(
+    const Polygon2D<RatT>& l_op, const Polygon2D<RatT>& r_op)
+{
+  return boolean_operation(l_op, r_op, BooleanOperation::kUnion);
+}
+
+template <typename RatT>
+Polygon2D<RatT> operator&(
+    const Polygon2D<RatT>& l_op, const Polygon2D<RatT>& r_op)
+{
+  return boolean_operation(l_op, r_op, BooleanOperation::kIntersection);
+}
+
+template <typename RatT>
+Polygon2D<RatT> operator-(
+    const Polygon2D<RatT>& l_op, const Polygon2D<RatT>& r_op)
+{
+  return boolean_operation(l_op, r_op, BooleanOperation::kDifference);
+}
+
+template <typename RatT>
+Polygon2D<RatT> operator^(
+    const Polygon2D<RatT>& l_op, const Polygon2D<RatT>& r_op)
+{
+  return boolean_operation(l_op, r_op, BooleanOperation::kSymmetricDifference);
+}
+
+template <typename RatT>
+bool operator==(const Polygon2D<RatT>& l_op, const Polygon2D<RatT>& r_op)
+{
+  return l_op.rings() == r_op.rings();
+}
+
+template <typename RatT>
+bool operator!=(const Polygon2D<RatT>& l_op, const Polygon2D<RatT>& r_op)
+{
+  return !(l_op == r_op);
+}
+
+template <typename RatT>
+std::ostream& operator<<(
+    std::ostream& the_stream, const Polygon2D<RatT>& the_polygon)
+{
+  the_stream << typeid(the_polygon).name();
+  the_stream << ":[\n";
+  for (const auto& ring : the_polygon.rings()) {
+    the_stream << " (";
+    for (const auto& point : ring) {
+      the_stream << "(" << point[0] << ", " << point[1] << "), ";
+    }
+    the_stream << ")\n";
+  }
+  the_stream << "]";
+  return the_stream;
+}
+
+//-------------------
+// Related Functions
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_POLYGON2D_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
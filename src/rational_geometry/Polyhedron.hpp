@@ -0,0 +1,580 @@
+/// \file    Polyhedron.hpp
+/// \author  Tim Holt
+///
+/// A closed polyhedron class, and exact boolean operations between
+/// polyhedra.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_POLYHEDRON_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_POLYHEDRON_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "BoundingVolumeHierarchy.hpp"
+#include "BspTree.hpp"
+#include "Direction.hpp"
+#include "Operations.hpp"
+#include "Point.hpp"
+#include "Polygon2D.hpp"
+#include "predicates.hpp"
+
+#include <algorithm>
+#include <array>
+#include <future>
+#include <map>
+#include <ostream>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Class Template Declaration
+//----------------------------
+
+/// \brief  A closed surface of planar faces, whose vertices are Point3Ds of
+///         rational coordinates.
+///
+/// Each face is a list of rings of vertex indices, all in one plane. As with
+/// Polygon2D, the rings bound the face by the even-odd rule, so a face may have
+/// holes. The first ring winds counter-clockwise when seen from outside, which
+/// gives the face's outward normal.
+///
+/// Polyhedra produced by the boolean operations below have exactly one face
+/// per plane and facing, with clockwise holes, no collinear vertices, and
+/// their vertices and faces in order.
+///
+/// \note  Merging collinear vertices can leave T-junctions, where one face's
+///        vertex lies along an edge of its neighbour.
+///
+template <typename RatT>
+class Polyhedron
+{
+ public:
+  // TYPES
+  typedef Point<RatT, 3> PointT;
+  typedef std::vector<std::vector<size_t>> FaceT;
+
+ protected:
+  // INTERNAL STATE
+  std::vector<PointT> vertices_;
+  std::vector<FaceT> faces_;
+
+ public:
+  // CONSTRUCTORS
+  Polyhedron();
+  Polyhedron(std::vector<PointT> vertices, std::vector<FaceT> faces);
+
+  // ACCESSORS
+  const std::vector<PointT>& vertices() const;
+  const std::vector<FaceT>& faces() const;
+  bool empty() const;
+
+  PointT face_normal(size_t face) const;
+  RatT signed_volume() const;
+};
+
+// Class Template Definitions
+//----------------------------
+//   Constructors
+//  --------------
+
+/// Creates an empty polyhedron.
+///
+template <typename RatT>
+Polyhedron<RatT>::Polyhedron()
+{
+}
+
+template <typename RatT>
+Polyhedron<RatT>::Polyhedron(
+    std::vector<PointT> vertices, std::vector<FaceT> faces)
+    : vertices_(std::move(vertices)), faces_(std::move(faces))
+{
+}
+
+//   Accessors
+//  -----------
+
+template <typename RatT>
+auto Polyhedron<RatT>::vertices() const -> const std::vector<PointT>&
+{
+  return vertices_;
+}
+
+template <typename RatT>
+auto Polyhedron<RatT>::faces() const -> const std::vector<FaceT>&
+{
+  return faces_;
+}
+
+template <typename RatT>
+bool Polyhedron<RatT>::empty() const
+{
+  return faces_.empty();
+}
+
+/// Get a vector normal to a face, pointing outward.
+///
+/// This is found by Newell's method over the face's first ring, so it is exact
+/// (and non-zero) even for non-convex faces. Its length is twice the ring's
+/// area.
+///
+/// The sum is taken over the vertices' numerators, as integers, so only the
+/// normal itself need be representable.
+///
+template <typename RatT>
+auto Polyhedron<RatT>::face_normal(size_t face) const -> PointT
+{
+  auto newell = scaled_newell_normal(vertices_, faces_[face].front());
+  typedef typename std::decay<decltype(newell[0])>::type WideT;
+
+  // The sum is scaled by the square of the common denominator.
+  const WideT denominator(numerator_of(RatT(1)));
+
+  PointT ret;
+  for (size_t i = 0; i < 3; ++i) {
+    ret[i] = from_numerator_ratio<RatT>(newell[i], denominator);
+  }
+  return ret;
+}
+
+/// Get the enclosed volume, which is negative if the faces point inward.
+///
+template <typename RatT>
+RatT Polyhedron<RatT>::signed_volume() const
+{
+  RatT six_times_volume(0);
+  for (const auto& face : faces_) {
+    for (const auto& ring : face) {
+      const auto& first = vertices_[ring.front()];
+      for (size_t i = 1; i + 1 < ring.size(); ++i) {
+        six_times_volume +=
+            dot(first, cross(vertices_[ring[i]], vertices_[ring[i + 1]]));
+      }
+    }
+  }
+  return six_times_volume / RatT(6);
+}
+
+// Related Functions
+//-------------------
+
+/// Make an axis-aligned box between two opposite corners.
+///
+template <typename RatT>
+Polyhedron<RatT> make_box(
+    const Point<RatT, 3>& lower, const Point<RatT, 3>& upper)
+{
+  std::vector<Point<RatT, 3>> vertices;
+  for (size_t i = 0; i < 8; ++i) {
+    vertices.push_back(Point<RatT, 3>{(i & 1) ? upper[0] : lower[0],
+        (i & 2) ? upper[1] : lower[1], (i & 4) ? upper[2] : lower[2]});
+  }
+
+  // clang-format off
+  std::vector<typename Polyhedron<RatT>::FaceT> faces{
+      {{0, 4, 6, 2}}, {{1, 3, 7, 5}},
+      {{0, 1, 5, 4}}, {{2, 6, 7, 3}},
+      {{0, 2, 3, 1}}, {{4, 5, 7, 6}}};
+  // clang-format on
+
+  return Polyhedron<RatT>{vertices, faces};
+}
+
+// Boolean Operation Helpers
+//---------------------------
+
+/// Break a polyhedron's faces into regions.
+///
+/// Each face's plane is found by Newell's method over its vertices'
+/// numerators, in integers wide enough for every product, and reduced to
+/// lowest terms before it is narrowed, so no rational product is ever needed.
+///
+/// \throws  std::overflow_error if a reduced normal's components, or a
+///          plane's offset, are beyond the range of RatT's numerators.
+///
+template <typename RatT>
+std::vector<PlanarRegion<RatT>> regions_of(const Polyhedron<RatT>& polyhedron)
+{
+  typedef typename NumeratorType<RatT>::type IntT;
+  typedef typename WidenedInt<IntT>::type WideT;
+
+  const auto& vertices = polyhedron.vertices();
+  std::vector<PlanarRegion<RatT>> ret;
+
+  for (const auto& rings : polyhedron.faces()) {
+    auto normal =
+        reduced_direction<IntT>(scaled_newell_normal(vertices, rings.front()));
+    if (normal == Direction<IntT, 3>{}) continue;
+
+    // The offset, over the first vertex's numerators.
+    const auto& first = vertices[rings.front().front()];
+    WideT offset(0);
+    for (size_t i = 0; i < 3; ++i) {
+      offset += WideT(normal.get(i)) * WideT(numerator_of(first[i]));
+    }
+    RegionPlane<RatT> plane{
+        normal, from_numerator<RatT>(narrowed<IntT>(offset))};
+    auto axis = dominant_axis(plane);
+
+    Polygon2D<RatT> projected;
+    for (const auto& ring : rings) {
+      typename Polygon2D<RatT>::RingT projected_ring;
+      for (auto vertex : ring) {
+        projected_ring.push_back(project(vertices[vertex], axis));
+      }
+      projected.add_ring(projected_ring);
+    }
+
+    ret.push_back(make_region(plane, projected));
+  }
+
+  return ret;
+}
+
+/// Get the bounding boxes of those of a polyhedron's faces that meet a box.
+///
+template <typename RatT>
+std::vector<AABB<RatT, 3>> face_boxes(
+    const Polyhedron<RatT>& polyhedron, const AABB<RatT, 3>& within)
+{
+  std::vector<AABB<RatT, 3>> ret;
+  for (const auto& rings : polyhedron.faces()) {
+    AABB<RatT, 3> box;
+    for (auto vertex : rings.front()) {
+      box.extend(polyhedron.vertices()[vertex]);
+    }
+    if (box.overlaps(within)) ret.push_back(box);
+  }
+  return ret;
+}
+
+/// \brief  Determine, for each of some regions clear of a solid's surface,
+///         whether it lies inside the solid.
+///
+/// A region clear of the surface lies wholly on one side of it, as do any
+/// regions connected to it through shared vertices. So only one region of
+/// each connected group is clipped against the solid's tree, and the rest
+/// follow it.
+///
+template <typename RatT>
+std::vector<bool> are_inside(
+    const std::vector<PlanarRegion<RatT>>& regions, const BspTree<RatT>& tree)
+{
+  using namespace std;
+
+  vector<size_t> parents(regions.size());
+  for (size_t i = 0; i < regions.size(); ++i) {
+    parents[i] = i;
+  }
+  auto root = [&parents](size_t i) {
+    while (parents[i] != i) {
+      parents[i] = parents[parents[i]];
+      i          = parents[i];
+    }
+    return i;
+  };
+
+  map<Point<RatT, 3>, size_t> owners;
+  for (size_t i = 0; i < regions.size(); ++i) {
+    for (const auto& ring : regions[i].region_.rings()) {
+      for (const auto& point : ring) {
+        auto found = owners.emplace(lift(regions[i], point), i).first;
+        parents[root(found->second)] = root(i);
+      }
+    }
+  }
+
+  vector<bool> ret(regions.size());
+  map<size_t, bool> group_is_inside;
+  for (size_t i = 0; i < regions.size(); ++i) {
+    auto group = group_is_inside.find(root(i));
+    if (group == end(group_is_inside)) {
+      group = group_is_inside
+                  .emplace(root(i), tree.clip_regions({regions[i]}).empty())
+                  .first;
+    }
+    ret[i] = group->second;
+  }
+  return ret;
+}
+
+/// \brief  Add an operand's regions, found clear of the other operand's
+///         surface, to the result of a boolean operation.
+///
+/// Each is kept, or dropped, or kept turned inside out, just as clipping it by
+/// the csg.js scheme of boolean_operation() would, but whole.
+///
+template <typename RatT>
+void add_clear_regions(std::vector<PlanarRegion<RatT>> regions,
+    const std::vector<bool>& is_inside,
+    BooleanOperation operation,
+    bool is_left_operand,
+    std::vector<PlanarRegion<RatT>>& result)
+{
+  for (size_t i = 0; i < regions.size(); ++i) {
+    bool is_kept    = true;
+    bool is_flipped = false;
+    switch (operation) {
+      case BooleanOperation::kUnion:
+        is_kept = !is_inside[i];
+        break;
+      case BooleanOperation::kIntersection:
+        is_kept = is_inside[i];
+        break;
+      case BooleanOperation::kDifference:
+        is_kept    = is_left_operand != is_inside[i];
+        is_flipped = !is_left_operand;
+        break;
+      case BooleanOperation::kSymmetricDifference:
+      default:
+        is_flipped = is_inside[i];
+        break;
+    }
+
+    if (!is_kept) continue;
+    if (is_flipped) flip(regions[i]);
+    result.push_back(std::move(regions[i]));
+  }
+}
+
+/// Merge coplanar regions, and gather them into a polyhedron.
+///
+template <typename RatT>
+Polyhedron<RatT> polyhedron_of(const std::vector<PlanarRegion<RatT>>& regions)
+{
+  using namespace std;
+
+  // Planes are canonical, so regions sharing a plane and facing share a key.
+  map<RegionPlane<RatT>, vector<size_t>> groups;
+  for (size_t i = 0; i < regions.size(); ++i) {
+    groups[regions[i].plane_].push_back(i);
+  }
+
+  typedef vector<vector<Point<RatT, 3>>> PointFaceT;
+  vector<PointFaceT> point_faces;
+
+  for (const auto& group : groups) {
+    const auto& members = group.second;
+
+    // The pieces of one plane and facing never overlap, so together, by the
+    // even-odd rule, they cover just their union; one pass merges them all.
+    Polygon2D<RatT> pieces;
+    for (auto member : members) {
+      for (const auto& ring : regions[member].region_.rings()) {
+        pieces.add_ring(ring);
+      }
+    }
+    auto face_region = pieces | Polygon2D<RatT>{};
+    if (face_region.empty()) continue;
+
+    const auto& representative = regions[members.front()];
+    bool is_reversed =
+        representative.plane_.normal().get(representative.axis_) < 0;
+
+    // The first ring holds the least point, so it is outer and gives the
+    // face's normal.
+    PointFaceT face;
+    for (const auto& ring : face_region.rings()) {
+      vector<Point<RatT, 3>> lifted;
+      for (const auto& point : ring) {
+        lifted.push_back(lift(representative, point));
+      }
+      // Reverse around the first vertex, keeping the ring's start.
+      if (is_reversed) reverse(next(begin(lifted)), end(lifted));
+      face.push_back(move(lifted));
+    }
+    point_faces.push_back(move(face));
+  }
+
+  // Put vertices and faces in order, so that equal polyhedra compare equal.
+  sort(begin(point_faces), end(point_faces));
+
+  vector<Point<RatT, 3>> vertices;
+  for (const auto& face : point_faces) {
+    for (const auto& ring : face) {
+      vertices.insert(end(vertices), begin(ring), end(ring));
+    }
+  }
+  sort(begin(vertices), end(vertices));
+  vertices.erase(unique(begin(vertices), end(vertices)), end(vertices));
+
+  vector<typename Polyhedron<RatT>::FaceT> faces;
+  for (const auto& face : point_faces) {
+    typename Polyhedron<RatT>::FaceT indexed;
+    for (const auto& ring : face) {
+      vector<size_t> indices;
+      for (const auto& point : ring) {
+        indices.push_back(static_cast<size_t>(
+            lower_bound(begin(vertices), end(vertices), point)
+            - begin(vertices)));
+      }
+      indexed.push_back(move(indices));
+    }
+    faces.push_back(move(indexed));
+  }
+
+  return Polyhedron<RatT>{vertices, faces};
+}
+
+/// Perform an exact boolean operation between two closed polyhedra.
+///
+/// Each operand's surface is clipped against a BspTree of the other, with
+/// faces kept as planar Polygon2D regions so that every split is exact and
+/// faces may be non-convex or have holes. Finally, coplanar pieces are merged
+/// back together.
+///
+/// Only faces near the other operand's surface need clipping. Those beyond its
+/// bounds are passed over by the trees themselves; within them, a hierarchy of
+/// the other's face boxes finds the regions whose boxes meet none of its
+/// faces. These are taken out of the trees before the csg.js scheme runs, and
+/// kept or dropped whole, with one exact test per connected group (see
+/// are_inside()). So the clipping follows the seam between the operands, not
+/// the size of their meshes.
+///
+/// \param  thread_count  How many threads may build the operands' trees; see
+///                      BspTree.
+///
+/// \throws  unrepresentable_operation_error if RatT is a FixedRational that
+///          cannot represent an intersection.
+///
+template <typename RatT>
+Polyhedron<RatT> boolean_operation(const Polyhedron<RatT>& l_op,
+    const Polyhedron<RatT>& r_op,
+    BooleanOperation operation,
+    BspSplitHeuristic heuristic = {},
+    size_t thread_count         = 1)
+{
+  typedef AABB<RatT, 3> BoxT;
+  typedef BoundingVolumeHierarchy<RatT, 3> HierarchyT;
+
+  // With threads to spare, the two trees are built at once.
+  auto r_share  = thread_count / 2;
+  auto r_future = std::async(
+      r_share > 0 ? std::launch::async : std::launch::deferred, [&] {
+        return BspTree<RatT>{
+            regions_of(r_op), heuristic, std::max<size_t>(r_share, 1)};
+      });
+  BspTree<RatT> l_tree{
+      regions_of(l_op), heuristic, std::max<size_t>(thread_count - r_share, 1)};
+  auto r_tree = r_future.get();
+
+  // Regions beyond the other operand's bounds already skip clipping, so only
+  // those within them, and the faces they might meet, are considered.
+  auto bounds = [](const Polyhedron<RatT>& polyhedron) {
+    BoxT ret;
+    for (const auto& vertex : polyhedron.vertices()) {
+      ret.extend(vertex);
+    }
+    return ret;
+  };
+  auto clear_of = [](const BoxT& other_bounds, const HierarchyT& faces) {
+    return [&other_bounds, &faces](const PlanarRegion<RatT>& region) {
+      BoxT box{region.lower_, region.upper_};
+      return box.overlaps(other_bounds) && faces.overlapping(box).empty();
+    };
+  };
+  const auto l_bounds = bounds(l_op);
+  const auto r_bounds = bounds(r_op);
+  const HierarchyT l_faces{face_boxes(l_op, r_bounds)};
+  const HierarchyT r_faces{face_boxes(r_op, l_bounds)};
+
+  auto l_clear     = l_tree.take_regions(clear_of(r_bounds, r_faces));
+  auto r_clear     = r_tree.take_regions(clear_of(l_bounds, l_faces));
+  auto l_is_inside = are_inside(l_clear, r_tree);
+  auto r_is_inside = are_inside(r_clear, l_tree);
+
+  auto regions =
+      boolean_operation(std::move(l_tree), std::move(r_tree), operation)
+          .all_regions();
+  add_clear_regions(std::move(l_clear), l_is_inside, operation, true, regions);
+  add_clear_regions(
+      std::move(r_clear), r_is_inside, operation, false, regions);
+
+  return polyhedron_of(regions);
+}
+
+template <typename RatT>
+Polyhedron<RatT> operator|(
+    const Polyhedron<RatT>& l_op, const Polyhedron<RatT>& r_op)
+{
+  return boolean_operation(l_op, r_op, BooleanOperation::kUnion);
+}
+
+template <typename RatT>
+Polyhedron<RatT> operator&(
+    const Polyhedron<RatT>& l_op, const Polyhedron<RatT>& r_op)
+{
+  return boolean_operation(l_op, r_op, BooleanOperation::kIntersection);
+}
+
+template <typename RatT>
+Polyhedron<RatT> operator-(
+    const Polyhedron<RatT>& l_op, const Polyhedron<RatT>& r_op)
+{
+  return boolean_operation(l_op, r_op, BooleanOperation::kDifference);
+}
+
+template <typename RatT>
+Polyhedron<RatT> operator^(
+    const Polyhedron<RatT>& l_op, const Polyhedron<RatT>& r_op)
+{
+  return boolean_operation(l_op, r_op, BooleanOperation::kSymmetricDifference);
+}
+
+/// Test equality of two polyhedra, as stored.
+///
+/// Results of the boolean operations are stored in a canonical order, so for
+/// those this is geometric equality.
+///
+template <typename RatT>
+bool operator==(const Polyhedron<RatT>& l_op, const Polyhedron<RatT>& r_op)
+{
+  return l_op.vertices() == r_op.vertices() && l_op.faces() == r_op.faces();
+}
+
+template <typename RatT>
+bool operator!=(const Polyhedron<RatT>& l_op, const Polyhedron<RatT>& r_op)
+{
+  return !(l_op == r_op);
+}
+
+template <typename RatT>
+std::ostream& operator<<(
+    std::ostream& the_stream, const Polyhedron<RatT>& the_polyhedron)
+{
+  the_stream << typeid(the_polyhedron).name();
+  the_stream << ":[\n";
+  for (const auto& face : the_polyhedron.faces()) {
+    the_stream << " (";
+    for (const auto& ring : face) {
+      the_stream << "(";
+      for (auto vertex : ring) {
+        const auto& point = the_polyhedron.vertices()[vertex];
+        the_stream << "(" << point[0] << ", " << point[1] << ", " << point[2]
+                   << "), ";
+      }
+      the_stream << "), ";
+    }
+    the_stream << ")\n";
+  }
+  the_stream << "]";
+  return the_stream;
+}
+
+//-------------------
+// Related Functions
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_POLYHEDRON_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,438 @@
+/// \file    SparseLU.hpp
+/// \author  Tim Holt
+///
+/// An exact, fraction-free LU factorization of a SparseMatrix.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_SPARSELU_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_SPARSELU_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "DynamicPoint.hpp"
+#include "SparseMatrix.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Class Template Declaration
+//----------------------------
+
+/// \brief  The factorization of a square SparseMatrix, by fraction-free
+///         (Bareiss) Gaussian elimination, for exact determinants and solves.
+///
+/// Each step k eliminates pivot column c from the remaining rows i with
+///
+///     a_ij = (p_k * a_ij - a_ic * a_kj) / p_(k-1)
+///
+/// where p_k is step k's pivot and p_(-1) is 1. Every division is exact, so a
+/// FixedRational never loses precision, and every intermediate value is a minor
+/// of the input, so none grows beyond the size of the determinant. Rows without
+/// an entry in the pivot column would only be scaled by p_k / p_(k-1); that is
+/// deferred until the row is next touched, and telescopes to a single scaling.
+///
+/// Pivots are chosen by the Markowitz criterion, minimizing
+/// (row count - 1) * (column count - 1) over the remaining entries, which
+/// bounds the fill each step may create. Any non-zero pivot is acceptable in
+/// exact arithmetic, so no numerical threshold is needed.
+///
+template <typename RatT>
+class SparseLU
+{
+ public:
+  // TYPES
+  typedef std::vector<std::pair<size_t, RatT>> SparseRowT;
+
+ protected:
+  // INTERNAL STATE
+  size_t size_;
+
+  /// The pivots, offset by one: pivots_[0] is 1, pivots_[k + 1] is p_k.
+  std::vector<RatT> pivots_;
+
+  std::vector<size_t> pivot_rows_;
+  std::vector<size_t> pivot_columns_;
+
+  /// Row k of U: the pivot row of step k, just before that step.
+  std::vector<SparseRowT> upper_rows_;
+
+  /// Column k of L: (row, a_ic) for each row eliminated by step k.
+  std::vector<SparseRowT> lower_columns_;
+
+  // HELPER FUNCTIONS
+  RatT rescaled(const RatT& value, size_t from_level, size_t to_level) const;
+  void factor(const SparseMatrix<RatT>& matrix);
+
+ public:
+  // CONSTRUCTORS
+  explicit SparseLU(const SparseMatrix<RatT>& matrix);
+
+  // ACCESSORS
+  size_t size() const;
+  size_t rank() const;
+  bool is_singular() const;
+  size_t nonzero_count() const;
+  size_t memory_footprint() const;
+
+  const std::vector<size_t>& pivot_rows() const;
+  const std::vector<size_t>& pivot_columns() const;
+
+  // OTHER METHODS
+  RatT determinant() const;
+
+  template <typename AllocatorT>
+  DynamicPoint<RatT, AllocatorT> solve(
+      const DynamicPoint<RatT, AllocatorT>& b) const;
+};
+
+// Class Template Definitions
+//----------------------------
+//   Constructors
+//  --------------
+
+/// Factor a square matrix.
+///
+/// A singular matrix may be factored; its rank() will be less than its size().
+///
+/// \throws  std::invalid_argument if the matrix isn't square.
+///
+template <typename RatT>
+SparseLU<RatT>::SparseLU(const SparseMatrix<RatT>& matrix)
+    : size_{matrix.height()}, pivots_{RatT(1)}
+{
+  if (matrix.height() != matrix.width()) {
+    throw std::invalid_argument("SparseLU of a non-square SparseMatrix");
+  }
+
+  factor(matrix);
+}
+
+//   Helper Functions
+//  ------------------
+
+/// Bring a value that is current as of an earlier step up to date, by applying
+/// all of the deferred scalings at once.
+///
+template <typename RatT>
+RatT SparseLU<RatT>::rescaled(
+    const RatT& value, size_t from_level, size_t to_level) const
+{
+  if (from_level == to_level) {
+    return value;
+  }
+  return value * pivots_[to_level] / pivots_[from_level];
+}
+
+template <typename RatT>
+void SparseLU<RatT>::factor(const SparseMatrix<RatT>& matrix)
+{
+  using namespace std;
+
+  const auto kNone = numeric_limits<size_t>::max();
+
+  // Working copy of the rows, each ordered by column. A row's level is the
+  // number of steps it is up to date with.
+  vector<SparseRowT> rows(size_);
+  vector<size_t> row_levels(size_, 0);
+  vector<bool> is_row_active(size_, true);
+
+  // Active rows with an entry in each column. column_rows may list rows that
+  // have since lost the entry; column_counts is exact.
+  vector<size_t> column_counts(size_, 0);
+  vector<vector<size_t>> column_rows(size_);
+
+  const auto& offsets = matrix.row_offsets();
+  const auto& columns = matrix.column_indices();
+  const auto& values  = matrix.values();
+  for (size_t row = 0; row < size_; ++row) {
+    rows[row].reserve(offsets[row + 1] - offsets[row]);
+    for (auto i = offsets[row]; i < offsets[row + 1]; ++i) {
+      rows[row].emplace_back(columns[i], values[i]);
+      ++column_counts[columns[i]];
+      column_rows[columns[i]].push_back(row);
+    }
+  }
+
+  auto find_entry = [](const SparseRowT& row, size_t column) {
+    return lower_bound(cbegin(row), cend(row), column,
+        [](const pair<size_t, RatT>& entry, size_t c) {
+          return entry.first < c;
+        });
+  };
+
+  vector<size_t> last_visited(size_, kNone);
+  SparseRowT merged;
+
+  for (size_t step = 0; step < size_; ++step) {
+    // Markowitz pivot search.
+    auto pivot_row    = kNone;
+    auto pivot_column = kNone;
+    auto best_cost    = numeric_limits<size_t>::max();
+    for (size_t row = 0; row < size_ && best_cost != 0; ++row) {
+      if (!is_row_active[row]) continue;
+      for (const auto& entry : rows[row]) {
+        auto cost = (rows[row].size() - 1) * (column_counts[entry.first] - 1);
+        if (cost < best_cost) {
+          best_cost    = cost;
+          pivot_row    = row;
+          pivot_column = entry.first;
+          if (cost == 0) break;
+        }
+      }
+    }
+
+    // Every remaining row is empty; the matrix is singular.
+    if (pivot_row == kNone) break;
+
+    auto& upper = rows[pivot_row];
+    for (auto& entry : upper) {
+      entry.second = rescaled(entry.second, row_levels[pivot_row], step);
+    }
+    const auto pivot = find_entry(upper, pivot_column)->second;
+
+    is_row_active[pivot_row] = false;
+    for (const auto& entry : upper) {
+      --column_counts[entry.first];
+    }
+
+    SparseRowT lower;
+    for (auto row : column_rows[pivot_column]) {
+      if (!is_row_active[row] || last_visited[row] == step) continue;
+      last_visited[row] = step;
+
+      auto& target = rows[row];
+      auto found   = find_entry(target, pivot_column);
+      if (found == cend(target) || found->first != pivot_column) continue;
+
+      const auto multiplier = rescaled(found->second, row_levels[row], step);
+      lower.emplace_back(row, multiplier);
+
+      // Merge the two rows, dropping the pivot column and any cancellations.
+      merged.clear();
+      auto l_it = cbegin(target);
+      auto r_it = cbegin(upper);
+      while (l_it != cend(target) || r_it != cend(upper)) {
+        size_t column;
+        RatT value(0);
+        if (r_it == cend(upper)
+            || (l_it != cend(target) && l_it->first < r_it->first)) {
+          column = l_it->first;
+          value  = rescaled(l_it->second, row_levels[row], step) * pivot
+                  / pivots_[step];
+          ++l_it;
+        }
+        else if (l_it == cend(target) || r_it->first < l_it->first) {
+          column = r_it->first;
+          value  = -(multiplier * r_it->second) / pivots_[step];
+          ++r_it;
+          if (column != pivot_column) {
+            ++column_counts[column];
+            column_rows[column].push_back(row);
+          }
+        }
+        else {
+          column = l_it->first;
+          value  = (rescaled(l_it->second, row_levels[row], step) * pivot
+                      - multiplier * r_it->second)
+                  / pivots_[step];
+          ++l_it;
+          ++r_it;
+          if (value == 0 && column != pivot_column) {
+            --column_counts[column];
+          }
+        }
+
+        if (column != pivot_column && value != 0) {
+          merged.emplace_back(column, value);
+        }
+      }
+      --column_counts[pivot_column];
+
+      target.swap(merged);
+      row_levels[row] = step + 1;
+    }
+    column_rows[pivot_column].clear();
+    column_rows[pivot_column].shrink_to_fit();
+
+    pivots_.push_back(pivot);
+    pivot_rows_.push_back(pivot_row);
+    pivot_columns_.push_back(pivot_column);
+    upper_rows_.push_back(move(upper));
+    lower_columns_.push_back(move(lower));
+  }
+}
+
+//   Accessors
+//  -----------
+
+template <typename RatT>
+size_t SparseLU<RatT>::size() const
+{
+  return size_;
+}
+
+template <typename RatT>
+size_t SparseLU<RatT>::rank() const
+{
+  return pivot_rows_.size();
+}
+
+template <typename RatT>
+bool SparseLU<RatT>::is_singular() const
+{
+  return rank() < size();
+}
+
+/// Get the number of entries stored in L and U together.
+///
+/// The excess over the input's non-zero count is the fill.
+///
+template <typename RatT>
+size_t SparseLU<RatT>::nonzero_count() const
+{
+  size_t ret = 0;
+  for (const auto& row : upper_rows_) {
+    ret += row.size();
+  }
+  for (const auto& column : lower_columns_) {
+    ret += column.size();
+  }
+  return ret;
+}
+
+/// Get the number of bytes of heap storage in use (not merely reserved).
+///
+template <typename RatT>
+size_t SparseLU<RatT>::memory_footprint() const
+{
+  return nonzero_count() * sizeof(typename SparseRowT::value_type)
+         + pivots_.size() * sizeof(RatT)
+         + (pivot_rows_.size() + pivot_columns_.size()) * sizeof(size_t)
+         + (upper_rows_.size() + lower_columns_.size()) * sizeof(SparseRowT);
+}
+
+/// Get the row chosen as the pivot at each step.
+///
+template <typename RatT>
+const std::vector<size_t>& SparseLU<RatT>::pivot_rows() const
+{
+  return pivot_rows_;
+}
+
+/// Get the column chosen as the pivot at each step.
+///
+template <typename RatT>
+const std::vector<size_t>& SparseLU<RatT>::pivot_columns() const
+{
+  return pivot_columns_;
+}
+
+//   Other Methods
+//  ---------------
+
+/// Find the determinant of the factored matrix.
+///
+/// The last pivot is the determinant of the permuted matrix; only its sign
+/// needs correcting for the row and column permutations.
+///
+template <typename RatT>
+RatT SparseLU<RatT>::determinant() const
+{
+  if (is_singular()) {
+    return RatT(0);
+  }
+
+  auto permutation_parity = [this](std::vector<size_t> permutation) {
+    bool is_odd = false;
+    for (size_t i = 0; i < size_; ++i) {
+      while (permutation[i] != i) {
+        std::swap(permutation[i], permutation[permutation[i]]);
+        is_odd = !is_odd;
+      }
+    }
+    return is_odd;
+  };
+
+  auto ret = pivots_.back();
+  if (permutation_parity(pivot_rows_) != permutation_parity(pivot_columns_)) {
+    ret = -ret;
+  }
+  return ret;
+}
+
+/// Solve the factored system for x, given b, where matrix * x == b.
+///
+/// Both substitutions are fraction-free as well; the only inexact-looking
+/// divisions are the final ones, by the determinant.
+///
+/// \throws  std::domain_error if the matrix is singular.
+/// \throws  std::invalid_argument if b is of the wrong dimension.
+///
+template <typename RatT>
+template <typename AllocatorT>
+DynamicPoint<RatT, AllocatorT> SparseLU<RatT>::solve(
+    const DynamicPoint<RatT, AllocatorT>& b) const
+{
+  if (b.dimension() != size_) {
+    throw std::invalid_argument(
+        "Solved a SparseLU with a DynamicPoint of the wrong dimension");
+  }
+  if (is_singular()) {
+    throw std::domain_error("Cannot solve a singular SparseMatrix system");
+  }
+
+  // Forward substitution, replaying the elimination on b.
+  std::vector<RatT> y(std::cbegin(b), std::cend(b));
+  std::vector<size_t> levels(size_, 0);
+
+  for (size_t step = 0; step < size_; ++step) {
+    auto pivot_row = pivot_rows_[step];
+    y[pivot_row]   = rescaled(y[pivot_row], levels[pivot_row], step);
+    levels[pivot_row] = step;
+
+    for (const auto& entry : lower_columns_[step]) {
+      auto row = entry.first;
+      y[row]   = (rescaled(y[row], levels[row], step) * pivots_[step + 1]
+                   - entry.second * y[pivot_row])
+               / pivots_[step];
+      levels[row] = step + 1;
+    }
+  }
+
+  // Back substitution, for determinant * x.
+  const auto& last_pivot = pivots_.back();
+  std::vector<RatT> scaled_x(size_, RatT(0));
+
+  for (size_t step = size_; step-- > 0;) {
+    auto sum = last_pivot * y[pivot_rows_[step]];
+    for (const auto& entry : upper_rows_[step]) {
+      if (entry.first != pivot_columns_[step]) {
+        sum -= entry.second * scaled_x[entry.first];
+      }
+    }
+    scaled_x[pivot_columns_[step]] = sum / pivots_[step + 1];
+  }
+
+  DynamicPoint<RatT, AllocatorT> ret(size_, b.get_allocator());
+  for (size_t i = 0; i < size_; ++i) {
+    ret[i] = scaled_x[i] / last_pivot;
+  }
+  return ret;
+}
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_SPARSELU_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,412 @@
+/// \file    SparseMatrix.hpp
+/// \author  Tim Holt
+///
+/// A compressed sparse row matrix class and its related functions.
+///
+/// The class is templatized so that any rational type may be used for the
+/// matrix elements.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_SPARSEMATRIX_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_SPARSEMATRIX_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "DynamicMatrix.hpp"
+#include "DynamicPoint.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <ostream>
+#include <stdexcept>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Helper Types
+//--------------
+
+/// A single (row, column, value) entry, for assembling a SparseMatrix.
+///
+template <typename RatT>
+struct SparseEntry
+{
+  size_t row_;
+  size_t column_;
+  RatT value_;
+};
+
+// Class Template Declaration
+//----------------------------
+
+/// \brief  A matrix with rational members, of which only the non-zero ones are
+///         stored.
+///
+/// Storage is compressed sparse row (CSR): the non-zero values and their column
+/// indices, row after row, plus the offset at which each row starts. The
+/// compressed sparse column (CSC) form of a matrix is the CSR form of its
+/// transpose, which transposed() provides.
+///
+/// Within a row, entries are ordered by column. Explicit zeros are never
+/// stored.
+///
+template <typename RatT>
+class SparseMatrix
+{
+ protected:
+  // INTERNAL STATE
+  size_t height_;
+  size_t width_;
+
+  std::vector<size_t> row_offsets_;
+  std::vector<size_t> column_indices_;
+  std::vector<RatT> values_;
+
+ public:
+  // CONSTRUCTORS
+  SparseMatrix();
+  SparseMatrix(size_t height, size_t width);
+  SparseMatrix(
+      size_t height, size_t width, std::vector<SparseEntry<RatT>> entries);
+
+  template <typename AllocatorT>
+  explicit SparseMatrix(const DynamicMatrix<RatT, AllocatorT>& dense);
+
+  // ACCESSORS
+  size_t height() const;
+  size_t width() const;
+  size_t nonzero_count() const;
+
+  RatT operator()(size_t row, size_t column) const;
+
+  const std::vector<size_t>& row_offsets() const;
+  const std::vector<size_t>& column_indices() const;
+  const std::vector<RatT>& values() const;
+
+  size_t memory_footprint() const;
+
+  SparseMatrix transposed() const;
+  DynamicMatrix<RatT> as_dynamic() const;
+};
+
+// Class Template Definitions
+//----------------------------
+//   Constructors
+//  --------------
+
+/// Creates an empty (0x0) matrix.
+///
+template <typename RatT>
+SparseMatrix<RatT>::SparseMatrix() : SparseMatrix(0, 0)
+{
+}
+
+/// Creates a matrix of the given size with no non-zero entries.
+///
+/// \note  Unlike Matrix<> and DynamicMatrix<>, this is <i>not</i> an identity
+///        matrix.
+///
+template <typename RatT>
+SparseMatrix<RatT>::SparseMatrix(size_t height, size_t width)
+    : height_{height}, width_{width}, row_offsets_(height + 1, 0)
+{
+}
+
+/// Assembles a matrix from a list of entries, in any order.
+///
+/// Entries at the same position are summed, and zero sums are dropped.
+///
+/// \throws  std::out_of_range if an entry lies outside the matrix.
+///
+template <typename RatT>
+SparseMatrix<RatT>::SparseMatrix(
+    size_t height, size_t width, std::vector<SparseEntry<RatT>> entries)
+    : SparseMatrix(height, width)
+{
+  using namespace std;
+
+  for (const auto& entry : entries) {
+    if (entry.row_ >= height_ || entry.column_ >= width_) {
+      throw std::out_of_range("SparseEntry outside of SparseMatrix");
+    }
+  }
+
+  stable_sort(begin(entries), end(entries),
+      [](const SparseEntry<RatT>& l_op, const SparseEntry<RatT>& r_op) {
+        return make_pair(l_op.row_, l_op.column_)
+               < make_pair(r_op.row_, r_op.column_);
+      });
+
+  column_indices_.reserve(entries.size());
+  values_.reserve(entries.size());
+
+  for (auto entry = cbegin(entries); entry != cend(entries);) {
+    auto row    = entry->row_;
+    auto column = entry->column_;
+    RatT sum    = entry->value_;
+
+    for (++entry; entry != cend(entries) && entry->row_ == row
+                  && entry->column_ == column;
+         ++entry) {
+      sum += entry->value_;
+    }
+
+    if (sum != 0) {
+      column_indices_.push_back(column);
+      values_.push_back(sum);
+      ++row_offsets_[row + 1];
+    }
+  }
+
+  partial_sum(cbegin(row_offsets_), cend(row_offsets_), begin(row_offsets_));
+}
+
+/// Converts from a dense DynamicMatrix, keeping only the non-zero entries.
+///
+template <typename RatT>
+template <typename AllocatorT>
+SparseMatrix<RatT>::SparseMatrix(const DynamicMatrix<RatT, AllocatorT>& dense)
+    : SparseMatrix(dense.height(), dense.width())
+{
+  for (size_t row = 0; row < height_; ++row) {
+    for (size_t column = 0; column < width_; ++column) {
+      const auto& value = dense(row, column);
+      if (value != 0) {
+        column_indices_.push_back(column);
+        values_.push_back(value);
+      }
+    }
+    row_offsets_[row + 1] = values_.size();
+  }
+}
+
+//   Accessors
+//  -----------
+
+template <typename RatT>
+size_t SparseMatrix<RatT>::height() const
+{
+  return height_;
+}
+
+template <typename RatT>
+size_t SparseMatrix<RatT>::width() const
+{
+  return width_;
+}
+
+template <typename RatT>
+size_t SparseMatrix<RatT>::nonzero_count() const
+{
+  return values_.size();
+}
+
+/// Get the value at a position, which is 0 if it isn't stored.
+///
+/// This is a binary search within the row, so prefer iterating over
+/// row_offsets(), column_indices() and values() for bulk access.
+///
+template <typename RatT>
+RatT SparseMatrix<RatT>::operator()(size_t row, size_t column) const
+{
+  using namespace std;
+
+  auto row_begin = cbegin(column_indices_) + row_offsets_[row];
+  auto row_end   = cbegin(column_indices_) + row_offsets_[row + 1];
+
+  auto found = lower_bound(row_begin, row_end, column);
+  if (found == row_end || *found != column) {
+    return RatT(0);
+  }
+  return values_[found - cbegin(column_indices_)];
+}
+
+/// Get the offset of each row's first entry, plus one past the last entry.
+///
+template <typename RatT>
+const std::vector<size_t>& SparseMatrix<RatT>::row_offsets() const
+{
+  return row_offsets_;
+}
+
+template <typename RatT>
+const std::vector<size_t>& SparseMatrix<RatT>::column_indices() const
+{
+  return column_indices_;
+}
+
+template <typename RatT>
+const std::vector<RatT>& SparseMatrix<RatT>::values() const
+{
+  return values_;
+}
+
+/// Get the number of bytes of heap storage in use (not merely reserved).
+///
+template <typename RatT>
+size_t SparseMatrix<RatT>::memory_footprint() const
+{
+  return row_offsets_.size() * sizeof(size_t)
+         + column_indices_.size() * sizeof(size_t)
+         + values_.size() * sizeof(RatT);
+}
+
+/// Get the transpose of the matrix.
+///
+/// Its storage is, equivalently, the compressed sparse column form of this
+/// matrix.
+///
+template <typename RatT>
+SparseMatrix<RatT> SparseMatrix<RatT>::transposed() const
+{
+  SparseMatrix<RatT> ret(width_, height_);
+
+  ret.column_indices_.resize(nonzero_count());
+  ret.values_.resize(nonzero_count());
+
+  // Counting sort by column. Walking the rows in order leaves each of the
+  // transpose's rows ordered by column, too.
+  for (auto column : column_indices_) {
+    ++ret.row_offsets_[column + 1];
+  }
+  std::partial_sum(std::cbegin(ret.row_offsets_), std::cend(ret.row_offsets_),
+      std::begin(ret.row_offsets_));
+
+  std::vector<size_t> next(
+      std::cbegin(ret.row_offsets_), std::cend(ret.row_offsets_) - 1);
+  for (size_t row = 0; row < height_; ++row) {
+    for (auto i = row_offsets_[row]; i < row_offsets_[row + 1]; ++i) {
+      auto destination                 = next[column_indices_[i]]++;
+      ret.column_indices_[destination] = row;
+      ret.values_[destination]         = values_[i];
+    }
+  }
+
+  return ret;
+}
+
+/// Converts to a dense DynamicMatrix.
+///
+template <typename RatT>
+DynamicMatrix<RatT> SparseMatrix<RatT>::as_dynamic() const
+{
+  DynamicMatrix<RatT> ret(height_, width_);
+  std::fill(ret.data(), ret.data() + height_ * width_, RatT(0));
+
+  for (size_t row = 0; row < height_; ++row) {
+    for (auto i = row_offsets_[row]; i < row_offsets_[row + 1]; ++i) {
+      ret(row, column_indices_[i]) = values_[i];
+    }
+  }
+  return ret;
+}
+
+// Related Operators
+//-------------------
+//   Comparison Operators
+//  ----------------------
+
+template <typename RatT_l, typename RatT_r>
+bool operator==(
+    const SparseMatrix<RatT_l>& l_op, const SparseMatrix<RatT_r>& r_op)
+{
+  using namespace std;
+
+  // The representation is unique, as zeros are never stored.
+  return l_op.height() == r_op.height() && l_op.width() == r_op.width()
+         && l_op.row_offsets() == r_op.row_offsets()
+         && l_op.column_indices() == r_op.column_indices()
+         && equal(cbegin(l_op.values()), cend(l_op.values()),
+                cbegin(r_op.values()), cend(r_op.values()));
+}
+
+template <typename RatT_l, typename RatT_r>
+bool operator!=(
+    const SparseMatrix<RatT_l>& l_op, const SparseMatrix<RatT_r>& r_op)
+{
+  return !(l_op == r_op);
+}
+
+//   Other Operators
+//  -----------------
+
+/// Multiply a DynamicPoint by a SparseMatrix.
+///
+/// Only the stored entries are visited, so this takes time proportional to
+/// the number of non-zero entries (plus the height).
+///
+/// \throws  std::invalid_argument if the sizes don't match.
+///
+template <typename RatT_l, typename RatT_r, typename AllocatorT_r>
+auto operator*(const SparseMatrix<RatT_l>& l_op,
+    const DynamicPoint<RatT_r, AllocatorT_r>& r_op)
+{
+  if (l_op.width() != r_op.dimension()) {
+    throw std::invalid_argument(
+        "Multiplied a SparseMatrix by a DynamicPoint of the wrong dimension");
+  }
+
+  using std::declval;
+  // clang-format off
+  typedef decltype(declval<RatT_l>() * declval<RatT_r>()
+                   +
+                   declval<RatT_l>() * declval<RatT_r>()) RetBaseT;
+  // clang-format on
+  typedef typename std::allocator_traits<AllocatorT_r>::template rebind_alloc<
+      RetBaseT>
+      RetAllocatorT;
+
+  DynamicPoint<RetBaseT, RetAllocatorT> ret(
+      l_op.height(), RetAllocatorT(r_op.get_allocator()));
+
+  const auto& offsets = l_op.row_offsets();
+  const auto& columns = l_op.column_indices();
+  const auto& values  = l_op.values();
+
+  for (size_t row = 0; row < l_op.height(); ++row) {
+    for (auto i = offsets[row]; i < offsets[row + 1]; ++i) {
+      ret[row] += values[i] * r_op[columns[i]];
+    }
+  }
+
+  return ret;
+}
+
+// Related Functions
+//-------------------
+
+template <typename RatT>
+std::ostream& operator<<(
+    std::ostream& the_stream, const SparseMatrix<RatT>& the_matrix)
+{
+  the_stream << typeid(the_matrix).name();
+  the_stream << ":\n[\n";
+  for (size_t row = 0; row < the_matrix.height(); ++row) {
+    for (auto i = the_matrix.row_offsets()[row];
+         i < the_matrix.row_offsets()[row + 1]; ++i) {
+      the_stream << " (" << row << ", " << the_matrix.column_indices()[i]
+                 << "): " << the_matrix.values()[i] << ",";
+    }
+    the_stream << "\n";
+  }
+  the_stream << "]";
+  return the_stream;
+}
+
+//-------------------
+// Related Functions
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_SPARSEMATRIX_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,455 @@
+/// \file     SpatialHash.hpp
+/// \author   Tim Holt
+///
+/// A uniform grid of exact points, hashed by cell, and exact point welding.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_SPATIALHASH_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_SPATIALHASH_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "AABB.hpp"
+#include "Point.hpp"
+#include "predicates.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Helper Functions
+//------------------
+
+/// Divide two integers, rounding toward negative infinity.
+///
+/// \note  The divisor must be positive.
+///
+template <typename IntT>
+IntT floor_divide(IntT dividend, IntT divisor)
+{
+  auto ret = dividend / divisor;
+  return dividend % divisor < 0 ? ret - 1 : ret;
+}
+
+/// Hash a tuple of integers, such as a grid cell or a point's numerators.
+///
+template <typename IntT, size_t kDimension>
+size_t hash_integers(const std::array<IntT, kDimension>& values)
+{
+  // FNV-1a, a whole integer at a time.
+  auto ret = static_cast<size_t>(14695981039346656037ULL);
+  for (const auto& value : values) {
+    ret = (ret ^ static_cast<size_t>(value))
+          * static_cast<size_t>(1099511628211ULL);
+  }
+  return ret ^ (ret >> 29);
+}
+
+/// Get the number of slots, a power of two, for an open addressed table of at
+/// most the given number of entries, kept at most half full.
+///
+inline size_t slot_count_for(size_t entry_count)
+{
+  size_t ret = 16;
+  while (ret < 2 * entry_count) {
+    ret *= 2;
+  }
+  return ret;
+}
+
+// Class Template Declaration
+//----------------------------
+
+/// \brief  A uniform grid over a set of points, for finding quickly which
+///         points lie in a box or near a point.
+///
+/// FixedRational coordinates lie on an exact lattice, 1/kDenominator apart,
+/// so a point's cell is found exactly, by integer floor division of its
+/// numerators by the cell size's. Integer coordinates are their own
+/// numerators.
+///
+/// The points are stored grouped by cell, in one flat array, and the occupied
+/// cells in another, found through an open addressed (linear probing) table.
+///
+template <typename RatT, size_t kDimension>
+class SpatialHash
+{
+ public:
+  // TYPES
+  typedef Point<RatT, kDimension> PointT;
+  typedef AABB<RatT, kDimension> BoxT;
+  typedef typename NumeratorType<RatT>::type IntT;
+  typedef std::array<IntT, kDimension> CellT;
+
+  // CONSTANTS
+  static constexpr size_t kNone = static_cast<size_t>(-1);
+
+ protected:
+  // TYPES
+  struct Cell
+  {
+    CellT key_;
+
+    /// The run of items_ in the cell.
+    size_t first_;
+    size_t count_;
+  };
+
+  // INTERNAL STATE
+  IntT cell_size_;
+  std::vector<PointT> points_;
+  std::vector<size_t> items_;
+  std::vector<Cell> cells_;
+  std::vector<size_t> slots_;
+
+  // HELPER FUNCTIONS
+  CellT cell_of(const PointT& point) const;
+  size_t find_cell(const CellT& key) const;
+  void rebuild();
+
+ public:
+  // CONSTRUCTORS
+  explicit SpatialHash(const RatT& cell_size);
+  SpatialHash(const RatT& cell_size, std::vector<PointT> points);
+
+  // ACCESSORS
+  const std::vector<PointT>& points() const;
+  size_t cell_count() const;
+  size_t find(const PointT& point) const;
+
+  std::vector<size_t> within(const BoxT& box) const;
+  std::vector<size_t> within(const PointT& center, const RatT& radius) const;
+  std::vector<std::vector<size_t>> within(
+      const std::vector<PointT>& centers, const RatT& radius) const;
+
+  // MUTATORS
+  void insert(const std::vector<PointT>& points);
+};
+
+// Class Template Definitions
+//----------------------------
+//   Constructors
+//  --------------
+
+/// Creates an empty grid of cells of the given size.
+///
+/// \throws  std::invalid_argument if cell_size is not positive.
+///
+template <typename RatT, size_t kDimension>
+SpatialHash<RatT, kDimension>::SpatialHash(const RatT& cell_size)
+    : cell_size_(numerator_of(cell_size))
+{
+  if (!(IntT(0) < cell_size_)) {
+    throw std::invalid_argument("SpatialHash cell size must be positive");
+  }
+}
+
+/// Creates a grid of cells of the given size over the given points, indexed
+/// as given.
+///
+/// \throws  std::invalid_argument if cell_size is not positive.
+///
+template <typename RatT, size_t kDimension>
+SpatialHash<RatT, kDimension>::SpatialHash(
+    const RatT& cell_size, std::vector<PointT> points)
+    : SpatialHash(cell_size)
+{
+  points_ = std::move(points);
+  rebuild();
+}
+
+//   Helper Functions
+//  ------------------
+
+template <typename RatT, size_t kDimension>
+auto SpatialHash<RatT, kDimension>::cell_of(const PointT& point) const
+    -> CellT
+{
+  CellT ret;
+  for (size_t i = 0; i < kDimension; ++i) {
+    ret[i] = floor_divide(numerator_of(point[i]), cell_size_);
+  }
+  return ret;
+}
+
+/// Find an occupied cell's index in cells_, or kNone if it is not occupied.
+///
+template <typename RatT, size_t kDimension>
+size_t SpatialHash<RatT, kDimension>::find_cell(const CellT& key) const
+{
+  if (slots_.empty()) return kNone;
+
+  auto mask = slots_.size() - 1;
+  for (auto slot = hash_integers(key) & mask; slots_[slot] != kNone;
+       slot = (slot + 1) & mask) {
+    if (cells_[slots_[slot]].key_ == key) return slots_[slot];
+  }
+  return kNone;
+}
+
+/// Group the points by cell, and hash the occupied cells.
+///
+template <typename RatT, size_t kDimension>
+void SpatialHash<RatT, kDimension>::rebuild()
+{
+  std::vector<CellT> keys;
+  keys.reserve(points_.size());
+  for (const auto& point : points_) {
+    keys.push_back(cell_of(point));
+  }
+
+  items_.resize(points_.size());
+  for (size_t i = 0; i < items_.size(); ++i) {
+    items_[i] = i;
+  }
+  std::stable_sort(items_.begin(), items_.end(),
+      [&keys](size_t l_op, size_t r_op) { return keys[l_op] < keys[r_op]; });
+
+  cells_.clear();
+  for (size_t i = 0; i < items_.size(); ++i) {
+    const auto& key = keys[items_[i]];
+    if (cells_.empty() || cells_.back().key_ != key) {
+      cells_.push_back(Cell{key, i, 0});
+    }
+    ++cells_.back().count_;
+  }
+
+  slots_.assign(slot_count_for(cells_.size()), kNone);
+  auto mask = slots_.size() - 1;
+  for (size_t i = 0; i < cells_.size(); ++i) {
+    auto slot = hash_integers(cells_[i].key_) & mask;
+    while (slots_[slot] != kNone) {
+      slot = (slot + 1) & mask;
+    }
+    slots_[slot] = i;
+  }
+}
+
+//   Accessors
+//  -----------
+
+/// Get the points, indexed as given.
+///
+template <typename RatT, size_t kDimension>
+auto SpatialHash<RatT, kDimension>::points() const
+    -> const std::vector<PointT>&
+{
+  return points_;
+}
+
+/// Get the number of occupied cells.
+///
+template <typename RatT, size_t kDimension>
+size_t SpatialHash<RatT, kDimension>::cell_count() const
+{
+  return cells_.size();
+}
+
+/// Find the first of the points equal to a point.
+///
+/// \return  The point's index, or kNone if no point is equal.
+///
+template <typename RatT, size_t kDimension>
+size_t SpatialHash<RatT, kDimension>::find(const PointT& point) const
+{
+  auto cell = find_cell(cell_of(point));
+  if (cell == kNone) return kNone;
+
+  const auto& run = cells_[cell];
+  for (size_t i = run.first_; i < run.first_ + run.count_; ++i) {
+    if (points_[items_[i]] == point) return items_[i];
+  }
+  return kNone;
+}
+
+/// Find the points in a closed box.
+///
+/// The box's cells are looked up one by one, unless there are more of them
+/// than occupied cells, in which case the occupied cells are scanned instead.
+///
+/// \return  The points' indices, in increasing order.
+///
+template <typename RatT, size_t kDimension>
+std::vector<size_t> SpatialHash<RatT, kDimension>::within(
+    const BoxT& box) const
+{
+  std::vector<size_t> ret;
+  if (box.empty() || cells_.empty()) return ret;
+
+  auto lower = cell_of(box.lower());
+  auto upper = cell_of(box.upper());
+
+  auto visit = [&](const Cell& cell) {
+    for (size_t i = cell.first_; i < cell.first_ + cell.count_; ++i) {
+      if (box.contains(points_[items_[i]])) ret.push_back(items_[i]);
+    }
+  };
+
+  // Count the box's cells, giving up once there are more than are occupied.
+  size_t box_cell_count = 1;
+  for (size_t i = 0; i < kDimension && box_cell_count <= cells_.size();
+       ++i) {
+    auto extent = static_cast<size_t>(upper[i] - lower[i]) + 1;
+    box_cell_count =
+        extent > cells_.size() ? cells_.size() + 1 : box_cell_count * extent;
+  }
+
+  if (cells_.size() < box_cell_count) {
+    for (const auto& cell : cells_) {
+      bool is_inside = true;
+      for (size_t i = 0; i < kDimension && is_inside; ++i) {
+        is_inside = lower[i] <= cell.key_[i] && cell.key_[i] <= upper[i];
+      }
+      if (is_inside) visit(cell);
+    }
+  }
+  else {
+    // Step through the box's cells like an odometer.
+    auto key = lower;
+    for (;;) {
+      auto cell = find_cell(key);
+      if (cell != kNone) visit(cells_[cell]);
+
+      size_t i = 0;
+      for (; i < kDimension && key[i] == upper[i]; ++i) {
+        key[i] = lower[i];
+      }
+      if (i == kDimension) break;
+      ++key[i];
+    }
+  }
+
+  std::sort(ret.begin(), ret.end());
+  return ret;
+}
+
+/// Find the points within a distance of a point, including those at exactly
+/// that distance.
+///
+/// \return  The points' indices, in increasing order.
+///
+template <typename RatT, size_t kDimension>
+std::vector<size_t> SpatialHash<RatT, kDimension>::within(
+    const PointT& center, const RatT& radius) const
+{
+  std::vector<size_t> ret;
+  if (radius < RatT(0)) return ret;
+
+  PointT lower;
+  PointT upper;
+  for (size_t i = 0; i < kDimension; ++i) {
+    lower[i] = center[i] - radius;
+    upper[i] = center[i] + radius;
+  }
+
+  typename WidenedInt<IntT>::type limit = numerator_of(radius);
+  limit *= limit;
+  for (auto index : within(BoxT{lower, upper})) {
+    if (scaled_squared_distance(points_[index], center) <= limit) {
+      ret.push_back(index);
+    }
+  }
+  return ret;
+}
+
+/// Find the points within a distance of each of many points.
+///
+template <typename RatT, size_t kDimension>
+std::vector<std::vector<size_t>> SpatialHash<RatT, kDimension>::within(
+    const std::vector<PointT>& centers, const RatT& radius) const
+{
+  std::vector<std::vector<size_t>> ret;
+  ret.reserve(centers.size());
+  for (const auto& center : centers) {
+    ret.push_back(within(center, radius));
+  }
+  return ret;
+}
+
+//   Mutators
+//  ----------
+
+/// Add many points, indexed after those already held.
+///
+/// The grid is regrouped once for the whole batch.
+///
+template <typename RatT, size_t kDimension>
+void SpatialHash<RatT, kDimension>::insert(const std::vector<PointT>& points)
+{
+  points_.insert(points_.end(), points.begin(), points.end());
+  rebuild();
+}
+
+// Related Types
+//---------------
+
+/// Points with exact duplicates merged, and where each original point went.
+///
+template <typename RatT, size_t kDimension>
+struct WeldedPoints
+{
+  /// The distinct points, in order of first appearance.
+  std::vector<Point<RatT, kDimension>> points_;
+
+  /// For each original point, the index of its equal in points_.
+  std::vector<size_t> indices_;
+};
+
+// Related Functions
+//-------------------
+
+/// Merge exactly equal points.
+///
+/// Each point's numerators are hashed straight into an open addressed table,
+/// in a single pass, so welding takes linear time and no sorting.
+///
+template <typename RatT, size_t kDimension>
+WeldedPoints<RatT, kDimension> weld(
+    const std::vector<Point<RatT, kDimension>>& points)
+{
+  typedef std::array<typename NumeratorType<RatT>::type, kDimension> KeyT;
+  const auto kNone = static_cast<size_t>(-1);
+
+  WeldedPoints<RatT, kDimension> ret;
+  ret.indices_.reserve(points.size());
+
+  std::vector<size_t> slots(slot_count_for(points.size()), kNone);
+  auto mask = slots.size() - 1;
+  for (const auto& point : points) {
+    KeyT key;
+    for (size_t i = 0; i < kDimension; ++i) {
+      key[i] = numerator_of(point[i]);
+    }
+
+    auto slot = hash_integers(key) & mask;
+    while (slots[slot] != kNone && ret.points_[slots[slot]] != point) {
+      slot = (slot + 1) & mask;
+    }
+    if (slots[slot] == kNone) {
+      slots[slot] = ret.points_.size();
+      ret.points_.push_back(point);
+    }
+    ret.indices_.push_back(slots[slot]);
+  }
+  return ret;
+}
+
+//-------------------
+// Related Functions
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_SPATIALHASH_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,341 @@
+/// \file    TransformTree.hpp
+/// \author  Tim Holt
+///
+/// A hierarchy of affine transforms that caches its composed (world)
+/// transforms.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_TRANSFORMTREE_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_TRANSFORMTREE_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "Matrix.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Class Template Declaration
+//----------------------------
+
+/// \brief  A tree of nodes, each with a local affine transform relative to its
+///         parent, whose world transforms are only recomputed when needed.
+///
+/// Nodes are identified by their index, in order of creation. A node's world
+/// transform is its parent's world transform multiplied by its own local
+/// transform. Changing a local transform (or a parent) marks the node and its
+/// whole subtree dirty; world transforms of dirty nodes are recomputed lazily,
+/// the first time they are asked for (or all at once by update()). Clean
+/// subtrees are never multiplied out again.
+///
+/// \note  Invariant: a dirty node's descendants are all dirty. This lets
+///        marking stop at any node that is already dirty.
+///
+template <typename RatT, size_t kDimension = 3>
+class TransformTree
+{
+ public:
+  // TYPES
+  typedef Matrix<RatT, kDimension + 1> TransformT;
+
+  // CONSTANTS
+  static constexpr size_t kNoParent = static_cast<size_t>(-1);
+
+ protected:
+  // INTERNAL STATE
+  std::vector<size_t> parents_;
+  std::vector<std::vector<size_t>> children_;
+  std::vector<TransformT> local_transforms_;
+
+  mutable std::vector<TransformT> world_transforms_;
+  mutable std::vector<bool> dirty_;
+
+  /// Scratch space for recompute_world(), kept to avoid reallocating it.
+  mutable std::vector<size_t> chain_;
+
+  // HELPER FUNCTIONS
+  void mark_dirty(size_t node);
+  const TransformT& recompute_world(size_t node) const;
+
+ public:
+  // CONSTRUCTORS
+  TransformTree();
+
+  // ACCESSORS
+  size_t size() const;
+
+  size_t get_parent(size_t node) const;
+  const std::vector<size_t>& get_children(size_t node) const;
+
+  const TransformT& get_local(size_t node) const;
+  const TransformT& get_world(size_t node) const;
+
+  bool is_dirty(size_t node) const;
+
+  // MUTATORS
+  size_t add_node(
+      const TransformT& local = TransformT{}, size_t parent = kNoParent);
+
+  TransformTree& set_local(size_t node, const TransformT& local);
+  TransformTree& apply(size_t node, const TransformT& transform);
+  TransformTree& set_parent(size_t node, size_t parent);
+
+  // OTHER METHODS
+  const std::vector<TransformT>& update() const;
+
+  template <typename OutputIt>
+  OutputIt copy_world_transforms(OutputIt destination) const;
+};
+
+// Class Template Definitions
+//----------------------------
+//   Constructors
+//  --------------
+
+/// Creates an empty tree.
+///
+template <typename RatT, size_t kDimension>
+TransformTree<RatT, kDimension>::TransformTree()
+{
+}
+
+//   Helper Functions
+//  ------------------
+
+/// Mark a node and all of its descendants dirty.
+///
+template <typename RatT, size_t kDimension>
+void TransformTree<RatT, kDimension>::mark_dirty(size_t node)
+{
+  std::vector<size_t> pending{node};
+
+  while (!pending.empty()) {
+    auto current = pending.back();
+    pending.pop_back();
+
+    // Its descendants are already dirty, by the invariant.
+    if (dirty_[current]) continue;
+
+    dirty_[current] = true;
+    pending.insert(std::end(pending), std::cbegin(children_[current]),
+        std::cend(children_[current]));
+  }
+}
+
+/// Bring a node's world transform up to date, along with any dirty ancestors.
+///
+template <typename RatT, size_t kDimension>
+auto TransformTree<RatT, kDimension>::recompute_world(size_t node) const
+    -> const TransformT&
+{
+  if (!dirty_[node]) {
+    return world_transforms_[node];
+  }
+
+  // By the invariant, the dirty ancestors form an unbroken chain above node.
+  chain_.assign(1, node);
+  for (auto parent = parents_[node]; parent != kNoParent && dirty_[parent];
+       parent      = parents_[parent]) {
+    chain_.push_back(parent);
+  }
+
+  for (auto current = std::crbegin(chain_); current != std::crend(chain_);
+       ++current) {
+    auto parent = parents_[*current];
+    if (parent == kNoParent) {
+      world_transforms_[*current] = local_transforms_[*current];
+    }
+    else {
+      world_transforms_[*current] =
+          world_transforms_[parent] * local_transforms_[*current];
+    }
+    dirty_[*current] = false;
+  }
+
+  return world_transforms_[node];
+}
+
+//   Accessors
+//  -----------
+
+template <typename RatT, size_t kDimension>
+size_t TransformTree<RatT, kDimension>::size() const
+{
+  return parents_.size();
+}
+
+/// Get the index of a node's parent, or kNoParent for a root node.
+///
+template <typename RatT, size_t kDimension>
+size_t TransformTree<RatT, kDimension>::get_parent(size_t node) const
+{
+  return parents_[node];
+}
+
+template <typename RatT, size_t kDimension>
+const std::vector<size_t>& TransformTree<RatT, kDimension>::get_children(
+    size_t node) const
+{
+  return children_[node];
+}
+
+template <typename RatT, size_t kDimension>
+auto TransformTree<RatT, kDimension>::get_local(size_t node) const
+    -> const TransformT&
+{
+  return local_transforms_[node];
+}
+
+/// Get the transform from a node's space into the space of its root.
+///
+/// This is recomputed (along with that of any dirty ancestors) only if the node
+/// is dirty.
+///
+template <typename RatT, size_t kDimension>
+auto TransformTree<RatT, kDimension>::get_world(size_t node) const
+    -> const TransformT&
+{
+  return recompute_world(node);
+}
+
+/// Determine if a node's cached world transform is out of date.
+///
+template <typename RatT, size_t kDimension>
+bool TransformTree<RatT, kDimension>::is_dirty(size_t node) const
+{
+  return dirty_[node];
+}
+
+//   Mutators
+//  ----------
+
+/// Add a node to the tree.
+///
+/// \return  The index of the new node.
+///
+template <typename RatT, size_t kDimension>
+size_t TransformTree<RatT, kDimension>::add_node(
+    const TransformT& local, size_t parent)
+{
+  assert(parent == kNoParent || parent < size());
+
+  auto node = size();
+
+  parents_.push_back(parent);
+  children_.emplace_back();
+  local_transforms_.push_back(local);
+  world_transforms_.push_back(local);
+  dirty_.push_back(true);
+
+  if (parent != kNoParent) {
+    children_[parent].push_back(node);
+  }
+
+  return node;
+}
+
+/// Replace a node's local transform, marking its subtree dirty.
+///
+template <typename RatT, size_t kDimension>
+TransformTree<RatT, kDimension>& TransformTree<RatT, kDimension>::set_local(
+    size_t node, const TransformT& local)
+{
+  local_transforms_[node] = local;
+  mark_dirty(node);
+
+  return *this;
+}
+
+/// Apply a further transform to a node, after its current local transform.
+///
+/// e.g. tree.apply(node, make_translation(offset));
+///
+template <typename RatT, size_t kDimension>
+TransformTree<RatT, kDimension>& TransformTree<RatT, kDimension>::apply(
+    size_t node, const TransformT& transform)
+{
+  return set_local(node, transform * local_transforms_[node]);
+}
+
+/// Move a node (and its subtree) under a different parent.
+///
+/// The node's local transform is kept, so its world transform changes.
+///
+/// \throws  std::invalid_argument if the new parent is the node itself or one
+///          of its descendants, which would make a cycle.
+///
+template <typename RatT, size_t kDimension>
+TransformTree<RatT, kDimension>& TransformTree<RatT, kDimension>::set_parent(
+    size_t node, size_t parent)
+{
+  using namespace std;
+
+  for (auto ancestor = parent; ancestor != kNoParent;
+       ancestor      = parents_[ancestor]) {
+    if (ancestor == node) {
+      throw invalid_argument("TransformTree node made its own ancestor");
+    }
+  }
+
+  auto old_parent = parents_[node];
+  if (old_parent != kNoParent) {
+    auto& siblings = children_[old_parent];
+    siblings.erase(find(begin(siblings), end(siblings), node));
+  }
+
+  parents_[node] = parent;
+  if (parent != kNoParent) {
+    children_[parent].push_back(node);
+  }
+
+  mark_dirty(node);
+
+  return *this;
+}
+
+//   Other Methods
+//  ---------------
+
+/// Bring every world transform up to date.
+///
+/// \return  The world transforms of all nodes, contiguous and in node order.
+///
+template <typename RatT, size_t kDimension>
+auto TransformTree<RatT, kDimension>::update() const
+    -> const std::vector<TransformT>&
+{
+  for (size_t node = 0; node < size(); ++node) {
+    recompute_world(node);
+  }
+  return world_transforms_;
+}
+
+/// Copy all (up to date) world transforms, in node order, to a destination.
+///
+/// \return  Iterator past the last element copied.
+///
+template <typename RatT, size_t kDimension>
+template <typename OutputIt>
+OutputIt TransformTree<RatT, kDimension>::copy_world_transforms(
+    OutputIt destination) const
+{
+  const auto& worlds = update();
+  return std::copy(std::cbegin(worlds), std::cend(worlds), destination);
+}
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_TRANSFORMTREE_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,468 @@
+/// \file     WideInteger.hpp
+/// \author   Tim Holt
+///
+/// A fixed-width signed integer type wider than any standard one.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_WIDEINTEGER_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_WIDEINTEGER_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Class Template Declaration
+//----------------------------
+
+/// \brief  A signed integer of kBits bits, in two's complement, for exact
+///         arithmetic past the range of long long.
+///
+/// Addition, subtraction and multiplication wrap modulo 2^kBits, as unsigned
+/// arithmetic does, so a width should be chosen that the values cannot
+/// exceed (WidenedInt, in predicates.hpp, does so for sums of products).
+/// Division truncates towards zero, as it does for the standard types.
+///
+/// Standard integers, and narrower WideIntegers, convert to it implicitly, so
+/// it may be mixed with them in expressions. For that, its operators are
+/// friends defined within the class.
+///
+/// \note  This is portable C++, unlike a compiler's own 128-bit integer (MSVC
+///        has none).
+///
+template <std::size_t kBits>
+class WideInteger
+{
+  // STATIC ASSERTIONS
+  static_assert(kBits % 32 == 0 && kBits >= 64,
+      "kBits template argument of rational_geometry::WideInteger<> must be a "
+      "multiple of 32, and at least 64.");
+
+  template <std::size_t kOtherBits>
+  friend class WideInteger;
+
+ public:
+  // CONSTANTS
+  static constexpr std::size_t kWords = kBits / 32;
+
+ protected:
+  // TYPES
+  typedef std::uint32_t WordT;
+  typedef std::uint64_t DoubleWordT;
+
+  // INTERNAL STATE
+  /// The words of the value, least significant first.
+  std::array<WordT, kWords> words_;
+
+  // HELPER FUNCTIONS
+  constexpr bool is_unsigned_less(const WideInteger& other) const;
+  constexpr WideInteger magnitude() const;
+  static constexpr int compare(
+      const WideInteger& l_op, const WideInteger& r_op);
+  static constexpr void divide(const WideInteger& dividend,
+      const WideInteger& divisor,
+      WideInteger& quotient,
+      WideInteger& remainder);
+
+ public:
+  // CONSTRUCTORS
+  constexpr WideInteger();
+
+  template <typename IntT,
+      typename std::enable_if<std::is_integral<IntT>::value, int>::type = 0>
+  constexpr WideInteger(IntT value);
+
+  template <std::size_t kOtherBits,
+      typename std::enable_if<(kOtherBits < kBits), int>::type = 0>
+  constexpr WideInteger(const WideInteger<kOtherBits>& other);
+
+  // ACCESSORS
+  constexpr bool is_negative() const;
+
+  template <typename IntT,
+      typename std::enable_if<std::is_integral<IntT>::value, int>::type = 0>
+  explicit constexpr operator IntT() const;
+
+  template <typename IntT>
+  constexpr bool fits() const;
+
+  // OPERATORS
+  constexpr WideInteger operator-() const;
+
+  constexpr WideInteger& operator+=(const WideInteger& r_op);
+  constexpr WideInteger& operator-=(const WideInteger& r_op);
+  constexpr WideInteger& operator*=(const WideInteger& r_op);
+  constexpr WideInteger& operator/=(const WideInteger& r_op);
+  constexpr WideInteger& operator%=(const WideInteger& r_op);
+
+  friend constexpr WideInteger operator+(
+      WideInteger l_op, const WideInteger& r_op)
+  {
+    return l_op += r_op;
+  }
+
+  friend constexpr WideInteger operator-(
+      WideInteger l_op, const WideInteger& r_op)
+  {
+    return l_op -= r_op;
+  }
+
+  friend constexpr WideInteger operator*(
+      WideInteger l_op, const WideInteger& r_op)
+  {
+    return l_op *= r_op;
+  }
+
+  friend constexpr WideInteger operator/(
+      WideInteger l_op, const WideInteger& r_op)
+  {
+    return l_op /= r_op;
+  }
+
+  friend constexpr WideInteger operator%(
+      WideInteger l_op, const WideInteger& r_op)
+  {
+    return l_op %= r_op;
+  }
+
+  friend constexpr bool operator==(
+      const WideInteger& l_op, const WideInteger& r_op)
+  {
+    return compare(l_op, r_op) == 0;
+  }
+
+  friend constexpr bool operator!=(
+      const WideInteger& l_op, const WideInteger& r_op)
+  {
+    return compare(l_op, r_op) != 0;
+  }
+
+  friend constexpr bool operator<(
+      const WideInteger& l_op, const WideInteger& r_op)
+  {
+    return compare(l_op, r_op) < 0;
+  }
+
+  friend constexpr bool operator>(
+      const WideInteger& l_op, const WideInteger& r_op)
+  {
+    return compare(l_op, r_op) > 0;
+  }
+
+  friend constexpr bool operator<=(
+      const WideInteger& l_op, const WideInteger& r_op)
+  {
+    return compare(l_op, r_op) <= 0;
+  }
+
+  friend constexpr bool operator>=(
+      const WideInteger& l_op, const WideInteger& r_op)
+  {
+    return compare(l_op, r_op) >= 0;
+  }
+
+  // FUNCTIONS
+  friend constexpr WideInteger abs(const WideInteger& value)
+  {
+    return value.magnitude();
+  }
+
+  /// Find the greatest common divisor, by Euclid's algorithm.
+  friend constexpr WideInteger gcd(WideInteger a, WideInteger b)
+  {
+    while (b != WideInteger()) {
+      a %= b;
+      auto swapped = a;
+      a            = b;
+      b            = swapped;
+    }
+    return a.magnitude();
+  }
+
+  friend std::ostream& operator<<(
+      std::ostream& the_stream, const WideInteger& value)
+  {
+    // Split off nine decimal digits at a time.
+    const WideInteger kBillion(1000000000);
+    auto rest = value.magnitude();
+    std::string digits;
+    do {
+      WideInteger quotient;
+      WideInteger remainder;
+      divide(rest, kBillion, quotient, remainder);
+      auto chunk = std::to_string(remainder.words_[0]);
+      rest       = quotient;
+      if (rest != WideInteger()) chunk.insert(0, 9 - chunk.size(), '0');
+      digits.insert(0, chunk);
+    } while (rest != WideInteger());
+
+    if (value.is_negative()) the_stream << '-';
+    return the_stream << digits;
+  }
+};
+
+// Class Template Definitions
+//----------------------------
+//   Helper Functions
+//  ------------------
+
+/// Compare two values' bits as unsigned integers.
+///
+template <std::size_t kBits>
+constexpr bool WideInteger<kBits>::is_unsigned_less(
+    const WideInteger& other) const
+{
+  for (auto i = kWords; i-- > 0;) {
+    if (words_[i] != other.words_[i]) return words_[i] < other.words_[i];
+  }
+  return false;
+}
+
+/// Get the absolute value; for the most negative value, its bits read as
+/// unsigned.
+///
+template <std::size_t kBits>
+constexpr WideInteger<kBits> WideInteger<kBits>::magnitude() const
+{
+  return is_negative() ? -*this : *this;
+}
+
+/// \return  -1, 0 or 1, as l_op is less than, equal to or greater than r_op.
+///
+template <std::size_t kBits>
+constexpr int WideInteger<kBits>::compare(
+    const WideInteger& l_op, const WideInteger& r_op)
+{
+  if (l_op.is_negative() != r_op.is_negative()) {
+    return l_op.is_negative() ? -1 : 1;
+  }
+  // Values of the same sign order as their bits do.
+  if (l_op.is_unsigned_less(r_op)) return -1;
+  return r_op.is_unsigned_less(l_op) ? 1 : 0;
+}
+
+/// Divide, truncating towards zero; the remainder takes the dividend's sign.
+///
+/// \throws  std::domain_error on division by zero.
+///
+template <std::size_t kBits>
+constexpr void WideInteger<kBits>::divide(const WideInteger& dividend,
+    const WideInteger& divisor,
+    WideInteger& quotient,
+    WideInteger& remainder)
+{
+  if (divisor == WideInteger()) {
+    throw std::domain_error("WideInteger division by zero");
+  }
+
+  // The results may be the operands themselves, so copy what is needed.
+  bool is_quotient_negative  = dividend.is_negative() != divisor.is_negative();
+  bool is_remainder_negative = dividend.is_negative();
+  auto top                   = dividend.magnitude();
+  auto bottom                = divisor.magnitude();
+  quotient                   = WideInteger();
+  remainder                  = WideInteger();
+
+  bool is_short = true;
+  for (std::size_t i = 1; i < kWords; ++i) {
+    is_short = is_short && bottom.words_[i] == 0;
+  }
+
+  if (is_short) {
+    // A word at a time, as by hand.
+    DoubleWordT carried = 0;
+    for (auto i = kWords; i-- > 0;) {
+      auto current       = carried << 32 | top.words_[i];
+      quotient.words_[i] = static_cast<WordT>(current / bottom.words_[0]);
+      carried            = current % bottom.words_[0];
+    }
+    remainder.words_[0] = static_cast<WordT>(carried);
+  }
+  else {
+    // A bit at a time, from the highest set.
+    auto bit = kBits;
+    while (bit > 0 && top.words_[(bit - 1) / 32] == 0) {
+      bit -= 32;
+    }
+    while (bit-- > 0) {
+      WordT carry = top.words_[bit / 32] >> (bit % 32) & 1;
+      for (std::size_t i = 0; i < kWords; ++i) {
+        auto shifted       = remainder.words_[i] >> 31;
+        remainder.words_[i] = remainder.words_[i] << 1 | carry;
+        carry              = shifted;
+      }
+      if (!remainder.is_unsigned_less(bottom)) {
+        remainder -= bottom;
+        quotient.words_[bit / 32] |= WordT(1) << (bit % 32);
+      }
+    }
+  }
+
+  if (is_quotient_negative) quotient = -quotient;
+  if (is_remainder_negative) remainder = -remainder;
+}
+
+//   Constructors
+//  --------------
+
+/// Creates a zero.
+///
+template <std::size_t kBits>
+constexpr WideInteger<kBits>::WideInteger() : words_{}
+{
+}
+
+template <std::size_t kBits>
+template <typename IntT,
+    typename std::enable_if<std::is_integral<IntT>::value, int>::type>
+constexpr WideInteger<kBits>::WideInteger(IntT value) : words_{}
+{
+  bool is_negative = value < IntT(0);
+  auto bits        = static_cast<unsigned long long>(value);
+
+  words_[0] = static_cast<WordT>(bits);
+  words_[1] = static_cast<WordT>(bits >> 32);
+  for (std::size_t i = 2; i < kWords; ++i) {
+    words_[i] = is_negative ? ~WordT(0) : WordT(0);
+  }
+}
+
+/// Creates a copy of a narrower value.
+///
+template <std::size_t kBits>
+template <std::size_t kOtherBits,
+    typename std::enable_if<(kOtherBits < kBits), int>::type>
+constexpr WideInteger<kBits>::WideInteger(const WideInteger<kOtherBits>& other)
+    : words_{}
+{
+  for (std::size_t i = 0; i < kWords; ++i) {
+    if (i < other.kWords) {
+      words_[i] = other.words_[i];
+    }
+    else {
+      words_[i] = other.is_negative() ? ~WordT(0) : WordT(0);
+    }
+  }
+}
+
+//   Accessors
+//  -----------
+
+template <std::size_t kBits>
+constexpr bool WideInteger<kBits>::is_negative() const
+{
+  return words_[kWords - 1] >> 31 != 0;
+}
+
+/// Convert to a standard integer, keeping only as many low bits as it has.
+///
+/// \sa  fits()
+///
+template <std::size_t kBits>
+template <typename IntT,
+    typename std::enable_if<std::is_integral<IntT>::value, int>::type>
+constexpr WideInteger<kBits>::operator IntT() const
+{
+  auto bits = static_cast<unsigned long long>(words_[1]) << 32 | words_[0];
+  return static_cast<IntT>(bits);
+}
+
+/// Determine if the value is within the range of a standard integer type.
+///
+template <std::size_t kBits>
+template <typename IntT>
+constexpr bool WideInteger<kBits>::fits() const
+{
+  return WideInteger(std::numeric_limits<IntT>::min()) <= *this
+         && *this <= WideInteger(std::numeric_limits<IntT>::max());
+}
+
+//   Operators
+//  -----------
+
+template <std::size_t kBits>
+constexpr WideInteger<kBits> WideInteger<kBits>::operator-() const
+{
+  WideInteger ret;
+  for (std::size_t i = 0; i < kWords; ++i) {
+    ret.words_[i] = ~words_[i];
+  }
+  return ret += WideInteger(1);
+}
+
+template <std::size_t kBits>
+constexpr WideInteger<kBits>& WideInteger<kBits>::operator+=(
+    const WideInteger& r_op)
+{
+  DoubleWordT carry = 0;
+  for (std::size_t i = 0; i < kWords; ++i) {
+    carry += DoubleWordT(words_[i]) + r_op.words_[i];
+    words_[i] = static_cast<WordT>(carry);
+    carry >>= 32;
+  }
+  return *this;
+}
+
+template <std::size_t kBits>
+constexpr WideInteger<kBits>& WideInteger<kBits>::operator-=(
+    const WideInteger& r_op)
+{
+  return *this += -r_op;
+}
+
+template <std::size_t kBits>
+constexpr WideInteger<kBits>& WideInteger<kBits>::operator*=(
+    const WideInteger& r_op)
+{
+  // Two's complement products are the same as unsigned ones, modulo 2^kBits.
+  std::array<WordT, kWords> product{};
+  for (std::size_t i = 0; i < kWords; ++i) {
+    if (words_[i] == 0) continue;
+    DoubleWordT carry = 0;
+    for (std::size_t j = 0; i + j < kWords; ++j) {
+      carry += DoubleWordT(words_[i]) * r_op.words_[j] + product[i + j];
+      product[i + j] = static_cast<WordT>(carry);
+      carry >>= 32;
+    }
+  }
+  words_ = product;
+  return *this;
+}
+
+template <std::size_t kBits>
+constexpr WideInteger<kBits>& WideInteger<kBits>::operator/=(
+    const WideInteger& r_op)
+{
+  WideInteger remainder;
+  divide(*this, r_op, *this, remainder);
+  return *this;
+}
+
+template <std::size_t kBits>
+constexpr WideInteger<kBits>& WideInteger<kBits>::operator%=(
+    const WideInteger& r_op)
+{
+  WideInteger quotient;
+  divide(*this, r_op, quotient, *this);
+  return *this;
+}
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_WIDEINTEGER_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
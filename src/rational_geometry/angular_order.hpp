@@ -0,0 +1,380 @@
+/// \file     angular_order.hpp
+/// \author   Tim Holt
+///
+/// Exact angular ordering of Directions, without trigonometry.
+///
+/// Directions in the plane are ordered counter-clockwise from the positive x
+/// axis: first by which half-plane they lie in, then by the sign of their
+/// cross product, so no angle is ever computed. Directions in space are
+/// ordered the same way around an axis, as seen looking down from its tip.
+///
+/// For bulk sorts, each direction also has an integer key that never
+/// decreases with its angle, so directions can be radix sorted by key and
+/// only runs of equal keys compared exactly.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_ANGULAR_ORDER_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_ANGULAR_ORDER_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "Direction.hpp"
+#include "predicates.hpp"
+#include "spatial_order.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Helper Functions
+//------------------
+
+/// \brief  Find which half-plane an integer vector lies in: 0 for the zero
+///         vector, 1 for the upper, including the positive x axis, and 2 for
+///         the lower, including the negative x axis.
+///
+template <typename IntT>
+int half_plane(const IntT& x, const IntT& y)
+{
+  const IntT zero(0);
+  if (x == zero && y == zero) return 0;
+  return y < zero || (y == zero && x < zero) ? 2 : 1;
+}
+
+/// Compare the angles of two integer vectors, counter-clockwise from the
+/// positive x axis.
+///
+/// Vectors in one half-plane are compared by the sign of their cross product,
+/// whose two products are taken in long long where the components are small
+/// enough, and otherwise in IntT, which must hold them exactly.
+///
+/// \return  -1 if the first comes first, 1 if the second does, 0 if they
+///          point the same way. The zero vector comes before all others.
+///
+template <typename IntT>
+int compare_angles(const IntT& l_x, const IntT& l_y, const IntT& r_x,
+    const IntT& r_y)
+{
+  auto l_half = half_plane(l_x, l_y);
+  auto r_half = half_plane(r_x, r_y);
+  if (l_half != r_half || l_half == 0) {
+    return (r_half < l_half) - (l_half < r_half);
+  }
+
+  if (is_within_bits(l_x, 31) && is_within_bits(l_y, 31)
+      && is_within_bits(r_x, 31) && is_within_bits(r_y, 31)) {
+    auto left  = static_cast<long long>(l_x) * static_cast<long long>(r_y);
+    auto right = static_cast<long long>(l_y) * static_cast<long long>(r_x);
+    return (left < right) - (right < left);
+  }
+
+  // Comparing the two products gives the cross product's sign.
+  IntT left  = l_x * r_y;
+  IntT right = l_y * r_x;
+  return (left < right) - (right < left);
+}
+
+/// \brief  Find a key for an integer vector's angle, counter-clockwise from
+///         the positive x axis, that never decreases as the angle grows.
+///
+/// The top two bits give the quadrant. The rest give the pseudo-angle within
+/// it, b / (a + b) for the vector rotated into the first quadrant as (a, b),
+/// rounded down by exact binary long division. The zero vector's key is 0.
+///
+/// Standard integers are divided as unsigned magnitudes, so no negation can
+/// overflow; other types, such as WideInteger, in their own arithmetic, which
+/// must hold twice each magnitude.
+///
+template <typename IntT>
+unsigned long long angular_key(const IntT& x, const IntT& y)
+{
+  typedef unsigned long long KeyT;
+  constexpr int kFractionBits = 62;
+
+  auto divide = [](auto total, auto remainder) {
+    KeyT ret = 0;
+    for (int i = 0; i < kFractionBits; ++i) {
+      ret <<= 1;
+      if (total - remainder <= remainder) {
+        remainder -= total - remainder;
+        ret |= 1;
+      }
+      else {
+        remainder += remainder;
+      }
+    }
+    return ret;
+  };
+
+  const IntT zero(0);
+  if (x == zero && y == zero) return 0;
+
+  // Each quadrant starts at, and holds, a half-axis. Rotated into the
+  // first, a vector in an odd one has its magnitudes swapped.
+  KeyT quadrant = 0;
+  if (y < zero) {
+    quadrant = x < zero ? 2 : 3;
+  }
+  else if (!(zero < x)) {
+    quadrant = y == zero ? 2 : 1;
+  }
+
+  if constexpr (std::is_integral<IntT>::value) {
+    auto magnitude = [](const IntT& value) {
+      return value < 0 ? KeyT(0) - static_cast<KeyT>(value)
+                       : static_cast<KeyT>(value);
+    };
+    auto a = magnitude(quadrant % 2 == 0 ? x : y);
+    auto b = magnitude(quadrant % 2 == 0 ? y : x);
+
+    // Equal magnitudes could overflow their sum, but are half-way.
+    if (a == b) return quadrant << kFractionBits | KeyT(1) << 61;
+    return quadrant << kFractionBits | divide(a + b, b);
+  }
+  else {
+    using std::abs;
+    auto a = abs(quadrant % 2 == 0 ? x : y);
+    auto b = abs(quadrant % 2 == 0 ? y : x);
+    return quadrant << kFractionBits | divide(IntT(a + b), IntT(b));
+  }
+}
+
+/// \brief  Find two vectors at right angles to an axis, and to each other,
+///         the second a quarter-turn counter-clockwise from the first as seen
+///         from the axis' tip.
+///
+/// They are integer vectors, but not of equal length; as each is only used
+/// for a coordinate's sign and for cross products of like coordinates, that
+/// does not change any angular order. The second's components are products
+/// of two of the axis', so they are found in WidenedInt<SignedIntT, 3>, which
+/// also holds a direction's coordinates along them.
+///
+template <typename SignedIntT>
+std::array<Point<typename WidenedInt<SignedIntT, 3>::type, 3>, 2> axis_basis(
+    const Direction<SignedIntT, 3>& axis)
+{
+  typedef typename WidenedInt<SignedIntT, 3>::type WideT;
+
+  Point<WideT, 3> a{WideT(axis.get(0)), WideT(axis.get(1)), WideT(axis.get(2))};
+
+  // Cross with the coordinate axis least like the given one.
+  using std::abs;
+  size_t least = 0;
+  for (size_t i = 1; i < 3; ++i) {
+    if (abs(a[i]) < abs(a[least])) least = i;
+  }
+  Point<WideT, 3> coordinate_axis{WideT(0), WideT(0), WideT(0)};
+  coordinate_axis[least] = WideT(1);
+
+  auto first = cross(a, coordinate_axis);
+  return {first, cross(a, first)};
+}
+
+/// Find a direction's coordinates in the plane at right angles to an axis.
+///
+template <typename SignedIntT>
+std::pair<typename WidenedInt<SignedIntT, 3>::type,
+    typename WidenedInt<SignedIntT, 3>::type>
+around_axis(const Direction<SignedIntT, 3>& direction,
+    const std::array<Point<typename WidenedInt<SignedIntT, 3>::type, 3>, 2>&
+        basis)
+{
+  typedef typename WidenedInt<SignedIntT, 3>::type WideT;
+
+  Point<WideT, 3> d{WideT(direction.get(0)), WideT(direction.get(1)),
+      WideT(direction.get(2))};
+  return {dot(d, basis[0]), dot(d, basis[1])};
+}
+
+/// \brief  Compare the angles of two directions around an axis, given their
+///         coordinates around_axis().
+///
+/// Those in one half-plane are compared by the sign of the triple product of
+/// the axis and the two directions, which is the sign of their projections'
+/// cross product, so no product of the wide coordinates is needed.
+///
+template <typename SignedIntT, typename WideT>
+int compare_around_axis(const Direction<SignedIntT, 3>& l_op,
+    const std::pair<WideT, WideT>& l_at,
+    const Direction<SignedIntT, 3>& r_op,
+    const std::pair<WideT, WideT>& r_at,
+    const Direction<SignedIntT, 3>& axis)
+{
+  auto l_half = half_plane(l_at.first, l_at.second);
+  auto r_half = half_plane(r_at.first, r_at.second);
+  if (l_half != r_half || l_half == 0) {
+    return (r_half < l_half) - (l_half < r_half);
+  }
+
+  auto widened = [](const Direction<SignedIntT, 3>& direction) {
+    return Point<WideT, 3>{WideT(direction.get(0)), WideT(direction.get(1)),
+        WideT(direction.get(2))};
+  };
+  return -sign(dot(widened(axis), cross(widened(l_op), widened(r_op))));
+}
+
+/// \brief  Order items by their keys, breaking ties between equal keys with a
+///         three-way comparison.
+///
+/// \return  The items' indices, in order; items that compare equal keep their
+///          given order.
+///
+template <typename CompareT>
+std::vector<size_t> order_by_keys(
+    const std::vector<unsigned long long>& keys, const CompareT& compare)
+{
+  auto ret = radix_order(keys);
+  for (auto first = ret.begin(); first != ret.end();) {
+    auto last = std::find_if(first, ret.end(),
+        [&keys, first](size_t i) { return keys[i] != keys[*first]; });
+    if (last - first > 1) {
+      std::stable_sort(first, last,
+          [&compare](size_t l_op, size_t r_op) {
+            return compare(l_op, r_op) < 0;
+          });
+    }
+    first = last;
+  }
+  return ret;
+}
+
+// Functions
+//-----------
+
+/// Compare two directions' angles, counter-clockwise from the positive x axis.
+///
+/// \return  -1 if l_op comes first, 1 if r_op does, 0 if they are equal. The
+///          null direction comes before all others.
+///
+template <typename SignedIntT>
+int compare_angles(const Direction<SignedIntT, 2>& l_op,
+    const Direction<SignedIntT, 2>& r_op)
+{
+  typedef typename WidenedInt<SignedIntT>::type WideT;
+
+  const auto& l = l_op.get();
+  const auto& r = r_op.get();
+  if (is_within_bits(l[0], 31) && is_within_bits(l[1], 31)
+      && is_within_bits(r[0], 31) && is_within_bits(r[1], 31)) {
+    return compare_angles<long long>(l[0], l[1], r[0], r[1]);
+  }
+  return compare_angles<WideT>(l[0], l[1], r[0], r[1]);
+}
+
+/// \brief  Compare two directions' angles around an axis, counter-clockwise
+///         as seen from the axis' tip.
+///
+/// Angles start from a fixed, though arbitrary, direction at right angles to
+/// the axis. Directions along the axis come before all others.
+///
+/// \return  -1 if l_op comes first, 1 if r_op does, 0 if they are equal
+///          around the axis.
+///
+template <typename SignedIntT>
+int compare_angles(const Direction<SignedIntT, 3>& l_op,
+    const Direction<SignedIntT, 3>& r_op,
+    const Direction<SignedIntT, 3>& axis)
+{
+  auto basis = axis_basis(axis);
+  return compare_around_axis(l_op, around_axis(l_op, basis), r_op,
+      around_axis(r_op, basis), axis);
+}
+
+/// \brief  Get a key for a direction's angle, counter-clockwise from the
+///         positive x axis, for radix sorting.
+///
+/// Keys never decrease as the angle grows, but different angles may share a
+/// key; compare_angles() tells them apart.
+///
+template <typename SignedIntT>
+unsigned long long angular_key(const Direction<SignedIntT, 2>& direction)
+{
+  return angular_key(direction.get(0), direction.get(1));
+}
+
+/// Get a key for a direction's angle around an axis, for radix sorting.
+///
+/// \sa  compare_angles()
+///
+template <typename SignedIntT>
+unsigned long long angular_key(const Direction<SignedIntT, 3>& direction,
+    const Direction<SignedIntT, 3>& axis)
+{
+  auto at = around_axis(direction, axis_basis(axis));
+  return angular_key(at.first, at.second);
+}
+
+/// Find the order of many directions by angle.
+///
+/// The directions are radix sorted by angular_key(), and only runs with equal
+/// keys sorted by compare_angles().
+///
+/// \return  The directions' indices, counter-clockwise from the positive x
+///          axis; equal directions keep their given order.
+///
+template <typename SignedIntT>
+std::vector<size_t> angular_order(
+    const std::vector<Direction<SignedIntT, 2>>& directions)
+{
+  std::vector<unsigned long long> keys;
+  keys.reserve(directions.size());
+  for (const auto& direction : directions) {
+    keys.push_back(angular_key(direction));
+  }
+  return order_by_keys(keys, [&directions](size_t l_op, size_t r_op) {
+    return compare_angles(directions[l_op], directions[r_op]);
+  });
+}
+
+/// Find the order of many directions by angle around an axis.
+///
+/// The keys are taken from the directions' exact coordinates around_axis(),
+/// and ties broken by compare_around_axis().
+///
+/// \return  The directions' indices, counter-clockwise as seen from the axis'
+///          tip; equal directions keep their given order.
+///
+template <typename SignedIntT>
+std::vector<size_t> angular_order(
+    const std::vector<Direction<SignedIntT, 3>>& directions,
+    const Direction<SignedIntT, 3>& axis)
+{
+  typedef typename WidenedInt<SignedIntT, 3>::type WideT;
+
+  auto basis = axis_basis(axis);
+  std::vector<std::pair<WideT, WideT>> coordinates;
+  std::vector<unsigned long long> keys;
+  coordinates.reserve(directions.size());
+  keys.reserve(directions.size());
+  for (const auto& direction : directions) {
+    coordinates.push_back(around_axis(direction, basis));
+    keys.push_back(
+        angular_key(coordinates.back().first, coordinates.back().second));
+  }
+  return order_by_keys(
+      keys, [&directions, &coordinates, &axis](size_t l_op, size_t r_op) {
+        return compare_around_axis(directions[l_op], coordinates[l_op],
+            directions[r_op], coordinates[r_op], axis);
+      });
+}
+
+//-----------
+// Functions
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_ANGULAR_ORDER_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
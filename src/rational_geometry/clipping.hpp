@@ -0,0 +1,336 @@
+/// \file     clipping.hpp
+/// \author   Tim Holt
+///
+/// Exact Sutherland-Hodgman clipping of many polygons at once against convex
+/// windows, boxes and sets of planes.
+///
+/// Polygons go in and come out in flat buffers, and each polygon is clipped in
+/// reused scratch space, so no memory is allocated per polygon.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_CLIPPING_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_CLIPPING_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "AABB.hpp"
+#include "Plane.hpp"
+#include "Point.hpp"
+#include "predicates.hpp"
+#include "unrepresentable_operation_error.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Types
+//-------
+
+/// \brief  Many polygons' vertices in one array, with each polygon's run of it
+///         marked by offsets.
+///
+/// Polygon i's vertices are vertices_[offsets_[i]] up to, but not including,
+/// vertices_[offsets_[i + 1]], so there is one more offset than polygons.
+///
+template <typename RatT, size_t kDimension>
+struct PolygonBuffer
+{
+  std::vector<size_t> offsets_{0};
+  std::vector<Point<RatT, kDimension>> vertices_;
+};
+
+// Helper Functions
+//------------------
+
+/// \brief  Clip a polygon, in place, to where each of a number of height
+///         functions is non-negative.
+///
+/// height(i, point) gives a point's height above the i'th boundary. In 2D, a
+/// polygon clipped down to a segment or point is left empty, as is any with
+/// fewer than three vertices.
+///
+template <typename RatT, size_t kDimension, typename HeightT>
+void clip_polygon(std::vector<Point<RatT, kDimension>>& polygon,
+    std::vector<Point<RatT, kDimension>>& scratch,
+    size_t boundary_count,
+    const HeightT& height)
+{
+  for (size_t i = 0; i < boundary_count && !polygon.empty(); ++i) {
+    scratch.clear();
+    bool has_above = false;
+
+    auto previous_height = height(i, polygon.back());
+    const auto* previous = &polygon.back();
+    for (const auto& current : polygon) {
+      auto current_height = height(i, current);
+      int previous_side   = sign(previous_height);
+      int current_side    = sign(current_height);
+
+      if (previous_side * current_side < 0) {
+        scratch.push_back(crossing_point(
+            *previous, current, previous_height, current_height));
+      }
+      if (current_side >= 0) scratch.push_back(current);
+      has_above = has_above || current_side > 0;
+
+      previous_height = current_height;
+      previous        = &current;
+    }
+
+    polygon.swap(scratch);
+    if (kDimension == 2 && !has_above) polygon.clear();
+  }
+  if (polygon.size() < 3) polygon.clear();
+}
+
+/// Clip each polygon in a buffer to where each of a number of height
+/// functions is non-negative.
+///
+template <typename RatT, size_t kDimension, typename HeightT>
+PolygonBuffer<RatT, kDimension> clip_buffer(
+    const PolygonBuffer<RatT, kDimension>& polygons,
+    size_t boundary_count,
+    const HeightT& height)
+{
+  PolygonBuffer<RatT, kDimension> ret;
+  ret.offsets_.reserve(polygons.offsets_.size());
+  ret.vertices_.reserve(polygons.vertices_.size());
+
+  std::vector<Point<RatT, kDimension>> polygon;
+  std::vector<Point<RatT, kDimension>> scratch;
+  auto vertices = polygons.vertices_.begin();
+  for (size_t i = 0; i + 1 < polygons.offsets_.size(); ++i) {
+    polygon.assign(vertices + polygons.offsets_[i],
+        vertices + polygons.offsets_[i + 1]);
+    clip_polygon(polygon, scratch, boundary_count, height);
+    ret.vertices_.insert(ret.vertices_.end(), polygon.begin(), polygon.end());
+    ret.offsets_.push_back(ret.vertices_.size());
+  }
+  return ret;
+}
+
+// Functions
+//-----------
+
+/// Clip each of many polygons to a convex window.
+///
+/// Heights above the window's edges are found over the numerators, in a type
+/// wide enough for any of them, so they are exact.
+///
+/// \param  window  The window's vertices, counter-clockwise.
+///
+/// \return  The clipped polygons, indexed as given; those wholly outside the
+///          window are left with no vertices.
+///
+/// \throws  std::invalid_argument if the window has fewer than three
+///          vertices.
+/// \throws  unrepresentable_operation_error if RatT cannot represent a
+///          clipped vertex.
+///
+template <typename RatT>
+PolygonBuffer<RatT, 2> clip(const PolygonBuffer<RatT, 2>& polygons,
+    const std::vector<Point<RatT, 2>>& window)
+{
+  typedef typename WidenedInt<typename NumeratorType<RatT>::type>::type WideT;
+  if (window.size() < 3) {
+    throw std::invalid_argument("Clipping window needs three vertices");
+  }
+
+  // Each edge's start and direction, over the numerators.
+  std::vector<Point<WideT, 2>> starts;
+  std::vector<Point<WideT, 2>> directions;
+  for (size_t i = 0; i < window.size(); ++i) {
+    const auto& start = window[i];
+    const auto& end   = window[(i + 1) % window.size()];
+    starts.push_back({numerator_of(start[0]), numerator_of(start[1])});
+    directions.push_back({WideT(numerator_of(end[0])) - starts.back()[0],
+        WideT(numerator_of(end[1])) - starts.back()[1]});
+  }
+
+  // With the window's numerators and the point's under 2^30, a height fits in
+  // long long, so the wide products are skipped.
+  typedef typename NumeratorType<RatT>::type IntT;
+  bool is_small = std::is_integral<IntT>::value;
+  for (size_t i = 0; i < window.size() && is_small; ++i) {
+    for (size_t j = 0; j < 2; ++j) {
+      is_small = is_small && is_within_bits(starts[i][j], 30)
+                 && is_within_bits(directions[i][j], 30);
+    }
+  }
+
+  return clip_buffer(polygons, window.size(),
+      [&starts, &directions, is_small](
+          size_t i, const Point<RatT, 2>& point) {
+        auto x = numerator_of(point[0]);
+        auto y = numerator_of(point[1]);
+        if constexpr (std::is_integral<IntT>::value) {
+          if (is_small && is_within_bits(x, 30) && is_within_bits(y, 30)) {
+            return WideT(
+                static_cast<long long>(directions[i][0])
+                    * (y - static_cast<long long>(starts[i][1]))
+                - static_cast<long long>(directions[i][1])
+                      * (x - static_cast<long long>(starts[i][0])));
+          }
+        }
+        return WideT(directions[i][0] * (y - starts[i][1])
+                     - directions[i][1] * (x - starts[i][0]));
+      });
+}
+
+/// Clip each of many polygons to the region on or below each of many planes.
+///
+/// Heights above the planes are found over the numerators, in a type wide
+/// enough for products of the numerators and the normals' components,
+/// whichever is wider, so they are exact.
+///
+/// \return  The clipped polygons, indexed as given; those wholly above any
+///          plane are left with no vertices.
+///
+/// \throws  unrepresentable_operation_error if RatT cannot represent a
+///          plane's offset or a clipped vertex.
+///
+template <typename RatT, typename SignedIntT, typename OffsetT>
+PolygonBuffer<RatT, 3> clip(const PolygonBuffer<RatT, 3>& polygons,
+    const std::vector<Plane<SignedIntT, OffsetT>>& planes)
+{
+  typedef typename NumeratorType<RatT>::type IntT;
+  typedef typename std::conditional<std::is_integral<IntT>::value
+                                        && (IntegerDigits<IntT>::value
+                                            < IntegerDigits<SignedIntT>::value),
+      SignedIntT,
+      IntT>::type FactorT;
+  typedef typename WidenedInt<FactorT>::type WideT;
+
+  std::vector<WideT> offsets;
+  for (const auto& plane : planes) {
+    offsets.push_back(numerator_of(RatT(plane.offset())));
+  }
+
+  return clip_buffer(polygons, planes.size(),
+      [&planes, &offsets](size_t i, const Point<RatT, 3>& point) {
+        WideT ret = offsets[i];
+        for (size_t j = 0; j < 3; ++j) {
+          ret -= WideT(planes[i].normal().get(j))
+                 * WideT(numerator_of(point[j]));
+        }
+        return ret;
+      });
+}
+
+/// Clip each of many polygons to each of many boxes, such as tiles.
+///
+/// Each polygon's bounding box is found once; polygons wholly inside or
+/// outside a box are then copied or skipped without clipping.
+///
+/// Given more than one thread, the boxes are dealt out in contiguous runs,
+/// one to each thread, each with its own scratch space.
+///
+/// \param  thread_count  How many threads may clip at once.
+///
+/// \return  For each box, the clipped polygons, indexed as given; those wholly
+///          outside the box are left with no vertices.
+///
+/// \throws  unrepresentable_operation_error if RatT cannot represent a
+///          clipped vertex.
+///
+template <typename RatT, size_t kDimension>
+std::vector<PolygonBuffer<RatT, kDimension>> clip(
+    const PolygonBuffer<RatT, kDimension>& polygons,
+    const std::vector<AABB<RatT, kDimension>>& boxes,
+    size_t thread_count = 1)
+{
+  typedef typename WidenedInt<typename NumeratorType<RatT>::type>::type WideT;
+
+  auto vertices = polygons.vertices_.begin();
+  std::vector<AABB<RatT, kDimension>> bounds;
+  for (size_t i = 0; i + 1 < polygons.offsets_.size(); ++i) {
+    bounds.emplace_back();
+    for (auto vertex = vertices + polygons.offsets_[i];
+         vertex != vertices + polygons.offsets_[i + 1]; ++vertex) {
+      bounds.back().extend(*vertex);
+    }
+  }
+
+  std::vector<PolygonBuffer<RatT, kDimension>> ret(boxes.size());
+  auto clip_boxes = [&](size_t first, size_t last) {
+    std::vector<Point<RatT, kDimension>> polygon;
+    std::vector<Point<RatT, kDimension>> scratch;
+    for (size_t b = first; b < last; ++b) {
+      const auto& box = boxes[b];
+
+      // Heights above the lower sides, then below the upper sides.
+      auto height = [&box](size_t i, const Point<RatT, kDimension>& point) {
+        auto axis = i % kDimension;
+        if (i < kDimension) {
+          return WideT(numerator_of(point[axis]))
+                 - numerator_of(box.lower()[axis]);
+        }
+        return WideT(numerator_of(box.upper()[axis]))
+               - numerator_of(point[axis]);
+      };
+
+      auto& clipped = ret[b];
+      for (size_t i = 0; i < bounds.size(); ++i) {
+        if (box.overlaps(bounds[i])) {
+          polygon.assign(vertices + polygons.offsets_[i],
+              vertices + polygons.offsets_[i + 1]);
+          if (!box.contains(bounds[i])) {
+            clip_polygon(polygon, scratch, 2 * kDimension, height);
+          }
+          else if (polygon.size() < 3) {
+            polygon.clear();
+          }
+          clipped.vertices_.insert(
+              clipped.vertices_.end(), polygon.begin(), polygon.end());
+        }
+        clipped.offsets_.push_back(clipped.vertices_.size());
+      }
+    }
+  };
+
+  auto block_count =
+      std::max<size_t>(std::min(thread_count, boxes.size()), 1);
+  std::vector<std::future<void>> running;
+  for (size_t block = 1; block < block_count; ++block) {
+    running.push_back(std::async(std::launch::async, clip_boxes,
+        boxes.size() * block / block_count,
+        boxes.size() * (block + 1) / block_count));
+  }
+  clip_boxes(0, boxes.size() / block_count);
+  for (auto& result : running) {
+    result.get();
+  }
+  return ret;
+}
+
+/// Clip each of many polygons to a box.
+///
+template <typename RatT, size_t kDimension>
+PolygonBuffer<RatT, kDimension> clip(
+    const PolygonBuffer<RatT, kDimension>& polygons,
+    const AABB<RatT, kDimension>& box)
+{
+  auto ret = clip(polygons, std::vector<AABB<RatT, kDimension>>{box});
+  return std::move(ret.front());
+}
+
+//-----------
+// Functions
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_CLIPPING_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,337 @@
+/// \file     convex_hull.hpp
+/// \author   Tim Holt
+///
+/// Exact convex hulls of point sets, in 2D and 3D.
+///
+/// Every decision is made by the exact predicates, so degenerate inputs
+/// (repeated, collinear or coplanar points) give the same, exact hull whatever
+/// the input order.
+///
+/// Both take a thread count. Large point sets are then divided in halves whose
+/// hulls are found concurrently and merged; as the hull of the halves' hull
+/// corners is the hull of them all, the result does not depend on it.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_CONVEX_HULL_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_CONVEX_HULL_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "Point.hpp"
+#include "Polyhedron.hpp"
+#include "predicates.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <future>
+#include <iterator>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Functions
+//-----------
+
+/// Find the convex hull of a set of points in the plane.
+///
+/// This is Andrew's monotone chain: the points are sorted lexicographically
+/// (see Point's operator<), then the lower and upper hulls are each built in
+/// one pass.
+///
+/// \param  thread_count  How many threads may work at once. With more than
+///                       one, sets of at least parallel_minimum points are
+///                       halved, and the halves' hulls found concurrently.
+///                       This pays for itself from about 10^7 points, when
+///                       the sort dominates.
+///
+/// \return  The hull's corners, counter-clockwise from the least point, with
+///          no repeated or collinear points; so a single point for identical
+///          points, and two for collinear ones. Empty for no points.
+///
+template <typename RatT>
+std::vector<Point<RatT, 2>> convex_hull(std::vector<Point<RatT, 2>> points,
+    std::size_t thread_count     = 1,
+    std::size_t parallel_minimum = 10000000)
+{
+  using namespace std;
+
+  if (thread_count > 1 && points.size() >= parallel_minimum) {
+    // The halves' corners are far fewer than their points, so merging them
+    // costs little next to the halves' sorts.
+    auto middle     = next(begin(points), points.size() / 2);
+    auto left_share = thread_count / 2;
+    auto left       = async(launch::async, [&] {
+      return convex_hull(vector<Point<RatT, 2>>(begin(points), middle),
+          left_share, parallel_minimum);
+    });
+    auto right = convex_hull(vector<Point<RatT, 2>>(middle, end(points)),
+        thread_count - left_share, parallel_minimum);
+
+    points = left.get();
+    points.insert(end(points), begin(right), end(right));
+  }
+
+  sort(begin(points), end(points));
+  points.erase(unique(begin(points), end(points)), end(points));
+  if (points.size() < 3) return points;
+
+  vector<Point<RatT, 2>> ret;
+
+  // Each chain keeps only strictly counter-clockwise turns.
+  auto extend_chain = [&ret](const Point<RatT, 2>& point, size_t floor) {
+    while (ret.size() >= floor + 2
+           && orient2d(ret[ret.size() - 2], ret.back(), point) <= 0) {
+      ret.pop_back();
+    }
+    ret.push_back(point);
+  };
+
+  for (const auto& point : points) {
+    extend_chain(point, 0);
+  }
+  auto lower_size = ret.size();
+  for (auto point = next(rbegin(points)); point != rend(points); ++point) {
+    extend_chain(*point, lower_size - 1);
+  }
+
+  // The upper chain ends back at the first point.
+  ret.pop_back();
+  return ret;
+}
+
+/// Find a projection that leaves three points in space a triangle.
+///
+/// \return  The axis that project() should drop, or 3 if the points are
+///          collinear.
+///
+template <typename RatT>
+std::size_t triangle_axis(const Point<RatT, 3>& a,
+    const Point<RatT, 3>& b,
+    const Point<RatT, 3>& c)
+{
+  std::size_t axis = 0;
+  while (axis < 3
+         && orient2d(project(a, axis), project(b, axis), project(c, axis))
+                == 0) {
+    ++axis;
+  }
+  return axis;
+}
+
+/// Find the triangles of the convex hull of a set of points in space.
+///
+/// This is the incremental algorithm: starting from a tetrahedron, each point
+/// in turn replaces the triangles it can see (those it is strictly above, by
+/// orient3d()) with a fan of triangles to their horizon.
+///
+/// \param  points  Distinct points, sorted lexicographically.
+///
+/// \return  Triples of indices into points, counter-clockwise from outside.
+///          Empty if the points are all coplanar.
+///
+template <typename RatT>
+std::vector<std::array<std::size_t, 3>> hull_triangles(
+    const std::vector<Point<RatT, 3>>& points)
+{
+  using namespace std;
+  typedef array<size_t, 3> TriangleT;
+
+  // Find a triangle, and then a point off its plane.
+  size_t second = 1;
+  size_t third  = 2;
+  while (third < points.size()
+         && triangle_axis(points[0], points[second], points[third]) == 3) {
+    ++third;
+  }
+  if (third >= points.size()) return {};
+
+  size_t fourth = third + 1;
+  while (fourth < points.size()
+         && orient3d(points[0], points[second], points[third], points[fourth])
+                == 0) {
+    ++fourth;
+  }
+  if (fourth == points.size()) return {};
+
+  // Wind the tetrahedron's faces counter-clockwise from outside.
+  if (orient3d(points[0], points[second], points[third], points[fourth]) < 0) {
+    swap(second, third);
+  }
+  vector<TriangleT> triangles{TriangleT{0, second, third},
+      TriangleT{second, 0, fourth}, TriangleT{third, second, fourth},
+      TriangleT{0, third, fourth}};
+
+  for (size_t i = 1; i < points.size(); ++i) {
+    if (i == second || i == third || i == fourth) continue;
+    const auto& point = points[i];
+
+    // The edges of visible triangles whose twins are not visible form the
+    // horizon.
+    set<pair<size_t, size_t>> visible_edges;
+    auto is_visible = [&](const TriangleT& tri) {
+      if (orient3d(points[tri[0]], points[tri[1]], points[tri[2]], point)
+          >= 0) {
+        return false;
+      }
+      for (size_t j = 0; j < 3; ++j) {
+        visible_edges.emplace(tri[j], tri[(j + 1) % 3]);
+      }
+      return true;
+    };
+    triangles.erase(remove_if(begin(triangles), end(triangles), is_visible),
+        end(triangles));
+
+    for (const auto& edge : visible_edges) {
+      if (visible_edges.count({edge.second, edge.first}) == 0) {
+        triangles.push_back(TriangleT{edge.first, edge.second, i});
+      }
+    }
+  }
+
+  return triangles;
+}
+
+/// Find the points of a range that may be corners of its convex hull.
+///
+/// Ranges longer than leaf_size are halved, and the hull of the corners of
+/// the halves' hulls found; halves of more than leaf_size points each are
+/// found concurrently while threads remain. As each hull has far fewer
+/// corners than points, this keeps the incremental algorithm's scans short.
+///
+/// \param  first, last  A range of distinct, lexicographically sorted points.
+///
+/// \return  A sorted subset of the range holding every corner of its hull.
+///          All of it, if the range is coplanar.
+///
+template <typename RatT, typename IteratorT>
+std::vector<Point<RatT, 3>> hull_corners(IteratorT first,
+    IteratorT last,
+    std::size_t thread_count,
+    std::size_t leaf_size)
+{
+  using namespace std;
+
+  vector<Point<RatT, 3>> points;
+  auto size = static_cast<size_t>(distance(first, last));
+  if (size <= leaf_size) {
+    points.assign(first, last);
+  } else {
+    auto middle     = next(first, size / 2);
+    auto left_share = thread_count / 2;
+    auto policy     = left_share > 0 && size / 2 > leaf_size
+                      ? launch::async
+                      : launch::deferred;
+    auto left       = async(policy, [&] {
+      return hull_corners<RatT>(first, middle, max<size_t>(left_share, 1),
+          leaf_size);
+    });
+    auto right = hull_corners<RatT>(middle, last,
+        max<size_t>(thread_count - left_share, 1), leaf_size);
+
+    // The halves lie either side of middle, so they stay sorted.
+    points = left.get();
+    points.insert(end(points), begin(right), end(right));
+  }
+
+  auto triangles = hull_triangles(points);
+  if (triangles.empty()) return points;
+
+  vector<bool> is_corner(points.size(), false);
+  for (const auto& tri : triangles) {
+    for (auto index : tri) {
+      is_corner[index] = true;
+    }
+  }
+
+  vector<Point<RatT, 3>> ret;
+  for (size_t i = 0; i < points.size(); ++i) {
+    if (is_corner[i]) ret.push_back(points[i]);
+  }
+  return ret;
+}
+
+/// Find the convex hull of a set of points in space.
+///
+/// The hull's triangles are found by hull_triangles(), over the corners that
+/// hull_corners() keeps, and coplanar triangles then merged into single faces,
+/// as with the results of the Polyhedron boolean operations.
+///
+/// \param  thread_count  How many threads may find the hulls of parts of the
+///                       set at once. This pays for itself from about 10^7
+///                       points.
+/// \param  leaf_size     The most points whose hull is found in one pass.
+///
+/// \return  The hull, with no points interior to its faces or edges. If the
+///          points are all coplanar, it is flat: the one polygon, facing both
+///          ways. If they are all collinear, it is empty.
+///
+/// \sa  https://en.wikipedia.org/wiki/Convex_hull_algorithms
+///
+template <typename RatT>
+Polyhedron<RatT> convex_hull(std::vector<Point<RatT, 3>> points,
+    std::size_t thread_count = 1,
+    std::size_t leaf_size    = 1024)
+{
+  using namespace std;
+  typedef typename Polyhedron<RatT>::FaceT FaceT;
+
+  sort(begin(points), end(points));
+  points.erase(unique(begin(points), end(points)), end(points));
+  points = hull_corners<RatT>(
+      begin(points), end(points), max<size_t>(thread_count, 1), leaf_size);
+
+  auto triangles = hull_triangles(points);
+  if (!triangles.empty()) {
+    vector<FaceT> faces;
+    for (const auto& tri : triangles) {
+      faces.push_back(FaceT{{tri[0], tri[1], tri[2]}});
+    }
+    return polyhedron_of(regions_of(Polyhedron<RatT>{points, faces}));
+  }
+
+  // Flat or collinear: find a triangle, and the polygon's hull in a
+  // projection that keeps it simple.
+  size_t third = 2;
+  while (third < points.size()
+         && triangle_axis(points[0], points[1], points[third]) == 3) {
+    ++third;
+  }
+  if (third >= points.size()) return Polyhedron<RatT>{};
+  auto axis = triangle_axis(points[0], points[1], points[third]);
+
+  map<Point<RatT, 2>, size_t> indices;
+  vector<Point<RatT, 2>> projected;
+  for (size_t i = 0; i < points.size(); ++i) {
+    projected.push_back(project(points[i], axis));
+    indices[projected.back()] = i;
+  }
+
+  vector<size_t> ring;
+  for (const auto& corner : convex_hull(projected)) {
+    ring.push_back(indices[corner]);
+  }
+  auto reversed = ring;
+  reverse(begin(reversed), end(reversed));
+
+  return polyhedron_of(regions_of(Polyhedron<RatT>{
+      points, vector<FaceT>{FaceT{ring}, FaceT{reversed}}}));
+}
+
+//-----------
+// Functions
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_CONVEX_HULL_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,418 @@
+/// \file     intersections.hpp
+/// \author   Tim Holt
+///
+/// Exact intersections of segments, triangles, lines and planes.
+///
+/// Whether two objects meet is decided by the exact predicates alone. Where
+/// they meet is then found by crossing_point(), from heights taken over the
+/// coordinates' numerators as wide integers: each coordinate is formed over
+/// one shared denominator and divided once, so a FixedRational result is exact
+/// whenever the point itself is representable.
+///
+/// (The point where three planes meet is intersection_point() in Plane.hpp.)
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_INTERSECTIONS_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_INTERSECTIONS_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "Operations.hpp"
+#include "Plane.hpp"
+#include "Point.hpp"
+#include "predicates.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Types
+//-------
+
+enum class IntersectionType
+{
+  kNone,
+  kPoint,
+  kSegment
+};
+
+/// \brief  Where two objects meet: nowhere, at first_, or along the segment
+///         from first_ to second_.
+///
+/// For a single point, second_ equals first_.
+///
+template <typename RatT, std::size_t kDimension>
+struct Intersection
+{
+  IntersectionType type_;
+  Point<RatT, kDimension> first_;
+  Point<RatT, kDimension> second_;
+};
+
+// Helper Functions
+//------------------
+
+/// Find the point a fraction numerator / denominator of the way from start to
+/// end.
+///
+/// This is crossing_point(start, end, numerator, numerator - denominator),
+/// over the fraction's numerators, so the fraction need not be representable.
+///
+/// \throws  unrepresentable_operation_error if RatT is a FixedRational that
+///          cannot represent the point.
+///
+template <typename RatT, std::size_t kDimension>
+Point<RatT, kDimension> point_along(const Point<RatT, kDimension>& start,
+    const Point<RatT, kDimension>& end,
+    const RatT& numerator,
+    const RatT& denominator)
+{
+  typedef typename WidenedInt<typename NumeratorType<RatT>::type>::type WideT;
+
+  if (numerator == RatT(0)) return start;
+  if (numerator == denominator) return end;
+
+  const WideT scaled(numerator_of(numerator));
+  return crossing_point(
+      start, end, scaled, scaled - WideT(numerator_of(denominator)));
+}
+
+/// Get a point's coordinates' numerators, as integers of type WideT.
+///
+template <typename WideT, typename RatT, std::size_t kDimension>
+Point<WideT, kDimension> scaled_point(const Point<RatT, kDimension>& point)
+{
+  Point<WideT, kDimension> ret;
+  for (std::size_t i = 0; i < kDimension; ++i) {
+    ret[i] = WideT(numerator_of(point[i]));
+  }
+  return ret;
+}
+
+/// Make an intersection from the ends of the part of a segment that is shared.
+///
+template <typename RatT, std::size_t kDimension>
+Intersection<RatT, kDimension> make_intersection(
+    const Point<RatT, kDimension>& first, const Point<RatT, kDimension>& second)
+{
+  auto type = first == second ? IntersectionType::kPoint
+                              : IntersectionType::kSegment;
+  return Intersection<RatT, kDimension>{type, first, second};
+}
+
+/// Test whether the boxes bounding two groups of points overlap.
+///
+template <typename RatT, std::size_t kDimension, std::size_t kCount_l,
+    std::size_t kCount_r>
+bool bounds_overlap(const std::array<Point<RatT, kDimension>, kCount_l>& l_op,
+    const std::array<Point<RatT, kDimension>, kCount_r>& r_op)
+{
+  for (std::size_t i = 0; i < kDimension; ++i) {
+    auto by_axis = [i](const Point<RatT, kDimension>& l_point,
+                       const Point<RatT, kDimension>& r_point) {
+      return l_point[i] < r_point[i];
+    };
+    auto l_range = std::minmax_element(l_op.begin(), l_op.end(), by_axis);
+    auto r_range = std::minmax_element(r_op.begin(), r_op.end(), by_axis);
+    if ((*l_range.second)[i] < (*r_range.first)[i]
+        || (*r_range.second)[i] < (*l_range.first)[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Functions
+//-----------
+
+/// Find where two segments in the plane meet.
+///
+/// \return  The point or (for collinear segments) the segment shared, if any.
+///          Degenerate segments, with both ends equal, are points.
+///
+/// \throws  unrepresentable_operation_error if RatT is a FixedRational that
+///          cannot represent a crossing point.
+///
+template <typename RatT>
+Intersection<RatT, 2> intersection(const Point<RatT, 2>& p1,
+    const Point<RatT, 2>& p2,
+    const Point<RatT, 2>& q1,
+    const Point<RatT, 2>& q2)
+{
+  int o1 = orient2d(p1, p2, q1);
+  int o2 = orient2d(p1, p2, q2);
+  int o3 = orient2d(q1, q2, p1);
+  int o4 = orient2d(q1, q2, p2);
+
+  if (o1 == 0 && o2 == 0 && o3 == 0 && o4 == 0) {
+    // Collinear: lexicographic order is the order along the line.
+    auto p_range = std::minmax(p1, p2);
+    auto q_range = std::minmax(q1, q2);
+    auto first   = std::max(p_range.first, q_range.first);
+    auto second  = std::min(p_range.second, q_range.second);
+    if (second < first) return {IntersectionType::kNone, {}, {}};
+    return make_intersection(first, second);
+  }
+
+  if (o1 * o2 > 0 || o3 * o4 > 0) return {IntersectionType::kNone, {}, {}};
+
+  // An end lying on the other segment's line is where they meet.
+  if (o1 == 0) return make_intersection(q1, q1);
+  if (o2 == 0) return make_intersection(q2, q2);
+  if (o3 == 0) return make_intersection(p1, p1);
+  if (o4 == 0) return make_intersection(p2, p2);
+
+  // The ends' heights about the other segment's line, over the numerators.
+  auto crossing = crossing_point(
+      p1, p2, scaled_orient2d(q1, q2, p1), scaled_orient2d(q1, q2, p2));
+  return make_intersection(crossing, crossing);
+}
+
+/// Find where a segment in space meets a (solid) triangle.
+///
+/// \return  The point where the segment passes through the triangle, or, if
+///          they are coplanar, the part of the segment within the triangle.
+///
+/// \note  A degenerate triangle, with collinear corners, meets nothing.
+///
+/// \throws  unrepresentable_operation_error if RatT is a FixedRational that
+///          cannot represent a point found.
+///
+template <typename RatT>
+Intersection<RatT, 3> intersection(const Point<RatT, 3>& p,
+    const Point<RatT, 3>& q,
+    const std::array<Point<RatT, 3>, 3>& triangle)
+{
+  typedef typename NumeratorType<RatT>::type IntT;
+
+  // Normals and heights are of degrees 2 and 3 in the numerators, sides in
+  // the plane of degree 4, and comparisons of fractions of those, 8.
+  typedef typename WidenedInt<IntT, 4>::type WideT;
+  typedef typename WidenedInt<IntT, 8>::type FractionT;
+
+  const Intersection<RatT, 3> kNothing{IntersectionType::kNone, {}, {}};
+  const auto a        = scaled_point<WideT>(triangle[0]);
+  const auto b        = scaled_point<WideT>(triangle[1]);
+  const auto c        = scaled_point<WideT>(triangle[2]);
+  const auto p_scaled = scaled_point<WideT>(p);
+  const auto q_scaled = scaled_point<WideT>(q);
+
+  auto normal = cross(b - a, c - a);
+  if (normal == Point<WideT, 3>{WideT(0), WideT(0), WideT(0)}) {
+    return kNothing;
+  }
+
+  // How far a point is on the inside of a directed edge, judged in the
+  // plane.
+  auto inside = [&normal](const Point<WideT, 3>& from,
+                    const Point<WideT, 3>& to, const Point<WideT, 3>& point) {
+    return dot(normal, cross(to - from, point - from));
+  };
+
+  int p_side = orient3d(triangle[0], triangle[1], triangle[2], p);
+  int q_side = orient3d(triangle[0], triangle[1], triangle[2], q);
+  if (p_side * q_side > 0) return kNothing;
+
+  if (p_side != 0 || q_side != 0) {
+    // The segment passes through the plane once, within the triangle if it
+    // passes no edge on the outside.
+    int edge_sides[] = {orient3d(p, q, triangle[0], triangle[1]),
+        orient3d(p, q, triangle[1], triangle[2]),
+        orient3d(p, q, triangle[2], triangle[0])};
+    if (p_side == 0 || q_side == 0) {
+      // It touches the plane at an end, so test that end in the plane.
+      const auto& end = p_side == 0 ? p_scaled : q_scaled;
+      edge_sides[0]   = sign(inside(a, b, end));
+      edge_sides[1]   = sign(inside(b, c, end));
+      edge_sides[2]   = sign(inside(c, a, end));
+    }
+    bool has_positive = false;
+    bool has_negative = false;
+    for (auto side : edge_sides) {
+      has_positive = has_positive || side > 0;
+      has_negative = has_negative || side < 0;
+    }
+    if (has_positive && has_negative) return kNothing;
+
+    auto crossing = crossing_point(
+        p, q, dot(normal, p_scaled - a), dot(normal, q_scaled - a));
+    return make_intersection(crossing, crossing);
+  }
+
+  // Coplanar: clip the segment's parameter range, as fractions, to the inside
+  // of each edge.
+  const std::array<Point<WideT, 3>, 3> corners{a, b, c};
+  FractionT lower_numerator(0);
+  FractionT lower_denominator(1);
+  FractionT upper_numerator(1);
+  FractionT upper_denominator(1);
+  for (std::size_t i = 0; i < 3; ++i) {
+    const auto& from = corners[i];
+    const auto& to   = corners[(i + 1) % 3];
+    FractionT inside_p(inside(from, to, p_scaled));
+    FractionT inside_q(inside(from, to, q_scaled));
+    if (inside_p < FractionT(0) && inside_q < FractionT(0)) return kNothing;
+    if (!(inside_p < FractionT(0)) && !(inside_q < FractionT(0))) continue;
+
+    // The segment crosses the edge's line at inside_p / (inside_p - inside_q).
+    auto numerator   = inside_p;
+    auto denominator = inside_p - inside_q;
+    if (denominator < FractionT(0)) {
+      numerator   = -numerator;
+      denominator = -denominator;
+    }
+    if (inside_p < FractionT(0)) {
+      if (lower_numerator * denominator < numerator * lower_denominator) {
+        lower_numerator   = numerator;
+        lower_denominator = denominator;
+      }
+    }
+    else if (numerator * upper_denominator < upper_numerator * denominator) {
+      upper_numerator   = numerator;
+      upper_denominator = denominator;
+    }
+  }
+  if (upper_numerator * lower_denominator
+      < lower_numerator * upper_denominator) {
+    return kNothing;
+  }
+
+  // A fraction numerator / denominator of the way along the segment.
+  auto along = [&p, &q](const FractionT& numerator,
+                   const FractionT& denominator) {
+    if (numerator == FractionT(0)) return p;
+    if (numerator == denominator) return q;
+    return crossing_point(p, q, numerator, numerator - denominator);
+  };
+  return make_intersection(along(lower_numerator, lower_denominator),
+      along(upper_numerator, upper_denominator));
+}
+
+/// Find where one segment in the plane meets each of many others.
+///
+/// Candidates whose bounding boxes miss the segment's are rejected before any
+/// predicate is evaluated.
+///
+/// \return  The intersections, in the candidates' order.
+///
+template <typename RatT>
+std::vector<Intersection<RatT, 2>> intersections(const Point<RatT, 2>& p1,
+    const Point<RatT, 2>& p2,
+    const std::vector<std::array<Point<RatT, 2>, 2>>& candidates)
+{
+  std::array<Point<RatT, 2>, 2> segment{p1, p2};
+
+  std::vector<Intersection<RatT, 2>> ret;
+  ret.reserve(candidates.size());
+  for (const auto& candidate : candidates) {
+    if (bounds_overlap(segment, candidate)) {
+      ret.push_back(intersection(p1, p2, candidate[0], candidate[1]));
+    }
+    else {
+      ret.push_back({IntersectionType::kNone, {}, {}});
+    }
+  }
+  return ret;
+}
+
+/// Find where one segment in space meets each of many triangles.
+///
+/// Triangles whose bounding boxes miss the segment's are rejected before any
+/// predicate is evaluated.
+///
+/// \return  The intersections, in the triangles' order.
+///
+template <typename RatT>
+std::vector<Intersection<RatT, 3>> intersections(const Point<RatT, 3>& p,
+    const Point<RatT, 3>& q,
+    const std::vector<std::array<Point<RatT, 3>, 3>>& triangles)
+{
+  std::array<Point<RatT, 3>, 2> segment{p, q};
+
+  std::vector<Intersection<RatT, 3>> ret;
+  ret.reserve(triangles.size());
+  for (const auto& triangle : triangles) {
+    if (bounds_overlap(segment, triangle)) {
+      ret.push_back(intersection(p, q, triangle));
+    }
+    else {
+      ret.push_back({IntersectionType::kNone, {}, {}});
+    }
+  }
+  return ret;
+}
+
+/// Find where the line through two points crosses a plane.
+///
+/// \throws  std::domain_error if the line is parallel to the plane (or the
+///          points are equal).
+/// \throws  unrepresentable_operation_error if RatT is a FixedRational that
+///          cannot represent the point.
+///
+template <typename RatT, typename SignedIntT, typename OffsetT>
+Point<RatT, 3> intersection_point(const Point<RatT, 3>& a,
+    const Point<RatT, 3>& b,
+    const Plane<SignedIntT, OffsetT>& plane)
+{
+  typedef typename NumeratorType<RatT>::type IntT;
+  typedef typename std::conditional<(sizeof(IntT) < sizeof(SignedIntT)),
+      SignedIntT,
+      IntT>::type LargerT;
+  typedef typename WidenedInt<LargerT>::type WideT;
+
+  // Heights above the plane, scaled by the normal's length and by the
+  // coordinates' common denominator.
+  const WideT offset(numerator_of(RatT(plane.offset())));
+  auto height = [&plane, &offset](const Point<RatT, 3>& point) {
+    WideT ret(0);
+    for (std::size_t i = 0; i < 3; ++i) {
+      ret += WideT(numerator_of(point[i])) * WideT(plane.normal().get(i));
+    }
+    return ret - offset;
+  };
+  auto a_height = height(a);
+  auto b_height = height(b);
+  if (a_height == b_height) {
+    throw std::domain_error("Line does not cross the plane in a single point");
+  }
+
+  return crossing_point(a, b, a_height, b_height);
+}
+
+/// Find where the lines through two points cross each of many planes.
+///
+/// \throws  std::domain_error if the line is parallel to any of the planes.
+///
+template <typename RatT, typename SignedIntT, typename OffsetT>
+std::vector<Point<RatT, 3>> intersection_points(const Point<RatT, 3>& a,
+    const Point<RatT, 3>& b,
+    const std::vector<Plane<SignedIntT, OffsetT>>& planes)
+{
+  std::vector<Point<RatT, 3>> ret;
+  ret.reserve(planes.size());
+  for (const auto& plane : planes) {
+    ret.push_back(intersection_point(a, b, plane));
+  }
+  return ret;
+}
+
+//-----------
+// Functions
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_INTERSECTIONS_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
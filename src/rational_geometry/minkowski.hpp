@@ -0,0 +1,319 @@
+/// \file     minkowski.hpp
+/// \author   Tim Holt
+///
+/// Exact Minkowski sums of polygons in the plane.
+///
+/// Convex polygons are summed in linear time by merging their edges in angular
+/// order. Other polygons are cut into convex pieces, each pair of pieces is
+/// summed, and the sums are joined by the exact boolean union of Polygon2D, so
+/// the result is exact however thin or degenerate its parts.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_MINKOWSKI_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_MINKOWSKI_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "ConstrainedDelaunay.hpp"
+#include "Point.hpp"
+#include "Polygon2D.hpp"
+#include "angular_order.hpp"
+#include "convex_hull.hpp"
+#include "predicates.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Helper Functions
+//------------------
+
+/// \brief  Compare two edges' directions by angle, counter-clockwise from the
+///         positive x axis, with compare_angles().
+///
+/// The edges' vectors are taken over the coordinates' numerators: in long
+/// long, where compare_angles() multiplies them directly, while they are small
+/// enough, and in WidenedInt otherwise, which holds their products exactly.
+///
+/// \return  -1 if the first edge comes first, 1 if the second does, 0 if they
+///          are parallel and point the same way.
+///
+template <typename RatT>
+int compare_edge_angles(const Point<RatT, 2>& start,
+    const Point<RatT, 2>& end,
+    const Point<RatT, 2>& other_start,
+    const Point<RatT, 2>& other_end)
+{
+  typedef typename NumeratorType<RatT>::type IntT;
+  typedef typename WidenedInt<IntT>::type WideT;
+
+  if constexpr (std::is_integral<IntT>::value) {
+    bool is_small = true;
+    for (const auto* point : {&start, &end, &other_start, &other_end}) {
+      is_small = is_small && is_within_bits(numerator_of((*point)[0]), 29)
+                 && is_within_bits(numerator_of((*point)[1]), 29);
+    }
+    if (is_small) {
+      auto delta = [](const Point<RatT, 2>& from, const Point<RatT, 2>& to,
+                       size_t axis) {
+        return static_cast<long long>(numerator_of(to[axis]))
+               - numerator_of(from[axis]);
+      };
+      return compare_angles(delta(start, end, 0), delta(start, end, 1),
+          delta(other_start, other_end, 0), delta(other_start, other_end, 1));
+    }
+  }
+
+  auto delta = [](const Point<RatT, 2>& from, const Point<RatT, 2>& to,
+                   size_t axis) {
+    return WideT(numerator_of(to[axis])) - numerator_of(from[axis]);
+  };
+  return compare_angles(delta(start, end, 0), delta(start, end, 1),
+      delta(other_start, other_end, 0), delta(other_start, other_end, 1));
+}
+
+/// Find the index of a ring's lowest vertex, the leftmost of those tied.
+///
+template <typename RatT>
+size_t lowest_vertex(const std::vector<Point<RatT, 2>>& ring)
+{
+  size_t ret = 0;
+  for (size_t i = 1; i < ring.size(); ++i) {
+    if (ring[i][1] < ring[ret][1]
+        || (ring[i][1] == ring[ret][1] && ring[i][0] < ring[ret][0])) {
+      ret = i;
+    }
+  }
+  return ret;
+}
+
+/// Check whether a ring is strictly convex, in either winding.
+///
+/// \return  The ring wound counter-clockwise, or empty if it is not strictly
+///          convex.
+///
+template <typename RatT>
+std::vector<Point<RatT, 2>> as_convex_ring(std::vector<Point<RatT, 2>> ring)
+{
+  using namespace std;
+
+  auto hull = convex_hull(ring);
+  if (hull.size() < 3 || hull.size() != ring.size()) return {};
+
+  // The hull starts at the least point; a convex ring is the same cycle.
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    rotate(begin(ring), min_element(begin(ring), end(ring)), end(ring));
+    if (ring == hull) return ring;
+    reverse(begin(ring), end(ring));
+  }
+  return {};
+}
+
+/// Cut a polygon into convex pieces.
+///
+/// A polygon of one convex ring is its own piece. Any other is triangulated,
+/// with its rings' edges as constraints, and the triangles inside it by the
+/// even-odd rule are kept: starting outside, the inside flips across each
+/// constrained edge.
+///
+/// \return  The pieces, each wound counter-clockwise.
+///
+/// \throws  std::invalid_argument if the polygon's rings cross.
+///
+template <typename RatT>
+std::vector<std::vector<Point<RatT, 2>>> convex_pieces(
+    const Polygon2D<RatT>& polygon)
+{
+  using namespace std;
+  typedef ConstrainedDelaunay<RatT> TriangulationT;
+
+  if (polygon.rings().size() == 1) {
+    auto ring = as_convex_ring(polygon.rings().front());
+    if (!ring.empty()) return {ring};
+  }
+
+  vector<Point<RatT, 2>> points;
+  vector<pair<size_t, size_t>> constraints;
+  for (const auto& ring : polygon.rings()) {
+    auto first = points.size();
+    for (size_t i = 0; i < ring.size(); ++i) {
+      points.push_back(ring[i]);
+      constraints.emplace_back(first + i, first + (i + 1) % ring.size());
+    }
+  }
+  TriangulationT triangulation{move(points), constraints};
+
+  const auto& triangles = triangulation.triangles();
+  const auto& neighbors = triangulation.neighbors();
+  vector<size_t> parity(triangles.size(), TriangulationT::kNone);
+  vector<size_t> pending;
+  for (size_t t = 0; t < triangles.size() && pending.empty(); ++t) {
+    for (size_t edge = 0; edge < 3; ++edge) {
+      if (neighbors[t][edge] == TriangulationT::kNone) {
+        parity[t] = triangulation.is_constrained(t, edge) ? 1 : 0;
+        pending.push_back(t);
+        break;
+      }
+    }
+  }
+  while (!pending.empty()) {
+    auto t = pending.back();
+    pending.pop_back();
+    for (size_t edge = 0; edge < 3; ++edge) {
+      auto other = neighbors[t][edge];
+      if (other == TriangulationT::kNone
+          || parity[other] != TriangulationT::kNone) {
+        continue;
+      }
+      parity[other] = parity[t] ^ triangulation.is_constrained(t, edge);
+      pending.push_back(other);
+    }
+  }
+
+  vector<vector<Point<RatT, 2>>> ret;
+  const auto& vertices = triangulation.vertices();
+  for (size_t t = 0; t < triangles.size(); ++t) {
+    if (parity[t] == 1) {
+      ret.push_back({vertices[triangles[t][0]], vertices[triangles[t][1]],
+          vertices[triangles[t][2]]});
+    }
+  }
+  return ret;
+}
+
+// Functions
+//-----------
+
+/// Find the Minkowski sum of two convex polygons.
+///
+/// Each polygon's edges are already in angular order from its lowest vertex,
+/// so the sum's edges are found by merging the two sequences, comparing edges
+/// exactly by compare_edge_angles(). Parallel edges are merged into one.
+///
+/// \param  l_op  A convex polygon's vertices, counter-clockwise. It may also
+///               be a single point or a segment.
+/// \param  r_op  As l_op.
+///
+/// \return  The sum's vertices, counter-clockwise from its lowest, with no
+///          collinear vertices; or, if either input is a point or a segment,
+///          the convex hull of the vertices' pairwise sums. Empty if either
+///          input is.
+///
+template <typename RatT>
+std::vector<Point<RatT, 2>> minkowski_sum(
+    const std::vector<Point<RatT, 2>>& l_op,
+    const std::vector<Point<RatT, 2>>& r_op)
+{
+  using namespace std;
+
+  if (l_op.empty() || r_op.empty()) return {};
+  if (l_op.size() < 3 || r_op.size() < 3) {
+    vector<Point<RatT, 2>> sums;
+    for (const auto& l_point : l_op) {
+      for (const auto& r_point : r_op) {
+        sums.push_back(l_point + r_point);
+      }
+    }
+    return convex_hull(move(sums));
+  }
+
+  auto l_size  = l_op.size();
+  auto r_size  = r_op.size();
+  auto l_start = lowest_vertex(l_op);
+  auto r_start = lowest_vertex(r_op);
+
+  auto l_at = [&](size_t i) -> const Point<RatT, 2>& {
+    return l_op[(l_start + i) % l_size];
+  };
+  auto r_at = [&](size_t i) -> const Point<RatT, 2>& {
+    return r_op[(r_start + i) % r_size];
+  };
+
+  vector<Point<RatT, 2>> ret;
+  ret.reserve(l_size + r_size);
+  size_t i = 0;
+  size_t j = 0;
+  while (i < l_size || j < r_size) {
+    auto sum = l_at(i) + r_at(j);
+
+    // Drop a vertex left between collinear edges.
+    if (ret.size() >= 2
+        && orient2d(ret[ret.size() - 2], ret.back(), sum) == 0) {
+      ret.pop_back();
+    }
+    ret.push_back(sum);
+
+    int order = i == l_size ? 1
+                : j == r_size
+                    ? -1
+                    : compare_edge_angles(
+                        l_at(i), l_at(i + 1), r_at(j), r_at(j + 1));
+    if (order <= 0) ++i;
+    if (order >= 0) ++j;
+  }
+
+  // The last vertex, and the first, may also lie between collinear edges.
+  if (ret.size() >= 3
+      && orient2d(ret[ret.size() - 2], ret.back(), ret[0]) == 0) {
+    ret.pop_back();
+  }
+  if (ret.size() >= 3 && orient2d(ret.back(), ret[0], ret[1]) == 0) {
+    ret.erase(ret.begin());
+  }
+  return ret;
+}
+
+/// Find the Minkowski sum of two polygons, which need not be convex.
+///
+/// Each polygon is cut into convex pieces (see convex_pieces()), each pair of
+/// pieces is summed, and the sums are joined by boolean union, pairwise in a
+/// balanced tree so each union stays small.
+///
+/// \return  The sum, in the form given by Polygon2D's boolean operations.
+///
+/// \throws  std::invalid_argument if either polygon's rings cross.
+///
+template <typename RatT>
+Polygon2D<RatT> minkowski_sum(
+    const Polygon2D<RatT>& l_op, const Polygon2D<RatT>& r_op)
+{
+  auto l_pieces = convex_pieces(l_op);
+  auto r_pieces = convex_pieces(r_op);
+
+  std::vector<Polygon2D<RatT>> sums;
+  sums.reserve(l_pieces.size() * r_pieces.size());
+  for (const auto& l_piece : l_pieces) {
+    for (const auto& r_piece : r_pieces) {
+      sums.push_back(Polygon2D<RatT>{minkowski_sum(l_piece, r_piece)});
+    }
+  }
+  if (sums.empty()) return Polygon2D<RatT>{};
+
+  while (sums.size() > 1) {
+    for (size_t i = 0; 2 * i < sums.size(); ++i) {
+      sums[i] = 2 * i + 1 < sums.size() ? sums[2 * i] | sums[2 * i + 1]
+                                        : std::move(sums[2 * i]);
+    }
+    sums.resize((sums.size() + 1) / 2);
+  }
+  return sums.front() | Polygon2D<RatT>{};
+}
+
+//-----------
+// Functions
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_MINKOWSKI_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
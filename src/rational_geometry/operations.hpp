@@ -12,11 +12,16 @@
 // Includes
 //----------
 
+#include <cstddef>
 #include <utility>
 
 //----------
 // Includes
 
+namespace rational_geometry {
+
+// Functions
+//-----------
 
 /// Find the dot product (<i>scalar</i> product) between two vectors.
 ///
@@ -39,7 +44,7 @@ template <typename RatT_l,
     std::size_t kDimension,
     template <typename, size_t> typename TContainer_l,
     template <typename, size_t> typename TContainer_r>
-auto dot(const TContainer_l<RatT_l, kDimension>& l_op,
+constexpr auto dot(const TContainer_l<RatT_l, kDimension>& l_op,
     const TContainer_r<RatT_r, kDimension>& r_op)
 {
   using std::declval;
@@ -73,7 +78,8 @@ auto dot(const TContainer_l<RatT_l, kDimension>& l_op,
 template <typename RatT_l,
     typename RatT_r,
     template <typename, size_t> typename TContainer>
-auto cross(const TContainer<RatT_l, 3>& l_op, const TContainer<RatT_r, 3>& r_op)
+constexpr auto cross(
+    const TContainer<RatT_l, 3>& l_op, const TContainer<RatT_r, 3>& r_op)
 {
   using std::declval;
   // clang-format off
@@ -89,6 +95,11 @@ auto cross(const TContainer<RatT_l, 3>& l_op, const TContainer<RatT_r, 3>& r_op)
   return ret;
 }
 
+//-----------
+// Functions
+
+} // namespace rational_geometry
+
 #endif // _RATIONAL_GEOMETRY_OPERATIONS_HPP_INCLUDED_
 
 // vim:set et ts=2 sw=2 sts=2:
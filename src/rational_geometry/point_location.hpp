@@ -0,0 +1,598 @@
+/// \file     point_location.hpp
+/// \author   Tim Holt
+///
+/// Exact point-in-polygon and point-in-polyhedron queries, singly and through
+/// preprocessed locators for many queries against the same shape.
+///
+/// Every test counts the crossings of a ray from the point with a half-open
+/// rule: an edge counts only if the point's coordinate lies in the edge's
+/// [least, greatest) range. This acts as an exact, consistent perturbation of
+/// the point, so rays through vertices, along edges, or shared between faces
+/// are never miscounted.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_POINT_LOCATION_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_POINT_LOCATION_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "AABB.hpp"
+#include "BoundingVolumeHierarchy.hpp"
+#include "BspTree.hpp"
+#include "Point.hpp"
+#include "Polygon2D.hpp"
+#include "Polyhedron.hpp"
+#include "predicates.hpp"
+#include "spatial_order.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Types
+//-------
+
+/// Where a point lies relative to a polygon or polyhedron.
+///
+enum class Location
+{
+  kOutside,
+  kBoundary,
+  kInside
+};
+
+// Helper Functions
+//------------------
+
+/// Test whether a point lies on the closed segment between two others.
+///
+template <typename RatT>
+bool is_on_segment(const Point<RatT, 2>& point,
+    const Point<RatT, 2>& start,
+    const Point<RatT, 2>& end)
+{
+  if (orient2d(start, end, point) != 0) return false;
+  for (size_t i = 0; i < 2; ++i) {
+    if (point[i] < std::min(start[i], end[i])
+        || std::max(start[i], end[i]) < point[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// \brief  Test whether a ray from a point, straight up (toward +y), crosses
+///         the segment between two others, under the half-open rule.
+///
+template <typename RatT>
+bool is_crossed_above(const Point<RatT, 2>& point,
+    const Point<RatT, 2>& start,
+    const Point<RatT, 2>& end)
+{
+  const auto& left  = start[0] < end[0] ? start : end;
+  const auto& right = start[0] < end[0] ? end : start;
+  return !(point[0] < left[0]) && point[0] < right[0]
+         && orient2d(left, right, point) < 0;
+}
+
+/// \brief  Get a Polyhedron face's outer ring's normal, by Newell's method,
+///         scaled by the square of its coordinates' common denominator.
+///
+/// It is the shared scaled_newell_normal(), so it is exact for any face, and
+/// is reduced by its components' common factor where they fit in long long,
+/// so face_side() more often takes its fast path.
+///
+template <typename RatT>
+Point<typename WidenedInt<typename NumeratorType<RatT>::type, 3>::type, 3>
+scaled_face_normal(const Polyhedron<RatT>& polyhedron, size_t face)
+{
+  typedef typename NumeratorType<RatT>::type IntT;
+  typedef typename WidenedInt<IntT, 3>::type WideT;
+
+  auto ret = scaled_newell_normal(
+      polyhedron.vertices(), polyhedron.faces()[face].front());
+  if constexpr (std::is_integral<IntT>::value) {
+    if (is_within_bits(ret[0], 62) && is_within_bits(ret[1], 62)
+        && is_within_bits(ret[2], 62)) {
+      auto reduced = reduced_direction<long long>(ret);
+      for (size_t i = 0; i < 3; ++i) {
+        ret[i] = WideT(reduced.get(i));
+      }
+    }
+  }
+  return ret;
+}
+
+/// \brief  Get the sign of a point's height above the plane of a face, along
+///         the face's scaled_face_normal().
+///
+/// The height is a sum of products of the normal, twice as wide as the
+/// numerators, with offsets between them, so it is evaluated in the normal's
+/// type, wide enough for three factors. Small normals and offsets take a fast
+/// path in long long.
+///
+template <typename RatT, typename WideT>
+int face_side(const Polyhedron<RatT>& polyhedron,
+    size_t face,
+    const Point<WideT, 3>& normal,
+    const Point<RatT, 3>& point)
+{
+  const auto& corner =
+      polyhedron.vertices()[polyhedron.faces()[face].front().front()];
+  if constexpr (std::is_integral<typename NumeratorType<RatT>::type>::value) {
+    bool is_small = true;
+    for (size_t i = 0; i < 3 && is_small; ++i) {
+      is_small = is_within_bits(normal[i], 40)
+                 && is_within_bits(numerator_of(point[i]), 20)
+                 && is_within_bits(numerator_of(corner[i]), 20);
+    }
+    if (is_small) {
+      long long height = 0;
+      for (size_t i = 0; i < 3; ++i) {
+        height += static_cast<long long>(normal[i])
+                  * (static_cast<long long>(numerator_of(point[i]))
+                      - numerator_of(corner[i]));
+      }
+      return sign(height);
+    }
+  }
+
+  WideT height(0);
+  for (size_t i = 0; i < 3; ++i) {
+    height += normal[i]
+              * (WideT(numerator_of(point[i])) - numerator_of(corner[i]));
+  }
+  return sign(height);
+}
+
+/// \brief  Find where a point lies relative to a face of a polyhedron, and
+///         whether a ray from it toward +x crosses the face.
+///
+/// \param  normal  The face's scaled_face_normal().
+///
+/// \return  kBoundary if the point is on the face, kInside if the ray crosses
+///          it, kOutside otherwise.
+///
+template <typename RatT, typename WideT>
+Location locate_on_face(const Polyhedron<RatT>& polyhedron,
+    size_t face,
+    const Point<WideT, 3>& normal,
+    const Point<RatT, 3>& point)
+{
+  auto side = face_side(polyhedron, face, normal, point);
+
+  const auto& vertices = polyhedron.vertices();
+  const auto& rings    = polyhedron.faces()[face];
+
+  if (side == 0) {
+    // On the face's plane: look along the normal's largest component.
+    using std::abs;
+    size_t axis = 0;
+    for (size_t i = 1; i < 3; ++i) {
+      if (abs(normal[axis]) < abs(normal[i])) axis = i;
+    }
+    if (normal[axis] == 0) return Location::kOutside;
+
+    auto projected = project(point, axis);
+    bool is_inside = false;
+    for (const auto& ring : rings) {
+      for (size_t i = 0; i < ring.size(); ++i) {
+        auto start = project(vertices[ring[i]], axis);
+        auto end   = project(vertices[ring[(i + 1) % ring.size()]], axis);
+        if (is_on_segment(projected, start, end)) return Location::kBoundary;
+        is_inside = is_inside != is_crossed_above(projected, start, end);
+      }
+    }
+    return is_inside ? Location::kBoundary : Location::kOutside;
+  }
+
+  // The ray meets the plane ahead of the point only if the point is below
+  // the plane and the normal faces +x, or the reverse.
+  if (normal[0] == 0 || (side < 0) != (0 < normal[0])) {
+    return Location::kOutside;
+  }
+
+  auto projected = project(point, 0);
+  bool is_inside = false;
+  for (const auto& ring : rings) {
+    for (size_t i = 0; i < ring.size(); ++i) {
+      is_inside = is_inside
+                  != is_crossed_above(projected, project(vertices[ring[i]], 0),
+                      project(vertices[ring[(i + 1) % ring.size()]], 0));
+    }
+  }
+  return is_inside ? Location::kInside : Location::kOutside;
+}
+
+template <typename RatT>
+Location locate_on_face(const Polyhedron<RatT>& polyhedron,
+    size_t face,
+    const Point<RatT, 3>& point)
+{
+  return locate_on_face(
+      polyhedron, face, scaled_face_normal(polyhedron, face), point);
+}
+
+// Functions
+//-----------
+
+/// Find where a point lies relative to rings, by the even-odd rule.
+///
+template <typename RatT>
+Location locate(const Point<RatT, 2>& point,
+    const std::vector<std::vector<Point<RatT, 2>>>& rings)
+{
+  bool is_inside = false;
+  for (const auto& ring : rings) {
+    for (size_t i = 0; i < ring.size(); ++i) {
+      const auto& start = ring[i];
+      const auto& end   = ring[(i + 1) % ring.size()];
+      if (is_on_segment(point, start, end)) return Location::kBoundary;
+      is_inside = is_inside != is_crossed_above(point, start, end);
+    }
+  }
+  return is_inside ? Location::kInside : Location::kOutside;
+}
+
+/// Find where a point lies relative to a polygon.
+///
+template <typename RatT>
+Location locate(const Point<RatT, 2>& point, const Polygon2D<RatT>& polygon)
+{
+  return locate(point, polygon.rings());
+}
+
+/// \brief  Count the times a ring winds counter-clockwise around a point, less
+///         the times it winds clockwise.
+///
+/// \note  The point must not be on the ring.
+///
+template <typename RatT>
+int winding_number(
+    const Point<RatT, 2>& point, const std::vector<Point<RatT, 2>>& ring)
+{
+  int ret = 0;
+  for (size_t i = 0; i < ring.size(); ++i) {
+    const auto& start = ring[i];
+    const auto& end   = ring[(i + 1) % ring.size()];
+    if (is_crossed_above(point, start, end)) ret += end[0] < start[0] ? 1 : -1;
+  }
+  return ret;
+}
+
+/// Find where a point lies relative to a closed polyhedron.
+///
+template <typename RatT>
+Location locate(const Point<RatT, 3>& point, const Polyhedron<RatT>& polyhedron)
+{
+  bool is_inside = false;
+  for (size_t face = 0; face < polyhedron.faces().size(); ++face) {
+    auto found = locate_on_face(polyhedron, face, point);
+    if (found == Location::kBoundary) return found;
+    is_inside = is_inside != (found == Location::kInside);
+  }
+  return is_inside ? Location::kInside : Location::kOutside;
+}
+
+//-----------
+// Functions
+
+// Class Template Declarations
+//-----------------------------
+
+/// \brief  A polygon preprocessed into vertical slabs, for locating many
+///         points in logarithmic time each.
+///
+/// The slabs lie between consecutive distinct x coordinates of the vertices.
+/// No edge has a vertex inside a slab, so those crossing it are kept in order
+/// from bottom to top, and a point is located by a binary search for its
+/// slab, then one for its place among the slab's edges. Storage can grow
+/// quadratically with the number of edges, though it seldom does.
+///
+/// \note  The polygon's edges must not cross.
+///
+template <typename RatT>
+class PolygonLocator
+{
+ public:
+  // TYPES
+  typedef Point<RatT, 2> PointT;
+
+ protected:
+  // INTERNAL STATE
+  std::vector<std::array<PointT, 2>> edges_;
+  std::vector<RatT> xs_;
+
+  /// Each slab's run of slab_edges_, bottom to top, marked by offsets.
+  std::vector<size_t> slab_offsets_;
+  std::vector<size_t> slab_edges_;
+
+  /// The y ranges of vertical edges and vertices at each x in xs_, sorted.
+  std::vector<size_t> column_offsets_;
+  std::vector<std::array<RatT, 2>> column_spans_;
+
+ public:
+  // CONSTRUCTORS
+  PolygonLocator();
+  explicit PolygonLocator(const Polygon2D<RatT>& polygon);
+
+  // ACCESSORS
+  size_t slab_count() const;
+  Location locate(const PointT& point) const;
+  std::vector<Location> locate(
+      const std::vector<PointT>& points, size_t thread_count = 1) const;
+};
+
+/// \brief  A polyhedron's faces in a bounding volume hierarchy, for locating
+///         many points by ray parity.
+///
+/// Only faces whose boxes a point's ray toward +x meets are tested, so each
+/// query touches a handful of faces rather than all of them. Each face's
+/// scaled_face_normal() is found once, when the locator is built.
+///
+template <typename RatT>
+class PolyhedronLocator
+{
+ public:
+  // TYPES
+  typedef Point<RatT, 3> PointT;
+  typedef Point<
+      typename WidenedInt<typename NumeratorType<RatT>::type, 3>::type, 3>
+      NormalT;
+
+ protected:
+  // INTERNAL STATE
+  Polyhedron<RatT> polyhedron_;
+  BoundingVolumeHierarchy<RatT, 3> faces_;
+  std::vector<NormalT> normals_;
+
+ public:
+  // CONSTRUCTORS
+  PolyhedronLocator();
+  explicit PolyhedronLocator(Polyhedron<RatT> polyhedron);
+
+  // ACCESSORS
+  const Polyhedron<RatT>& polyhedron() const;
+  Location locate(const PointT& point) const;
+  std::vector<Location> locate(
+      const std::vector<PointT>& points, size_t thread_count = 1) const;
+};
+
+// Class Template Definitions
+//----------------------------
+//   PolygonLocator
+//  ----------------
+
+/// Creates a locator of an empty polygon.
+///
+template <typename RatT>
+PolygonLocator<RatT>::PolygonLocator() : slab_offsets_{0}, column_offsets_{0}
+{
+}
+
+template <typename RatT>
+PolygonLocator<RatT>::PolygonLocator(const Polygon2D<RatT>& polygon)
+    : PolygonLocator()
+{
+  for (const auto& ring : polygon.rings()) {
+    for (size_t i = 0; i < ring.size(); ++i) {
+      const auto& start = ring[i];
+      const auto& end   = ring[(i + 1) % ring.size()];
+      edges_.push_back(end < start ? std::array<PointT, 2>{end, start}
+                                   : std::array<PointT, 2>{start, end});
+      xs_.push_back(start[0]);
+    }
+  }
+  std::sort(xs_.begin(), xs_.end());
+  xs_.erase(std::unique(xs_.begin(), xs_.end()), xs_.end());
+
+  auto slab_of = [this](const RatT& x) -> size_t {
+    return std::lower_bound(xs_.begin(), xs_.end(), x) - xs_.begin();
+  };
+
+  // Columns: each vertex, and each vertical edge, as a y range.
+  std::vector<std::vector<std::array<RatT, 2>>> columns(xs_.size());
+  std::vector<std::vector<size_t>> slabs(xs_.empty() ? 0 : xs_.size() - 1);
+  for (size_t i = 0; i < edges_.size(); ++i) {
+    const auto& left  = edges_[i][0];
+    const auto& right = edges_[i][1];
+    auto first        = slab_of(left[0]);
+    columns[first].push_back({left[1], left[1]});
+    columns[slab_of(right[0])].push_back({right[1], right[1]});
+    if (left[0] == right[0]) {
+      columns[first].push_back({left[1], right[1]});
+      continue;
+    }
+    for (auto slab = first; slab < slab_of(right[0]); ++slab) {
+      slabs[slab].push_back(i);
+    }
+  }
+
+  for (auto& column : columns) {
+    std::sort(column.begin(), column.end());
+    // Merge overlapping spans, so their upper ends are sorted too.
+    size_t kept = 0;
+    for (const auto& span : column) {
+      if (kept != 0 && !(column[kept - 1][1] < span[0])) {
+        column[kept - 1][1] = std::max(column[kept - 1][1], span[1]);
+      }
+      else {
+        column[kept++] = span;
+      }
+    }
+    column_spans_.insert(
+        column_spans_.end(), column.begin(), column.begin() + kept);
+    column_offsets_.push_back(column_spans_.size());
+  }
+
+  // Edges in a slab never cross, so one's endpoints lie on one side of the
+  // other's line, which tells which is higher.
+  auto is_below = [this](size_t l_op, size_t r_op) {
+    const auto& l_edge = edges_[l_op];
+    const auto& r_edge = edges_[r_op];
+    int start_side     = orient2d(l_edge[0], l_edge[1], r_edge[0]);
+    int end_side       = orient2d(l_edge[0], l_edge[1], r_edge[1]);
+    if (start_side >= 0 && end_side >= 0 && (start_side || end_side)) {
+      return true;
+    }
+    if (start_side <= 0 && end_side <= 0) return false;
+    return orient2d(r_edge[0], r_edge[1], l_edge[0]) <= 0
+           && orient2d(r_edge[0], r_edge[1], l_edge[1]) <= 0;
+  };
+  for (auto& slab : slabs) {
+    std::sort(slab.begin(), slab.end(), is_below);
+    slab_edges_.insert(slab_edges_.end(), slab.begin(), slab.end());
+    slab_offsets_.push_back(slab_edges_.size());
+  }
+}
+
+template <typename RatT>
+size_t PolygonLocator<RatT>::slab_count() const
+{
+  return slab_offsets_.size() - 1;
+}
+
+template <typename RatT>
+Location PolygonLocator<RatT>::locate(const PointT& point) const
+{
+  auto column = std::lower_bound(xs_.begin(), xs_.end(), point[0]);
+  if (column == xs_.end()) return Location::kOutside;
+
+  // On a column, the point may lie on a vertex or vertical edge.
+  auto slab = static_cast<size_t>(column - xs_.begin());
+  if (*column == point[0]) {
+    auto first = column_spans_.begin() + column_offsets_[slab];
+    auto last  = column_spans_.begin() + column_offsets_[slab + 1];
+    auto span  = std::lower_bound(first, last, point[1],
+        [](const std::array<RatT, 2>& span, const RatT& y) {
+          return span[1] < y;
+        });
+    if (span != last && !(point[1] < (*span)[0])) return Location::kBoundary;
+  }
+  else if (slab == 0) {
+    return Location::kOutside;
+  }
+  else {
+    --slab;
+  }
+  if (slab == slab_count()) return Location::kOutside;
+
+  // Count the slab's edges strictly below the point; those above it cross
+  // its upward ray.
+  auto first = slab_edges_.begin() + slab_offsets_[slab];
+  auto last  = slab_edges_.begin() + slab_offsets_[slab + 1];
+  auto above = std::partition_point(first, last, [&](size_t edge) {
+    return 0 < orient2d(edges_[edge][0], edges_[edge][1], point);
+  });
+  if (above != last
+      && orient2d(edges_[*above][0], edges_[*above][1], point) == 0) {
+    return Location::kBoundary;
+  }
+  return (last - above) % 2 == 1 ? Location::kInside : Location::kOutside;
+}
+
+/// Locate each of many points.
+///
+/// Given more than one thread, the points are dealt out in contiguous runs,
+/// one to each thread.
+///
+/// \param  thread_count  How many threads may locate points at once.
+///
+template <typename RatT>
+std::vector<Location> PolygonLocator<RatT>::locate(
+    const std::vector<PointT>& points, size_t thread_count) const
+{
+  std::vector<Location> ret(points.size());
+  for_each_block(points.size(), thread_count, 1,
+      [&](size_t, size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+          ret[i] = locate(points[i]);
+        }
+      });
+  return ret;
+}
+
+//   PolyhedronLocator
+//  -------------------
+
+/// Creates a locator of an empty polyhedron.
+///
+template <typename RatT>
+PolyhedronLocator<RatT>::PolyhedronLocator()
+{
+}
+
+template <typename RatT>
+PolyhedronLocator<RatT>::PolyhedronLocator(Polyhedron<RatT> polyhedron)
+    : polyhedron_(std::move(polyhedron))
+{
+  std::vector<AABB<RatT, 3>> boxes;
+  for (const auto& face : polyhedron_.faces()) {
+    boxes.emplace_back();
+    for (const auto& ring : face) {
+      for (auto vertex : ring) {
+        boxes.back().extend(polyhedron_.vertices()[vertex]);
+      }
+    }
+    normals_.push_back(scaled_face_normal(polyhedron_, normals_.size()));
+  }
+  faces_ = BoundingVolumeHierarchy<RatT, 3>{std::move(boxes)};
+}
+
+template <typename RatT>
+const Polyhedron<RatT>& PolyhedronLocator<RatT>::polyhedron() const
+{
+  return polyhedron_;
+}
+
+template <typename RatT>
+Location PolyhedronLocator<RatT>::locate(const PointT& point) const
+{
+  bool is_inside = false;
+  PointT ray{RatT(1), RatT(0), RatT(0)};
+  for (auto face : faces_.hit_by(point, ray)) {
+    auto found = locate_on_face(polyhedron_, face, normals_[face], point);
+    if (found == Location::kBoundary) return found;
+    is_inside = is_inside != (found == Location::kInside);
+  }
+  return is_inside ? Location::kInside : Location::kOutside;
+}
+
+/// Locate each of many points.
+///
+/// Given more than one thread, the points are dealt out in contiguous runs,
+/// one to each thread.
+///
+/// \param  thread_count  How many threads may locate points at once.
+///
+template <typename RatT>
+std::vector<Location> PolyhedronLocator<RatT>::locate(
+    const std::vector<PointT>& points, size_t thread_count) const
+{
+  std::vector<Location> ret(points.size());
+  for_each_block(points.size(), thread_count, 1,
+      [&](size_t, size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+          ret[i] = locate(points[i]);
+        }
+      });
+  return ret;
+}
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_POINT_LOCATION_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
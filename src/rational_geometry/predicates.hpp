@@ -0,0 +1,718 @@
+/// \file     predicates.hpp
+/// \author   Tim Holt
+///
+/// Exact geometric predicates: orientation and in-circle/in-sphere tests.
+///
+/// Each predicate answers with only a sign (-1, 0 or 1). For integer and
+/// FixedRational coordinates, the sign is found from the numerators alone, as
+/// integers: in long long when they are small enough, and otherwise exactly,
+/// in a WideInteger wide enough for the whole determinant.
+///
+/// \sa  https://www.cs.cmu.edu/~quake/robust.html, whose sign conventions
+///      these follow.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_PREDICATES_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_PREDICATES_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "Direction.hpp"
+#include "FixedRational.hpp"
+#include "Matrix.hpp"
+#include "Operations.hpp"
+#include "Point.hpp"
+#include "WideInteger.hpp"
+#include "common_factor.hpp"
+#include "unrepresentable_operation_error.hpp"
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Helper Types
+//--------------
+
+/// The integer type of a rational type's numerators.
+///
+template <typename RatT>
+struct NumeratorType
+{
+  typedef RatT type;
+};
+
+template <typename SignedIntT, SignedIntT kDenominator, bool kDoThrowOnInexact>
+struct NumeratorType<FixedRational<SignedIntT, kDenominator, kDoThrowOnInexact>>
+{
+  typedef SignedIntT type;
+};
+
+/// \brief  An integer type in which sums of products of IntT numerators are
+///         evaluated exactly.
+///
+/// It holds any sum of up to 256 products, each of kFactors differences of
+/// IntT values, without overflow: long long where that is wide enough, and a
+/// WideInteger otherwise. Types that are not integers are their own widened
+/// type.
+///
+template <typename IntT, int kFactors = 2>
+struct WidenedInt
+{
+  static constexpr int kDigits =
+      kFactors * (std::numeric_limits<IntT>::digits + 1) + 8;
+
+  typedef typename std::conditional<!std::is_integral<IntT>::value,
+      IntT,
+      typename std::conditional<
+          (kDigits <= std::numeric_limits<long long>::digits),
+          long long,
+          WideInteger<(kDigits / 32 + 1) * 32>>::type>::type type;
+};
+
+/// The number of value bits, excluding the sign, of a standard integer type or
+/// a WideInteger.
+///
+template <typename IntT>
+struct IntegerDigits
+{
+  static constexpr int value = std::numeric_limits<IntT>::digits;
+};
+
+template <std::size_t kBits>
+struct IntegerDigits<WideInteger<kBits>>
+{
+  static constexpr int value = static_cast<int>(kBits) - 1;
+};
+
+/// \brief  An integer type in which a difference of two products, each of an
+///         IntT numerator and a WideT value, is evaluated exactly.
+///
+/// Types that are not integers are their own product type.
+///
+template <typename IntT, typename WideT>
+struct ProductInt
+{
+  static constexpr int kDigits =
+      IntegerDigits<IntT>::value + IntegerDigits<WideT>::value + 2;
+
+  typedef typename std::conditional<!std::is_integral<IntT>::value,
+      IntT,
+      typename std::conditional<
+          (kDigits <= std::numeric_limits<long long>::digits),
+          long long,
+          WideInteger<(kDigits / 32 + 1) * 32>>::type>::type type;
+};
+
+// Helper Functions
+//------------------
+
+/// Get the sign of a value, as -1, 0 or 1.
+///
+template <typename RatT>
+int sign(const RatT& value)
+{
+  const RatT zero(0);
+  return (zero < value) - (value < zero);
+}
+
+/// Get a value's nearest long double, for estimates only.
+///
+template <typename RatT>
+long double approximate(const RatT& value)
+{
+  if constexpr (std::is_arithmetic<RatT>::value) {
+    return static_cast<long double>(value);
+  }
+  else {
+    return value.as_long_double();
+  }
+}
+
+/// Get a value's numerator over its type's common denominator; a value with
+/// no denominator is its own numerator.
+///
+template <typename RatT>
+typename NumeratorType<RatT>::type numerator_of(const RatT& value)
+{
+  if constexpr (std::is_same<typename NumeratorType<RatT>::type,
+                    RatT>::value) {
+    return value;
+  }
+  else {
+    return value.numerator();
+  }
+}
+
+/// Get the value with a numerator over RatT's common denominator; the inverse
+/// of numerator_of().
+///
+template <typename RatT>
+RatT from_numerator(const typename NumeratorType<RatT>::type& numerator)
+{
+  if constexpr (std::is_same<typename NumeratorType<RatT>::type,
+                    RatT>::value) {
+    return numerator;
+  }
+  else {
+    return RatT(numerator, RatT().denominator());
+  }
+}
+
+/// \brief  Convert an exact, wide value to a narrower integer type.
+///
+/// \throws  std::overflow_error if the value is beyond IntT's range.
+///
+template <typename IntT, typename WideT>
+IntT narrowed(const WideT& value)
+{
+  if constexpr (std::is_same<IntT, WideT>::value) {
+    return value;
+  }
+  else {
+    if (value < WideT(std::numeric_limits<IntT>::min())
+        || WideT(std::numeric_limits<IntT>::max()) < value) {
+      throw std::overflow_error("Value is beyond the range of its type");
+    }
+    return static_cast<IntT>(value);
+  }
+}
+
+/// \brief  Determine if a value's magnitude is less than 2^bits, so that
+///         arithmetic on it may take a fast path in long long.
+///
+/// Values of types that are not integers never are.
+///
+template <typename ValueT>
+bool is_within_bits(const ValueT& value, int bits)
+{
+  if constexpr (std::is_integral<ValueT>::value) {
+    const long long limit = 1LL << bits;
+    return -limit < value && value < limit;
+  }
+  else {
+    return false;
+  }
+}
+
+template <std::size_t kBits>
+bool is_within_bits(const WideInteger<kBits>& value, int bits)
+{
+  const WideInteger<kBits> limit(1LL << bits);
+  return -limit < value && value < limit;
+}
+
+/// \brief  Get the squared distance between two points, scaled by the square
+///         of their coordinates' common denominator.
+///
+/// Scaled distances order just as the distances do, and are summed over the
+/// numerators, as integers wide enough for any of them, so none of the
+/// products need be representable.
+///
+template <typename RatT, size_t kDimension>
+typename WidenedInt<typename NumeratorType<RatT>::type>::type
+scaled_squared_distance(
+    const Point<RatT, kDimension>& a, const Point<RatT, kDimension>& b)
+{
+  typedef typename NumeratorType<RatT>::type IntT;
+  typedef typename WidenedInt<IntT>::type WideT;
+
+  // Offsets under 2^28 square and sum within long long, in few dimensions.
+  if constexpr (std::is_integral<IntT>::value && kDimension <= 64) {
+    long long sum = 0;
+    bool is_small = true;
+    for (size_t i = 0; i < kDimension && is_small; ++i) {
+      auto l_op = numerator_of(a[i]);
+      auto r_op = numerator_of(b[i]);
+      is_small  = is_within_bits(l_op, 62) && is_within_bits(r_op, 62);
+      if (is_small) {
+        auto offset = static_cast<long long>(l_op) - r_op;
+        is_small    = is_within_bits(offset, 28);
+        sum += offset * offset;
+      }
+    }
+    if (is_small) return WideT(sum);
+  }
+
+  WideT ret(0);
+  for (size_t i = 0; i < kDimension; ++i) {
+    WideT offset = WideT(numerator_of(a[i])) - WideT(numerator_of(b[i]));
+    ret += offset * offset;
+  }
+  return ret;
+}
+
+/// \brief  Get the Direction of an exact, wide vector, reduced by its
+///         components' common factor before narrowing them to IntT.
+///
+/// \throws  std::overflow_error if a reduced component is beyond IntT's range.
+///
+template <typename IntT, typename WideT, std::size_t kDimension>
+Direction<IntT, kDimension> reduced_direction(
+    const Point<WideT, kDimension>& vector)
+{
+  std::array<IntT, kDimension> values{};
+  if constexpr (std::is_integral<IntT>::value) {
+    bool is_small = true;
+    for (std::size_t i = 0; i < kDimension; ++i) {
+      is_small = is_small && is_within_bits(vector[i], 62);
+    }
+    if (is_small) {
+      long long factor = 0;
+      for (std::size_t i = 0; i < kDimension; ++i) {
+        factor = gcd(factor, static_cast<long long>(vector[i]));
+      }
+      if (factor == 0) return Direction<IntT, kDimension>{};
+
+      for (std::size_t i = 0; i < kDimension; ++i) {
+        values[i] = narrowed<IntT>(static_cast<long long>(vector[i]) / factor);
+      }
+      return Direction<IntT, kDimension>{values};
+    }
+
+    WideT factor(0);
+    for (std::size_t i = 0; i < kDimension; ++i) {
+      factor = gcd(factor, vector[i]);
+    }
+    if (factor == WideT(0)) return Direction<IntT, kDimension>{};
+
+    for (std::size_t i = 0; i < kDimension; ++i) {
+      values[i] = narrowed<IntT>(vector[i] / factor);
+    }
+  }
+  else {
+    for (std::size_t i = 0; i < kDimension; ++i) {
+      values[i] = vector[i];
+    }
+  }
+  return Direction<IntT, kDimension>{values};
+}
+
+/// \brief  Get the value of an exact, wide numerator over RatT's common
+///         denominator, divided by a wide divisor.
+///
+/// \throws  unrepresentable_operation_error if RatT is a FixedRational that
+///          cannot represent the quotient.
+/// \throws  std::overflow_error if the quotient is beyond RatT's range.
+///
+template <typename RatT, typename WideT>
+RatT from_numerator_ratio(const WideT& numerator, const WideT& divisor)
+{
+  typedef typename NumeratorType<RatT>::type IntT;
+
+  if constexpr (std::is_integral<IntT>::value) {
+    if (numerator % divisor != WideT(0)) {
+      WideT factor = abs(divisor / gcd(numerator, divisor));
+      throw unrepresentable_operation_error<IntT>(
+          "Quotient is not representable", 1, narrowed<IntT>(factor));
+    }
+  }
+  return from_numerator<RatT>(narrowed<IntT>(numerator / divisor));
+}
+
+/// \brief  Find where the segment between two points crosses a boundary, given
+///         their heights above it, of opposite signs.
+///
+/// The heights need only be in proportion to the true ones, so they may be
+/// found over the coordinates' numerators, as integers. Each coordinate is
+/// then formed over the numerators in a ProductInt and divided once, so no
+/// product need be representable, only the point itself.
+///
+/// \throws  unrepresentable_operation_error if RatT is a FixedRational that
+///          cannot represent the point.
+/// \throws  std::overflow_error if a coordinate is beyond RatT's range.
+///
+template <typename RatT, std::size_t kDimension, typename HeightT>
+Point<RatT, kDimension> crossing_point(const Point<RatT, kDimension>& p,
+    const Point<RatT, kDimension>& q,
+    const HeightT& p_height,
+    const HeightT& q_height)
+{
+  typedef typename NumeratorType<RatT>::type IntT;
+  typedef typename ProductInt<IntT, HeightT>::type WideT;
+
+  const WideT p_wide(p_height);
+  const WideT q_wide(q_height);
+  const WideT denominator = p_wide - q_wide;
+
+  Point<RatT, kDimension> ret;
+  for (std::size_t i = 0; i < kDimension; ++i) {
+    ret[i] = from_numerator_ratio<RatT>(
+        WideT(numerator_of(q[i])) * p_wide - WideT(numerator_of(p[i])) * q_wide,
+        denominator);
+  }
+  return ret;
+}
+
+/// \brief  Find the determinant whose sign orient2d() gives, over the points'
+///         numerators.
+///
+/// It is twice the triangle's signed area, scaled by the square of the
+/// coordinates' common denominator: the height of c above the line from a to
+/// b, in proportion, as crossing_point() takes.
+///
+template <typename RatT>
+typename WidenedInt<typename NumeratorType<RatT>::type>::type
+scaled_orient2d(const Point<RatT, 2>& a,
+    const Point<RatT, 2>& b,
+    const Point<RatT, 2>& c)
+{
+  typedef typename WidenedInt<typename NumeratorType<RatT>::type>::type WideT;
+
+  auto offset = [](const RatT& to, const RatT& from) {
+    return WideT(numerator_of(to)) - WideT(numerator_of(from));
+  };
+  return offset(a[0], c[0]) * offset(b[1], c[1])
+         - offset(a[1], c[1]) * offset(b[0], c[0]);
+}
+
+/// \brief  Find a vector normal to a ring of vertices by Newell's method, over
+///         their numerators.
+///
+/// It is twice the ring's vector area, scaled by the square of the
+/// coordinates' common denominator, and is summed as integers in a type wide
+/// enough for rings of far more vertices than memory holds, so no product
+/// need be representable.
+///
+template <typename RatT>
+Point<typename WidenedInt<typename NumeratorType<RatT>::type, 3>::type, 3>
+scaled_newell_normal(const std::vector<Point<RatT, 3>>& vertices,
+    const std::vector<std::size_t>& ring)
+{
+  typedef typename WidenedInt<typename NumeratorType<RatT>::type, 3>::type
+      WideT;
+
+  // With fewer than 2^20 vertices, of numerators under 2^20, every partial
+  // sum fits in long long.
+  static constexpr int kSmallBits = 20;
+  if constexpr (std::is_integral<typename NumeratorType<RatT>::type>::value) {
+    bool is_small = ring.size() < (std::size_t(1) << kSmallBits);
+    for (std::size_t i = 0; i < ring.size() && is_small; ++i) {
+      for (std::size_t j = 0; j < 3; ++j) {
+        is_small = is_small
+                   && is_within_bits(numerator_of(vertices[ring[i]][j]),
+                       kSmallBits);
+      }
+    }
+
+    if (is_small) {
+      auto numerators = [&vertices](std::size_t vertex) {
+        const auto& point = vertices[vertex];
+        return Point<long long, 3>{numerator_of(point[0]),
+            numerator_of(point[1]), numerator_of(point[2])};
+      };
+
+      Point<long long, 3> sum{0, 0, 0};
+      for (std::size_t i = 0; i < ring.size(); ++i) {
+        sum = sum + cross(numerators(ring[i]),
+                        numerators(ring[(i + 1) % ring.size()]));
+      }
+      return {WideT(sum[0]), WideT(sum[1]), WideT(sum[2])};
+    }
+  }
+
+  auto numerators = [&vertices](std::size_t vertex) {
+    const auto& point = vertices[vertex];
+    return Point<WideT, 3>{WideT(numerator_of(point[0])),
+        WideT(numerator_of(point[1])), WideT(numerator_of(point[2]))};
+  };
+
+  Point<WideT, 3> ret{WideT(0), WideT(0), WideT(0)};
+  for (std::size_t i = 0; i < ring.size(); ++i) {
+    ret = ret + cross(numerators(ring[i]),
+                    numerators(ring[(i + 1) % ring.size()]));
+  }
+  return ret;
+}
+
+/// \brief  Find the largest magnitude M such that coefficient * M^power fits
+///         in IntT.
+///
+/// A polynomial of the given degree, whose terms' magnitudes sum to at most
+/// coefficient * M^power, can then be evaluated without overflow.
+///
+template <typename IntT>
+constexpr IntT filter_bound(IntT coefficient, int power)
+{
+  auto fits = [coefficient, power](IntT magnitude) {
+    auto remaining = std::numeric_limits<IntT>::max() / coefficient;
+    for (int i = 0; i < power; ++i) {
+      remaining /= magnitude;
+    }
+    return remaining >= 1;
+  };
+
+  IntT low  = 1;
+  IntT high = std::numeric_limits<IntT>::max() / 2;
+  while (low < high) {
+    IntT middle = low + (high - low + 1) / 2;
+    if (fits(middle)) {
+      low = middle;
+    }
+    else {
+      high = middle - 1;
+    }
+  }
+  return low;
+}
+
+/// \brief  Determine if all coordinates' numerators lie within bound of the
+///         last point's, copying their differences from it into long long
+///         points if so.
+///
+/// The predicates do not change under translation, and taking the points
+/// relative to one of them keeps nearby points in range however far they are
+/// from the origin.
+///
+template <typename RatT, std::size_t kDimension, std::size_t kCount>
+bool numerators_within(long long bound,
+    const Point<RatT, kDimension>* const (&points)[kCount],
+    Point<long long, kDimension> (&numerators)[kCount])
+{
+  // Beyond this, the differences themselves could overflow.
+  static constexpr long long kLimit = 1LL << 62;
+
+  const auto& origin = *points[kCount - 1];
+  for (std::size_t j = 0; j < kDimension; ++j) {
+    auto base = numerator_of(origin[j]);
+    if (base < -kLimit || kLimit < base) {
+      return false;
+    }
+    for (std::size_t i = 0; i < kCount; ++i) {
+      auto value = numerator_of((*points[i])[j]);
+      if (value < -kLimit || kLimit < value) {
+        return false;
+      }
+      auto difference = static_cast<long long>(value) - base;
+      if (difference < -bound || bound < difference) {
+        return false;
+      }
+      numerators[i][j] = difference;
+    }
+  }
+  return true;
+}
+
+/// \brief  Find the sign of a predicate's determinant, a polynomial of degree
+///         kDegree in the coordinates, over the points' numerators.
+///
+/// evaluate() is given an array of the points' numerators: as long long
+/// differences from the last point's if they all lie within bound, where it
+/// cannot overflow, and otherwise as WidenedInt<IntT, kDegree>, which holds
+/// the determinant exactly.
+///
+template <int kDegree,
+    typename RatT,
+    std::size_t kDimension,
+    std::size_t kCount,
+    typename EvaluateT>
+int sign_over_numerators(long long bound,
+    const Point<RatT, kDimension>* const (&points)[kCount],
+    const EvaluateT& evaluate)
+{
+  typedef typename NumeratorType<RatT>::type IntT;
+  typedef typename WidenedInt<IntT, kDegree>::type ExactT;
+
+  Point<long long, kDimension> numerators[kCount];
+  if (numerators_within(bound, points, numerators)) {
+    return evaluate(numerators);
+  }
+
+  Point<ExactT, kDimension> exact[kCount];
+  for (std::size_t i = 0; i < kCount; ++i) {
+    for (std::size_t j = 0; j < kDimension; ++j) {
+      exact[i][j] = numerator_of((*points[i])[j]);
+    }
+  }
+  return evaluate(exact);
+}
+
+//   Unfiltered Predicates
+//  -----------------------
+
+/// orient2d(), evaluated in the coordinates' own arithmetic.
+///
+template <typename RatT>
+int exact_orient2d(const Point<RatT, 2>& a,
+    const Point<RatT, 2>& b,
+    const Point<RatT, 2>& c)
+{
+  auto ac = a - c;
+  auto bc = b - c;
+
+  // Comparing the two products gives the sign without their difference.
+  auto left  = ac[0] * bc[1];
+  auto right = ac[1] * bc[0];
+  return (right < left) - (left < right);
+}
+
+/// orient3d(), evaluated in the coordinates' own arithmetic.
+///
+template <typename RatT>
+int exact_orient3d(const Point<RatT, 3>& a,
+    const Point<RatT, 3>& b,
+    const Point<RatT, 3>& c,
+    const Point<RatT, 3>& d)
+{
+  return sign(dot(a - d, cross(b - d, c - d)));
+}
+
+/// incircle(), evaluated in the coordinates' own arithmetic.
+///
+template <typename RatT>
+int exact_incircle(const Point<RatT, 2>& a,
+    const Point<RatT, 2>& b,
+    const Point<RatT, 2>& c,
+    const Point<RatT, 2>& d)
+{
+  auto lifted = [&d](const Point<RatT, 2>& p) {
+    auto pd = p - d;
+    return Point<decltype(dot(pd, pd)), 3>{pd[0], pd[1], dot(pd, pd)};
+  };
+
+  return sign(dot(lifted(a), cross(lifted(b), lifted(c))));
+}
+
+/// insphere(), evaluated in the coordinates' own arithmetic.
+///
+template <typename RatT>
+int exact_insphere(const Point<RatT, 3>& a,
+    const Point<RatT, 3>& b,
+    const Point<RatT, 3>& c,
+    const Point<RatT, 3>& d,
+    const Point<RatT, 3>& e)
+{
+  Matrix<decltype(dot(a - e, a - e)), 4> lifted;
+  const Point<RatT, 3>* points[] = {&a, &b, &c, &d};
+  for (std::size_t i = 0; i < 4; ++i) {
+    auto pe = *points[i] - e;
+    lifted.values_[i] = {pe[0], pe[1], pe[2], dot(pe, pe)};
+  }
+
+  return sign(determinant(lifted));
+}
+
+// Predicates
+//------------
+//
+// A FixedRational is its numerator over a common denominator, so each
+// predicate's determinant, taken over the numerators, only differs from the
+// real one by a positive power of that denominator. For integer and
+// FixedRational coordinates, its sign is thus found with integer arithmetic,
+// which never throws for inexactness: in long long while the points lie within
+// each bound below of the last one (the largest coordinate difference the
+// determinant's expansion allows), and exactly in a WideInteger beyond it.
+// Other coordinate types use their own arithmetic.
+
+/// Find which side of the line through a and b the point c lies on.
+///
+/// \return  1 if a, b and c wind counter-clockwise, -1 if clockwise, 0 if they
+///          are collinear.
+///
+template <typename RatT>
+int orient2d(const Point<RatT, 2>& a,
+    const Point<RatT, 2>& b,
+    const Point<RatT, 2>& c)
+{
+  if constexpr (std::is_integral<typename NumeratorType<RatT>::type>::value) {
+    static constexpr long long kBound = filter_bound<long long>(2, 2);
+
+    const Point<RatT, 2>* const points[] = {&a, &b, &c};
+    return sign_over_numerators<2>(kBound, points, [](const auto& p) {
+      return exact_orient2d(p[0], p[1], p[2]);
+    });
+  }
+  else {
+    return exact_orient2d(a, b, c);
+  }
+}
+
+/// Find which side of the plane through a, b and c the point d lies on.
+///
+/// \return  1 if d lies below the plane, where "above" is the side from which
+///          a, b and c appear counter-clockwise; -1 if above; 0 if the four
+///          points are coplanar.
+///
+template <typename RatT>
+int orient3d(const Point<RatT, 3>& a,
+    const Point<RatT, 3>& b,
+    const Point<RatT, 3>& c,
+    const Point<RatT, 3>& d)
+{
+  if constexpr (std::is_integral<typename NumeratorType<RatT>::type>::value) {
+    static constexpr long long kBound = filter_bound<long long>(6, 3);
+
+    const Point<RatT, 3>* const points[] = {&a, &b, &c, &d};
+    return sign_over_numerators<3>(kBound, points, [](const auto& p) {
+      return exact_orient3d(p[0], p[1], p[2], p[3]);
+    });
+  }
+  else {
+    return exact_orient3d(a, b, c, d);
+  }
+}
+
+/// Find whether d lies within the circle through a, b and c.
+///
+/// \return  1 if d lies inside the circle, -1 if outside, 0 if on it. The sign
+///          is reversed if a, b and c wind clockwise.
+///
+template <typename RatT>
+int incircle(const Point<RatT, 2>& a,
+    const Point<RatT, 2>& b,
+    const Point<RatT, 2>& c,
+    const Point<RatT, 2>& d)
+{
+  if constexpr (std::is_integral<typename NumeratorType<RatT>::type>::value) {
+    static constexpr long long kBound = filter_bound<long long>(12, 4);
+
+    const Point<RatT, 2>* const points[] = {&a, &b, &c, &d};
+    return sign_over_numerators<4>(kBound, points, [](const auto& p) {
+      return exact_incircle(p[0], p[1], p[2], p[3]);
+    });
+  }
+  else {
+    return exact_incircle(a, b, c, d);
+  }
+}
+
+/// Find whether e lies within the sphere through a, b, c and d.
+///
+/// \return  1 if e lies inside the sphere, -1 if outside, 0 if on it. The sign
+///          is reversed if orient3d(a, b, c, d) is negative.
+///
+template <typename RatT>
+int insphere(const Point<RatT, 3>& a,
+    const Point<RatT, 3>& b,
+    const Point<RatT, 3>& c,
+    const Point<RatT, 3>& d,
+    const Point<RatT, 3>& e)
+{
+  if constexpr (std::is_integral<typename NumeratorType<RatT>::type>::value) {
+    static constexpr long long kBound = filter_bound<long long>(72, 5);
+
+    const Point<RatT, 3>* const points[] = {&a, &b, &c, &d, &e};
+    return sign_over_numerators<5>(kBound, points, [](const auto& p) {
+      return exact_insphere(p[0], p[1], p[2], p[3], p[4]);
+    });
+  }
+  else {
+    return exact_insphere(a, b, c, d, e);
+  }
+}
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_PREDICATES_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
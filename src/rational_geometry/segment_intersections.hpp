@@ -0,0 +1,322 @@
+/// \file     segment_intersections.hpp
+/// \author   Tim Holt
+///
+/// Finding every point where segments in the plane meet, by a sweep.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_SEGMENT_INTERSECTIONS_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_SEGMENT_INTERSECTIONS_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "Point.hpp"
+#include "intersections.hpp"
+#include "predicates.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Types
+//-------
+
+/// \brief  A point where two or more segments meet, and the indices of all the
+///         segments through it, in increasing order.
+///
+template <typename RatT>
+struct SegmentCrossing
+{
+  Point<RatT, 2> point_;
+  std::vector<size_t> segments_;
+};
+
+/// \brief  The segments crossing a sweep line, bottom to top, as a skip list.
+///
+/// Nodes are allocated from one contiguous pool, linked by index, and their
+/// links from a second; those erased are kept for reuse, by height, so a long
+/// sweep allocates only as much as the most segments ever crossing it. Each
+/// node reaches a level above with probability 1/4, so a search visits O(log
+/// n) nodes in expectation.
+///
+/// A cursor sits between two nodes. seek() moves it past every segment below
+/// a point, and insert() and erase_next() work just beyond it, so the sweep's
+/// changes at an event cost one search in all.
+///
+class SweepStatus
+{
+ public:
+  // CONSTANTS
+  static constexpr size_t kNone     = static_cast<size_t>(-1);
+  static constexpr size_t kMaxLevel = 16;
+
+ protected:
+  // TYPES
+  struct Node
+  {
+    size_t segment_;
+    size_t height_;
+    size_t links_;
+  };
+
+  // INTERNAL STATE
+  std::vector<Node> nodes_;
+  std::vector<size_t> links_;
+  std::array<std::vector<size_t>, kMaxLevel + 1> free_;
+
+  /// The last node before the cursor on each level; node 0 is the head.
+  std::array<size_t, kMaxLevel> path_;
+  std::uint64_t state_;
+
+  // HELPER FUNCTIONS
+  size_t& link(size_t node, size_t level);
+  size_t random_height();
+
+ public:
+  // CONSTRUCTORS
+  SweepStatus();
+
+  // ACCESSORS
+  size_t before() const;
+  size_t after() const;
+
+  // MODIFIERS
+  template <typename PredT>
+  void seek(PredT is_below);
+  void insert(size_t segment);
+  void erase_next();
+};
+
+// Member Function Definitions
+//-----------------------------
+
+inline SweepStatus::SweepStatus()
+    : nodes_{Node{kNone, kMaxLevel, 0}}
+    , links_(kMaxLevel, kNone)
+    , free_{}
+    , path_{}
+    , state_{0x9e3779b97f4a7c15ULL}
+{
+}
+
+inline size_t& SweepStatus::link(size_t node, size_t level)
+{
+  return links_[nodes_[node].links_ + level];
+}
+
+/// Draw a node's height, by xorshift, so sweeps are reproducible.
+///
+inline size_t SweepStatus::random_height()
+{
+  state_ ^= state_ << 13;
+  state_ ^= state_ >> 7;
+  state_ ^= state_ << 17;
+
+  size_t height = 1;
+  for (auto bits = state_; height < kMaxLevel && (bits & 3) == 0; bits >>= 2) {
+    ++height;
+  }
+  return height;
+}
+
+/// \return  The segment just below the cursor, or kNone if there is none.
+///
+inline size_t SweepStatus::before() const
+{
+  return nodes_[path_[0]].segment_;
+}
+
+/// \return  The segment just above the cursor, or kNone if there is none.
+///
+inline size_t SweepStatus::after() const
+{
+  auto next = links_[nodes_[path_[0]].links_];
+  return next == kNone ? kNone : nodes_[next].segment_;
+}
+
+/// Move the cursor just past the segments for which is_below holds, which
+/// must be a prefix of the status.
+///
+template <typename PredT>
+void SweepStatus::seek(PredT is_below)
+{
+  size_t node = 0;
+  for (size_t level = kMaxLevel; level-- > 0;) {
+    for (auto next = link(node, level);
+         next != kNone && is_below(nodes_[next].segment_);
+         next = link(node, level)) {
+      node = next;
+    }
+    path_[level] = node;
+  }
+}
+
+/// Insert a segment just above the cursor, and move the cursor past it.
+///
+inline void SweepStatus::insert(size_t segment)
+{
+  auto height = random_height();
+
+  size_t node;
+  if (free_[height].empty()) {
+    node = nodes_.size();
+    nodes_.push_back(Node{segment, height, links_.size()});
+    links_.resize(links_.size() + height);
+  }
+  else {
+    node = free_[height].back();
+    free_[height].pop_back();
+    nodes_[node].segment_ = segment;
+  }
+
+  for (size_t level = 0; level < height; ++level) {
+    link(node, level)         = link(path_[level], level);
+    link(path_[level], level) = node;
+    path_[level]              = node;
+  }
+}
+
+/// Erase the segment just above the cursor, which must exist.
+///
+inline void SweepStatus::erase_next()
+{
+  auto node = link(path_[0], 0);
+  for (size_t level = 0; level < nodes_[node].height_; ++level) {
+    link(path_[level], level) = link(node, level);
+  }
+  free_[nodes_[node].height_].push_back(node);
+}
+
+// Functions
+//-----------
+
+/// Find every point where two or more of a group of segments meet.
+///
+/// This is the Bentley-Ottmann sweep, as given by de Berg et al., so shared
+/// ends, ends touching other segments and collinear overlaps are all handled.
+/// Events are visited in lexicographic order (see Point's operator<), which
+/// acts as a sweep line tilted infinitesimally from vertical. The segments
+/// crossing the sweep line are kept bottom to top in a SweepStatus, searched
+/// by orient2d() against each event point; only neighbours in it are ever
+/// intersected.
+///
+/// \return  The meeting points, in lexicographic order. Where collinear
+///          segments overlap, the points reported are the ends of the
+///          overlap.
+///
+/// \throws  unrepresentable_operation_error if RatT is a FixedRational that
+///          cannot represent a crossing point.
+///
+/// \sa  https://en.wikipedia.org/wiki/Bentley%E2%80%93Ottmann_algorithm
+///
+template <typename RatT>
+std::vector<SegmentCrossing<RatT>> segment_intersections(
+    std::vector<std::array<Point<RatT, 2>, 2>> segments)
+{
+  using namespace std;
+  typedef Point<RatT, 2> PointT;
+
+  // Each event point, with the segments starting there.
+  map<PointT, vector<size_t>> events;
+  for (size_t i = 0; i < segments.size(); ++i) {
+    auto& segment = segments[i];
+    if (segment[1] < segment[0]) swap(segment[0], segment[1]);
+    events[segment[0]].push_back(i);
+    events[segment[1]];
+  }
+
+  auto add_crossing = [&segments, &events](
+                          size_t below, size_t above, const PointT& after) {
+    const auto& l_op = segments[below];
+    const auto& r_op = segments[above];
+    auto found       = intersection(l_op[0], l_op[1], r_op[0], r_op[1]);
+    if (found.type_ != IntersectionType::kNone && after < found.first_) {
+      events[found.first_];
+    }
+  };
+
+  SweepStatus status;
+  vector<SegmentCrossing<RatT>> ret;
+  while (!events.empty()) {
+    auto point    = events.begin()->first;
+    auto starting = move(events.begin()->second);
+    events.erase(events.begin());
+
+    // The segments through the point lie together in the status, above those
+    // passing below it.
+    status.seek([&segments, &point](size_t index) {
+      return orient2d(segments[index][0], segments[index][1], point) > 0;
+    });
+    vector<size_t> through;
+    for (auto index = status.after(); index != SweepStatus::kNone
+         && orient2d(segments[index][0], segments[index][1], point) == 0;
+         index = status.after()) {
+      through.push_back(index);
+      status.erase_next();
+    }
+
+    vector<size_t> involved(starting);
+    involved.insert(end(involved), begin(through), end(through));
+    if (involved.size() > 1) {
+      sort(begin(involved), end(involved));
+      ret.push_back({point, involved});
+    }
+
+    // Those continuing past the point are reinserted in their order just
+    // beyond it: by angle, as all point rightward.
+    vector<size_t> continuing;
+    for (auto index : starting) {
+      if (segments[index][0] != segments[index][1]) continuing.push_back(index);
+    }
+    for (auto index : through) {
+      if (segments[index][1] != point) continuing.push_back(index);
+    }
+    sort(begin(continuing), end(continuing),
+        [&segments, &point](size_t l_op, size_t r_op) {
+          int turn = orient2d(point, segments[l_op][1], segments[r_op][1]);
+          return turn > 0 || (turn == 0 && l_op < r_op);
+        });
+
+    auto below = status.before();
+    if (continuing.empty()) {
+      auto above = status.after();
+      if (below != SweepStatus::kNone && above != SweepStatus::kNone) {
+        add_crossing(below, above, point);
+      }
+    }
+    else {
+      if (below != SweepStatus::kNone) {
+        add_crossing(below, continuing.front(), point);
+      }
+      for (auto index : continuing) {
+        status.insert(index);
+      }
+      auto above = status.after();
+      if (above != SweepStatus::kNone) {
+        add_crossing(continuing.back(), above, point);
+      }
+    }
+  }
+
+  return ret;
+}
+
+//-----------
+// Functions
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_SEGMENT_INTERSECTIONS_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,370 @@
+/// \file     spatial_order.hpp
+/// \author   Tim Holt
+///
+/// Morton (Z-order) and Hilbert keys of exact points, and orderings of points
+/// by them, for keeping points near in space near in memory.
+///
+/// \sa  John Skilling, "Programming the Hilbert curve", AIP Conference
+///      Proceedings 707, 381 (2004), whose transform hilbert_transpose()
+///      follows.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_SPATIAL_ORDER_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_SPATIAL_ORDER_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "AABB.hpp"
+#include "Point.hpp"
+#include "predicates.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <future>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Helper Functions
+//------------------
+
+/// Get the number of bits each axis contributes to a 64-bit key.
+///
+template <size_t kDimension>
+constexpr int key_bits_per_axis()
+{
+  static_assert(kDimension > 0, "Keys need at least one axis");
+  return 64 / kDimension < 32 ? static_cast<int>(64 / kDimension) : 32;
+}
+
+/// \brief  Get a point's cell in a grid of 2^key_bits_per_axis() cells along
+///         each axis of a bounding box.
+///
+/// Each coordinate's numerator is offset by the box's lower corner, then
+/// shifted right, by the same amount on every axis, just far enough that the
+/// box's widest side fits. All of it is integer arithmetic, so exact.
+///
+/// \note  The point must be in the box.
+///
+template <typename RatT, size_t kDimension>
+std::array<unsigned long long, kDimension> grid_coordinates(
+    const Point<RatT, kDimension>& point, const AABB<RatT, kDimension>& bounds)
+{
+  typedef unsigned long long KeyT;
+  constexpr int kBits = key_bits_per_axis<kDimension>();
+
+  // Unsigned subtraction wraps, so any offset between IntT values is exact.
+  auto offset = [&bounds](const RatT& value, size_t axis) {
+    return static_cast<KeyT>(numerator_of(value))
+           - static_cast<KeyT>(numerator_of(bounds.lower()[axis]));
+  };
+
+  KeyT widest = 0;
+  for (size_t i = 0; i < kDimension; ++i) {
+    widest = std::max(widest, offset(bounds.upper()[i], i));
+  }
+  int shift = 0;
+  while (shift < 64 && (widest >> shift) >> kBits != 0) {
+    ++shift;
+  }
+
+  std::array<KeyT, kDimension> ret;
+  for (size_t i = 0; i < kDimension; ++i) {
+    ret[i] = offset(point[i], i) >> shift;
+  }
+  return ret;
+}
+
+/// Interleave grid coordinates' bits, most significant first, and the first
+/// axis first at each level.
+///
+template <size_t kDimension>
+unsigned long long interleave_bits(
+    const std::array<unsigned long long, kDimension>& coordinates)
+{
+  constexpr int kBits = key_bits_per_axis<kDimension>();
+
+  unsigned long long ret = 0;
+  for (int bit = kBits - 1; bit >= 0; --bit) {
+    for (size_t i = 0; i < kDimension; ++i) {
+      ret = (ret << 1) | ((coordinates[i] >> bit) & 1);
+    }
+  }
+  return ret;
+}
+
+/// \brief  Transform grid coordinates in place so that interleaving their
+///         bits gives their distance along the Hilbert curve.
+///
+template <size_t kDimension>
+void hilbert_transpose(std::array<unsigned long long, kDimension>& coordinates)
+{
+  typedef unsigned long long KeyT;
+  constexpr int kBits = key_bits_per_axis<kDimension>();
+  auto& x             = coordinates;
+
+  // Undo the excess rotations and reflections, level by level: invert the
+  // low bits of x[0] where x[i]'s bit is set, else exchange them with x[i]'s.
+  // Masks take the place of branches, which the bits would mispredict.
+  for (KeyT q = KeyT(1) << (kBits - 1); q > 1; q >>= 1) {
+    auto p = q - 1;
+    for (size_t i = 0; i < kDimension; ++i) {
+      KeyT is_set = KeyT(0) - ((x[i] & q) != 0);
+      auto t      = (x[0] ^ x[i]) & p & ~is_set;
+      x[0] ^= (p & is_set) | t;
+      x[i] ^= t;
+    }
+  }
+
+  // Gray encode.
+  for (size_t i = 1; i < kDimension; ++i) {
+    x[i] ^= x[i - 1];
+  }
+  KeyT t = 0;
+  for (KeyT q = KeyT(1) << (kBits - 1); q > 1; q >>= 1) {
+    if (x[kDimension - 1] & q) t ^= q - 1;
+  }
+  for (size_t i = 0; i < kDimension; ++i) {
+    x[i] ^= t;
+  }
+}
+
+/// Split a range of indices evenly into blocks, one to each of up to
+/// thread_count threads and each of at least minimum_size indices, call a
+/// function on each block, and wait for all of them.
+///
+/// \note  minimum_size must not be zero.
+///
+/// The function is given the block's number, and its first and last (one
+/// past the end) indices.
+///
+/// \return  The number of blocks.
+///
+template <typename FunctionT>
+size_t for_each_block(size_t count,
+    size_t thread_count,
+    size_t minimum_size,
+    FunctionT function)
+{
+  auto block_count =
+      std::max<size_t>(std::min(thread_count, count / minimum_size), 1);
+
+  std::vector<std::future<void>> running;
+  for (size_t block = 1; block < block_count; ++block) {
+    running.push_back(std::async(std::launch::async, function, block,
+        count * block / block_count, count * (block + 1) / block_count));
+  }
+  function(size_t(0), size_t(0), count / block_count);
+  for (auto& result : running) {
+    result.get();
+  }
+  return block_count;
+}
+
+// Functions
+//-----------
+
+/// Get a point's Morton (Z-order) key within a bounding box.
+///
+template <typename RatT, size_t kDimension>
+unsigned long long morton_key(
+    const Point<RatT, kDimension>& point, const AABB<RatT, kDimension>& bounds)
+{
+  return interleave_bits(grid_coordinates(point, bounds));
+}
+
+/// Get a point's Hilbert key within a bounding box.
+///
+/// Unlike Morton order, consecutive cells in Hilbert order always share a
+/// side, so points sorted by it are more tightly clustered.
+///
+template <typename RatT, size_t kDimension>
+unsigned long long hilbert_key(
+    const Point<RatT, kDimension>& point, const AABB<RatT, kDimension>& bounds)
+{
+  auto coordinates = grid_coordinates(point, bounds);
+  hilbert_transpose(coordinates);
+  return interleave_bits(coordinates);
+}
+
+/// \brief  Find the order that sorts keys, stably, by least significant digit
+///         first radix sort.
+///
+/// Given more than one thread, each pass counts and then scatters the keys
+/// in as many blocks, one to a thread; a digit's keys from earlier blocks are
+/// placed before those from later ones, so the sort stays stable.
+///
+/// \param  thread_count      How many threads may sort at once.
+/// \param  parallel_minimum  The fewest keys for each thread to sort.
+///
+/// \return  The keys' indices, in sorted order.
+///
+inline std::vector<size_t> radix_order(
+    const std::vector<unsigned long long>& keys,
+    size_t thread_count     = 1,
+    size_t parallel_minimum = 65536)
+{
+  const size_t kDigitBits = 8;
+  const size_t kRadix     = size_t(1) << kDigitBits;
+
+  auto block_count = std::max<size_t>(
+      std::min(thread_count, keys.size() / parallel_minimum), 1);
+  // The keys travel with their indices, so each pass reads both in order.
+  std::vector<size_t> ret(keys.size());
+  for (size_t i = 0; i < ret.size(); ++i) {
+    ret[i] = i;
+  }
+  std::vector<unsigned long long> sorted(keys);
+  std::vector<size_t> scratch(keys.size());
+  std::vector<unsigned long long> sorted_scratch(keys.size());
+
+  // Each block's count of each digit, and then where its next key of that
+  // digit goes.
+  std::vector<size_t> starts(block_count * kRadix);
+  for (size_t shift = 0; shift < 64; shift += kDigitBits) {
+    std::fill(starts.begin(), starts.end(), 0);
+    for_each_block(keys.size(), block_count, parallel_minimum,
+        [&](size_t block, size_t first, size_t last) {
+          auto counts = starts.begin() + block * kRadix;
+          for (size_t i = first; i < last; ++i) {
+            ++counts[(sorted[i] >> shift) & (kRadix - 1)];
+          }
+        });
+
+    size_t position = 0;
+    bool is_shared  = false;
+    for (size_t digit = 0; digit < kRadix; ++digit) {
+      size_t total = 0;
+      for (size_t block = 0; block < block_count; ++block) {
+        auto count                     = starts[block * kRadix + digit];
+        starts[block * kRadix + digit] = position + total;
+        total += count;
+      }
+      is_shared = is_shared || total == keys.size();
+      position += total;
+    }
+    // Skip a digit every key shares.
+    if (is_shared) continue;
+
+    for_each_block(keys.size(), block_count, parallel_minimum,
+        [&](size_t block, size_t first, size_t last) {
+          auto next = starts.begin() + block * kRadix;
+          for (size_t i = first; i < last; ++i) {
+            auto to            = next[(sorted[i] >> shift) & (kRadix - 1)]++;
+            scratch[to]        = ret[i];
+            sorted_scratch[to] = sorted[i];
+          }
+        });
+    ret.swap(scratch);
+    sorted.swap(sorted_scratch);
+  }
+  return ret;
+}
+
+/// Find the order of points along the Morton curve through their bounding box.
+///
+/// \param  thread_count      How many threads may find keys and sort at once.
+/// \param  parallel_minimum  The fewest points for each thread to take.
+///
+/// \return  The points' indices, in Morton order; ties keep their given order.
+///
+template <typename RatT, size_t kDimension>
+std::vector<size_t> morton_order(
+    const std::vector<Point<RatT, kDimension>>& points,
+    size_t thread_count     = 1,
+    size_t parallel_minimum = 65536)
+{
+  AABB<RatT, kDimension> bounds;
+  for (const auto& point : points) {
+    bounds.extend(point);
+  }
+
+  std::vector<unsigned long long> keys(points.size());
+  for_each_block(points.size(), thread_count, parallel_minimum,
+      [&](size_t, size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+          keys[i] = morton_key(points[i], bounds);
+        }
+      });
+  return radix_order(keys, thread_count, parallel_minimum);
+}
+
+/// Find the order of points along the Hilbert curve through their bounding
+/// box.
+///
+/// \param  thread_count      How many threads may find keys and sort at once.
+/// \param  parallel_minimum  The fewest points for each thread to take.
+///
+/// \return  The points' indices, in Hilbert order; ties keep their given
+///          order.
+///
+template <typename RatT, size_t kDimension>
+std::vector<size_t> hilbert_order(
+    const std::vector<Point<RatT, kDimension>>& points,
+    size_t thread_count     = 1,
+    size_t parallel_minimum = 65536)
+{
+  AABB<RatT, kDimension> bounds;
+  for (const auto& point : points) {
+    bounds.extend(point);
+  }
+
+  std::vector<unsigned long long> keys(points.size());
+  for_each_block(points.size(), thread_count, parallel_minimum,
+      [&](size_t, size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+          keys[i] = hilbert_key(points[i], bounds);
+        }
+      });
+  return radix_order(keys, thread_count, parallel_minimum);
+}
+
+/// Rearrange values into an order, as from morton_order() or hilbert_order().
+///
+template <typename T>
+std::vector<T> reorder(
+    const std::vector<T>& values, const std::vector<size_t>& order)
+{
+  std::vector<T> ret;
+  ret.reserve(order.size());
+  for (auto index : order) {
+    ret.push_back(values[index]);
+  }
+  return ret;
+}
+
+/// \brief  Renumber indices into values, such as a mesh's faces' vertex
+///         indices, to match the values after reorder().
+///
+template <typename IndexT>
+std::vector<IndexT> reindex(
+    const std::vector<IndexT>& indices, const std::vector<size_t>& order)
+{
+  std::vector<IndexT> new_index(order.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    new_index[order[i]] = static_cast<IndexT>(i);
+  }
+
+  std::vector<IndexT> ret;
+  ret.reserve(indices.size());
+  for (auto index : indices) {
+    ret.push_back(new_index[index]);
+  }
+  return ret;
+}
+
+//-----------
+// Functions
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_SPATIAL_ORDER_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
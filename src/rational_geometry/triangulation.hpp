@@ -0,0 +1,454 @@
+/// \file     triangulation.hpp
+/// \author   Tim Holt
+///
+/// Exact triangulation of polygons, with or without holes.
+///
+/// Polygons are split into pieces monotone in x by a sweep line, and each
+/// piece is triangulated in one pass, for O(n log n) time in all. Small
+/// polygons of a single ring are instead triangulated by ear clipping, whose
+/// O(n^2) time costs less than the sweep's set up at that size.
+///
+/// Triangles come out as vertex indices in one flat buffer, three to a
+/// triangle, each wound counter-clockwise. A polygon's vertices are numbered
+/// through its rings in order, as Polygon2D::vertex_count() counts them.
+///
+/// This code is under the MIT license, please see LICENSE.txt for more
+/// information
+
+#ifndef _RATIONAL_GEOMETRY_TRIANGULATION_HPP_INCLUDED_
+#define _RATIONAL_GEOMETRY_TRIANGULATION_HPP_INCLUDED_
+
+// Includes
+//----------
+
+#include "Point.hpp"
+#include "Polygon2D.hpp"
+#include "predicates.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <set>
+#include <utility>
+#include <vector>
+
+//----------
+// Includes
+
+namespace rational_geometry {
+
+// Types
+//-------
+
+/// \brief  A polygon edge under the sweep line of monotone_triangulate(),
+///         from its lexicographically least end to its greatest.
+///
+struct SweepEdge
+{
+  size_t left_;
+  size_t right_;
+
+  /// Whether the polygon's inside lies just above the edge, by the even-odd
+  /// rule, and the rightmost vertex seen so far that can see the edge from
+  /// above.
+  bool is_inside_above_;
+  size_t helper_;
+};
+
+// Helper Functions
+//------------------
+
+/// Append a triangle, wound counter-clockwise, to a flat buffer of them.
+///
+/// Triangles with no area are left out.
+///
+template <typename RatT>
+void add_triangle(const std::vector<Point<RatT, 2>>& points,
+    size_t a,
+    size_t b,
+    size_t c,
+    std::vector<size_t>& triangles)
+{
+  int side = orient2d(points[a], points[b], points[c]);
+  if (side == 0) return;
+  if (side < 0) std::swap(b, c);
+  triangles.insert(triangles.end(), {a, b, c});
+}
+
+/// Triangulate a polygon that is monotone in x.
+///
+/// The vertices are merged from the lower and upper chains in lexicographic
+/// order and swept once, keeping a stack of vertices that still need
+/// triangles: each new vertex fans out to the whole stack when it lies on the
+/// other chain, and otherwise to as much of it as it can see.
+///
+/// \param  face  The polygon's vertex indices, counter-clockwise.
+///
+template <typename RatT>
+void triangulate_monotone(const std::vector<Point<RatT, 2>>& points,
+    const std::vector<size_t>& face,
+    std::vector<size_t>& triangles)
+{
+  using namespace std;
+
+  auto count = face.size();
+  if (count < 3) return;
+
+  auto precedes = [&points](size_t l_op, size_t r_op) {
+    return points[l_op] < points[r_op]
+           || (points[l_op] == points[r_op] && l_op < r_op);
+  };
+  auto at = [&face, count](size_t i) { return face[i % count]; };
+  auto first = static_cast<size_t>(
+      min_element(begin(face), end(face), precedes) - begin(face));
+  auto last = static_cast<size_t>(
+      max_element(begin(face), end(face), precedes) - begin(face));
+
+  // Counter-clockwise from the first vertex runs the lower chain; clockwise,
+  // the upper.
+  vector<pair<size_t, bool>> sorted{{at(first), false}};
+  size_t lower = first + 1;
+  size_t upper = first + count - 1;
+  while (sorted.size() < count) {
+    bool is_lower_done = lower % count == (last + 1) % count;
+    bool is_upper_done = upper % count == last;
+    if (is_upper_done
+        || (!is_lower_done && precedes(at(lower), at(upper)))) {
+      sorted.emplace_back(at(lower++), false);
+    }
+    else {
+      sorted.emplace_back(at(upper--), true);
+    }
+  }
+
+  vector<pair<size_t, bool>> stack{sorted[0], sorted[1]};
+  for (size_t j = 2; j + 1 < count; ++j) {
+    const auto& current = sorted[j];
+    if (current.second != stack.back().second) {
+      for (size_t i = 0; i + 1 < stack.size(); ++i) {
+        add_triangle(points, current.first, stack[i].first,
+            stack[i + 1].first, triangles);
+      }
+      stack = {sorted[j - 1], current};
+      continue;
+    }
+
+    // Cut off the stack's vertices that the current one can see past.
+    auto previous = stack.back();
+    stack.pop_back();
+    int inside_side = current.second ? -1 : 1;
+    while (!stack.empty()
+           && orient2d(points[stack.back().first], points[previous.first],
+                  points[current.first])
+                  == inside_side) {
+      add_triangle(points, current.first, previous.first,
+          stack.back().first, triangles);
+      previous = stack.back();
+      stack.pop_back();
+    }
+    stack.push_back(previous);
+    stack.push_back(current);
+  }
+
+  for (size_t i = 0; i + 1 < stack.size(); ++i) {
+    add_triangle(points, sorted.back().first, stack[i].first,
+        stack[i + 1].first, triangles);
+  }
+}
+
+// Functions
+//-----------
+
+/// Triangulate a simple polygon by clipping its ears.
+///
+/// An ear is three consecutive vertices turning counter-clockwise whose
+/// triangle holds no other vertex; it is cut off, and the search goes on from
+/// the vertex before.
+///
+/// \param  ring  The polygon's vertices, in either winding.
+///
+/// \return  Indices into ring, three per triangle, wound counter-clockwise.
+///
+template <typename RatT>
+std::vector<size_t> ear_clip(const std::vector<Point<RatT, 2>>& ring)
+{
+  using namespace std;
+
+  vector<size_t> ret;
+  if (ring.size() < 3) return ret;
+  ret.reserve(3 * (ring.size() - 2));
+
+  vector<size_t> remaining(ring.size());
+  iota(begin(remaining), end(remaining), size_t(0));
+
+  // The turn at the least vertex gives the ring's winding.
+  auto least = static_cast<size_t>(
+      min_element(begin(ring), end(ring)) - begin(ring));
+  if (orient2d(ring[(least + ring.size() - 1) % ring.size()], ring[least],
+          ring[(least + 1) % ring.size()])
+      < 0) {
+    reverse(begin(remaining), end(remaining));
+  }
+
+  auto is_ear = [&](size_t a, size_t b, size_t c) {
+    if (orient2d(ring[a], ring[b], ring[c]) <= 0) return false;
+    return none_of(begin(remaining), end(remaining), [&](size_t p) {
+      return p != a && p != b && p != c
+             && orient2d(ring[a], ring[b], ring[p]) >= 0
+             && orient2d(ring[b], ring[c], ring[p]) >= 0
+             && orient2d(ring[c], ring[a], ring[p]) >= 0;
+    });
+  };
+
+  size_t i      = 0;
+  size_t misses = 0;
+  while (remaining.size() > 3 && misses < remaining.size()) {
+    auto size = remaining.size();
+    auto a    = remaining[(i + size - 1) % size];
+    auto b    = remaining[i];
+    auto c    = remaining[(i + 1) % size];
+    if (is_ear(a, b, c)) {
+      ret.insert(end(ret), {a, b, c});
+      remaining.erase(begin(remaining) + i);
+      i      = (i + size - 2) % (size - 1);
+      misses = 0;
+    }
+    else {
+      i = (i + 1) % size;
+      ++misses;
+    }
+  }
+  if (remaining.size() == 3) {
+    add_triangle(ring, remaining[0], remaining[1], remaining[2], ret);
+  }
+  return ret;
+}
+
+/// Triangulate a polygon by splitting it into pieces monotone in x.
+///
+/// A sweep line, as in de Berg et al., meets the vertices in lexicographic
+/// order. Each edge under it knows whether the inside lies above it, from the
+/// edge below it when inserted, so rings may be wound either way. Vertices
+/// where the inside opens or closes on the left of the sweep (split and merge
+/// vertices) are joined by diagonals to a vertex that sees them, which leaves
+/// monotone pieces; these are traced, inside on the left, and triangulated in
+/// turn by triangulate_monotone().
+///
+/// \pre  No two rings cross or touch, and no ring crosses itself.
+///
+/// \return  Vertex indices, numbered through the rings in order, three per
+///          triangle, wound counter-clockwise.
+///
+/// \sa  https://en.wikipedia.org/wiki/Polygon_triangulation
+///
+template <typename RatT>
+std::vector<size_t> monotone_triangulate(const Polygon2D<RatT>& polygon)
+{
+  using namespace std;
+
+  vector<Point<RatT, 2>> points;
+  vector<size_t> next;
+  vector<size_t> previous;
+  vector<size_t> order;
+  for (const auto& ring : polygon.rings()) {
+    auto first = points.size();
+    points.insert(end(points), begin(ring), end(ring));
+    for (size_t i = 0; i < ring.size(); ++i) {
+      next.push_back(first + (i + 1) % ring.size());
+      previous.push_back(first + (i + ring.size() - 1) % ring.size());
+      if (ring.size() >= 3) order.push_back(first + i);
+    }
+  }
+
+  auto precedes = [&points](size_t l_op, size_t r_op) {
+    return points[l_op] < points[r_op]
+           || (points[l_op] == points[r_op] && l_op < r_op);
+  };
+  sort(begin(order), end(order), precedes);
+
+  // Edge i runs between vertex i and the next.
+  vector<SweepEdge> edges(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    bool is_forward = precedes(i, next[i]);
+    edges[i]        = {is_forward ? i : next[i], is_forward ? next[i] : i,
+        false, i};
+  }
+
+  auto is_below = [&points, &edges](size_t l_op, size_t r_op) {
+    if (l_op == r_op) return false;
+    const auto& s = points[edges[l_op].left_];
+    const auto& t = points[edges[r_op].left_];
+    const auto& s_end = points[edges[l_op].right_];
+    const auto& t_end = points[edges[r_op].right_];
+
+    if (edges[l_op].left_ == edges[r_op].left_) {
+      return orient2d(s, s_end, t_end) > 0;
+    }
+    if (s < t) {
+      int side = orient2d(s, s_end, t);
+      return side != 0 ? side > 0 : orient2d(s, s_end, t_end) > 0;
+    }
+    int side = orient2d(t, t_end, s);
+    return side != 0 ? side < 0 : orient2d(t, t_end, s_end) < 0;
+  };
+
+  typedef set<size_t, decltype(is_below)> StatusT;
+  StatusT status(is_below);
+  vector<typename StatusT::iterator> positions(edges.size(), end(status));
+  vector<bool> is_merge(points.size(), false);
+  vector<pair<size_t, size_t>> diagonals;
+
+  auto join_merge_helper = [&](size_t edge, size_t vertex) {
+    if (is_merge[edges[edge].helper_]) {
+      diagonals.emplace_back(vertex, edges[edge].helper_);
+    }
+  };
+  auto edge_below = [&](size_t edge) {
+    auto position = positions[edge];
+    return position == begin(status) ? edges.size() : *prev(position);
+  };
+
+  for (auto vertex : order) {
+    auto before = previous[vertex];
+    auto after  = vertex;
+    bool is_before_left = edges[before].right_ == vertex;
+    bool is_after_left  = edges[after].right_ == vertex;
+
+    if (!is_before_left && !is_after_left) {
+      // A start or split vertex: the inside opens to the right, or closes.
+      positions[before] = status.insert(before).first;
+      positions[after]  = status.insert(after).first;
+      auto lower = is_below(before, after) ? before : after;
+      auto upper = lower == before ? after : before;
+
+      auto below = edge_below(lower);
+      bool is_inside_around =
+          below != edges.size() && edges[below].is_inside_above_;
+      edges[lower].is_inside_above_ = !is_inside_around;
+      edges[upper].is_inside_above_ = is_inside_around;
+      if (is_inside_around) {
+        diagonals.emplace_back(vertex, edges[below].helper_);
+        edges[below].helper_ = vertex;
+      }
+      edges[lower].helper_ = vertex;
+      edges[upper].helper_ = vertex;
+    }
+    else if (is_before_left && is_after_left) {
+      // An end or merge vertex.
+      auto lower = is_below(before, after) ? before : after;
+      auto upper = lower == before ? after : before;
+
+      if (edges[lower].is_inside_above_) {
+        join_merge_helper(lower, vertex);
+      }
+      else {
+        join_merge_helper(upper, vertex);
+        auto below = edge_below(lower);
+        join_merge_helper(below, vertex);
+        edges[below].helper_ = vertex;
+        is_merge[vertex]     = true;
+      }
+      status.erase(positions[before]);
+      status.erase(positions[after]);
+    }
+    else {
+      // A regular vertex, where one edge gives way to the next.
+      auto incoming = is_before_left ? before : after;
+      auto outgoing = is_before_left ? after : before;
+
+      bool is_inside_above = edges[incoming].is_inside_above_;
+      if (is_inside_above) {
+        join_merge_helper(incoming, vertex);
+      }
+      else {
+        auto below = edge_below(incoming);
+        join_merge_helper(below, vertex);
+        edges[below].helper_ = vertex;
+      }
+      status.erase(positions[incoming]);
+      edges[outgoing].is_inside_above_ = is_inside_above;
+      edges[outgoing].helper_          = vertex;
+      positions[outgoing] = status.insert(outgoing).first;
+    }
+  }
+
+  // Direct the edges with the inside on their left, add the diagonals both
+  // ways, and trace the pieces.
+  vector<pair<size_t, size_t>> half_edges;
+  for (auto vertex : order) {
+    const auto& edge = edges[vertex];
+    if (edge.is_inside_above_) {
+      half_edges.emplace_back(edge.left_, edge.right_);
+    }
+    else {
+      half_edges.emplace_back(edge.right_, edge.left_);
+    }
+  }
+  for (const auto& diagonal : diagonals) {
+    half_edges.push_back(diagonal);
+    half_edges.emplace_back(diagonal.second, diagonal.first);
+  }
+
+  vector<vector<size_t>> outgoing(points.size());
+  for (size_t i = 0; i < half_edges.size(); ++i) {
+    outgoing[half_edges[i].first].push_back(i);
+  }
+
+  vector<size_t> ret;
+  ret.reserve(3 * (points.size() + 2 * polygon.rings().size()));
+  vector<bool> is_used(half_edges.size(), false);
+  vector<size_t> face;
+  for (size_t first = 0; first < half_edges.size(); ++first) {
+    if (is_used[first]) continue;
+
+    face.clear();
+    auto current = first;
+    do {
+      is_used[current] = true;
+      face.push_back(half_edges[current].first);
+
+      // The first outgoing edge clockwise from the way back keeps the inside
+      // on the left.
+      auto vertex          = half_edges[current].second;
+      const auto reference = points[half_edges[current].first] - points[vertex];
+      const auto& choices  = outgoing[vertex];
+      current = *min_element(begin(choices), end(choices),
+          [&](size_t l_op, size_t r_op) {
+            return precedes_clockwise(reference,
+                points[half_edges[l_op].second] - points[vertex],
+                points[half_edges[r_op].second] - points[vertex]);
+          });
+    } while (current != first);
+
+    triangulate_monotone(points, face, ret);
+  }
+  return ret;
+}
+
+/// Triangulate a polygon, by ear clipping if it is one small ring, and
+/// otherwise by monotone_triangulate().
+///
+/// \pre  No two rings cross or touch, and no ring crosses itself.
+///
+/// \return  Vertex indices, numbered through the rings in order, three per
+///          triangle, wound counter-clockwise.
+///
+template <typename RatT>
+std::vector<size_t> triangulate(
+    const Polygon2D<RatT>& polygon, size_t ear_clipping_limit = 16)
+{
+  const auto& rings = polygon.rings();
+  if (rings.size() == 1 && rings.front().size() <= ear_clipping_limit) {
+    return ear_clip(rings.front());
+  }
+  return monotone_triangulate(polygon);
+}
+
+//-----------
+// Functions
+
+} // namespace rational_geometry
+
+#endif // _RATIONAL_GEOMETRY_TRIANGULATION_HPP_INCLUDED_
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,114 @@
+
+#include "../src/rational_geometry/AABB.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "../src/rational_geometry/Point.hpp"
+
+#include "doctest.h"
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing AABB.hpp")
+{
+  typedef FixedRational<long long, 2 * 3 * 5> Rat;
+  typedef AABB<Rat, 3> Box;
+  typedef Box::PointT P;
+
+  auto p = [](int x, int y, int z) { return P{Rat(x), Rat(y), Rat(z)}; };
+
+  SUBCASE("is_fraction_less()")
+  {
+    CHECK(is_fraction_less(Rat(1), Rat(3), Rat(1), Rat(2)));
+    CHECK_FALSE(is_fraction_less(Rat(1), Rat(2), Rat(1), Rat(3)));
+    CHECK_FALSE(is_fraction_less(Rat(2), Rat(4), Rat(1), Rat(2)));
+    CHECK(is_fraction_less(Rat(-1), Rat(1, 5), Rat(0), Rat(1)));
+    CHECK(is_fraction_less(1, 3, 1, 2));
+
+    // Numerators whose products are beyond long long.
+    typedef FixedRational<long long, 1000000> Micro;
+    CHECK(is_fraction_less(Micro(5000), Micro(4999), Micro(4999), Micro(4998)));
+    CHECK_FALSE(
+        is_fraction_less(Micro(4999), Micro(4998), Micro(5000), Micro(4999)));
+    CHECK(is_fraction_less(
+        Micro(-4999), Micro(4998), Micro(-5000), Micro(4999)));
+  }
+
+  SUBCASE("AABB<> class")
+  {
+    Box empty{};
+    CHECK(empty.empty());
+    CHECK_FALSE(empty.contains(p(0, 0, 0)));
+
+    Box box{p(2, 0, 3), p(0, 1, 1)};
+    CHECK_FALSE(box.empty());
+    CHECK(box.lower() == p(0, 0, 1));
+    CHECK(box.upper() == p(2, 1, 3));
+    CHECK(box.doubled_center() == p(2, 1, 4));
+
+    CHECK(box.contains(p(1, 1, 1)));
+    CHECK(box.contains(P{Rat(1, 2), Rat(1, 3), Rat(2)}));
+    CHECK_FALSE(box.contains(p(1, 2, 1)));
+    CHECK(box.contains(Box{p(1, 0, 2)}));
+    CHECK(box.contains(empty));
+    CHECK_FALSE(empty.contains(box));
+
+    CHECK((Box{p(0, 0, 0)}.extend(p(1, -1, 2)))
+          == Box{p(1, 0, 2), p(0, -1, 0)});
+    CHECK((empty | box) == box);
+    CHECK((box | Box{p(5, 5, 5)}) == Box{p(0, 0, 1), p(5, 5, 5)});
+  }
+
+  SUBCASE("overlaps()")
+  {
+    Box box{p(0, 0, 0), p(2, 2, 2)};
+    CHECK(box.overlaps(Box{p(1, 1, 1), p(3, 3, 3)}));
+    CHECK(box.overlaps(Box{p(2, 2, 2), p(3, 3, 3)}));
+    CHECK_FALSE(box.overlaps(Box{p(3, 0, 0), p(4, 2, 2)}));
+    CHECK_FALSE(box.overlaps(Box{}));
+
+    CHECK((box & Box{p(1, -1, 1), p(3, 1, 5)}) == Box{p(1, 0, 1), p(2, 1, 2)});
+    CHECK((box & Box{p(2, 0, 0), p(3, 1, 1)}) == Box{p(2, 0, 0), p(2, 1, 1)});
+    CHECK((box & Box{p(3, 3, 3)}).empty());
+  }
+
+  SUBCASE("is_hit_by()")
+  {
+    Box box{p(1, 1, 1), p(2, 2, 2)};
+
+    CHECK(box.is_hit_by(p(0, 0, 0), p(1, 1, 1)));
+    CHECK(box.is_hit_by(p(0, 0, 0), p(3, 2, 2)));
+    CHECK_FALSE(box.is_hit_by(p(0, 0, 0), p(-1, -1, -1)));
+    CHECK_FALSE(box.is_hit_by(p(0, 0, 0), p(5, 1, 1)));
+
+    // Grazing an edge, and starting inside.
+    CHECK(box.is_hit_by(p(0, 1, 0), p(1, 0, 1)));
+    CHECK(box.is_hit_by(P{Rat(3, 2), Rat(3, 2), Rat(3, 2)}, p(0, 0, -1)));
+
+    // Axis-parallel rays, inside and outside the slabs.
+    CHECK(box.is_hit_by(p(0, 1, 2), p(1, 0, 0)));
+    CHECK_FALSE(box.is_hit_by(p(0, 3, 2), p(1, 0, 0)));
+    CHECK_FALSE(box.is_hit_by(p(3, 1, 1), p(1, 0, 0)));
+
+    // Steep rays whose slab intervals only just miss.
+    CHECK_FALSE(box.is_hit_by(p(0, 0, 0), P{Rat(1), Rat(3), Rat(1)}));
+    CHECK(box.is_hit_by(p(0, 0, 0), P{Rat(1), Rat(2), Rat(1)}));
+
+    // The same, far from the origin at a fine resolution.
+    typedef FixedRational<long long, 1000000> Micro;
+    typedef AABB<Micro, 3> MicroBox;
+    typedef MicroBox::PointT MP;
+    MicroBox far_box{MP{Micro(5000), Micro(5000), Micro(5000)},
+        MP{Micro(5001), Micro(5001), Micro(5001)}};
+    MP far_origin{Micro(-4999), Micro(-4999), Micro(-4999)};
+    CHECK_FALSE(far_box.is_hit_by(
+        far_origin, MP{Micro(9999), Micro(10001), Micro(9999)}));
+    CHECK(far_box.is_hit_by(
+        far_origin, MP{Micro(9999), Micro(10000), Micro(9999)}));
+  }
+}
+
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,173 @@
+
+#include "../src/rational_geometry/Arrangement.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "../src/rational_geometry/Point.hpp"
+#include "../src/rational_geometry/Polygon2D.hpp"
+
+#include "doctest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing Arrangement.hpp")
+{
+  typedef FixedRational<long long, 4 * 9 * 5> Rat;
+  typedef Arrangement<Rat> ArrangementT;
+  typedef ArrangementT::Segment S;
+  typedef Point<Rat, 2> P;
+  typedef std::vector<P> Ring;
+  typedef std::vector<std::size_t> Indices;
+
+  const auto kNone = ArrangementT::kNone;
+
+  auto p = [](int x, int y) { return P{Rat(x), Rat(y)}; };
+  auto square = [&p](int low, int high) {
+    return Ring{p(low, low), p(high, low), p(high, high), p(low, high)};
+  };
+
+  // Every half-edge's next starts where it ends, on the same face, and each
+  // bounded face's outer boundary winds counter-clockwise.
+  auto check_links = [kNone](const ArrangementT& arrangement) {
+    const auto& half_edges = arrangement.half_edges();
+    for (std::size_t i = 0; i < half_edges.size(); ++i) {
+      const auto& next = half_edges[half_edges[i].next_];
+      CHECK(next.origin_ == arrangement.destination(i));
+      CHECK(next.face_ == half_edges[i].face_);
+    }
+    CHECK(arrangement.outer_half_edge(0) == kNone);
+    for (std::size_t face = 1; face < arrangement.face_count(); ++face) {
+      Ring ring;
+      auto outer = arrangement.outer_half_edge(face);
+      for (auto vertex : arrangement.boundary_vertices(outer)) {
+        ring.push_back(arrangement.vertices()[vertex]);
+      }
+      CHECK(Rat(0) < Polygon2D<Rat>{ring}.signed_area());
+    }
+  };
+
+  SUBCASE("crossing segments")
+  {
+    ArrangementT cross{std::vector<S>{S{p(0, 0), p(2, 2)},
+        S{p(0, 2), p(2, 0)}, S{p(5, 5), p(5, 5)}}};
+    check_links(cross);
+    CHECK(cross.vertices()
+          == Ring{p(0, 0), p(0, 2), p(1, 1), p(2, 0), p(2, 2)});
+    CHECK(cross.edge_count() == 4);
+    CHECK(cross.face_count() == 1);
+    CHECK(cross.inner_half_edges(0).size() == 1);
+
+    // A square split by its diagonal.
+    ArrangementT split{std::vector<S>{S{p(0, 0), p(4, 0)}, S{p(4, 0), p(4, 4)},
+        S{p(4, 4), p(0, 4)}, S{p(0, 4), p(0, 0)}, S{p(0, 0), p(4, 4)}}};
+    check_links(split);
+    CHECK(split.edge_count() == 5);
+    CHECK(split.face_count() == 3);
+    CHECK(split.outer_half_edge(1) != kNone);
+    CHECK(split.boundary_vertices(split.outer_half_edge(1)).size() == 3);
+    CHECK(split.inner_half_edges(0).size() == 1);
+    CHECK(split.inner_half_edges(1).empty());
+
+    CHECK(ArrangementT{}.face_count() == 1);
+    CHECK(ArrangementT{std::vector<S>{}}.face_count() == 1);
+  }
+
+  SUBCASE("overlapping segments")
+  {
+    ArrangementT overlapping{std::vector<S>{
+        S{p(0, 0), p(4, 0)}, S{p(6, 0), p(2, 0)}, S{p(2, 0), p(4, 0)}}};
+    check_links(overlapping);
+    CHECK(overlapping.vertices() == Ring{p(0, 0), p(2, 0), p(4, 0), p(6, 0)});
+    REQUIRE(overlapping.edge_count() == 3);
+    CHECK(overlapping.edge_segments(0) == Indices{0});
+    CHECK(overlapping.edge_segments(1) == Indices{0, 1, 2});
+    CHECK(overlapping.edge_segments(2) == Indices{1});
+  }
+
+  SUBCASE("islands")
+  {
+    // A square with a triangle inside it, and another outside it.
+    std::vector<S> segments;
+    for (const auto& ring : {square(0, 6), Ring{p(2, 2), p(4, 2), p(3, 4)},
+             Ring{p(8, 0), p(10, 0), p(9, 2)}}) {
+      for (std::size_t i = 0; i < ring.size(); ++i) {
+        segments.push_back(S{ring[i], ring[(i + 1) % ring.size()]});
+      }
+    }
+    ArrangementT islands{segments};
+    check_links(islands);
+    REQUIRE(islands.face_count() == 4);
+    CHECK(islands.inner_half_edges(0).size() == 2);
+
+    // The square's face holds the inner triangle.
+    auto outer  = islands.half_edges()[1].face_;
+    auto inside = islands.inner_half_edges(outer);
+    REQUIRE(inside.size() == 1);
+    auto hole = islands.boundary_vertices(inside[0]);
+    CHECK(hole.size() == 3);
+    CHECK(islands.vertices()[hole[0]] < p(6, 0));
+  }
+
+  SUBCASE("labels")
+  {
+    auto labels = [](const ArrangementT& arrangement, std::size_t face) {
+      Indices ret;
+      for (std::size_t i = 0; i < arrangement.layer_count(); ++i) {
+        ret.push_back(arrangement.label(face, i));
+      }
+      return ret;
+    };
+
+    // Two overlapping squares give every combination of inside and outside.
+    auto overlap = overlay(std::vector<Polygon2D<Rat>>{
+        Polygon2D<Rat>{square(0, 2)}, Polygon2D<Rat>{square(1, 3)}});
+    check_links(overlap);
+    REQUIRE(overlap.face_count() == 4);
+    REQUIRE(overlap.layer_count() == 2);
+    std::vector<Indices> found;
+    for (std::size_t face = 0; face < overlap.face_count(); ++face) {
+      found.push_back(labels(overlap, face));
+    }
+    CHECK(found[0] == Indices{kNone, kNone});
+    std::sort(found.begin(), found.end());
+    CHECK(found
+          == std::vector<Indices>{
+              {0, 0}, {0, kNone}, {kNone, 0}, {kNone, kNone}});
+
+    // Labels reach faces no edge of their layer touches, through holes.
+    auto hole = square(4, 8);
+    Polygon2D<Rat> frame{square(0, 12), Ring(hole.rbegin(), hole.rend())};
+    Polygon2D<Rat> islands{square(5, 7), square(1, 3)};
+    auto nested = overlay(std::vector<Polygon2D<Rat>>{frame, islands});
+    check_links(nested);
+    REQUIRE(nested.face_count() == 5);
+    for (std::size_t face = 1; face < nested.face_count(); ++face) {
+      auto outer = nested.boundary_vertices(nested.outer_half_edge(face));
+      auto low   = nested.vertices()[outer[0]];
+      for (auto vertex : outer) {
+        low = std::min(low, nested.vertices()[vertex]);
+      }
+      if (low == p(0, 0)) CHECK(labels(nested, face) == Indices{0, kNone});
+      if (low == p(1, 1)) CHECK(labels(nested, face) == Indices{0, 0});
+      if (low == p(4, 4)) CHECK(labels(nested, face) == Indices{kNone, kNone});
+      if (low == p(5, 5)) CHECK(labels(nested, face) == Indices{kNone, 0});
+    }
+
+    // Segments may give labels directly, either way along them.
+    ArrangementT given{std::vector<S>{S{p(0, 0), p(2, 0), 1, 7, 8},
+        S{p(2, 0), p(1, 2), 1, 7, 8}, S{p(0, 0), p(1, 2), 1, 8, 7}}};
+    REQUIRE(given.face_count() == 2);
+    REQUIRE(given.layer_count() == 2);
+    CHECK(labels(given, 0) == Indices{kNone, 8});
+    CHECK(labels(given, 1) == Indices{kNone, 7});
+  }
+}
+
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
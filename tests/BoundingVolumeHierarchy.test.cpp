@@ -0,0 +1,151 @@
+
+#include "../src/rational_geometry/BoundingVolumeHierarchy.hpp"
+
+#include "../src/rational_geometry/AABB.hpp"
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "../src/rational_geometry/Point.hpp"
+
+#include "doctest.h"
+
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing BoundingVolumeHierarchy.hpp")
+{
+  typedef FixedRational<long long, 2 * 3 * 5> Rat;
+  typedef BoundingVolumeHierarchy<Rat, 3> Bvh;
+  typedef Bvh::BoxT Box;
+  typedef Bvh::PointT P;
+  typedef std::vector<std::size_t> Indices;
+
+  auto p = [](int x, int y, int z) { return P{Rat(x), Rat(y), Rat(z)}; };
+
+  // Small boxes scattered over a 40 x 40 x 40 cube.
+  std::vector<Box> boxes;
+  for (int i = 0; i < 300; ++i) {
+    auto corner = p((i * 7) % 40, (i * 13) % 37, (i * 29) % 41);
+    auto size   = P{Rat(1 + i % 3), Rat(1 + i % 5, 2), Rat(1 + i % 4, 3)};
+    boxes.push_back(Box{corner, corner + size});
+  }
+  Bvh tree{boxes};
+
+  auto brute_force = [&boxes](const Box& box) {
+    Indices ret;
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+      if (boxes[i].overlaps(box)) ret.push_back(i);
+    }
+    return ret;
+  };
+
+  SUBCASE("construction")
+  {
+    Bvh empty{};
+    CHECK(empty.node_count() == 0);
+    CHECK(empty.depth() == 0);
+    CHECK(empty.overlapping(Box{p(0, 0, 0), p(9, 9, 9)}).empty());
+
+    Bvh small{std::vector<Box>{Box{p(0, 0, 0)}, Box{p(1, 1, 1)}}};
+    CHECK(small.node_count() == 1);
+    CHECK(small.overlapping(Box{p(1, 1, 1), p(2, 2, 2)}) == Indices{1});
+
+    CHECK(tree.boxes().size() == 300);
+    CHECK(tree.node_count() < 300);
+
+    // The heuristic keeps the tree shallow.
+    CHECK(tree.depth() <= 16);
+
+    // Boxes all centered together still split.
+    std::vector<Box> nested;
+    for (int i = 1; i <= 20; ++i) {
+      nested.push_back(Box{p(-i, -i, -i), p(i, i, i)});
+    }
+    Bvh nested_tree{nested};
+    CHECK(nested_tree.depth() > 1);
+    CHECK(nested_tree.overlapping(Box{p(15, 0, 0)}).size() == 6);
+  }
+
+  SUBCASE("threaded construction")
+  {
+    std::vector<Box> many;
+    for (int i = 0; i < 3 * static_cast<int>(Bvh::kParallelMinimum); ++i) {
+      auto corner = p((i * 7) % 401, (i * 13) % 397, (i * 29) % 409);
+      many.push_back(Box{corner, corner + p(1 + i % 3, 1 + i % 5, 1)});
+    }
+    Bvh single{many};
+    Bvh threaded{many, 4};
+    CHECK(threaded.node_count() == single.node_count());
+    CHECK(threaded.depth() == single.depth());
+
+    Box query{p(100, 100, 100), p(140, 150, 160)};
+    CHECK(threaded.overlapping(query) == single.overlapping(query));
+    CHECK_FALSE(threaded.overlapping(query).empty());
+    CHECK(threaded.hit_by(p(0, 0, 0), p(1, 1, 1))
+          == single.hit_by(p(0, 0, 0), p(1, 1, 1)));
+  }
+
+  SUBCASE("box queries")
+  {
+    std::vector<Box> queries{Box{p(0, 0, 0), p(10, 10, 10)},
+        Box{p(20, 5, 7)}, Box{p(-5, -5, -5), p(-1, -1, -1)},
+        Box{P{Rat(1, 2), Rat(1, 3), Rat(1, 5)}, p(40, 40, 40)},
+        Box{p(3, 0, 0), p(3, 36, 40)}};
+    for (const auto& query : queries) {
+      CHECK(tree.overlapping(query) == brute_force(query));
+    }
+
+    auto batched = tree.overlapping(queries);
+    REQUIRE(batched.size() == queries.size());
+    for (std::size_t i = 0; i < queries.size(); ++i) {
+      CHECK(batched[i] == brute_force(queries[i]));
+    }
+  }
+
+  SUBCASE("ray queries")
+  {
+    std::vector<std::array<P, 2>> rays{{p(0, 0, 0), p(1, 1, 1)},
+        {p(-1, 5, 5), p(1, 0, 0)}, {p(20, 20, -3), p(0, 0, 1)},
+        {p(40, 0, 40), p(-3, 2, -3)}, {p(-1, -1, -1), p(-1, 0, 0)}};
+
+    auto batched = tree.hit_by(rays);
+    REQUIRE(batched.size() == rays.size());
+    for (std::size_t i = 0; i < rays.size(); ++i) {
+      Indices expected;
+      for (std::size_t j = 0; j < boxes.size(); ++j) {
+        if (boxes[j].is_hit_by(rays[i][0], rays[i][1])) expected.push_back(j);
+      }
+      CHECK(tree.hit_by(rays[i][0], rays[i][1]) == expected);
+      CHECK(batched[i] == expected);
+    }
+    CHECK(batched[4].empty());
+  }
+
+  SUBCASE("overlapping pairs")
+  {
+    std::vector<Box> others;
+    for (int i = 0; i < 50; ++i) {
+      auto corner = p((i * 11) % 38, (i * 3) % 35, (i * 17) % 39);
+      others.push_back(Box{corner, corner + p(2, 3, 2)});
+    }
+    Bvh other_tree{others};
+
+    std::vector<std::pair<std::size_t, std::size_t>> expected;
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+      for (std::size_t j = 0; j < others.size(); ++j) {
+        if (boxes[i].overlaps(others[j])) expected.emplace_back(i, j);
+      }
+    }
+    CHECK_FALSE(expected.empty());
+    CHECK(tree.overlapping(other_tree) == expected);
+    CHECK(tree.overlapping(Bvh{}).empty());
+  }
+}
+
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
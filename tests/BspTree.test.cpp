@@ -0,0 +1,200 @@
+
+#include "../src/rational_geometry/BspTree.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "../src/rational_geometry/Polyhedron.hpp"
+
+#include "doctest.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing BspTree.hpp")
+{
+  typedef FixedRational<long long, 16 * 9 * 5 * 7 * 11 * 13> Rat;
+  typedef BspTree<Rat> RatTree;
+  typedef RatTree::RegionT Region;
+  typedef RatTree::PlaneT RatPlane;
+  typedef RatPlane::DirectionT Dir;
+  typedef Point<Rat, 2> P2;
+  typedef Point<Rat, 3> P3;
+
+  auto box = [](int x0, int y0, int z0, int x1, int y1, int z1) {
+    return make_box(
+        P3{Rat(x0), Rat(y0), Rat(z0)}, P3{Rat(x1), Rat(y1), Rat(z1)});
+  };
+
+  // The square [0, 2] x [0, 2], at height z, facing up.
+  auto square = [](int z) {
+    Polygon2D<Rat> projected{{P2{Rat(0), Rat(0)}, P2{Rat(2), Rat(0)},
+        P2{Rat(2), Rat(2)}, P2{Rat(0), Rat(2)}}};
+    return make_region(RatPlane{Dir{0, 0, 1}, Rat(z)}, projected);
+  };
+
+  auto total_area = [](const std::vector<Region>& regions) {
+    Rat ret(0);
+    for (const auto& region : regions) {
+      ret += region.region_.signed_area();
+    }
+    return ret;
+  };
+
+  SUBCASE("regions")
+  {
+    auto region = square(2);
+    CHECK(region.axis_ == 2);
+    CHECK(region.lower_ == P3{Rat(0), Rat(0), Rat(2)});
+    CHECK(region.upper_ == P3{Rat(2), Rat(2), Rat(2)});
+
+    RatPlane tilted{Dir{1, 0, 1}, Rat(4)};
+    auto slanted = make_region(tilted, region.region_);
+    CHECK(dominant_axis(tilted) == 0);
+    CHECK(lift(slanted, P2{Rat(1), Rat(3)}) == P3{Rat(1), Rat(1), Rat(3)});
+
+    CHECK(region_side(region, RatPlane{Dir{0, 0, 1}, Rat(1)})
+          == RegionSide::kFront);
+    CHECK(region_side(region, RatPlane{Dir{0, 0, -1}, Rat(-1)})
+          == RegionSide::kBack);
+    CHECK(region_side(region, RatPlane{Dir{0, 0, 1}, Rat(2)})
+          == RegionSide::kCoplanarFront);
+    CHECK(region_side(region, RatPlane{Dir{0, 0, -1}, Rat(-2)})
+          == RegionSide::kCoplanarBack);
+    CHECK(region_side(region, RatPlane{Dir{1, 0, 0}, Rat(2)})
+          == RegionSide::kBack);
+    CHECK(region_side(region, RatPlane{Dir{1, 1, 0}, Rat(1)})
+          == RegionSide::kSpanning);
+
+    std::vector<Region> coplanar;
+    std::vector<Region> front;
+    std::vector<Region> back;
+    split_region(region, RatPlane{Dir{2, 0, 0}, Rat(1, 2)}, coplanar,
+        coplanar, front, back);
+    REQUIRE(front.size() == 1);
+    REQUIRE(back.size() == 1);
+    CHECK(coplanar.empty());
+    CHECK(front.front().region_.signed_area() == Rat(3));
+    CHECK(back.front().region_.signed_area() == Rat(1));
+    CHECK(front.front().lower_ == P3{Rat(1, 2), Rat(0), Rat(2)});
+
+    flip(region);
+    CHECK(region.plane_ == RatPlane{Dir{0, 0, -1}, Rat(-2)});
+  }
+
+  SUBCASE("BspTree<> class")
+  {
+    RatTree empty{};
+    CHECK(empty.node_count() == 0);
+    CHECK(empty.depth() == 0);
+    CHECK(empty.all_regions().empty());
+
+    RatTree tree{regions_of(box(0, 0, 0, 4, 4, 4))};
+    CHECK(tree.node_count() == 6);
+    CHECK(tree.depth() == 6);
+    CHECK(tree.all_regions().size() == 6);
+    CHECK_FALSE(tree.is_inverted());
+
+    // Inside the box is removed, outside is kept, across is split.
+    auto inside   = square(2);
+    auto outside  = square(5);
+    auto far_away = square(50);
+    Polygon2D<Rat> wide{{P2{Rat(-2), Rat(1)}, P2{Rat(2), Rat(1)},
+        P2{Rat(2), Rat(3)}, P2{Rat(-2), Rat(3)}}};
+    auto across = make_region(RatPlane{Dir{0, 0, 1}, Rat(1)}, wide);
+
+    CHECK(tree.clip_regions({inside}).empty());
+    CHECK(tree.clip_regions({outside}).size() == 1);
+    CHECK(tree.clip_regions({far_away}).size() == 1);
+    CHECK(total_area(tree.clip_regions({across})) == Rat(4));
+
+    tree.invert();
+    CHECK(tree.is_inverted());
+    CHECK(total_area(tree.clip_regions({inside})) == Rat(4));
+    CHECK(tree.clip_regions({outside}).empty());
+    CHECK(tree.clip_regions({far_away}).empty());
+    CHECK(total_area(tree.clip_regions({across})) == Rat(4));
+
+    tree.invert();
+    CHECK(tree.clip_regions({inside}).empty());
+  }
+
+  SUBCASE("split heuristic")
+  {
+    // A row of separate cubes: the first region's plane keeps the tree a long
+    // chain, where the balanced choice halves it each time.
+    std::vector<Region> regions;
+    for (int i = 0; i < 8; ++i) {
+      auto cube_regions = regions_of(box(2 * i, 0, 0, 2 * i + 1, 1, 1));
+      regions.insert(
+          std::end(regions), std::begin(cube_regions), std::end(cube_regions));
+    }
+
+    RatTree first_plane{regions};
+
+    BspSplitHeuristic balanced;
+    balanced.candidate_count_ = 16;
+    balanced.split_weight_    = 8;
+    balanced.balance_weight_  = 1;
+    RatTree balanced_tree{regions, balanced};
+
+    CHECK(balanced_tree.depth() < first_plane.depth());
+    CHECK(total_area(balanced_tree.all_regions())
+          == total_area(first_plane.all_regions()));
+    CHECK(polyhedron_of(balanced_tree.all_regions())
+          == polyhedron_of(first_plane.all_regions()));
+
+    // Large, balanced splits are built on separate threads, to the same tree.
+    std::vector<Region> many;
+    for (int i = 0; i < 128; ++i) {
+      auto cube_regions = regions_of(box(2 * i, 0, 0, 2 * i + 1, 1, 1));
+      many.insert(
+          std::end(many), std::begin(cube_regions), std::end(cube_regions));
+    }
+    RatTree serial{many, balanced};
+    RatTree threaded{many, balanced, 4};
+    CHECK(threaded.node_count() == serial.node_count());
+    CHECK(threaded.depth() == serial.depth());
+    CHECK(polyhedron_of(threaded.all_regions())
+          == polyhedron_of(serial.all_regions()));
+  }
+
+  SUBCASE("boolean_operation()")
+  {
+    RatTree a{regions_of(box(0, 0, 0, 2, 2, 2))};
+    RatTree b{regions_of(box(1, 1, 1, 3, 3, 3))};
+
+    auto volume_of = [](const RatTree& tree) {
+      return polyhedron_of(tree.all_regions()).signed_volume();
+    };
+
+    CHECK(volume_of(boolean_operation(a, b, BooleanOperation::kUnion))
+          == Rat(15));
+    CHECK(volume_of(boolean_operation(a, b, BooleanOperation::kIntersection))
+          == Rat(1));
+    CHECK(volume_of(boolean_operation(a, b, BooleanOperation::kDifference))
+          == Rat(7));
+    CHECK(volume_of(boolean_operation(
+              a, b, BooleanOperation::kSymmetricDifference))
+          == Rat(14));
+
+    // Results are trees, ready for further operations.
+    auto united = boolean_operation(a, b, BooleanOperation::kUnion);
+    CHECK_FALSE(united.is_inverted());
+    CHECK(volume_of(boolean_operation(
+              united, a, BooleanOperation::kDifference))
+          == Rat(7));
+
+    CHECK(boolean_operation(a, RatTree{}, BooleanOperation::kIntersection)
+              .all_regions()
+              .empty());
+    CHECK(volume_of(boolean_operation(a, RatTree{}, BooleanOperation::kUnion))
+          == Rat(8));
+  }
+}
+
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
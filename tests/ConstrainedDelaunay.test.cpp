@@ -0,0 +1,225 @@
+
+#include "../src/rational_geometry/ConstrainedDelaunay.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "../src/rational_geometry/predicates.hpp"
+
+#include "doctest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing ConstrainedDelaunay.hpp")
+{
+  typedef FixedRational<long long, 4 * 3 * 5 * 7> Rat;
+  typedef ConstrainedDelaunay<Rat> RatTriangulation;
+  typedef RatTriangulation::PointT P;
+  const auto kNone = RatTriangulation::kNone;
+
+  auto has_edge = [](const RatTriangulation& triangulation, std::size_t from,
+                      std::size_t to) {
+    for (const auto& tri : triangulation.triangles()) {
+      for (std::size_t i = 0; i < 3; ++i) {
+        if (tri[i] == from && tri[(i + 1) % 3] == to) return true;
+        if (tri[i] == to && tri[(i + 1) % 3] == from) return true;
+      }
+    }
+    return false;
+  };
+
+  // Twice the area covered, with every triangle counter-clockwise.
+  auto doubled_area = [](const RatTriangulation& triangulation) {
+    const auto& v = triangulation.vertices();
+    Rat ret(0);
+    for (const auto& tri : triangulation.triangles()) {
+      auto a = v[tri[1]] - v[tri[0]];
+      auto b = v[tri[2]] - v[tri[0]];
+      auto doubled = a[0] * b[1] - a[1] * b[0];
+      CHECK(doubled > Rat(0));
+      ret += doubled;
+    }
+    return ret;
+  };
+
+  // Neighbours agree, and no point visible across an unconstrained edge lies
+  // within a triangle's circumcircle.
+  auto check_structure = [kNone](const RatTriangulation& triangulation) {
+    const auto& v         = triangulation.vertices();
+    const auto& triangles = triangulation.triangles();
+    const auto& neighbors = triangulation.neighbors();
+    for (std::size_t t = 0; t < triangles.size(); ++t) {
+      const auto& tri = triangles[t];
+      for (std::size_t i = 0; i < 3; ++i) {
+        auto other = neighbors[t][i];
+        if (other == kNone) continue;
+
+        const auto& other_tri = triangles[other];
+        std::size_t j         = 0;
+        while (j < 3
+               && !(other_tri[j] == tri[(i + 1) % 3]
+                    && other_tri[(j + 1) % 3] == tri[i])) {
+          ++j;
+        }
+        REQUIRE(j < 3);
+        CHECK(neighbors[other][j] == t);
+        CHECK(triangulation.is_constrained(other, j)
+              == triangulation.is_constrained(t, i));
+
+        if (!triangulation.is_constrained(t, i)) {
+          CHECK(incircle(v[tri[0]], v[tri[1]], v[tri[2]],
+                    v[other_tri[(j + 2) % 3]])
+                <= 0);
+        }
+      }
+    }
+  };
+
+  SUBCASE("Delaunay triangulation")
+  {
+    RatTriangulation empty{{}};
+    CHECK(empty.triangles().empty());
+
+    RatTriangulation collinear{{P{Rat(0), Rat(0)}, P{Rat(2), Rat(2)},
+        P{Rat(1), Rat(1)}}};
+    CHECK(collinear.triangles().empty());
+
+    // A square splits along one diagonal or the other.
+    RatTriangulation square{{P{Rat(0), Rat(0)}, P{Rat(1), Rat(0)},
+        P{Rat(1), Rat(1)}, P{Rat(0), Rat(1)}}};
+    CHECK(square.triangles().size() == 2);
+    CHECK(doubled_area(square) == Rat(2));
+    check_structure(square);
+
+    // Of a kite's two diagonals, only the short one is Delaunay.
+    RatTriangulation kite{{P{Rat(0), Rat(0)}, P{Rat(2), Rat(-1)},
+        P{Rat(4), Rat(0)}, P{Rat(2), Rat(1)}}};
+    CHECK(has_edge(kite, 1, 3));
+    CHECK_FALSE(has_edge(kite, 0, 2));
+    check_structure(kite);
+
+    // A grid, with a repeated point and points leading off in a line.
+    std::vector<P> grid;
+    for (int x = 0; x < 6; ++x) {
+      for (int y = 0; y < 5; ++y) {
+        grid.push_back(P{Rat(x), Rat(y, 2)});
+      }
+    }
+    grid.push_back(P{Rat(3), Rat(1)});
+    RatTriangulation grid_triangulation{grid};
+
+    // For n points, h on the hull, there are 2n - h - 2 triangles.
+    CHECK(grid_triangulation.triangles().size() == 2 * 30 - 18 - 2);
+    CHECK(doubled_area(grid_triangulation) == Rat(2 * 5 * 2));
+    check_structure(grid_triangulation);
+  }
+
+  SUBCASE("irregular points")
+  {
+    std::vector<P> points;
+    for (int i = 0; i < 40; ++i) {
+      points.push_back(P{Rat((i * 17) % 23, 4), Rat((i * 29) % 31, 3)});
+    }
+    RatTriangulation triangulation{points};
+    check_structure(triangulation);
+
+    // Each triangle's circumcircle is empty of every point.
+    const auto& v = triangulation.vertices();
+    for (const auto& tri : triangulation.triangles()) {
+      for (const auto& point : v) {
+        CHECK(incircle(v[tri[0]], v[tri[1]], v[tri[2]], point) <= 0);
+      }
+    }
+  }
+
+  SUBCASE("constraints")
+  {
+    std::vector<P> points{P{Rat(0), Rat(0)}, P{Rat(2), Rat(-1)},
+        P{Rat(4), Rat(0)}, P{Rat(2), Rat(1)}};
+    RatTriangulation kite{points, {{0, 2}}};
+    CHECK(has_edge(kite, 0, 2));
+    CHECK_FALSE(has_edge(kite, 1, 3));
+    check_structure(kite);
+
+    // A long constraint through a grid, crossing many edges.
+    std::vector<P> grid;
+    for (int x = 0; x < 7; ++x) {
+      for (int y = 0; y < 7; ++y) {
+        grid.push_back(P{Rat(x), Rat(y)});
+      }
+    }
+    grid.push_back(P{Rat(-1), Rat(1, 3)});
+    grid.push_back(P{Rat(7), Rat(5)});
+    auto from = grid.size() - 2;
+    auto to   = grid.size() - 1;
+
+    RatTriangulation unconstrained{grid};
+    RatTriangulation constrained{grid, {{from, to}}};
+    CHECK_FALSE(has_edge(unconstrained, from, to));
+    CHECK(has_edge(constrained, from, to));
+    CHECK(constrained.triangles().size() == unconstrained.triangles().size());
+    CHECK(doubled_area(constrained) == doubled_area(unconstrained));
+    check_structure(constrained);
+
+    std::size_t constrained_edges = 0;
+    for (std::size_t t = 0; t < constrained.triangles().size(); ++t) {
+      for (std::size_t i = 0; i < 3; ++i) {
+        constrained_edges += constrained.is_constrained(t, i);
+      }
+    }
+    CHECK(constrained_edges == 2);
+
+    // A constraint crossing it is refused.
+    CHECK_THROWS_AS(
+        constrained.add_constraint(0, 6 * 7 + 6), std::invalid_argument);
+
+    // One passing through points is split at them.
+    RatTriangulation diagonal{grid, {{0, 6 * 7 + 6}}};
+    for (int i = 0; i < 6; ++i) {
+      CHECK(has_edge(diagonal, i * 8, (i + 1) * 8));
+    }
+    check_structure(diagonal);
+
+    // One through points that are not neighbours of its ends.
+    RatTriangulation steep{grid, {{0, 6 * 7 + 3}}};
+    for (int i = 0; i < 3; ++i) {
+      CHECK(has_edge(steep, i * 15, (i + 1) * 15));
+    }
+    check_structure(steep);
+  }
+
+  SUBCASE("scattered points far from the origin")
+  {
+    // Beyond the predicates' long long filters, in any order.
+    std::vector<P> points;
+    unsigned seed = 7;
+    for (int i = 0; i < 300; ++i) {
+      seed   = seed * 1103515245u + 12345u;
+      auto x = static_cast<long long>(seed >> 8) % 5000;
+      seed   = seed * 1103515245u + 12345u;
+      auto y = static_cast<long long>(seed >> 8) % 5000;
+      points.push_back(P{Rat(x * 2000 + 3, 7LL), Rat(y * 2000, 5LL)});
+    }
+    points.push_back(points[17]);
+
+    RatTriangulation triangulation{points, {{3, 200}, {200, 41}}};
+    check_structure(triangulation);
+    CHECK(has_edge(triangulation, 3, 200));
+    CHECK(has_edge(triangulation, 200, 41));
+
+    std::reverse(std::begin(points), std::end(points));
+    RatTriangulation reversed{points};
+    CHECK(reversed.triangles().size() == triangulation.triangles().size());
+    CHECK(doubled_area(reversed) == doubled_area(triangulation));
+    check_structure(reversed);
+  }
+}
+
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
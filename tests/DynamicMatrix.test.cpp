@@ -0,0 +1,254 @@
+
+#include "../src/rational_geometry/DynamicMatrix.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+
+#include "doctest.h"
+
+#include <memory_resource>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing DynamicMatrix.hpp")
+{
+  typedef DynamicMatrix<int> IDynMat;
+  typedef DynamicPoint<int> IDynPoint;
+
+  SUBCASE("DynamicMatrix<> class")
+  {
+    SUBCASE("Constructors")
+    {
+      SUBCASE("DynamicMatrix()")
+      {
+        IDynMat a{};
+
+        CHECK(a.height() == 0);
+        CHECK(a.width() == 0);
+      }
+
+      SUBCASE("DynamicMatrix(size_t, size_t)")
+      {
+        IDynMat a(3, 5);
+
+        REQUIRE(a.height() == 3);
+        REQUIRE(a.width() == 5);
+
+        for (size_t i = 0; i < 3; ++i) {
+          for (size_t j = 0; j < 5; ++j) {
+            CHECK(a(i, j) == ((i == j) ? 1 : 0));
+          }
+        }
+      }
+
+      SUBCASE("DynamicMatrix(initializer_list<initializer_list<>>)")
+      {
+        // clang-format off
+        IDynMat a{
+            {11, 12},
+            {21, 22},
+            {31}};
+        // clang-format on
+
+        CHECK(a.height() == 3);
+        CHECK(a.width() == 2);
+
+        CHECK(a(0, 1) == 12);
+        CHECK(a(2, 0) == 31);
+        CHECK(a(2, 1) == 0);
+      }
+
+      SUBCASE("DynamicMatrix(Matrix<>)")
+      {
+        Matrix<int, 2, 3> fixed{{1, 2, 3}, {4, 5, 6}};
+        IDynMat a{fixed};
+
+        CHECK(a == IDynMat{{1, 2, 3}, {4, 5, 6}});
+      }
+
+      SUBCASE("with an arena allocator")
+      {
+        typedef std::pmr::polymorphic_allocator<int> ArenaAllocator;
+
+        std::pmr::monotonic_buffer_resource arena{};
+        DynamicMatrix<int, ArenaAllocator> a(10, 20, ArenaAllocator{&arena});
+        DynamicMatrix<int, ArenaAllocator> b(20, 10, ArenaAllocator{&arena});
+
+        CHECK(a.get_allocator().resource() == &arena);
+
+        auto product = a * b;
+        CHECK(product.get_allocator().resource() == &arena);
+        CHECK(product == DynamicMatrix<int, ArenaAllocator>(10, 10));
+      }
+    }
+
+    // clang-format off
+    IDynMat a{
+        {1, 2},
+        {3, 4}};
+
+    IDynMat rectangular{
+        {1, 2, 3},
+        {4, 5, 6}};
+    // clang-format on
+
+    SUBCASE("Accessors")
+    {
+      SUBCASE("data()")
+      {
+        const int* data = rectangular.data();
+
+        CHECK(data[2] == 3);
+        CHECK(data[3] == 4);
+      }
+
+      SUBCASE("as_fixed()")
+      {
+        Matrix<int, 2, 3> expected{{1, 2, 3}, {4, 5, 6}};
+        CHECK(rectangular.as_fixed<2, 3>() == expected);
+
+        CHECK_THROWS_AS((rectangular.as_fixed<3, 2>()), std::invalid_argument);
+      }
+    }
+
+    SUBCASE("Getters")
+    {
+      CHECK(rectangular.get_row(1) == IDynPoint{4, 5, 6});
+      CHECK(rectangular.get_column(2) == IDynPoint{3, 6});
+    }
+
+    SUBCASE("Setters")
+    {
+      rectangular.set_row(0, IDynPoint{7, 8, 9});
+      CHECK(rectangular == IDynMat{{7, 8, 9}, {4, 5, 6}});
+
+      rectangular.set_column(1, IDynPoint{0, 0});
+      CHECK(rectangular == IDynMat{{7, 0, 9}, {4, 0, 6}});
+
+      CHECK_THROWS_AS(rectangular.set_row(0, a.get_row(0)),
+          std::invalid_argument);
+      CHECK_THROWS_AS(rectangular.set_column(0, IDynPoint{1, 2, 3}),
+          std::invalid_argument);
+    }
+  }
+
+  SUBCASE("Related operators")
+  {
+    // clang-format off
+    IDynMat a{
+        {1, 2},
+        {3, 4}};
+
+    IDynMat not_a{
+        {1, 2},
+        {3, 5}};
+    // clang-format on
+
+    SUBCASE("DynamicMatrix<> == DynamicMatrix<>")
+    {
+      CHECK(a == IDynMat{{1, 2}, {3, 4}});
+      CHECK(a != not_a);
+      CHECK(a != IDynMat{{1, 2, 0}, {3, 4, 0}});
+
+      DynamicMatrix<char> a_char{{1, 2}, {3, 4}};
+      CHECK(a == a_char);
+    }
+
+    SUBCASE("DynamicMatrix<> < DynamicMatrix<>")
+    {
+      CHECK(a < not_a);
+      CHECK_FALSE(not_a < a);
+      CHECK(a < IDynMat(3, 3));
+    }
+
+    SUBCASE("DynamicMatrix<> * DynamicMatrix<>")
+    {
+      // clang-format off
+      IDynMat lop_mat{
+          {1, 2, 3},
+          {4, 5, 6}};
+
+      IDynMat rop_mat{
+          { 7,  8},
+          { 9, 10},
+          {11, 12}};
+
+      IDynMat expected{
+          { 58,  64},
+          {139, 154}};
+      // clang-format on
+
+      CHECK(lop_mat * rop_mat == expected);
+      CHECK_THROWS_AS(lop_mat * lop_mat, std::invalid_argument);
+
+      SUBCASE("Larger than a block")
+      {
+        const size_t kHeight = 70;
+        const size_t kCommon = 130;
+        const size_t kWidth  = 65;
+
+        IDynMat l_op(kHeight, kCommon);
+        IDynMat r_op(kCommon, kWidth);
+        for (size_t i = 0; i < kHeight; ++i) {
+          for (size_t j = 0; j < kCommon; ++j) {
+            l_op(i, j) = static_cast<int>((i * 7 + j * 3) % 11) - 5;
+          }
+        }
+        for (size_t i = 0; i < kCommon; ++i) {
+          for (size_t j = 0; j < kWidth; ++j) {
+            r_op(i, j) = static_cast<int>((i * 5 + j * 2) % 13) - 6;
+          }
+        }
+
+        auto product = l_op * r_op;
+        REQUIRE(product.height() == kHeight);
+        REQUIRE(product.width() == kWidth);
+
+        bool all_match = true;
+        for (size_t i = 0; i < kHeight; ++i) {
+          for (size_t j = 0; j < kWidth; ++j) {
+            auto expected = dot(l_op.get_row(i), r_op.get_column(j));
+            all_match     = all_match && product(i, j) == expected;
+          }
+        }
+        CHECK(all_match);
+      }
+
+      SUBCASE("Agrees with Matrix<>")
+      {
+        Matrix<int, 2, 3> fixed_l{{1, 2, 3}, {4, 5, 6}};
+        Matrix<int, 3, 2> fixed_r{{7, 8}, {9, 10}, {11, 12}};
+
+        auto product = IDynMat{fixed_l} * IDynMat{fixed_r};
+        CHECK((product.as_fixed<2, 2>()) == fixed_l * fixed_r);
+      }
+
+      SUBCASE("FixedRational")
+      {
+        using Rat = FixedRational<int, 12>;
+        DynamicMatrix<Rat> half{{Rat{1, 2}, Rat{0}}, {Rat{0}, Rat{1, 2}}};
+
+        DynamicMatrix<Rat> expected_quarter{
+            {Rat{1, 4}, Rat{0}}, {Rat{0}, Rat{1, 4}}};
+        CHECK(half * half == expected_quarter);
+      }
+    }
+
+    SUBCASE("DynamicMatrix<> * DynamicPoint<>")
+    {
+      IDynPoint b{1, 1};
+
+      CHECK(a * b == IDynPoint{3, 7});
+      CHECK_THROWS_AS((a * IDynPoint{1, 2, 3}), std::invalid_argument);
+    }
+  }
+}
+
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
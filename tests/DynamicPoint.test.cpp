@@ -0,0 +1,146 @@
+
+#include "../src/rational_geometry/DynamicPoint.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+
+#include "doctest.h"
+
+#include <memory_resource>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing DynamicPoint.hpp")
+{
+  typedef DynamicPoint<int> IDynPoint;
+
+  SUBCASE("DynamicPoint<> class")
+  {
+    SUBCASE("constructors")
+    {
+      SUBCASE("DynamicPoint()")
+      {
+        IDynPoint a{};
+        CHECK(a.dimension() == 0);
+      }
+
+      SUBCASE("DynamicPoint(size_t)")
+      {
+        IDynPoint a(5);
+
+        REQUIRE(a.dimension() == 5);
+        for (const auto& coordinate : a) {
+          CHECK(coordinate == 0);
+        }
+
+        using Rat = FixedRational<int, 12>;
+        DynamicPoint<Rat> b(3);
+        CHECK(b[2] == 0);
+      }
+
+      SUBCASE("DynamicPoint(std::initializer_list)")
+      {
+        IDynPoint a{1, 2, 3, 4};
+
+        CHECK(a.dimension() == 4);
+        CHECK(a[3] == 4);
+      }
+
+      SUBCASE("DynamicPoint(Point<>)")
+      {
+        Point<int, 3> fixed{1, 2, 3};
+        IDynPoint a{fixed};
+
+        CHECK(a == IDynPoint{1, 2, 3});
+      }
+
+      SUBCASE("with an arena allocator")
+      {
+        std::pmr::monotonic_buffer_resource arena{};
+        std::pmr::polymorphic_allocator<int> allocator{&arena};
+
+        DynamicPoint<int, std::pmr::polymorphic_allocator<int>> a(
+            100, allocator);
+
+        CHECK(a.get_allocator().resource() == &arena);
+
+        auto b = a + a;
+        CHECK(b.get_allocator().resource() == &arena);
+      }
+    }
+
+    SUBCASE("accessors")
+    {
+      SUBCASE("as_fixed()")
+      {
+        IDynPoint a{1, 2, 3};
+
+        Point<int, 3> expected{1, 2, 3};
+        CHECK(a.as_fixed<3>() == expected);
+
+        CHECK_THROWS_AS(a.as_fixed<2>(), std::invalid_argument);
+      }
+    }
+  }
+
+  SUBCASE("DynamicPoint<> [comparator operator] DynamicPoint<>")
+  {
+    IDynPoint a{1, 2, 3};
+    IDynPoint b{1, 2, 4};
+    IDynPoint c{1, 2};
+
+    CHECK(a == IDynPoint{1, 2, 3});
+    CHECK(a != b);
+    CHECK(a != c);
+
+    CHECK(a < b);
+    CHECK(c < a);
+    CHECK_FALSE(b < a);
+
+    SUBCASE("Different types")
+    {
+      DynamicPoint<char> a_char{1, 2, 3};
+      CHECK(a == a_char);
+    }
+  }
+
+  SUBCASE("DynamicPoint<> + DynamicPoint<>")
+  {
+    IDynPoint a{1, 2, 3};
+    IDynPoint b{10, 20, 30};
+
+    CHECK(a + b == IDynPoint{11, 22, 33});
+    CHECK_THROWS_AS((a + IDynPoint{1, 2}), std::invalid_argument);
+  }
+
+  SUBCASE("DynamicPoint<> * RatT")
+  {
+    IDynPoint a{3, 5, 7};
+
+    CHECK(a * 2 == IDynPoint{6, 10, 14});
+    CHECK(2 * a == IDynPoint{6, 10, 14});
+  }
+
+  SUBCASE("dot()")
+  {
+    IDynPoint a{1, 2, 3, 4};
+    IDynPoint b{4, 3, 2, 1};
+
+    CHECK(dot(a, b) == 20);
+    CHECK_THROWS_AS((dot(a, IDynPoint{1})), std::invalid_argument);
+
+    using Rat = FixedRational<int, 12>;
+    DynamicPoint<Rat> c{Rat{1, 2}, Rat{1, 3}};
+    DynamicPoint<Rat> d{Rat{2}, Rat{3}};
+    CHECK(dot(c, d) == 2);
+  }
+}
+
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
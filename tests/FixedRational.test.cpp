@@ -258,6 +258,32 @@ TEST_CASE("Testing FixedRational.hpp")
         ApproxRat b{1};
         CHECK(-b == -1);
       }
+
+      SUBCASE("compound assignment")
+      {
+        MyRationalT a{1, 2};
+
+        a += MyRationalT{1, 4};
+        CHECK(a == MyRationalT{3, 4});
+
+        a -= MyRationalT{1};
+        CHECK(a == MyRationalT{-1, 4});
+
+        a *= MyRationalT{-2};
+        CHECK(a == MyRationalT{1, 2});
+
+        a /= MyRationalT{1, 3};
+        CHECK(a == MyRationalT{3, 2});
+
+        SUBCASE("Exceptional")
+        {
+          using SmallerRat = FixedRational<int, 12>;
+
+          SmallerRat b{1, 3};
+          CHECK_THROWS_AS(b *= SmallerRat(2, 3),
+              unrepresentable_operation_error<int>);
+        }
+      }
     }
   }
 
@@ -715,6 +741,13 @@ TEST_CASE("Testing FixedRational.hpp")
           CHECK_FALSE(a * b == r_2_3);
           CHECK_FALSE(r_2_3 / b == a);
 
+          SUBCASE("Negative divisor")
+          {
+            CHECK(-a == c / -b);
+            CHECK(r_1_4 == -r_1_6 / -r_2_3);
+            CHECK(-2 == c / MyRationalT{-3});
+          }
+
           SUBCASE("Exceptional")
           {
             using RatI18 = FixedRational<int, 18>;
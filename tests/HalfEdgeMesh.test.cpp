@@ -0,0 +1,187 @@
+
+#include "../src/rational_geometry/HalfEdgeMesh.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "../src/rational_geometry/Polyhedron.hpp"
+
+#include "doctest.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing HalfEdgeMesh.hpp")
+{
+  typedef FixedRational<long long, 4 * 9 * 5> Rat;
+  typedef HalfEdgeMesh<Rat> Mesh;
+  typedef Mesh::PointT P;
+  typedef Mesh::DirectionT D;
+  typedef std::vector<std::size_t> Ring;
+  const auto kNone = Mesh::kNone;
+
+  std::vector<P> tetrahedron_vertices{P{Rat(0), Rat(0), Rat(0)},
+      P{Rat(1), Rat(0), Rat(0)}, P{Rat(0), Rat(1), Rat(0)},
+      P{Rat(0), Rat(0), Rat(1)}};
+  std::vector<Ring> tetrahedron_faces{
+      {0, 2, 1}, {0, 1, 3}, {0, 3, 2}, {1, 2, 3}};
+
+  // Every half-edge's links agree with those of its neighbours.
+  auto check_links = [kNone](const Mesh& mesh) {
+    const auto& half_edges = mesh.half_edges();
+    for (std::size_t i = 0; i < half_edges.size(); ++i) {
+      const auto& half_edge = half_edges[i];
+      if (half_edge.origin_ == kNone) continue;
+
+      CHECK(half_edges[half_edge.next_].prev_ == i);
+      CHECK(half_edges[half_edge.prev_].next_ == i);
+      CHECK(half_edges[half_edge.next_].face_ == half_edge.face_);
+      if (half_edge.twin_ != kNone) {
+        CHECK(half_edges[half_edge.twin_].twin_ == i);
+        CHECK(half_edges[half_edge.twin_].origin_ == mesh.destination(i));
+      }
+    }
+    for (std::size_t v = 0; v < mesh.vertices().size(); ++v) {
+      auto half_edge = mesh.vertex_half_edge(v);
+      if (half_edge != kNone) CHECK(half_edges[half_edge].origin_ == v);
+    }
+  };
+
+  SUBCASE("construction")
+  {
+    Mesh empty{};
+    CHECK(empty.face_count() == 0);
+    CHECK(empty.half_edges().empty());
+
+    Mesh tetrahedron{tetrahedron_vertices, tetrahedron_faces};
+    CHECK(tetrahedron.face_count() == 4);
+    CHECK(tetrahedron.half_edges().size() == 12);
+    check_links(tetrahedron);
+    for (std::size_t i = 0; i < 12; ++i) {
+      CHECK_FALSE(tetrahedron.is_boundary(i));
+    }
+
+    CHECK(tetrahedron.face_normal(0) == D{0, 0, -1});
+    CHECK(tetrahedron.face_normal(3) == D{1, 1, 1});
+    CHECK(tetrahedron.face_vertices(3) == Ring{1, 2, 3});
+
+    auto edge = tetrahedron.find_half_edge(1, 2);
+    REQUIRE(edge != kNone);
+    CHECK(tetrahedron.half_edges()[edge].face_ == 3);
+    CHECK(tetrahedron.half_edges()[tetrahedron.half_edges()[edge].twin_].face_
+          == 0);
+    CHECK(tetrahedron.find_half_edge(1, 1) == kNone);
+
+    // Open surfaces have boundary edges.
+    Mesh square{{P{Rat(0), Rat(0), Rat(0)}, P{Rat(2), Rat(0), Rat(0)},
+                    P{Rat(2), Rat(2), Rat(0)}, P{Rat(0), Rat(2), Rat(0)}},
+        {{0, 1, 2}, {0, 2, 3}}};
+    check_links(square);
+    std::size_t boundary = 0;
+    for (std::size_t i = 0; i < square.half_edges().size(); ++i) {
+      boundary += square.is_boundary(i);
+    }
+    CHECK(boundary == 4);
+    CHECK(square.find_half_edge(3, 0) != kNone);
+    CHECK(square.find_half_edge(0, 3) == kNone);
+
+    CHECK_THROWS_AS(
+        (Mesh{tetrahedron_vertices, {{0, 1, 2}, {0, 1, 3}}}),
+        std::invalid_argument);
+  }
+
+  SUBCASE("normals whose sums are not representable")
+  {
+    // Newell's sums over these numerators overflow int, though the normal
+    // is small.
+    typedef FixedRational<int, 1000> Milli;
+    typedef HalfEdgeMesh<Milli> MilliMesh;
+    typedef MilliMesh::PointT MP;
+
+    MilliMesh square{{MP{Milli(0), Milli(0), Milli(0)},
+                         MP{Milli(100), Milli(0), Milli(0)},
+                         MP{Milli(100), Milli(100), Milli(0)},
+                         MP{Milli(0), Milli(100), Milli(0)}},
+        {{0, 1, 2, 3}}};
+    CHECK(square.face_normal(0) == MilliMesh::DirectionT{0, 0, 1});
+
+    MilliMesh slope{{MP{Milli(0), Milli(0), Milli(0)},
+                        MP{Milli(100), Milli(0), Milli(100)},
+                        MP{Milli(0), Milli(100), Milli(0)}},
+        {{0, 1, 2}}};
+    CHECK(slope.face_normal(0) == MilliMesh::DirectionT{-1, 0, 1});
+  }
+
+  SUBCASE("polyhedra")
+  {
+    auto box = make_box(
+        P{Rat(0), Rat(0), Rat(0)}, P{Rat(3, 2), Rat(2), Rat(1)});
+    Mesh mesh{box};
+    CHECK(mesh.face_count() == 6);
+    CHECK(mesh.half_edges().size() == 24);
+    check_links(mesh);
+
+    for (std::size_t face = 0; face < mesh.face_count(); ++face) {
+      const auto& normal = mesh.face_normal(face);
+      auto expected      = box.face_normal(face);
+      for (std::size_t i = 0; i < 3; ++i) {
+        CHECK((normal.get(i) > 0) == (expected[i] > Rat(0)));
+        CHECK((normal.get(i) < 0) == (expected[i] < Rat(0)));
+      }
+    }
+
+    CHECK(mesh.polyhedron().signed_volume() == box.signed_volume());
+
+    auto framed = make_box(P{Rat(0), Rat(0), Rat(0)},
+                      P{Rat(3), Rat(3), Rat(1)})
+                  - make_box(P{Rat(1), Rat(1), Rat(-1)},
+                      P{Rat(2), Rat(2), Rat(2)});
+    CHECK_THROWS_AS(Mesh{framed}, std::invalid_argument);
+  }
+
+  SUBCASE("editing")
+  {
+    Mesh mesh{tetrahedron_vertices, tetrahedron_faces};
+
+    mesh.remove_face(1);
+    check_links(mesh);
+    CHECK(mesh.face_half_edge(1) == kNone);
+    CHECK(mesh.face_vertices(1).empty());
+    CHECK(mesh.find_half_edge(0, 1) == kNone);
+    CHECK(mesh.is_boundary(mesh.find_half_edge(1, 0)));
+    CHECK(mesh.polyhedron().faces().size() == 3);
+
+    // The face can be put back, and linked again.
+    auto face = mesh.add_face({0, 1, 3});
+    CHECK(face == 4);
+    check_links(mesh);
+    CHECK_FALSE(mesh.is_boundary(mesh.find_half_edge(1, 0)));
+    CHECK_THROWS_AS(mesh.add_face({3, 0, 1}), std::invalid_argument);
+
+    mesh.compact();
+    check_links(mesh);
+    CHECK(mesh.face_count() == 4);
+    CHECK(mesh.half_edges().size() == 12);
+    CHECK(mesh.face_vertices(3) == Ring{0, 1, 3});
+    CHECK(mesh.polyhedron().signed_volume() == Rat(1, 6));
+
+    // Vertices left in no face are dropped.
+    mesh.remove_face(0);
+    mesh.remove_face(1);
+    mesh.remove_face(3);
+    mesh.compact();
+    check_links(mesh);
+    CHECK(mesh.face_count() == 1);
+    CHECK(mesh.vertices().size() == 3);
+    CHECK(mesh.vertices()[0] == tetrahedron_vertices[1]);
+    CHECK(mesh.face_vertices(0) == Ring{0, 1, 2});
+    CHECK(mesh.face_normal(0) == D{1, 1, 1});
+  }
+}
+
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
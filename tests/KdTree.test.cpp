@@ -0,0 +1,185 @@
+
+#include "../src/rational_geometry/KdTree.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "../src/rational_geometry/Point.hpp"
+#include "../src/rational_geometry/WideInteger.hpp"
+#include "../src/rational_geometry/predicates.hpp"
+
+#include "doctest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing KdTree.hpp")
+{
+  typedef FixedRational<long long, 4 * 9 * 5> Rat;
+  typedef KdTree<Rat, 3> Tree;
+  typedef Tree::PointT P;
+  typedef std::vector<std::size_t> Indices;
+
+  auto p = [](int x, int y, int z) { return P{Rat(x), Rat(y), Rat(z)}; };
+
+  SUBCASE("small trees")
+  {
+    Tree empty{};
+    CHECK(empty.depth() == 0);
+    CHECK(empty.nearest(p(0, 0, 0)) == Tree::kNone);
+    CHECK(empty.nearest(p(0, 0, 0), 3).empty());
+    CHECK(empty.within(p(0, 0, 0), Rat(5)).empty());
+
+    Tree tree{{p(0, 0, 0), p(2, 0, 0), p(0, 3, 0), p(0, 0, 4),
+        P{Rat(1, 2), Rat(1, 3), Rat(1, 4)}}};
+    CHECK(tree.depth() == 3);
+    CHECK(tree.nearest(p(0, 0, 0)) == 0);
+    CHECK(tree.nearest(p(3, 0, 0)) == 1);
+    CHECK(tree.nearest(P{Rat(1, 2), Rat(0), Rat(0)}) == 4);
+    CHECK(tree.nearest(p(0, 0, 0), 3) == Indices{0, 4, 1});
+    CHECK(tree.nearest(p(0, 0, 0), 9) == Indices{0, 4, 1, 2, 3});
+    CHECK(tree.nearest(p(0, 0, 0), 0).empty());
+
+    // Exactly equal distances go to the lower index.
+    CHECK(tree.nearest(p(1, 0, 0), 3) == Indices{4, 0, 1});
+    CHECK(tree.within(p(0, 0, 0), Rat(3)) == Indices{0, 1, 2, 4});
+    CHECK(tree.within(p(0, 0, 0), Rat(-1)).empty());
+  }
+
+  SUBCASE("against brute force")
+  {
+    // A deterministic scatter, with some points repeated.
+    std::vector<P> points;
+    unsigned long long state = 12345;
+    auto next = [&state](int range) {
+      state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+      return static_cast<int>((state >> 33) % range) - range / 2;
+    };
+    for (int i = 0; i < 300; ++i) {
+      points.push_back(P{Rat(next(40), 4), Rat(next(40), 3), Rat(next(8))});
+    }
+    for (int i = 0; i < 20; ++i) {
+      points.push_back(points[i * 7]);
+    }
+    Tree tree{points};
+    CHECK(tree.points() == points);
+    CHECK(tree.depth() == 9);
+
+    auto by_distance = [&points](const P& query) {
+      Indices ret(points.size());
+      for (std::size_t i = 0; i < ret.size(); ++i) {
+        ret[i] = i;
+      }
+      std::sort(ret.begin(), ret.end(), [&](std::size_t l, std::size_t r) {
+        auto l_distance = scaled_squared_distance(points[l], query);
+        auto r_distance = scaled_squared_distance(points[r], query);
+        return l_distance < r_distance || (l_distance == r_distance && l < r);
+      });
+      return ret;
+    };
+
+    std::vector<P> queries;
+    for (int i = 0; i < 30; ++i) {
+      queries.push_back(P{Rat(next(50), 5), Rat(next(50), 4), Rat(next(10))});
+    }
+    queries.push_back(points[14]);
+
+    auto batched = tree.nearest(queries, 7);
+    auto nearby  = tree.within(queries, Rat(3, 2));
+    REQUIRE(batched.size() == queries.size());
+    REQUIRE(nearby.size() == queries.size());
+    for (std::size_t i = 0; i < queries.size(); ++i) {
+      auto expected = by_distance(queries[i]);
+      CHECK(tree.nearest(queries[i]) == expected[0]);
+      CHECK(batched[i] == Indices(expected.begin(), expected.begin() + 7));
+
+      Indices expected_nearby;
+      for (std::size_t j = 0; j < points.size(); ++j) {
+        if (scaled_squared_distance(points[j], queries[i]) <= 270 * 270) {
+          expected_nearby.push_back(j);
+        }
+      }
+      CHECK(nearby[i] == expected_nearby);
+    }
+    CHECK(batched.back()[0] == 14);
+    CHECK(batched.back()[1] == 302);
+  }
+
+  SUBCASE("threaded construction")
+  {
+    std::vector<P> points;
+    for (int i = 0; i < 3 * static_cast<int>(Tree::kParallelMinimum); ++i) {
+      points.push_back(p((i * 7) % 401, (i * 13) % 397, (i * 29) % 409));
+    }
+    Tree single{points};
+    Tree threaded{points, 4};
+
+    std::vector<P> queries{p(0, 0, 0), p(200, 100, 300), p(-50, 500, 20),
+        P{Rat(1, 2), Rat(401, 3), Rat(77, 4)}};
+    CHECK(threaded.nearest(queries, 5) == single.nearest(queries, 5));
+    CHECK(threaded.within(queries, Rat(9)) == single.within(queries, Rat(9)));
+    CHECK_FALSE(threaded.within(queries, Rat(9))[1].empty());
+  }
+
+  SUBCASE("far from the origin at a fine resolution")
+  {
+    // Squared numerator offsets here pass 2^63.
+    typedef FixedRational<long long, 1000000> Micro;
+    typedef KdTree<Micro, 3> MicroTree;
+    typedef MicroTree::PointT MP;
+
+    unsigned long long state = 54321;
+    auto next = [&state] {
+      state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+      return static_cast<long long>((state >> 20) % 10000000001ULL)
+             - 5000000000LL;
+    };
+    auto random_point = [&next] {
+      return MP{Micro(next(), 1000000LL), Micro(next(), 1000000LL),
+          Micro(next(), 1000000LL)};
+    };
+
+    std::vector<MP> points;
+    for (int i = 0; i < 200; ++i) {
+      points.push_back(random_point());
+    }
+    MicroTree tree{points};
+
+    // Distances over the numerators, independently of the tree's helper.
+    auto distance = [](const MP& a, const MP& b) {
+      WideInteger<256> ret(0);
+      for (std::size_t i = 0; i < 3; ++i) {
+        WideInteger<256> offset(a[i].numerator() - b[i].numerator());
+        ret += offset * offset;
+      }
+      return ret;
+    };
+
+    for (int i = 0; i < 50; ++i) {
+      auto query           = random_point();
+      std::size_t expected = 0;
+      for (std::size_t j = 1; j < points.size(); ++j) {
+        if (distance(points[j], query) < distance(points[expected], query)) {
+          expected = j;
+        }
+      }
+      CHECK(tree.nearest(query) == expected);
+
+      Indices expected_nearby;
+      WideInteger<256> limit(3000LL * 1000000LL);
+      for (std::size_t j = 0; j < points.size(); ++j) {
+        if (distance(points[j], query) <= limit * limit) {
+          expected_nearby.push_back(j);
+        }
+      }
+      CHECK(tree.within(query, Micro(3000)) == expected_nearby);
+    }
+  }
+}
+
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -1,9 +1,12 @@
 
 #include "../src/rational_geometry/Matrix.hpp"
 
+#include "../src/rational_geometry/FixedRational.hpp"
+
 #include "doctest.h"
 
 #include <ostream>
+#include <stdexcept>
 #include <string>
 #include <typeinfo>
 
@@ -457,6 +460,225 @@ TEST_CASE("Testing Matrix.hpp")
       CHECK(expected_a_b == a * b);
       CHECK(expected_a_b == b * a);
     }
+
+    SUBCASE("constexpr")
+    {
+      typedef std::array<Point<int, 2>, 2> Rotation;
+
+      // A fixed transform stack, folded into one Matrix at compile time.
+      constexpr auto folded =
+          make_translation(Point<int, 2>{2, 3})
+          * make_rotation(Rotation{Point<int, 2>{0, 1}, Point<int, 2>{-1, 0}})
+          * make_scale<2>(5) * make_stretch<2>(0, 2);
+
+      // clang-format off
+      constexpr Matrix<int, 3> expected{
+          { 0, -5, 2},
+          {10,  0, 3},
+          { 0,  0, 1}};
+      // clang-format on
+      static_assert(folded == expected, "transforms fold at compile time");
+
+      constexpr auto moved = folded * Point<int, 2>{1, 1}.as_point();
+      static_assert(moved.as_simpler() == Point<int, 2>{-3, 13},
+          "points transform at compile time");
+
+      static_assert(folded.get_row(1) == Point<int, 3>{10, 0, 3},
+          "constexpr get_row()");
+      static_assert(folded.get_column(0) == Point<int, 3>{0, 10, 0},
+          "constexpr get_column()");
+
+      CHECK(folded == expected);
+    }
+
+    // clang-format off
+    const IMat2 two{
+        {3, 1},
+        {4, 2}};
+
+    const Matrix<int, 3> three{
+        {2, 1, 0},
+        {1, 3, 1},
+        {0, 1, 4}};
+
+    const Matrix<int, 4> four{
+        {2, 0, 1, 3},
+        {1, 1, 0, 2},
+        {0, 3, 1, 1},
+        {4, 1, 2, 0}};
+
+    const Matrix<int, 5> five{
+        {2, 1, 0, 0, 3},
+        {1, 3, 1, 0, 0},
+        {0, 1, 4, 1, 2},
+        {5, 0, 1, 2, 1},
+        {1, 2, 0, 1, 1}};
+
+    // Third row is the sum of the first two.
+    const Matrix<int, 3> singular_three{
+        {1, 2, 3},
+        {4, 5, 6},
+        {5, 7, 9}};
+
+    const Matrix<int, 5> singular_five{
+        {1, 2, 3, 4, 5},
+        {2, 0, 1, 1, 3},
+        {3, 2, 4, 5, 8},
+        {0, 1, 1, 2, 2},
+        {1, 1, 0, 3, 1}};
+    // clang-format on
+
+    SUBCASE("determinant()")
+    {
+      CHECK(determinant(Matrix<int, 1>{{7}}) == 7);
+      CHECK(determinant(two) == 2);
+      CHECK(determinant(three) == 18);
+      CHECK(determinant(four) == -32);
+      CHECK(determinant(five) == 220);
+
+      CHECK(determinant(IMat2{}) == 1);
+      CHECK(determinant(Matrix<int, 6>{}) == 1);
+
+      SUBCASE("closed forms agree with elimination")
+      {
+        CHECK(bareiss_determinant(two.values_) == determinant(two));
+        CHECK(bareiss_determinant(three.values_) == determinant(three));
+        CHECK(bareiss_determinant(four.values_) == determinant(four));
+      }
+
+      SUBCASE("singular")
+      {
+        CHECK(determinant(IMat2{{1, 2}, {2, 4}}) == 0);
+        CHECK(determinant(singular_three) == 0);
+        CHECK(determinant(singular_five) == 0);
+
+        Matrix<int, 4> zero_column{four};
+        zero_column.set_column(2, Point<int, 4>{});
+        CHECK(determinant(zero_column) == 0);
+      }
+
+      SUBCASE("requires row swaps")
+      {
+        // clang-format off
+        Matrix<int, 5> swapped{
+            {0, 1, 0, 0, 0},
+            {1, 0, 0, 0, 0},
+            {0, 0, 0, 0, 2},
+            {0, 0, 3, 0, 0},
+            {0, 0, 0, 1, 0}};
+        // clang-format on
+
+        CHECK(determinant(swapped) == -6);
+      }
+    }
+
+    SUBCASE("adjugate()")
+    {
+      // clang-format off
+      IMat2 expected_two{
+          { 2, -1},
+          {-4,  3}};
+      // clang-format on
+      CHECK(adjugate(two) == expected_two);
+
+      auto check_adjugate = [](const auto& matrix) {
+        auto product         = matrix * adjugate(matrix);
+        auto expected        = product;
+        auto the_determinant = determinant(matrix);
+        for (size_t i = 0; i < expected.values_.size(); ++i) {
+          for (size_t j = 0; j < expected.values_[i].size(); ++j) {
+            expected.values_[i][j] = (i == j) ? the_determinant : 0;
+          }
+        }
+        CHECK(product == expected);
+      };
+
+      check_adjugate(three);
+      check_adjugate(four);
+      check_adjugate(five);
+
+      SUBCASE("singular")
+      {
+        check_adjugate(singular_three);
+        check_adjugate(singular_five);
+
+        // Rank n-1, so the adjugate is not zero.
+        int nonzero_entries = 0;
+        for (const auto& row : adjugate(singular_five).values_) {
+          for (const auto& entry : row) {
+            nonzero_entries += (entry != 0) ? 1 : 0;
+          }
+        }
+        CHECK(nonzero_entries > 0);
+
+        // clang-format off
+        Matrix<int, 3> expected{
+            { 3,  3, -3},
+            {-6, -6,  6},
+            { 3,  3, -3}};
+        // clang-format on
+        CHECK(adjugate(singular_three) == expected);
+      }
+    }
+
+    SUBCASE("inverse()")
+    {
+      using Rat = FixedRational<long long, 32 * 9 * 5 * 11>;
+
+      // clang-format off
+      Matrix<Rat, 3> rat_three{
+          {Rat{2}, Rat{1}, Rat{0}},
+          {Rat{1}, Rat{3}, Rat{1}},
+          {Rat{0}, Rat{1}, Rat{4}}};
+
+      Matrix<Rat, 4> rat_four{
+          {Rat{2}, Rat{0}, Rat{1}, Rat{3}},
+          {Rat{1}, Rat{1}, Rat{0}, Rat{2}},
+          {Rat{0}, Rat{3}, Rat{1}, Rat{1}},
+          {Rat{4}, Rat{1}, Rat{2}, Rat{0}}};
+      // clang-format on
+
+      CHECK(inverse(rat_three) * rat_three == Matrix<Rat, 3>{});
+      CHECK(rat_three * inverse(rat_three) == Matrix<Rat, 3>{});
+      CHECK(inverse(rat_four) * rat_four == Matrix<Rat, 4>{});
+
+      CHECK(inverse(IMat2{{0, 1}, {-1, 0}}) == IMat2{{0, -1}, {1, 0}});
+
+      SUBCASE("singular")
+      {
+        CHECK_THROWS_AS(inverse(singular_three), std::domain_error);
+        CHECK_THROWS_AS(inverse(singular_five), std::domain_error);
+      }
+    }
+
+    SUBCASE("solve()")
+    {
+      using Rat = FixedRational<long long, 32 * 9 * 5 * 11>;
+
+      Point<int, 3> three_expected{1, -2, 3};
+      auto three_values = three * three_expected;
+      CHECK(solve(three, three_values) == three_expected);
+
+      Point<int, 5> five_expected{3, 1, -4, 1, -5};
+      auto five_values = five * five_expected;
+      CHECK(solve(five, five_values) == five_expected);
+
+      // clang-format off
+      Matrix<Rat, 2> rat_two{
+          {Rat{3}, Rat{1}},
+          {Rat{4}, Rat{2}}};
+      // clang-format on
+      Point<Rat, 2> rat_values{Rat{1}, Rat{0}};
+      Point<Rat, 2> rat_expected{Rat{1}, Rat{-2}};
+      CHECK(solve(rat_two, rat_values) == rat_expected);
+
+      SUBCASE("singular")
+      {
+        CHECK_THROWS_AS(
+            solve(singular_three, Point<int, 3>{1, 2, 3}), std::domain_error);
+        CHECK_THROWS_AS(solve(singular_five, five_values), std::domain_error);
+      }
+    }
   }
 }
 
@@ -0,0 +1,161 @@
+
+#include "../src/rational_geometry/Plane.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "../src/rational_geometry/Point.hpp"
+#include "../src/rational_geometry/predicates.hpp"
+
+#include "doctest.h"
+
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing Plane.hpp")
+{
+  typedef Plane<int> IPlane;
+  typedef IPlane::DirectionT IDirection;
+  typedef Point<int, 3> IPoint;
+  typedef FixedRational<long long, 8 * 9 * 125> Rat;
+  typedef Point<Rat, 3> RatPoint;
+
+  const IPlane floor{IDirection{0, 0, 1}, 0};
+  const IPlane tilted{IDirection{1, 1, 1}, 3};
+
+  SUBCASE("Plane<> class")
+  {
+    SUBCASE("constructors")
+    {
+      IPlane null_plane{};
+      CHECK(null_plane.normal() == IDirection{0, 0, 0});
+      CHECK(null_plane.offset() == 0);
+
+      // The normal is kept in lowest terms, so the offset must match it.
+      IPlane scaled{IDirection{0, 0, 2}, 4};
+      CHECK(scaled.normal() == IDirection{0, 0, 1});
+      CHECK(scaled.offset() == 4);
+
+      IPlane through{IPoint{3, 0, 0}, IPoint{0, 3, 0}, IPoint{0, 0, 3}};
+      CHECK(through == tilted);
+
+      IPlane reversed{IPoint{3, 0, 0}, IPoint{0, 0, 3}, IPoint{0, 3, 0}};
+      CHECK(reversed == tilted.flipped());
+
+      CHECK_THROWS_AS(
+          (IPlane{IPoint{0, 0, 0}, IPoint{1, 1, 1}, IPoint{2, 2, 2}}),
+          std::invalid_argument);
+    }
+
+    SUBCASE("flipped()")
+    {
+      auto flipped = tilted.flipped();
+      CHECK(flipped.normal() == IDirection{-1, -1, -1});
+      CHECK(flipped.offset() == -3);
+      CHECK(flipped != tilted);
+      CHECK(flipped.flipped() == tilted);
+    }
+
+    SUBCASE("classify(Point<>)")
+    {
+      CHECK(floor.classify(IPoint{5, -5, 1}) == 1);
+      CHECK(floor.classify(IPoint{5, -5, 0}) == 0);
+      CHECK(floor.classify(IPoint{5, -5, -1}) == -1);
+
+      CHECK(tilted.classify(RatPoint{Rat(1), Rat(1), Rat(1)}) == 0);
+      CHECK(tilted.classify(RatPoint{Rat(1), Rat(1), Rat(1001, 1000)}) == 1);
+      CHECK(tilted.flipped().classify(RatPoint{Rat(2), Rat(1), Rat(1)}) == -1);
+
+      // Agrees with orient3d, for planes through three points.
+      IPoint a{1, 2, 3};
+      IPoint b{-4, 0, 2};
+      IPoint c{2, -1, 5};
+      IPlane plane{a, b, c};
+      for (const auto& point :
+          {IPoint{0, 0, 0}, IPoint{7, 7, 7}, IPoint{-3, 8, 1}, a + b - c}) {
+        CHECK(plane.classify(point) == -orient3d(a, b, c, point));
+      }
+    }
+
+    SUBCASE("classify(std::vector<Point<>>)")
+    {
+      std::vector<IPoint> points{
+          IPoint{0, 0, 0}, IPoint{1, 1, 1}, IPoint{2, 2, 2}, IPoint{3, 0, 0}};
+      CHECK(tilted.classify(points) == std::vector<int>{-1, 0, 1, 0});
+
+      std::vector<RatPoint> rat_points;
+      std::vector<int> expected;
+      for (int i = -20; i <= 20; ++i) {
+        Rat coordinate(i, 8);
+        rat_points.push_back(RatPoint{coordinate, coordinate, coordinate});
+        expected.push_back((i > 8) - (i < 8));
+      }
+      CHECK(tilted.classify(rat_points) == expected);
+
+      // Points too large for the integer path give the same answers.
+      IPlane steep{IDirection{1000000, 1, 0}, 0};
+      std::vector<RatPoint> large{RatPoint{Rat(0), Rat(1), Rat(0)},
+          RatPoint{Rat(-1), Rat(1000000), Rat(0)},
+          RatPoint{Rat(-1), Rat(1000001), Rat(0)},
+          RatPoint{Rat(500000000), Rat(-1), Rat(0)},
+          RatPoint{Rat(-500000000), Rat(0), Rat(0)}};
+      CHECK(steep.classify(large) == std::vector<int>{1, 0, 1, 1, -1});
+      for (const auto& point : large) {
+        CHECK(steep.classify(std::vector<RatPoint>{point}).front()
+              == steep.classify(point));
+      }
+    }
+
+    SUBCASE("ordering")
+    {
+      std::set<IPlane> planes{floor, tilted, floor, tilted.flipped(),
+          IPlane{IDirection{0, 0, 3}, 0}};
+      CHECK(planes.size() == 3);
+    }
+  }
+
+  SUBCASE("are_parallel() and are_coincident()")
+  {
+    IPlane raised{IDirection{0, 0, 1}, 7};
+
+    CHECK(are_parallel(floor, raised));
+    CHECK(are_parallel(floor, raised.flipped()));
+    CHECK_FALSE(are_parallel(floor, tilted));
+
+    CHECK(are_coincident(floor, floor.flipped()));
+    CHECK(are_coincident(tilted, IPlane{IDirection{2, 2, 2}, 3}));
+    CHECK_FALSE(are_coincident(floor, raised));
+    CHECK_FALSE(are_coincident(floor, tilted));
+  }
+
+  SUBCASE("intersection_point()")
+  {
+    IPlane x_plane{IDirection{1, 0, 0}, 2};
+    IPlane y_plane{IDirection{0, -1, 0}, 3};
+
+    CHECK(intersection_point<Rat>(x_plane, y_plane, floor)
+          == RatPoint{Rat(2), Rat(-3), Rat(0)});
+
+    IPlane a{IDirection{1, 2, 0}, 1};
+    IPlane b{IDirection{0, 1, 4}, 2};
+    IPlane c{IDirection{1, 0, 1}, 3};
+    auto point = intersection_point<Rat>(a, b, c);
+    CHECK(a.classify(point) == 0);
+    CHECK(b.classify(point) == 0);
+    CHECK(c.classify(point) == 0);
+    CHECK(point == intersection_point<Rat>(c, a, b));
+
+    CHECK_THROWS_AS(intersection_point<Rat>(floor, floor.flipped(), tilted),
+        std::domain_error);
+    CHECK_THROWS_AS(
+        intersection_point<Rat>(x_plane, IPlane{IDirection{1, 0, 0}, 5}, floor),
+        std::domain_error);
+  }
+}
+
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -274,6 +274,18 @@ TEST_CASE("Testing Point.hpp")
     CHECK(b_d == b + d);
   }
 
+  SUBCASE("Point<> - Point<>")
+  {
+    IPoint3D b{1, 2, 3};
+    IPoint3D c{10, 20, 30};
+
+    CHECK(b - origin3 == b);
+    CHECK(b - b == origin3);
+    CHECK(c - b == IPoint3D{9, 18, 27});
+    CHECK(b - c == IPoint3D{-9, -18, -27});
+    CHECK((c - b) + b == c);
+  }
+
   SUBCASE("Point<> * RatT")
   {
     IPoint3D a{3, 5, 7};
@@ -291,6 +303,22 @@ TEST_CASE("Testing Point.hpp")
 
     CHECK(expected == factor * a);
   }
+
+  SUBCASE("constexpr")
+  {
+    constexpr IPoint3D a{1, 2, 3};
+    constexpr IPoint3D b{std::array<int, 3>{4, 5, 6}};
+
+    constexpr auto sum = a + b * 2;
+    static_assert(sum == IPoint3D{9, 12, 15}, "constexpr + and *");
+    static_assert(a < b && b > a && a != b, "constexpr comparisons");
+
+    constexpr auto homogeneous = a.as_point();
+    static_assert(homogeneous[3] == 1, "constexpr as_point()");
+    static_assert(homogeneous.as_simpler() == a, "constexpr as_simpler()");
+
+    CHECK(sum == IPoint3D{9, 12, 15});
+  }
 }
 
 
@@ -0,0 +1,209 @@
+
+#include "../src/rational_geometry/Polygon2D.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+
+#include "doctest.h"
+
+#include <vector>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing Polygon2D.hpp")
+{
+  typedef FixedRational<long long, 16 * 9 * 5 * 7 * 11 * 13> Rat;
+  typedef Polygon2D<Rat> RatPolygon;
+  typedef RatPolygon::RingT Ring;
+  typedef RatPolygon::PointT P;
+
+  auto rectangle = [](int left, int bottom, int right, int top) {
+    return Ring{P{Rat(left), Rat(bottom)}, P{Rat(right), Rat(bottom)},
+        P{Rat(right), Rat(top)}, P{Rat(left), Rat(top)}};
+  };
+
+  auto check_area_identities = [](
+                                   const RatPolygon& a, const RatPolygon& b) {
+    auto a_area            = (a | RatPolygon{}).signed_area();
+    auto b_area            = (b | RatPolygon{}).signed_area();
+    auto union_area        = (a | b).signed_area();
+    auto intersection_area = (a & b).signed_area();
+
+    CHECK(union_area + intersection_area == a_area + b_area);
+    CHECK((a - b).signed_area() == a_area - intersection_area);
+    CHECK((b - a).signed_area() == b_area - intersection_area);
+    CHECK((a ^ b).signed_area() == union_area - intersection_area);
+  };
+
+  SUBCASE("Polygon2D<> class")
+  {
+    RatPolygon empty{};
+    CHECK(empty.empty());
+    CHECK(empty.vertex_count() == 0);
+    CHECK(empty.signed_area() == Rat(0));
+
+    RatPolygon a{rectangle(0, 0, 4, 2)};
+    CHECK_FALSE(a.empty());
+    CHECK(a.vertex_count() == 4);
+    CHECK(a.signed_area() == Rat(8));
+
+    a.add_ring(rectangle(1, 1, 2, 0));
+    CHECK(a.rings().size() == 2);
+    CHECK(a.signed_area() == Rat(7));
+  }
+
+  SUBCASE("overlapping squares")
+  {
+    RatPolygon a{rectangle(0, 0, 2, 2)};
+    RatPolygon b{rectangle(1, 1, 3, 3)};
+
+    CHECK((a & b) == RatPolygon{rectangle(1, 1, 2, 2)});
+    CHECK((a | b).signed_area() == Rat(7));
+    CHECK((a | b).vertex_count() == 8);
+    CHECK((a - b).signed_area() == Rat(3));
+    CHECK((a ^ b).signed_area() == Rat(6));
+    CHECK((a ^ b).rings().size() == 2);
+
+    check_area_identities(a, b);
+  }
+
+  SUBCASE("normalized output")
+  {
+    // Clockwise, starting elsewhere, with a redundant collinear vertex.
+    RatPolygon a{{P{Rat(2), Rat(2)}, P{Rat(2), Rat(0)}, P{Rat(1), Rat(0)},
+        P{Rat(0), Rat(0)}, P{Rat(0), Rat(2)}}};
+
+    CHECK((a | RatPolygon{}) == RatPolygon{rectangle(0, 0, 2, 2)});
+    CHECK((a & a) == RatPolygon{rectangle(0, 0, 2, 2)});
+  }
+
+  SUBCASE("degenerate configurations")
+  {
+    SUBCASE("shared edge")
+    {
+      RatPolygon a{rectangle(0, 0, 1, 1)};
+      RatPolygon b{rectangle(1, 0, 2, 1)};
+
+      CHECK((a | b) == RatPolygon{rectangle(0, 0, 2, 1)});
+      CHECK((a & b).empty());
+      CHECK((a - b) == RatPolygon{rectangle(0, 0, 1, 1)});
+    }
+
+    SUBCASE("partly shared edge")
+    {
+      RatPolygon a{rectangle(0, 0, 2, 2)};
+      RatPolygon b{rectangle(2, 1, 3, 5)};
+
+      auto both = a | b;
+      CHECK(both.rings().size() == 1);
+      CHECK(both.vertex_count() == 8);
+      CHECK(both.signed_area() == Rat(8));
+    }
+
+    SUBCASE("identical polygons")
+    {
+      RatPolygon a{rectangle(0, 0, 3, 1)};
+
+      CHECK((a | a) == a);
+      CHECK((a & a) == a);
+      CHECK((a - a).empty());
+      CHECK((a ^ a).empty());
+    }
+
+    SUBCASE("touching at a vertex")
+    {
+      RatPolygon a{rectangle(0, 0, 1, 1)};
+      RatPolygon b{rectangle(1, 1, 2, 2)};
+
+      auto both = a | b;
+      CHECK(both.rings().size() == 2);
+      CHECK(both.signed_area() == Rat(2));
+      CHECK((a & b).empty());
+    }
+
+    SUBCASE("holes")
+    {
+      // A clockwise hole.
+      RatPolygon frame{rectangle(0, 0, 4, 4), rectangle(3, 1, 1, 3)};
+      RatPolygon plug{rectangle(1, 1, 3, 3)};
+
+      CHECK(frame.signed_area() == Rat(16 - 4));
+      CHECK((frame | plug) == RatPolygon{rectangle(0, 0, 4, 4)});
+      CHECK((frame & plug).empty());
+
+      auto holed = RatPolygon{rectangle(0, 0, 4, 4)} - plug;
+      CHECK(holed.rings().size() == 2);
+      CHECK(holed.signed_area() == Rat(12));
+    }
+  }
+
+  SUBCASE("crossing triangles")
+  {
+    RatPolygon up{{P{Rat(0), Rat(0)}, P{Rat(6), Rat(0)}, P{Rat(3), Rat(6)}}};
+    RatPolygon down{{P{Rat(0), Rat(4)}, P{Rat(3), Rat(-2)}, P{Rat(6), Rat(4)}}};
+
+    auto star = up | down;
+    CHECK(star.rings().size() == 1);
+    CHECK(star.vertex_count() == 12);
+
+    auto hexagon = up & down;
+    CHECK(hexagon.vertex_count() == 6);
+
+    check_area_identities(up, down);
+  }
+
+  SUBCASE("crossings between fine coordinates")
+  {
+    // The crossings are representable, though the products leading to them
+    // are finer than the denominator.
+    typedef FixedRational<long long, 1000> Fine;
+    auto at = [](long long x, long long y) {
+      return Point<Fine, 2>{Fine(x, 1000LL), Fine(y, 1000LL)};
+    };
+
+    Polygon2D<Fine> square{{at(0, 0), at(4, 0), at(4, 4), at(0, 4)}};
+    Polygon2D<Fine> triangle{{at(-2, 0), at(6, 4), at(-2, 4)}};
+
+    CHECK((square | triangle)
+          == Polygon2D<Fine>{{at(-2, 0), at(0, 1), at(0, 0), at(4, 0),
+              at(4, 3), at(6, 4), at(-2, 4)}});
+    CHECK((square & triangle)
+          == Polygon2D<Fine>{{at(0, 1), at(4, 3), at(4, 4), at(0, 4)}});
+  }
+
+  SUBCASE("many crossings")
+  {
+    // Two combs, one with vertical teeth, one with horizontal, crossing in a
+    // grid.
+    const int teeth = 12;
+    Ring vertical;
+    Ring horizontal;
+    for (int i = 0; i < teeth; ++i) {
+      vertical.push_back(P{Rat(2 * i), Rat(0)});
+      vertical.push_back(P{Rat(2 * i), Rat(3 * teeth)});
+      vertical.push_back(P{Rat(2 * i + 1), Rat(3 * teeth)});
+      vertical.push_back(P{Rat(2 * i + 1), Rat(0)});
+      horizontal.push_back(P{Rat(-1), Rat(3 * i + 1)});
+      horizontal.push_back(P{Rat(3 * teeth), Rat(3 * i + 1)});
+      horizontal.push_back(P{Rat(3 * teeth), Rat(3 * i + 2)});
+      horizontal.push_back(P{Rat(-1), Rat(3 * i + 2)});
+    }
+    vertical.push_back(P{Rat(2 * teeth), Rat(-1)});
+    vertical.push_back(P{Rat(0), Rat(-1)});
+    horizontal.push_back(P{Rat(-2), Rat(3 * teeth)});
+    horizontal.push_back(P{Rat(-2), Rat(1)});
+
+    RatPolygon a{vertical};
+    RatPolygon b{horizontal};
+
+    auto intersection = a & b;
+    CHECK(intersection.rings().size() == teeth * teeth);
+    CHECK(intersection.signed_area() == Rat(teeth * teeth));
+
+    check_area_identities(a, b);
+  }
+}
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,280 @@
+
+#include "../src/rational_geometry/Polyhedron.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+
+#include "doctest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing Polyhedron.hpp")
+{
+  typedef FixedRational<long long, 16 * 9 * 5 * 7 * 11 * 13> Rat;
+  typedef Polyhedron<Rat> RatPolyhedron;
+  typedef RatPolyhedron::PointT P;
+
+  auto box = [](int x0, int y0, int z0, int x1, int y1, int z1) {
+    return make_box(
+        P{Rat(x0), Rat(y0), Rat(z0)}, P{Rat(x1), Rat(y1), Rat(z1)});
+  };
+
+  auto ring_count = [](const RatPolyhedron& polyhedron) {
+    std::size_t ret = 0;
+    for (const auto& face : polyhedron.faces()) {
+      ret += face.size();
+    }
+    return ret;
+  };
+
+  auto check_volume_identities = [](const RatPolyhedron& a,
+                                     const RatPolyhedron& b) {
+    auto a_volume            = a.signed_volume();
+    auto b_volume            = b.signed_volume();
+    auto union_volume        = (a | b).signed_volume();
+    auto intersection_volume = (a & b).signed_volume();
+
+    CHECK(union_volume + intersection_volume == a_volume + b_volume);
+    CHECK((a - b).signed_volume() == a_volume - intersection_volume);
+    CHECK((b - a).signed_volume() == b_volume - intersection_volume);
+    CHECK((a ^ b).signed_volume() == union_volume - intersection_volume);
+  };
+
+  SUBCASE("Polyhedron<> class")
+  {
+    RatPolyhedron empty{};
+    CHECK(empty.empty());
+    CHECK(empty.signed_volume() == Rat(0));
+
+    auto a = box(0, 0, 0, 2, 3, 4);
+    CHECK_FALSE(a.empty());
+    CHECK(a.vertices().size() == 8);
+    CHECK(a.faces().size() == 6);
+    CHECK(a.signed_volume() == Rat(24));
+
+    // Normals point outward, with length twice the face's area.
+    CHECK(a.face_normal(0) == P{Rat(-24), Rat(0), Rat(0)});
+    CHECK(a.face_normal(1) == P{Rat(24), Rat(0), Rat(0)});
+    CHECK(a.face_normal(5) == P{Rat(0), Rat(0), Rat(12)});
+
+    auto inverted_faces = a.faces();
+    for (auto& face : inverted_faces) {
+      std::reverse(std::begin(face.front()), std::end(face.front()));
+    }
+    RatPolyhedron inverted{a.vertices(), inverted_faces};
+    CHECK(inverted.signed_volume() == Rat(-24));
+
+    // Normals are summed over numerators, so only they need fit in an int.
+    typedef FixedRational<int, 1000> IntRat;
+    typedef Point<IntRat, 3> IntP;
+    auto wide = make_box(IntP{IntRat(0), IntRat(0), IntRat(0)},
+        IntP{IntRat(100), IntRat(100), IntRat(1)});
+    CHECK(wide.face_normal(5) == IntP{IntRat(0), IntRat(0), IntRat(20000)});
+    CHECK(wide.face_normal(0) == IntP{IntRat(-200), IntRat(0), IntRat(0)});
+  }
+
+  SUBCASE("overlapping boxes")
+  {
+    auto a = box(0, 0, 0, 2, 2, 2);
+    auto b = box(1, 1, 1, 3, 3, 3);
+
+    auto united = a | b;
+    CHECK(united.signed_volume() == Rat(15));
+    CHECK(united.faces().size() == 12);
+
+    auto intersected = a & b;
+    CHECK(intersected.signed_volume() == Rat(1));
+    CHECK(intersected == (box(1, 1, 1, 2, 2, 2) | RatPolyhedron{}));
+
+    auto subtracted = a - b;
+    CHECK(subtracted.signed_volume() == Rat(7));
+    CHECK(subtracted.faces().size() == 9);
+
+    CHECK((a ^ b).signed_volume() == Rat(14));
+    check_volume_identities(a, b);
+  }
+
+  SUBCASE("coplanar faces are merged")
+  {
+    auto a = box(0, 0, 0, 1, 1, 1);
+    auto b = box(1, 0, 0, 2, 1, 1);
+
+    auto united = a | b;
+    CHECK(united.signed_volume() == Rat(2));
+    CHECK(united.faces().size() == 6);
+    CHECK(united.vertices().size() == 8);
+    CHECK(ring_count(united) == 6);
+
+    auto partly_shared = a | box(1, 0, 0, 2, 2, 1);
+    CHECK(partly_shared.signed_volume() == Rat(3));
+    CHECK(partly_shared.faces().size() == 8);
+
+    CHECK((a & b).empty());
+    CHECK((a - b).signed_volume() == Rat(1));
+    CHECK((a | a).signed_volume() == Rat(1));
+    CHECK((a & a).signed_volume() == Rat(1));
+    CHECK((a - a).empty());
+  }
+
+  SUBCASE("holes")
+  {
+    auto slab  = box(0, 0, 0, 3, 3, 1);
+    auto drill = box(1, 1, -1, 2, 2, 2);
+
+    auto frame = slab - drill;
+    CHECK(frame.signed_volume() == Rat(8));
+    CHECK(frame.faces().size() == 10);
+    CHECK(ring_count(frame) == 12);
+
+    // Faces with holes keep their outer ring first, so normals stay outward.
+    for (std::size_t i = 0; i < frame.faces().size(); ++i) {
+      if (frame.faces()[i].size() == 2) {
+        auto normal = frame.face_normal(i);
+        CHECK((normal[2] == Rat(18) || normal[2] == Rat(-18)));
+      }
+    }
+
+    // The frame can be filled back in, giving a single box again.
+    CHECK((frame | box(1, 1, 0, 2, 2, 1)) == (slab | RatPolyhedron{}));
+  }
+
+  SUBCASE("disjoint operands")
+  {
+    auto a = box(0, 0, 0, 1, 1, 1);
+    auto b = box(5, 5, 5, 7, 7, 7);
+
+    CHECK((a | b).signed_volume() == Rat(9));
+    CHECK((a | b).faces().size() == 12);
+    CHECK((a & b).empty());
+    CHECK((a - b) == (a | RatPolyhedron{}));
+    check_volume_identities(a, b);
+  }
+
+  SUBCASE("slanted faces")
+  {
+    std::vector<P> vertices{P{Rat(0), Rat(0), Rat(0)},
+        P{Rat(4), Rat(0), Rat(0)}, P{Rat(0), Rat(4), Rat(0)},
+        P{Rat(0), Rat(0), Rat(4)}};
+    RatPolyhedron tetrahedron{
+        vertices, {{{0, 2, 1}}, {{0, 1, 3}}, {{0, 3, 2}}, {{1, 2, 3}}}};
+    REQUIRE(tetrahedron.signed_volume() == Rat(32, 3));
+
+    auto cube = box(0, 0, 0, 2, 2, 2);
+
+    // The cube loses its corner beyond the plane x + y + z = 4.
+    auto clipped = tetrahedron & cube;
+    CHECK(clipped.signed_volume() == Rat(20, 3));
+    CHECK(clipped.faces().size() == 7);
+
+    check_volume_identities(tetrahedron, cube);
+    check_volume_identities(tetrahedron, box(1, 1, 1, 3, 3, 3));
+  }
+
+  SUBCASE("faces clear of the other operand")
+  {
+    // A box of 4 by 4 by 4, with each side tiled by unit squares.
+    std::vector<P> vertices;
+    std::vector<RatPolyhedron::FaceT> faces;
+    auto corners = box(0, 0, 0, 4, 4, 4);
+    for (const auto& face : corners.faces()) {
+      const auto& ring = face.front();
+      auto origin      = corners.vertices()[ring[0]];
+      auto u_step = (corners.vertices()[ring[1]] - origin) * Rat(1, 4);
+      auto v_step = (corners.vertices()[ring[3]] - origin) * Rat(1, 4);
+      for (int u = 0; u < 4; ++u) {
+        for (int v = 0; v < 4; ++v) {
+          auto corner = origin + u_step * Rat(u) + v_step * Rat(v);
+          auto first  = vertices.size();
+          vertices.insert(std::end(vertices), {corner, corner + u_step,
+              corner + u_step + v_step, corner + v_step});
+          faces.push_back({{first, first + 1, first + 2, first + 3}});
+        }
+      }
+    }
+    RatPolyhedron tiled{vertices, faces};
+    REQUIRE(tiled.signed_volume() == Rat(64));
+
+    // Most tiles are clear of the corner, and are kept or dropped whole.
+    auto corner = box(3, 3, 3, 5, 5, 5);
+    CHECK((tiled | corner) == (corners | corner));
+    CHECK((tiled & corner) == (box(3, 3, 3, 4, 4, 4) | RatPolyhedron{}));
+    CHECK((tiled - corner) == (corners - corner));
+    CHECK((corner - tiled) == (corner - corners));
+    check_volume_identities(tiled, corner);
+
+    // Every face of a cavity is clear of every tile.
+    auto cavity = box(1, 1, 1, 2, 2, 2);
+    CHECK((tiled - cavity) == (corners - cavity));
+    CHECK((tiled - cavity).faces().size() == 12);
+    CHECK((tiled & cavity) == (cavity | RatPolyhedron{}));
+    CHECK((cavity - tiled).empty());
+    CHECK((tiled ^ cavity) == (corners - cavity));
+    check_volume_identities(tiled, cavity);
+
+    // The operands' trees may be built on separate threads.
+    CHECK(boolean_operation(tiled, corner, BooleanOperation::kDifference,
+              BspSplitHeuristic{}, 4)
+          == (corners - corner));
+  }
+
+  SUBCASE("coordinates whose products exceed an int")
+  {
+    auto check = [](auto unit) {
+      typedef decltype(unit) IntRat;
+      typedef Point<IntRat, 3> IntP;
+
+      auto cube = [](int lower, int upper) {
+        return make_box(IntP{IntRat(lower), IntRat(lower), IntRat(lower)},
+            IntP{IntRat(upper), IntRat(upper), IntRat(upper)});
+      };
+      CHECK((cube(0, 100) & cube(50, 150))
+            == (cube(50, 100) | Polyhedron<IntRat>{}));
+
+      // A prism along x, under the plane 2y = 3z.
+      auto prism = [](int x0, int x1) {
+        std::vector<IntP> vertices;
+        for (auto x : {x0, x1}) {
+          vertices.push_back(IntP{IntRat(x), IntRat(0), IntRat(0)});
+          vertices.push_back(IntP{IntRat(x), IntRat(3), IntRat(0)});
+          vertices.push_back(IntP{IntRat(x), IntRat(3), IntRat(2)});
+        }
+        return Polyhedron<IntRat>{vertices,
+            {{{2, 1, 0}}, {{3, 4, 5}}, {{0, 1, 4, 3}}, {{1, 2, 5, 4}},
+                {{2, 0, 3, 5}}}};
+      };
+      auto slab = make_box(IntP{IntRat(0), IntRat(0), IntRat(0)},
+          IntP{IntRat(3), IntRat(3), IntRat(2)});
+      CHECK((slab & prism(-1, 4)) == (prism(0, 3) | Polyhedron<IntRat>{}));
+
+      // Both ends are left, and share their faces' planes but for the caps.
+      CHECK((prism(-1, 4) - slab).faces().size() == 7);
+    };
+    check(FixedRational<int, 1000>{});
+    check(FixedRational<int, 3000>{});
+  }
+
+  SUBCASE("chained operations")
+  {
+    RatPolyhedron stairs;
+    for (int i = 0; i < 4; ++i) {
+      stairs = stairs | box(i, 0, 0, i + 1, 4, i + 1);
+    }
+    CHECK(stairs.signed_volume() == Rat(40));
+
+    // Two long sides, one back, one bottom, and a tread and riser per step.
+    CHECK(stairs.faces().size() == 12);
+
+    auto notched = stairs - box(1, 1, -1, 3, 3, 5);
+    CHECK(notched.signed_volume() == Rat(40 - 2 * 2 - 2 * 3));
+    check_volume_identities(stairs, box(1, 1, 1, 3, 3, 3));
+  }
+}
+
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,145 @@
+
+#include "../src/rational_geometry/SparseLU.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "../src/rational_geometry/Matrix.hpp"
+
+#include "doctest.h"
+
+#include <stdexcept>
+#include <vector>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing SparseLU.hpp")
+{
+  typedef SparseMatrix<long long> LLSpMat;
+  typedef FixedRational<long long, 2 * 3 * 5 * 7> Rat;
+  typedef SparseMatrix<Rat> RatSpMat;
+  typedef DynamicPoint<Rat> RatDynPoint;
+
+  SUBCASE("SparseLU(SparseMatrix<>)")
+  {
+    CHECK_THROWS_AS(SparseLU<long long>{LLSpMat(2, 3)}, std::invalid_argument);
+
+    SparseLU<long long> empty{LLSpMat{}};
+    CHECK(empty.rank() == 0);
+    CHECK(empty.determinant() == 1);
+  }
+
+  SUBCASE("determinant()")
+  {
+    // clang-format off
+    Matrix<long long, 4, 4> dense{
+        {2, 0, 1, 0},
+        {0, 0, 3, 1},
+        {4, 1, 0, 0},
+        {0, 5, 0, 2}};
+    // clang-format on
+    LLSpMat a{DynamicMatrix<long long>{dense}};
+    SparseLU<long long> lu{a};
+
+    CHECK(lu.rank() == 4);
+    CHECK_FALSE(lu.is_singular());
+    CHECK(lu.determinant() == determinant(dense));
+
+    // Swapping two rows flips the sign.
+    LLSpMat swapped(4, 4,
+        {{0, 0, 2}, {0, 2, 1}, {2, 2, 3}, {2, 3, 1}, {1, 0, 4}, {1, 1, 1},
+            {3, 1, 5}, {3, 3, 2}});
+    CHECK(SparseLU<long long>{swapped}.determinant() == -determinant(dense));
+  }
+
+  SUBCASE("singular matrices")
+  {
+    // The third row is the sum of the first two.
+    LLSpMat a(3, 3,
+        {{0, 0, 1}, {0, 1, 2}, {1, 1, 3}, {1, 2, 4}, {2, 0, 1}, {2, 1, 5},
+            {2, 2, 4}});
+    SparseLU<long long> lu{a};
+
+    CHECK(lu.rank() == 2);
+    CHECK(lu.is_singular());
+    CHECK(lu.determinant() == 0);
+
+    SparseLU<Rat> rat_lu{RatSpMat(2, 2, {{0, 0, Rat(1)}, {1, 0, Rat(1)}})};
+    CHECK(rat_lu.rank() == 1);
+    CHECK_THROWS_AS(
+        rat_lu.solve(RatDynPoint{Rat(1), Rat(1)}), std::domain_error);
+  }
+
+  SUBCASE("Markowitz ordering")
+  {
+    // An arrowhead matrix: eliminating the dense row and column first would
+    // fill in everything, while the Markowitz order creates no fill at all.
+    const size_t size = 8;
+    std::vector<SparseEntry<long long>> entries{{0, 0, 10}};
+    for (size_t i = 1; i < size; ++i) {
+      entries.push_back({i, i, 10});
+      entries.push_back({0, i, 1});
+      entries.push_back({i, 0, 1});
+    }
+    LLSpMat a(size, size, entries);
+    SparseLU<long long> lu{a};
+
+    CHECK(lu.nonzero_count() == a.nonzero_count());
+    CHECK(lu.pivot_rows().front() != 0);
+
+    // 10^7 * (10 - 7 / 10)
+    CHECK(lu.determinant() == 93000000);
+  }
+
+  SUBCASE("solve()")
+  {
+    SUBCASE("exact rational solution")
+    {
+      RatSpMat a(3, 3,
+          {{0, 0, Rat(2)}, {0, 2, Rat(1)}, {1, 1, Rat(3)}, {2, 0, Rat(1)},
+              {2, 1, Rat(1)}, {2, 2, Rat(1)}});
+      RatDynPoint b{Rat(1), Rat(2), Rat(3)};
+      SparseLU<Rat> lu{a};
+
+      auto x = lu.solve(b);
+
+      CHECK(x == RatDynPoint{Rat(-4, 3), Rat(2, 3), Rat(11, 3)});
+      CHECK(a * x == b);
+
+      CHECK_THROWS_AS(
+          lu.solve(RatDynPoint{Rat(1), Rat(2)}), std::invalid_argument);
+    }
+
+    SUBCASE("larger system")
+    {
+      // A banded system, with a few long-range couplings.
+      const size_t size = 12;
+      std::vector<SparseEntry<Rat>> entries;
+      for (size_t i = 0; i < size; ++i) {
+        entries.push_back({i, i, Rat(4)});
+        if (i + 1 < size) {
+          entries.push_back({i, i + 1, Rat(-1)});
+          entries.push_back({i + 1, i, Rat(-1)});
+        }
+        if (i % 5 == 0) {
+          entries.push_back({i, size - 1 - i, Rat(1)});
+        }
+      }
+      RatSpMat a(size, size, entries);
+
+      RatDynPoint x(size);
+      for (size_t i = 0; i < size; ++i) {
+        x[i] = Rat(static_cast<int>(i % 5) - 2, 3);
+      }
+      auto b = a * x;
+
+      SparseLU<Rat> lu{a};
+
+      CHECK(lu.rank() == size);
+      CHECK(lu.solve(b) == x);
+    }
+  }
+}
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,125 @@
+
+#include "../src/rational_geometry/SparseMatrix.hpp"
+
+#include "doctest.h"
+
+#include <stdexcept>
+#include <vector>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing SparseMatrix.hpp")
+{
+  typedef SparseMatrix<int> ISpMat;
+  typedef SparseEntry<int> IEntry;
+  typedef DynamicPoint<int> IDynPoint;
+
+  SUBCASE("SparseMatrix<> class")
+  {
+    SUBCASE("Constructors")
+    {
+      SUBCASE("SparseMatrix()")
+      {
+        ISpMat a{};
+
+        CHECK(a.height() == 0);
+        CHECK(a.width() == 0);
+        CHECK(a.nonzero_count() == 0);
+      }
+
+      SUBCASE("SparseMatrix(size_t, size_t)")
+      {
+        ISpMat a(3, 5);
+
+        CHECK(a.height() == 3);
+        CHECK(a.width() == 5);
+        CHECK(a.nonzero_count() == 0);
+        CHECK(a(1, 1) == 0);
+      }
+
+      SUBCASE("SparseMatrix(size_t, size_t, vector<SparseEntry<>>)")
+      {
+        std::vector<IEntry> entries{
+            {2, 1, 5}, {0, 3, 7}, {0, 0, 1}, {2, 1, -2}, {1, 2, 4}, {1, 2, -4}};
+        ISpMat a(3, 4, entries);
+
+        // Duplicates are summed, and zero sums dropped.
+        CHECK(a.nonzero_count() == 3);
+        CHECK(a(0, 0) == 1);
+        CHECK(a(0, 3) == 7);
+        CHECK(a(1, 2) == 0);
+        CHECK(a(2, 1) == 3);
+
+        CHECK(a.row_offsets() == std::vector<size_t>{0, 2, 2, 3});
+        CHECK(a.column_indices() == std::vector<size_t>{0, 3, 1});
+        CHECK(a.values() == std::vector<int>{1, 7, 3});
+
+        CHECK_THROWS_AS((ISpMat(3, 4, {{3, 0, 1}})), std::out_of_range);
+        CHECK_THROWS_AS((ISpMat(3, 4, {{0, 4, 1}})), std::out_of_range);
+      }
+
+      SUBCASE("SparseMatrix(DynamicMatrix<>)")
+      {
+        // clang-format off
+        DynamicMatrix<int> dense{
+            {0, 2, 0},
+            {3, 0, 0}};
+        // clang-format on
+        ISpMat a{dense};
+
+        CHECK(a.nonzero_count() == 2);
+        CHECK(a == ISpMat(2, 3, {{0, 1, 2}, {1, 0, 3}}));
+        CHECK(a.as_dynamic() == dense);
+      }
+    }
+
+    SUBCASE("memory_footprint()")
+    {
+      ISpMat a(1000, 1000, {{0, 0, 1}, {999, 999, 1}});
+
+      CHECK(a.memory_footprint()
+            == 1001 * sizeof(size_t) + 2 * sizeof(size_t) + 2 * sizeof(int));
+      CHECK(a.memory_footprint() < 1000 * 1000 * sizeof(int) / 100);
+    }
+
+    SUBCASE("transposed()")
+    {
+      ISpMat a(2, 3, {{0, 2, 1}, {1, 0, 2}, {0, 0, 3}, {1, 2, 4}});
+      ISpMat a_t(3, 2, {{2, 0, 1}, {0, 1, 2}, {0, 0, 3}, {2, 1, 4}});
+
+      CHECK(a.transposed() == a_t);
+      CHECK(a.transposed().transposed() == a);
+    }
+  }
+
+  SUBCASE("operator==()")
+  {
+    ISpMat a(2, 2, {{0, 1, 1}});
+
+    CHECK(a == ISpMat(2, 2, {{0, 1, 1}}));
+    CHECK(a != ISpMat(2, 2, {{1, 0, 1}}));
+    CHECK(a != ISpMat(2, 3, {{0, 1, 1}}));
+  }
+
+  SUBCASE("operator*(SparseMatrix<>, DynamicPoint<>)")
+  {
+    // clang-format off
+    DynamicMatrix<int> dense{
+        {1, 0, 2, 0},
+        {0, 0, 0, 0},
+        {0, 3, 0, 4}};
+    // clang-format on
+    ISpMat a{dense};
+    IDynPoint b{1, 2, 3, 4};
+
+    CHECK(a * b == IDynPoint{7, 0, 22});
+    CHECK(a * b == dense * b);
+
+    CHECK_THROWS_AS((a * IDynPoint{1, 2, 3}), std::invalid_argument);
+  }
+}
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
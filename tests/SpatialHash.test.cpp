@@ -0,0 +1,162 @@
+
+#include "../src/rational_geometry/SpatialHash.hpp"
+
+#include "../src/rational_geometry/AABB.hpp"
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "../src/rational_geometry/Point.hpp"
+
+#include "doctest.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing SpatialHash.hpp")
+{
+  typedef FixedRational<long long, 4 * 9 * 5> Rat;
+  typedef SpatialHash<Rat, 2> Hash;
+  typedef Hash::PointT P;
+  typedef Hash::BoxT Box;
+  typedef std::vector<std::size_t> Indices;
+
+  auto p = [](int x, int y) { return P{Rat(x), Rat(y)}; };
+
+  SUBCASE("helpers")
+  {
+    CHECK(floor_divide(7, 2) == 3);
+    CHECK(floor_divide(-7, 2) == -4);
+    CHECK(floor_divide(-8, 2) == -4);
+    CHECK(floor_divide(0, 3) == 0);
+
+    CHECK(slot_count_for(0) == 16);
+    CHECK(slot_count_for(8) == 16);
+    CHECK(slot_count_for(9) == 32);
+  }
+
+  SUBCASE("construction and lookup")
+  {
+    CHECK_THROWS_AS(Hash{Rat(0)}, std::invalid_argument);
+    CHECK_THROWS_AS(Hash{Rat(-1)}, std::invalid_argument);
+
+    Hash empty{Rat(1)};
+    CHECK(empty.cell_count() == 0);
+    CHECK(empty.find(p(0, 0)) == Hash::kNone);
+    CHECK(empty.within(Box{p(-5, -5), p(5, 5)}).empty());
+
+    Hash hash{Rat(2),
+        {p(0, 0), p(1, 1), p(-1, 0), P{Rat(1, 3), Rat(-1, 5)}, p(1, 1),
+            p(5, 5)}};
+    CHECK(hash.points().size() == 6);
+    CHECK(hash.cell_count() == 4);
+    CHECK(hash.find(p(1, 1)) == 1);
+    CHECK(hash.find(P{Rat(1, 3), Rat(-1, 5)}) == 3);
+    CHECK(hash.find(p(1, 0)) == Hash::kNone);
+
+    hash.insert({p(1, 0), p(-7, 3)});
+    CHECK(hash.points().size() == 8);
+    CHECK(hash.cell_count() == 5);
+    CHECK(hash.find(p(1, 0)) == 6);
+    CHECK(hash.find(p(1, 1)) == 1);
+  }
+
+  SUBCASE("queries")
+  {
+    std::vector<P> grid;
+    for (int x = -4; x <= 4; ++x) {
+      for (int y = -4; y <= 4; ++y) {
+        grid.push_back(P{Rat(x, 2), Rat(y, 2)});
+      }
+    }
+
+    // Brute force answers, for the hash's to match.
+    auto in_box = [&grid](const Box& box) {
+      Indices ret;
+      for (std::size_t i = 0; i < grid.size(); ++i) {
+        if (box.contains(grid[i])) ret.push_back(i);
+      }
+      return ret;
+    };
+    auto in_radius = [&grid](const P& center, const Rat& radius) {
+      Indices ret;
+      for (std::size_t i = 0; i < grid.size(); ++i) {
+        auto offset = grid[i] - center;
+        if (dot(offset, offset) <= radius * radius) ret.push_back(i);
+      }
+      return ret;
+    };
+
+    for (auto cell_size : {Rat(1, 3), Rat(1), Rat(5)}) {
+      Hash hash{cell_size, grid};
+
+      std::vector<Box> boxes{Box{p(0, 0), p(1, 1)},
+          Box{P{Rat(-1, 3), Rat(-3, 2)}, P{Rat(3, 4), Rat(-1, 5)}},
+          Box{p(-10, -10), p(10, 10)}, Box{p(3, 3), p(4, 4)}, Box{}};
+      for (const auto& box : boxes) {
+        CHECK(hash.within(box) == in_box(box));
+      }
+
+      // Points exactly on the circle count.
+      CHECK(hash.within(p(0, 0), Rat(1)) == in_radius(p(0, 0), Rat(1)));
+      CHECK(hash.within(p(0, 0), Rat(1)).size() == 13);
+      CHECK(hash.within(P{Rat(1, 2), Rat(-1, 2)}, Rat(3, 2))
+            == in_radius(P{Rat(1, 2), Rat(-1, 2)}, Rat(3, 2)));
+      CHECK(hash.within(p(0, 0), Rat(-1)).empty());
+
+      auto batched = hash.within({p(0, 0), p(2, 2), p(9, 9)}, Rat(1, 2));
+      REQUIRE(batched.size() == 3);
+      CHECK(batched[0].size() == 5);
+      CHECK(batched[1] == in_radius(p(2, 2), Rat(1, 2)));
+      CHECK(batched[2].empty());
+    }
+
+    // Far from the origin at a fine resolution, where squared numerator
+    // offsets pass 2^63.
+    typedef FixedRational<long long, 1000000> Micro;
+    typedef SpatialHash<Micro, 2> MicroHash;
+    typedef MicroHash::PointT MP;
+    MicroHash far{Micro(1000),
+        {MP{Micro(5000), Micro(-5000)}, MP{Micro(-5000), Micro(5000)},
+            MP{Micro(4000), Micro(-5000)}, MP{Micro(3000), Micro(-2000)},
+            MP{Micro(4999), Micro(-4999)}}};
+    CHECK(far.within(MP{Micro(5000), Micro(-5000)}, Micro(1000))
+          == Indices{0, 2, 4});
+    CHECK(far.within(MP{Micro(3000), Micro(-5000)}, Micro(3000))
+          == Indices{0, 2, 3, 4});
+    CHECK(far.within(MP{Micro(-5000), Micro(-5000)}, Micro(9000))
+          == Indices{2, 3});
+    CHECK(far.within(MP{Micro(-5000), Micro(-5000)}, Micro(8999))
+          == Indices{3});
+  }
+
+  SUBCASE("welding")
+  {
+    auto welded = weld(std::vector<P>{
+        p(0, 0), p(1, 0), p(0, 0), P{Rat(1, 2), Rat(1, 3)}, p(1, 0),
+        P{Rat(1, 2), Rat(1, 3)}, p(0, 1)});
+    CHECK(welded.points_
+          == std::vector<P>{
+              p(0, 0), p(1, 0), P{Rat(1, 2), Rat(1, 3)}, p(0, 1)});
+    CHECK(welded.indices_ == Indices{0, 1, 0, 2, 1, 2, 3});
+
+    CHECK(weld(std::vector<P>{}).points_.empty());
+
+    // Enough points to grow the table past its smallest size.
+    std::vector<Point<long long, 3>> many;
+    for (long long i = 0; i < 100; ++i) {
+      many.push_back({i % 7, -(i % 5), 0});
+    }
+    auto many_welded = weld(many);
+    CHECK(many_welded.points_.size() == 35);
+    for (std::size_t i = 0; i < many.size(); ++i) {
+      CHECK(many_welded.points_[many_welded.indices_[i]] == many[i]);
+    }
+  }
+}
+
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
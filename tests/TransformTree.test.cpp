@@ -0,0 +1,140 @@
+
+#include "../src/rational_geometry/TransformTree.hpp"
+
+#include "doctest.h"
+
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing TransformTree.hpp")
+{
+  using Tree     = TransformTree<int, 2>;
+  using IMat3    = Matrix<int, 3>;
+  using IPoint2D = Point<int, 2>;
+  using Rotation = std::array<IPoint2D, 2>;
+
+  const IMat3 quarter_turn = make_rotation(Rotation{{{0, 1}, {-1, 0}}});
+
+  Tree tree{};
+
+  auto root  = tree.add_node(make_translation(IPoint2D{10, 0}));
+  auto arm   = tree.add_node(quarter_turn, root);
+  auto hand  = tree.add_node(make_translation(IPoint2D{2, 0}), arm);
+  auto other = tree.add_node(make_scale<2>(3));
+
+  SUBCASE("TransformTree<> class")
+  {
+    SUBCASE("add_node()")
+    {
+      CHECK(tree.size() == 4);
+
+      CHECK(tree.get_parent(root) == Tree::kNoParent);
+      CHECK(tree.get_parent(arm) == root);
+      CHECK(tree.get_parent(hand) == arm);
+
+      REQUIRE(tree.get_children(root).size() == 1);
+      CHECK(tree.get_children(root)[0] == arm);
+      CHECK(tree.get_children(other).empty());
+
+      // Nothing computed yet.
+      CHECK(tree.is_dirty(hand));
+    }
+
+    SUBCASE("get_world()")
+    {
+      auto world = tree.get_world(hand);
+      CHECK(world == make_translation(IPoint2D{10, 0}) * quarter_turn
+                         * make_translation(IPoint2D{2, 0}));
+
+      // Ancestors were brought up to date along the way, but not siblings.
+      CHECK_FALSE(tree.is_dirty(hand));
+      CHECK_FALSE(tree.is_dirty(arm));
+      CHECK_FALSE(tree.is_dirty(root));
+      CHECK(tree.is_dirty(other));
+
+      IPoint2D expected{10, 2};
+      CHECK((world * IPoint2D{}.as_point()).as_simpler() == expected);
+
+      CHECK(tree.get_world(other) == make_scale<2>(3));
+    }
+
+    SUBCASE("set_local()")
+    {
+      tree.update();
+
+      tree.set_local(arm, IMat3{});
+
+      CHECK_FALSE(tree.is_dirty(root));
+      CHECK(tree.is_dirty(arm));
+      CHECK(tree.is_dirty(hand));
+      CHECK_FALSE(tree.is_dirty(other));
+
+      CHECK(tree.get_world(hand) == make_translation(IPoint2D{12, 0}));
+    }
+
+    SUBCASE("apply()")
+    {
+      tree.apply(root, make_translation(IPoint2D{0, 5}));
+
+      CHECK(tree.get_local(root) == make_translation(IPoint2D{10, 5}));
+      CHECK(tree.get_world(hand) == make_translation(IPoint2D{10, 5})
+                                        * quarter_turn
+                                        * make_translation(IPoint2D{2, 0}));
+    }
+
+    SUBCASE("set_parent()")
+    {
+      tree.update();
+
+      tree.set_parent(hand, other);
+
+      CHECK(tree.get_children(arm).empty());
+      REQUIRE(tree.get_children(other).size() == 1);
+      CHECK(tree.get_children(other)[0] == hand);
+      CHECK(tree.is_dirty(hand));
+
+      CHECK(tree.get_world(hand)
+            == make_scale<2>(3) * make_translation(IPoint2D{2, 0}));
+
+      tree.set_parent(hand, Tree::kNoParent);
+      CHECK(tree.get_world(hand) == make_translation(IPoint2D{2, 0}));
+
+      // Cycles are refused, and leave the tree as it was.
+      CHECK_THROWS_AS(tree.set_parent(root, root), std::invalid_argument);
+      CHECK_THROWS_AS(tree.set_parent(root, arm), std::invalid_argument);
+      CHECK(tree.get_parent(root) == Tree::kNoParent);
+      CHECK(tree.get_world(arm)
+            == make_translation(IPoint2D{10, 0}) * quarter_turn);
+    }
+
+    SUBCASE("update()")
+    {
+      const auto& worlds = tree.update();
+
+      REQUIRE(worlds.size() == 4);
+      for (size_t node = 0; node < tree.size(); ++node) {
+        CHECK_FALSE(tree.is_dirty(node));
+        CHECK(worlds[node] == tree.get_world(node));
+      }
+    }
+
+    SUBCASE("copy_world_transforms()")
+    {
+      std::vector<IMat3> worlds(tree.size());
+      auto end = tree.copy_world_transforms(worlds.begin());
+
+      CHECK(end == worlds.end());
+      CHECK(worlds[hand] == tree.get_world(hand));
+      CHECK(worlds[other] == make_scale<2>(3));
+    }
+  }
+}
+
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,111 @@
+
+#include "../src/rational_geometry/WideInteger.hpp"
+
+#include "doctest.h"
+
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing WideInteger.hpp")
+{
+  typedef WideInteger<128> Wide;
+  typedef WideInteger<192> Wider;
+
+  const long long max = std::numeric_limits<long long>::max();
+  const long long min = std::numeric_limits<long long>::min();
+
+  auto text = [](const auto& value) {
+    std::ostringstream stream;
+    stream << value;
+    return stream.str();
+  };
+
+  SUBCASE("construction and conversion")
+  {
+    constexpr Wide zero;
+    CHECK(zero == 0);
+    CHECK(Wide(-5) == -5);
+    CHECK(static_cast<long long>(Wide(min)) == min);
+    CHECK(static_cast<int>(Wide(-7)) == -7);
+    CHECK(Wider(Wide(-3)) == -3);
+
+    CHECK(Wide(max).fits<long long>());
+    CHECK_FALSE((Wide(max) + 1).fits<long long>());
+    CHECK_FALSE(Wide(max).fits<int>());
+    CHECK(Wide(min).fits<long long>());
+    CHECK_FALSE((Wide(min) - 1).fits<long long>());
+  }
+
+  SUBCASE("arithmetic past long long")
+  {
+    // 2^63 - 1 squared is 2^126 - 2^64 + 1.
+    auto square = Wide(max) * max;
+    CHECK(text(square) == "85070591730234615847396907784232501249");
+    CHECK(square / max == max);
+    CHECK(square % max == 0);
+    CHECK((square + 5) % max == 5);
+    CHECK(-square / max == -max);
+
+    auto product = Wide(min) * -3;
+    CHECK(text(product) == "27670116110564327424");
+    CHECK(product - Wide(min) * -2 == -Wide(min));
+    CHECK(text(Wide(min) * min) == "85070591730234615865843651857942052864");
+
+    // Mixed with standard integers, and narrower WideIntegers.
+    CHECK(Wider(square) * 4 - Wide(2) == Wider(square) * 4 - 2);
+    CHECK(Wide(1) + 2 * Wide(3) == 7);
+  }
+
+  SUBCASE("division")
+  {
+    // Truncating towards zero, as for the standard types.
+    CHECK(Wide(7) / -2 == -3);
+    CHECK(Wide(-7) / 2 == -3);
+    CHECK(Wide(-7) % 2 == -1);
+    CHECK(Wide(7) % -2 == 1);
+
+    // By divisors wider than a word.
+    auto big      = Wide(1000000007) * 998244353;
+    auto multiple = big * 1234567891 + 17;
+    CHECK(multiple / big == 1234567891);
+    CHECK(multiple % big == 17);
+    CHECK((-multiple) / big == -1234567891);
+    CHECK((-multiple) % big == -17);
+
+    CHECK_THROWS_AS(Wide(1) / 0, std::domain_error);
+  }
+
+  SUBCASE("comparison, abs() and gcd()")
+  {
+    CHECK(Wide(-1) < Wide(0));
+    CHECK(Wide(min) * 2 < Wide(min));
+    CHECK(Wide(max) < Wide(max) * 2);
+    CHECK(Wide(3) <= 3);
+    CHECK(Wide(4) > -4);
+    CHECK(Wide(4) >= 4);
+    CHECK(Wide(4) != -4);
+
+    CHECK(abs(Wide(-12)) == 12);
+    CHECK(abs(Wide(min) * 2) == Wide(max) * 2 + 2);
+    CHECK(gcd(Wide(max) * 12, Wide(max) * -18) == Wide(max) * 6);
+    CHECK(gcd(Wide(0), Wide(-5)) == 5);
+  }
+
+  SUBCASE("printing")
+  {
+    CHECK(text(Wide(0)) == "0");
+    CHECK(text(Wide(-42)) == "-42");
+    CHECK(text(Wide(1000000000)) == "1000000000");
+    CHECK(text(Wide(max) + 1) == "9223372036854775808");
+  }
+}
+
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,218 @@
+
+#include "../src/rational_geometry/angular_order.hpp"
+
+#include "../src/rational_geometry/Direction.hpp"
+#include "../src/rational_geometry/Point.hpp"
+#include "../src/rational_geometry/WideInteger.hpp"
+
+#include "doctest.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing angular_order.hpp")
+{
+  typedef Direction<long long, 2> D2;
+  typedef Direction<long long, 3> D3;
+  typedef std::vector<std::size_t> Indices;
+
+  // Sixteen directions, counter-clockwise from the positive x axis.
+  std::vector<D2> circle{D2{1, 0}, D2{3, 1}, D2{1, 1}, D2{1, 3}, D2{0, 1},
+      D2{-1, 3}, D2{-1, 1}, D2{-3, 1}, D2{-1, 0}, D2{-3, -1}, D2{-1, -1},
+      D2{-1, -3}, D2{0, -1}, D2{1, -3}, D2{1, -1}, D2{3, -1}};
+
+  SUBCASE("comparisons")
+  {
+    for (std::size_t i = 0; i < circle.size(); ++i) {
+      CHECK(compare_angles(circle[i], circle[i]) == 0);
+      for (std::size_t j = i + 1; j < circle.size(); ++j) {
+        CHECK(compare_angles(circle[i], circle[j]) == -1);
+        CHECK(compare_angles(circle[j], circle[i]) == 1);
+      }
+    }
+
+    // Scaled copies are the same direction, and the null direction is first.
+    CHECK(compare_angles(D2{2, 6}, D2{1, 3}) == 0);
+    CHECK(compare_angles(D2{0, 0}, D2{1, 0}) == -1);
+    CHECK(compare_angles(D2{1, 0}, D2{0, 0}) == 1);
+    CHECK(compare_angles(D2{0, 0}, D2{0, 0}) == 0);
+  }
+
+  SUBCASE("keys")
+  {
+    for (std::size_t i = 1; i < circle.size(); ++i) {
+      CHECK(angular_key(circle[i - 1]) < angular_key(circle[i]));
+    }
+    CHECK(angular_key(D2{1, 0}) == 0);
+    CHECK(angular_key(D2{0, 1}) == 1ULL << 62);
+    CHECK(angular_key(D2{1, 1}) == 1ULL << 61);
+    CHECK(angular_key(D2{0, -1}) == 3ULL << 62);
+    CHECK(angular_key(D2{0, 0}) == 0);
+
+    // Nearby directions may share a key, but never go backwards.
+    const long long big = 1LL << 62;
+    CHECK(angular_key(D2{big, 1}) <= angular_key(D2{big - 1, 1}));
+  }
+
+  SUBCASE("ordering")
+  {
+    std::vector<D2> shuffled;
+    for (std::size_t i = 0; i < circle.size(); ++i) {
+      auto j = (i * 7) % circle.size();
+      shuffled.push_back(circle[j]);
+    }
+    auto order = angular_order(shuffled);
+    REQUIRE(order.size() == circle.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+      CHECK(shuffled[order[i]] == circle[i]);
+    }
+
+    // Directions whose keys tie are still ordered exactly, and equal ones
+    // keep their given order.
+    const long long big = 1LL << 62;
+    std::vector<D2> close{
+        D2{big - 1, 1}, D2{1, 1}, D2{big, 1}, D2{0, 0}, D2{2, 2}};
+    CHECK(angular_order(close) == Indices{3, 2, 0, 1, 4});
+    CHECK(angular_order(std::vector<D2>{}).empty());
+  }
+
+  SUBCASE("around an axis")
+  {
+    // Seen from above, around the z axis, as in the plane.
+    D3 up{0, 0, 1};
+    std::vector<D3> spokes;
+    for (const auto& direction : circle) {
+      spokes.push_back(D3{direction.get(0), direction.get(1), 5});
+    }
+    auto order = angular_order(spokes, up);
+    REQUIRE(order.size() == spokes.size());
+    for (std::size_t i = 1; i < order.size(); ++i) {
+      CHECK(compare_angles(spokes[order[i - 1]], spokes[order[i]], up) == -1);
+    }
+
+    // The order is a rotation of the planar one.
+    auto start = order[0];
+    for (std::size_t i = 0; i < order.size(); ++i) {
+      CHECK(order[i] == (start + i) % spokes.size());
+    }
+
+    // Seen from below, it reverses.
+    auto reversed = angular_order(spokes, D3{0, 0, -1});
+    for (std::size_t i = 1; i < reversed.size(); ++i) {
+      CHECK((reversed[i] + 1) % spokes.size() == reversed[i - 1]);
+    }
+
+    // A tilted axis, with a direction along it first.
+    D3 tilted{1, 1, 1};
+    std::vector<D3> around{D3{1, -1, 0}, D3{0, 1, -1}, D3{-1, 0, 1},
+        D3{2, 2, 2}};
+    auto tilted_order = angular_order(around, tilted);
+    CHECK(tilted_order[0] == 3);
+    CHECK(tilted_order[2] == (tilted_order[1] + 1) % 3);
+    CHECK(tilted_order[3] == (tilted_order[2] + 1) % 3);
+    CHECK(angular_key(D3{3, 3, 3}, tilted) == 0);
+  }
+
+  SUBCASE("large components")
+  {
+    typedef WideInteger<256> Wide;
+
+    unsigned long long state = 2024;
+    auto next = [&state](int bits) {
+      state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+      return static_cast<long long>(state >> (63 - bits)) - (1LL << bits);
+    };
+
+    // In the plane, exactly, by half-plane and then cross product.
+    auto half = [](const Wide& x, const Wide& y) {
+      return y < Wide(0) || (y == Wide(0) && x < Wide(0)) ? 1 : 0;
+    };
+    auto reference = [&half](const D2& l_op, const D2& r_op) {
+      Wide l_x(l_op.get(0)), l_y(l_op.get(1));
+      Wide r_x(r_op.get(0)), r_y(r_op.get(1));
+      if (half(l_x, l_y) != half(r_x, r_y)) {
+        return half(l_x, l_y) < half(r_x, r_y) ? -1 : 1;
+      }
+      return -sign(l_x * r_y - l_y * r_x);
+    };
+
+    for (int bits : {40, 62}) {
+      std::vector<D2> directions;
+      for (int i = 0; i < 200; ++i) {
+        directions.push_back(D2{next(bits), next(bits)});
+      }
+      std::size_t wrong = 0;
+      for (const auto& l_op : directions) {
+        for (const auto& r_op : directions) {
+          wrong += compare_angles(l_op, r_op) != reference(l_op, r_op);
+        }
+      }
+      CHECK(wrong == 0);
+
+      auto order = angular_order(directions);
+      for (std::size_t i = 1; i < order.size(); ++i) {
+        const auto& before = directions[order[i - 1]];
+        const auto& after  = directions[order[i]];
+        CHECK(reference(before, after) <= 0);
+        CHECK(angular_key(before) <= angular_key(after));
+      }
+
+      // Cross products of 2^(2 bits), differing by one.
+      const long long big = 1LL << bits;
+      CHECK(compare_angles(D2{big, big - 1}, D2{big - 1, big - 2}) == 1);
+      CHECK(compare_angles(D2{-big + 2, big - 1}, D2{-big + 1, big}) == -1);
+      CHECK(angular_key(D2{big - 1, big - 2}) <= angular_key(D2{big, big - 1}));
+    }
+
+    // Around an axis, exactly, by projecting into its plane as
+    // d |a|^2 - (d . a) a, and measuring from the first projection.
+    D3 axis{1000003, 2000029, 3000017};
+    Point<Wide, 3> a{Wide(axis.get(0)), Wide(axis.get(1)), Wide(axis.get(2))};
+    auto project = [&a](const D3& direction) {
+      Point<Wide, 3> d{Wide(direction.get(0)), Wide(direction.get(1)),
+          Wide(direction.get(2))};
+      return d * dot(a, a) - a * dot(d, a);
+    };
+
+    std::vector<D3> directions;
+    for (int i = 0; i < 100; ++i) {
+      directions.push_back(D3{next(25), next(25), next(25)});
+    }
+    typedef Point<Wide, 3> WideP;
+    auto start    = project(directions[0]);
+    auto is_lower = [&a, &start](const WideP& p) {
+      auto turn = sign(dot(a, cross(start, p)));
+      return turn < 0 || (turn == 0 && dot(start, p) < Wide(0));
+    };
+    auto is_before = [&a, &is_lower](const WideP& l_op, const WideP& r_op) {
+      if (is_lower(l_op) != is_lower(r_op)) return is_lower(r_op);
+      return 0 < sign(dot(a, cross(l_op, r_op)));
+    };
+
+    // The order is the reference order, rotated: it descends just once, at
+    // the wrap.
+    auto order = angular_order(directions, axis);
+    REQUIRE(order.size() == directions.size());
+    std::size_t descents = 0;
+    for (std::size_t i = 0; i < order.size(); ++i) {
+      auto j = (i + 1) % order.size();
+      descents += is_before(
+          project(directions[order[j]]), project(directions[order[i]]));
+      if (j != 0) {
+        CHECK(compare_angles(directions[order[i]], directions[order[j]], axis)
+              == -1);
+        CHECK(angular_key(directions[order[i]], axis)
+              <= angular_key(directions[order[j]], axis));
+      }
+    }
+    CHECK(descents == 1);
+  }
+}
+
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,171 @@
+
+#include "../src/rational_geometry/clipping.hpp"
+
+#include "../src/rational_geometry/AABB.hpp"
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "../src/rational_geometry/Plane.hpp"
+#include "../src/rational_geometry/Point.hpp"
+#include "../src/rational_geometry/unrepresentable_operation_error.hpp"
+
+#include "doctest.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing clipping.hpp")
+{
+  typedef FixedRational<long long, 4 * 9 * 5> Rat;
+  typedef Point<Rat, 2> P2;
+  typedef Point<Rat, 3> P3;
+  typedef PolygonBuffer<Rat, 2> Buffer2;
+  typedef PolygonBuffer<Rat, 3> Buffer3;
+  typedef std::vector<std::size_t> Offsets;
+
+  auto p = [](int x, int y) { return P2{Rat(x), Rat(y)}; };
+
+  // Three polygons: a square straddling the unit square's corner, a triangle
+  // wholly outside it, and a small square wholly inside.
+  Buffer2 polygons;
+  for (const auto& polygon : std::vector<std::vector<P2>>{
+           {p(-1, -1), p(1, -1), p(1, 1), p(-1, 1)},
+           {p(3, 3), p(4, 3), p(4, 4)},
+           {P2{Rat(1, 4), Rat(1, 4)}, P2{Rat(3, 4), Rat(1, 4)},
+               P2{Rat(3, 4), Rat(3, 4)}, P2{Rat(1, 4), Rat(3, 4)}}}) {
+    polygons.vertices_.insert(
+        polygons.vertices_.end(), polygon.begin(), polygon.end());
+    polygons.offsets_.push_back(polygons.vertices_.size());
+  }
+
+  SUBCASE("convex windows")
+  {
+    std::vector<P2> unit{p(0, 0), p(2, 0), p(2, 2), p(0, 2)};
+    auto clipped = clip(polygons, unit);
+    CHECK(clipped.offsets_ == Offsets{0, 4, 4, 8});
+    CHECK(std::vector<P2>(clipped.vertices_.begin(),
+              clipped.vertices_.begin() + 4)
+          == std::vector<P2>{p(0, 0), p(1, 0), p(1, 1), p(0, 1)});
+    CHECK(std::vector<P2>(
+              clipped.vertices_.begin() + 4, clipped.vertices_.end())
+          == std::vector<P2>(
+              polygons.vertices_.begin() + 7, polygons.vertices_.end()));
+
+    // A triangular window cuts the first square at exact rational points.
+    std::vector<P2> triangle{p(-1, 0), p(1, 0), p(0, 3)};
+    auto cut = clip(polygons, triangle);
+    CHECK(cut.offsets_ == Offsets{0, 4, 4, 8});
+    CHECK(std::vector<P2>(cut.vertices_.begin(), cut.vertices_.begin() + 4)
+          == std::vector<P2>{p(-1, 0), p(1, 0), P2{Rat(2, 3), Rat(1)},
+              P2{Rat(-2, 3), Rat(1)}});
+
+    // The same cut at a fine resolution, where heights' products of
+    // numerators pass 2^63.
+    typedef FixedRational<long long, 1000000> Micro;
+    typedef Point<Micro, 2> MP;
+    auto mp = [](long long x, long long y) { return MP{Micro(x), Micro(y)}; };
+    PolygonBuffer<Micro, 2> wide{
+        {0, 4}, {mp(-3000, -3000), mp(3000, -3000), mp(3000, 3000),
+                    mp(-3000, 3000)}};
+    auto wide_cut =
+        clip(wide, std::vector<MP>{mp(-3000, 0), mp(3000, 0), mp(0, 9000)});
+    CHECK(wide_cut.vertices_
+          == std::vector<MP>{
+              mp(-3000, 0), mp(3000, 0), mp(2000, 3000), mp(-2000, 3000)});
+
+    // Touching the window along an edge leaves nothing.
+    Buffer2 touching{{0, 3}, {p(2, 0), p(3, 1), p(2, 2)}};
+    CHECK(clip(touching, unit).offsets_ == Offsets{0, 0});
+
+    CHECK(clip(Buffer2{}, unit).vertices_.empty());
+    CHECK_THROWS_AS(clip(polygons, std::vector<P2>{p(0, 0), p(1, 1)}),
+        std::invalid_argument);
+
+    // A crossing between lattice points cannot be represented.
+    typedef FixedRational<long long, 2> CoarseRat;
+    typedef Point<CoarseRat, 2> CoarseP;
+    PolygonBuffer<CoarseRat, 2> coarse{{0, 3},
+        {CoarseP{CoarseRat(0), CoarseRat(-1)},
+            CoarseP{CoarseRat(3), CoarseRat(2)},
+            CoarseP{CoarseRat(0), CoarseRat(2)}}};
+    std::vector<CoarseP> window{CoarseP{CoarseRat(0), CoarseRat(0)},
+        CoarseP{CoarseRat(1), CoarseRat(0)},
+        CoarseP{CoarseRat(0), CoarseRat(3)}};
+    CHECK_THROWS_AS(clip(coarse, window),
+        unrepresentable_operation_error<long long>);
+  }
+
+  SUBCASE("boxes and tiles")
+  {
+    // Clipping to a box matches clipping to the same window.
+    auto clipped = clip(polygons, AABB<Rat, 2>{p(0, 0), p(2, 2)});
+    auto windowed =
+        clip(polygons, std::vector<P2>{p(0, 0), p(2, 0), p(2, 2), p(0, 2)});
+    CHECK(clipped.offsets_ == windowed.offsets_);
+    CHECK(clipped.vertices_ == windowed.vertices_);
+
+    // Four tiles around the origin share out the first square's area.
+    std::vector<AABB<Rat, 2>> tiles{AABB<Rat, 2>{p(-2, -2), p(0, 0)},
+        AABB<Rat, 2>{p(0, -2), p(2, 0)}, AABB<Rat, 2>{p(-2, 0), p(0, 2)},
+        AABB<Rat, 2>{p(0, 0), p(2, 2)}, AABB<Rat, 2>{p(5, 5), p(6, 6)}};
+    auto tiled = clip(polygons, tiles);
+    REQUIRE(tiled.size() == 5);
+    for (std::size_t i = 0; i < 4; ++i) {
+      CHECK(tiled[i].offsets_.size() == 4);
+      CHECK(tiled[i].offsets_[1] == 4);
+      for (std::size_t j = 0; j < 4; ++j) {
+        CHECK(tiles[i].contains(tiled[i].vertices_[j]));
+      }
+    }
+    CHECK(tiled[3].offsets_ == Offsets{0, 4, 4, 8});
+    CHECK(tiled[4].offsets_ == Offsets{0, 0, 0, 0});
+
+    // Threads dealt runs of tiles give the same buffers.
+    for (std::size_t threads : {2, 3, 8}) {
+      auto threaded = clip(polygons, tiles, threads);
+      REQUIRE(threaded.size() == tiled.size());
+      for (std::size_t i = 0; i < tiled.size(); ++i) {
+        CHECK(threaded[i].offsets_ == tiled[i].offsets_);
+        CHECK(threaded[i].vertices_ == tiled[i].vertices_);
+      }
+    }
+  }
+
+  SUBCASE("planes")
+  {
+    typedef Plane<long long, Rat> PlaneT;
+    typedef PlaneT::DirectionT D;
+
+    // A square in the z = 1 plane, and a triangle across z = 0.
+    Buffer3 faces{{0, 4, 7},
+        {P3{Rat(0), Rat(0), Rat(1)}, P3{Rat(2), Rat(0), Rat(1)},
+            P3{Rat(2), Rat(2), Rat(1)}, P3{Rat(0), Rat(2), Rat(1)},
+            P3{Rat(0), Rat(0), Rat(-1)}, P3{Rat(1), Rat(0), Rat(1)},
+            P3{Rat(0), Rat(1), Rat(1)}}};
+
+    // Below x + y = 1 and below z = 1/2.
+    std::vector<PlaneT> planes{
+        PlaneT{D{1, 1, 0}, Rat(1)}, PlaneT{D{0, 0, 1}, Rat(1, 2)}};
+    auto clipped = clip(faces, planes);
+    CHECK(clipped.offsets_ == Offsets{0, 0, 3});
+    CHECK(clipped.vertices_
+          == std::vector<P3>{P3{Rat(0), Rat(3, 4), Rat(1, 2)},
+              P3{Rat(0), Rat(0), Rat(-1)}, P3{Rat(3, 4), Rat(0), Rat(1, 2)}});
+
+    // The square lies on its plane's boundary, so is kept whole.
+    auto kept = clip(faces, std::vector<PlaneT>{PlaneT{D{0, 0, 1}, Rat(1)}});
+    CHECK(kept.offsets_ == faces.offsets_);
+    CHECK(kept.vertices_ == faces.vertices_);
+
+    auto boxed = clip(faces, AABB<Rat, 3>{P3{Rat(0), Rat(0), Rat(0)},
+                                 P3{Rat(1), Rat(1), Rat(1)}});
+    CHECK(boxed.offsets_ == Offsets{0, 4, 8});
+  }
+}
+
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,190 @@
+
+#include "../src/rational_geometry/convex_hull.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "../src/rational_geometry/Point.hpp"
+#include "../src/rational_geometry/Polyhedron.hpp"
+
+#include "doctest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing convex_hull.hpp")
+{
+  typedef FixedRational<long long, 4 * 3 * 5 * 7> Rat;
+  typedef Point<Rat, 2> P2;
+  typedef Point<Rat, 3> P3;
+
+  SUBCASE("convex_hull(std::vector<Point<RatT, 2>>)")
+  {
+    SUBCASE("general position")
+    {
+      std::vector<P2> points{P2{Rat(2), Rat(2)}, P2{Rat(0), Rat(0)},
+          P2{Rat(4), Rat(1)}, P2{Rat(1), Rat(1)}, P2{Rat(3), Rat(4)},
+          P2{Rat(0), Rat(3)}, P2{Rat(2), Rat(1)}};
+      std::vector<P2> expected{P2{Rat(0), Rat(0)}, P2{Rat(4), Rat(1)},
+          P2{Rat(3), Rat(4)}, P2{Rat(0), Rat(3)}};
+
+      CHECK(convex_hull(points) == expected);
+
+      std::reverse(std::begin(points), std::end(points));
+      CHECK(convex_hull(points) == expected);
+    }
+
+    SUBCASE("degeneracies")
+    {
+      CHECK(convex_hull(std::vector<P2>{}).empty());
+
+      std::vector<P2> same{P2{Rat(1), Rat(2)}, P2{Rat(1), Rat(2)}};
+      CHECK(convex_hull(same) == std::vector<P2>{P2{Rat(1), Rat(2)}});
+
+      std::vector<P2> collinear;
+      for (int i = 5; i >= -5; --i) {
+        collinear.push_back(P2{Rat(i, 2), Rat(i)});
+      }
+      CHECK(convex_hull(collinear)
+            == std::vector<P2>{P2{Rat(-5, 2), Rat(-5)}, P2{Rat(5, 2), Rat(5)}});
+
+      // Points along the edges, and repeated corners, are dropped.
+      std::vector<P2> square;
+      for (int i = 0; i <= 4; ++i) {
+        for (int j = 0; j <= 4; ++j) {
+          square.push_back(P2{Rat(i, 4), Rat(j, 4)});
+          square.push_back(P2{Rat(0), Rat(0)});
+        }
+      }
+      CHECK(convex_hull(square)
+            == std::vector<P2>{P2{Rat(0), Rat(0)}, P2{Rat(1), Rat(0)},
+                P2{Rat(1), Rat(1)}, P2{Rat(0), Rat(1)}});
+    }
+  }
+
+  SUBCASE("convex_hull(std::vector<Point<RatT, 3>>)")
+  {
+    SUBCASE("general position")
+    {
+      std::vector<P3> points{P3{Rat(0), Rat(0), Rat(0)},
+          P3{Rat(6), Rat(0), Rat(0)}, P3{Rat(0), Rat(6), Rat(0)},
+          P3{Rat(0), Rat(0), Rat(6)}, P3{Rat(1), Rat(1), Rat(1)},
+          P3{Rat(2), Rat(1), Rat(2)}};
+
+      auto hull = convex_hull(points);
+      CHECK(hull.vertices().size() == 4);
+      CHECK(hull.faces().size() == 4);
+      CHECK(hull.signed_volume() == Rat(36));
+
+      std::reverse(std::begin(points), std::end(points));
+      CHECK(convex_hull(points) == hull);
+    }
+
+    SUBCASE("coplanar and collinear points")
+    {
+      // The lattice points of a cube: most lie on faces or edges, so the hull
+      // is just the cube, with square faces.
+      std::vector<P3> lattice;
+      for (int i = 0; i <= 3; ++i) {
+        for (int j = 0; j <= 3; ++j) {
+          for (int k = 0; k <= 3; ++k) {
+            lattice.push_back(P3{Rat(i), Rat(j), Rat(k)});
+          }
+        }
+      }
+
+      auto hull = convex_hull(lattice);
+      CHECK(hull.vertices().size() == 8);
+      CHECK(hull.faces().size() == 6);
+      CHECK(hull.signed_volume() == Rat(27));
+      CHECK(hull
+            == (make_box(P3{Rat(0), Rat(0), Rat(0)},
+                    P3{Rat(3), Rat(3), Rat(3)})
+                   | Polyhedron<Rat>{}));
+
+      // An octahedron, with a point at the centre of each face.
+      std::vector<P3> octahedron;
+      for (int axis = 0; axis < 3; ++axis) {
+        for (int sign : {-3, 3}) {
+          P3 point{Rat(0), Rat(0), Rat(0)};
+          point[axis] = Rat(sign);
+          octahedron.push_back(point);
+        }
+      }
+      for (int x : {-1, 1}) {
+        for (int y : {-1, 1}) {
+          for (int z : {-1, 1}) {
+            octahedron.push_back(P3{Rat(x), Rat(y), Rat(z)});
+          }
+        }
+      }
+      auto octahedron_hull = convex_hull(octahedron);
+      CHECK(octahedron_hull.vertices().size() == 6);
+      CHECK(octahedron_hull.faces().size() == 8);
+      CHECK(octahedron_hull.signed_volume() == Rat(36));
+    }
+
+    SUBCASE("flat and degenerate point sets")
+    {
+      CHECK(convex_hull(std::vector<P3>{}).empty());
+
+      std::vector<P3> collinear{P3{Rat(0), Rat(0), Rat(0)},
+          P3{Rat(1), Rat(2), Rat(3)}, P3{Rat(2), Rat(4), Rat(6)}};
+      CHECK(convex_hull(collinear).empty());
+
+      std::vector<P3> flat;
+      for (int i = 0; i <= 2; ++i) {
+        for (int j = 0; j <= 2; ++j) {
+          flat.push_back(P3{Rat(i), Rat(j), Rat(i + j)});
+        }
+      }
+      auto hull = convex_hull(flat);
+      CHECK(hull.faces().size() == 2);
+      CHECK(hull.vertices().size() == 4);
+      CHECK(hull.signed_volume() == Rat(0));
+      CHECK(hull.face_normal(0) == hull.face_normal(1) * Rat(-1));
+    }
+  }
+
+  SUBCASE("divided and threaded hulls")
+  {
+    // A pseudo-random cloud inside a lattice cube, so that many points lie on
+    // its faces and edges and the halves' hulls share coplanar corners.
+    std::vector<P2> points_2d;
+    std::vector<P3> points_3d;
+    unsigned seed = 12345;
+    auto next = [&seed] {
+      seed = seed * 1103515245u + 12345u;
+      return static_cast<int>((seed >> 16) % 21);
+    };
+    for (int i = 0; i < 3000; ++i) {
+      points_2d.push_back(P2{Rat(next()), Rat(next() * next() % 21)});
+      auto third = Rat(static_cast<long long>(next()), 3LL);
+      points_3d.push_back(P3{Rat(next()), Rat(next()), third});
+    }
+
+    auto hull_2d = convex_hull(points_2d);
+    CHECK(convex_hull(points_2d, 4, 100) == hull_2d);
+    CHECK(convex_hull(points_2d, 3, 100) == hull_2d);
+
+    auto hull_3d = convex_hull(points_3d, 1, points_3d.size());
+    CHECK(hull_3d.signed_volume() > Rat(0));
+    CHECK(convex_hull(points_3d) == hull_3d);
+    CHECK(convex_hull(points_3d, 1, 16) == hull_3d);
+    CHECK(convex_hull(points_3d, 4, 16) == hull_3d);
+
+    // Coplanar halves merge into a solid.
+    std::vector<P3> slabs;
+    for (int i = 0; i < 40; ++i) {
+      slabs.push_back(P3{Rat(i % 2), Rat(i), Rat(i * i % 7)});
+    }
+    CHECK(convex_hull(slabs, 4, 8) == convex_hull(slabs, 1, slabs.size()));
+  }
+}
+
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
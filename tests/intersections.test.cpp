@@ -0,0 +1,215 @@
+
+#include "../src/rational_geometry/intersections.hpp"
+
+#include "../src/rational_geometry/Direction.hpp"
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "../src/rational_geometry/Plane.hpp"
+#include "../src/rational_geometry/Point.hpp"
+
+#include "doctest.h"
+
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing intersections.hpp")
+{
+  typedef FixedRational<long long, 4 * 9 * 5 * 7> Rat;
+  typedef Point<Rat, 2> P2;
+  typedef Point<Rat, 3> P3;
+
+  auto p2 = [](int x, int y) { return P2{Rat(x), Rat(y)}; };
+  auto p3 = [](int x, int y, int z) { return P3{Rat(x), Rat(y), Rat(z)}; };
+
+  SUBCASE("point_along()")
+  {
+    CHECK(point_along(p2(1, 1), p2(4, 7), Rat(1), Rat(3)) == p2(2, 3));
+    CHECK(point_along(p2(1, 1), p2(4, 7), Rat(0), Rat(5)) == p2(1, 1));
+    CHECK(point_along(p2(1, 1), p2(4, 7), Rat(5), Rat(5)) == p2(4, 7));
+
+    // Only the point itself need be representable, not the fraction.
+    CHECK(point_along(p2(0, 0), p2(11, 0), Rat(1), Rat(11)) == p2(1, 0));
+  }
+
+  SUBCASE("segment/segment intersection()")
+  {
+    auto crossing = intersection(p2(0, 0), p2(4, 4), p2(0, 4), p2(4, 0));
+    CHECK(crossing.type_ == IntersectionType::kPoint);
+    CHECK(crossing.first_ == p2(2, 2));
+    CHECK(crossing.second_ == p2(2, 2));
+
+    auto thirds = intersection(p2(0, 0), p2(3, 1), p2(1, 0), p2(1, 5));
+    CHECK(thirds.first_ == P2{Rat(1), Rat(1, 3)});
+
+    auto touching = intersection(p2(0, 0), p2(4, 0), p2(2, 0), p2(2, 3));
+    CHECK(touching.type_ == IntersectionType::kPoint);
+    CHECK(touching.first_ == p2(2, 0));
+
+    CHECK(intersection(p2(0, 0), p2(1, 1), p2(2, 0), p2(3, -5)).type_
+          == IntersectionType::kNone);
+    CHECK(intersection(p2(0, 0), p2(1, 1), p2(0, 1), p2(1, 2)).type_
+          == IntersectionType::kNone);
+
+    auto overlap = intersection(p2(0, 0), p2(4, 2), p2(6, 3), p2(2, 1));
+    CHECK(overlap.type_ == IntersectionType::kSegment);
+    CHECK(overlap.first_ == p2(2, 1));
+    CHECK(overlap.second_ == p2(4, 2));
+
+    auto end_to_end = intersection(p2(0, 0), p2(2, 1), p2(2, 1), p2(4, 2));
+    CHECK(end_to_end.type_ == IntersectionType::kPoint);
+    CHECK(end_to_end.first_ == p2(2, 1));
+
+    CHECK(intersection(p2(0, 0), p2(2, 1), p2(4, 2), p2(6, 3)).type_
+          == IntersectionType::kNone);
+
+    // A degenerate segment is a point.
+    CHECK(intersection(p2(1, 1), p2(1, 1), p2(0, 0), p2(2, 2)).type_
+          == IntersectionType::kPoint);
+    CHECK(intersection(p2(1, 2), p2(1, 2), p2(0, 0), p2(2, 2)).type_
+          == IntersectionType::kNone);
+  }
+
+  SUBCASE("segment/triangle intersection()")
+  {
+    std::array<P3, 3> triangle{p3(0, 0, 0), p3(6, 0, 0), p3(0, 6, 0)};
+
+    auto through = intersection(p3(1, 1, -1), p3(1, 1, 2), triangle);
+    CHECK(through.type_ == IntersectionType::kPoint);
+    CHECK(through.first_ == p3(1, 1, 0));
+
+    auto slanted = intersection(p3(0, 0, 3), p3(3, 3, -3), triangle);
+    CHECK(slanted.first_ == P3{Rat(3, 2), Rat(3, 2), Rat(0)});
+
+    CHECK(intersection(p3(5, 5, -1), p3(5, 5, 1), triangle).type_
+          == IntersectionType::kNone);
+    CHECK(intersection(p3(1, 1, 1), p3(1, 1, 2), triangle).type_
+          == IntersectionType::kNone);
+
+    // Ending on the triangle, or on its edge.
+    CHECK(intersection(p3(1, 1, 2), p3(1, 1, 0), triangle).first_
+          == p3(1, 1, 0));
+    CHECK(intersection(p3(3, 3, 0), p3(3, 3, 4), triangle).type_
+          == IntersectionType::kPoint);
+    CHECK(intersection(p3(4, 4, 0), p3(4, 4, 4), triangle).type_
+          == IntersectionType::kNone);
+
+    // Coplanar segments are clipped to the triangle.
+    auto clipped = intersection(p3(-2, 1, 0), p3(8, 1, 0), triangle);
+    CHECK(clipped.type_ == IntersectionType::kSegment);
+    CHECK(clipped.first_ == p3(0, 1, 0));
+    CHECK(clipped.second_ == p3(5, 1, 0));
+
+    auto corner = intersection(p3(-1, 7, 0), p3(7, -1, 0), triangle);
+    CHECK(corner.first_ == p3(0, 6, 0));
+    CHECK(corner.second_ == p3(6, 0, 0));
+
+    CHECK(intersection(p3(-1, 1, 0), p3(0, 7, 0), triangle).type_
+          == IntersectionType::kNone);
+
+    std::array<P3, 3> degenerate{p3(0, 0, 0), p3(1, 1, 1), p3(2, 2, 2)};
+    CHECK(intersection(p3(0, 2, 0), p3(2, 0, 2), degenerate).type_
+          == IntersectionType::kNone);
+  }
+
+  SUBCASE("batched intersections()")
+  {
+    std::vector<std::array<P2, 2>> segments{{p2(0, 4), p2(4, 0)},
+        {p2(10, 10), p2(12, 12)}, {p2(1, 0), p2(1, 5)}, {p2(4, 4), p2(6, 6)}};
+    auto found = intersections(p2(0, 0), p2(4, 4), segments);
+    REQUIRE(found.size() == 4);
+    CHECK(found[0].first_ == p2(2, 2));
+    CHECK(found[1].type_ == IntersectionType::kNone);
+    CHECK(found[2].first_ == p2(1, 1));
+    CHECK(found[3].first_ == p2(4, 4));
+
+    std::vector<std::array<P3, 3>> triangles{
+        {p3(0, 0, 1), p3(4, 0, 1), p3(0, 4, 1)},
+        {p3(0, 0, 9), p3(4, 0, 9), p3(0, 4, 9)},
+        {p3(0, 0, 2), p3(4, 0, 2), p3(0, 4, 2)}};
+    auto hits = intersections(p3(1, 1, 0), p3(1, 1, 3), triangles);
+    REQUIRE(hits.size() == 3);
+    CHECK(hits[0].first_ == p3(1, 1, 1));
+    CHECK(hits[1].type_ == IntersectionType::kNone);
+    CHECK(hits[2].first_ == p3(1, 1, 2));
+  }
+
+  SUBCASE("line/plane intersection_point()")
+  {
+    typedef Plane<long long> PlaneT;
+    typedef PlaneT::DirectionT D;
+
+    PlaneT plane{D{{1, 1, 1}}, 3};
+    CHECK(intersection_point(p3(0, 0, 0), p3(1, 1, 1), plane)
+          == p3(1, 1, 1));
+    CHECK(intersection_point(p3(0, 0, 0), p3(0, 0, 9), plane)
+          == p3(0, 0, 3));
+    CHECK(intersection_point(p3(0, 0, 0), p3(2, 0, 1), plane)
+          == P3{Rat(2), Rat(0), Rat(1)});
+
+    CHECK_THROWS_AS(intersection_point(p3(0, 0, 0), p3(1, -1, 0), plane),
+        std::domain_error);
+
+    auto points = intersection_points(p3(0, 0, 0), p3(0, 0, 1),
+        std::vector<PlaneT>{plane, PlaneT{D{{0, 0, 1}}, -2}});
+    REQUIRE(points.size() == 2);
+    CHECK(points[0] == p3(0, 0, 3));
+    CHECK(points[1] == p3(0, 0, -2));
+  }
+
+  SUBCASE("points whose coordinates' products are not representable")
+  {
+    // Thousandths, whose products need millionths, and millionths beyond
+    // 5000, whose numerators' products overflow long long.
+    typedef FixedRational<long long, 1000> Milli;
+    typedef FixedRational<long long, 1000000> Micro;
+
+    auto check_all = [](auto unit, long long offset) {
+      typedef decltype(unit) R;
+      typedef Point<R, 2> Q2;
+      typedef Point<R, 3> Q3;
+
+      auto at = [&unit, offset](long long steps) {
+        return R(offset) + unit * R(steps);
+      };
+      auto q2 = [&at](long long x, long long y) { return Q2{at(x), at(y)}; };
+      auto q3 = [&at](long long x, long long y, long long z) {
+        return Q3{at(x), at(y), at(z)};
+      };
+
+      CHECK(point_along(q2(0, 0), q2(2, 2), unit, unit * R(2)) == q2(1, 1));
+
+      auto crossing = intersection(q2(0, 0), q2(2, 2), q2(0, 2), q2(2, 0));
+      CHECK(crossing.type_ == IntersectionType::kPoint);
+      CHECK(crossing.first_ == q2(1, 1));
+
+      std::array<Q3, 3> triangle{q3(0, 0, 0), q3(6, 0, 0), q3(0, 6, 0)};
+      CHECK(intersection(q3(1, 1, -1), q3(1, 1, 2), triangle).first_
+            == q3(1, 1, 0));
+      CHECK(intersection(q3(0, 0, 3), q3(2, 2, -3), triangle).first_
+            == q3(1, 1, 0));
+      CHECK(intersection(q3(1, 1, 2), q3(1, 1, 0), triangle).first_
+            == q3(1, 1, 0));
+
+      auto clipped = intersection(q3(-2, 1, 0), q3(8, 1, 0), triangle);
+      CHECK(clipped.type_ == IntersectionType::kSegment);
+      CHECK(clipped.first_ == q3(0, 1, 0));
+      CHECK(clipped.second_ == q3(5, 1, 0));
+
+      typedef Plane<long long, R> PlaneT;
+      PlaneT plane{typename PlaneT::DirectionT{{1, 1, 1}}, at(1) * R(3)};
+      CHECK(intersection_point(q3(0, 0, 0), q3(2, 2, 2), plane)
+            == q3(1, 1, 1));
+    };
+    check_all(Milli(1LL, 1000LL), 0);
+    check_all(Micro(1LL, 1000000LL), 5000);
+    check_all(Micro(1LL, 1000000LL), -5000);
+  }
+}
+
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
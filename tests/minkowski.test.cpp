@@ -0,0 +1,128 @@
+
+#include "../src/rational_geometry/minkowski.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "../src/rational_geometry/Point.hpp"
+#include "../src/rational_geometry/Polygon2D.hpp"
+
+#include "doctest.h"
+
+#include <stdexcept>
+#include <vector>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing minkowski.hpp")
+{
+  typedef FixedRational<long long, 4 * 9 * 5> Rat;
+  typedef Point<Rat, 2> P;
+  typedef std::vector<P> Ring;
+
+  auto p = [](int x, int y) { return P{Rat(x), Rat(y)}; };
+  auto square = [&p](int low, int high) {
+    return Ring{p(low, low), p(high, low), p(high, high), p(low, high)};
+  };
+
+  SUBCASE("convex polygons")
+  {
+    Ring triangle{p(0, 0), p(1, 0), p(0, 1)};
+    CHECK(minkowski_sum(square(0, 1), triangle)
+          == Ring{p(0, 0), p(2, 0), p(2, 1), p(1, 2), p(0, 2)});
+
+    // Parallel edges merge, and the sum starts at its lowest vertex.
+    CHECK(minkowski_sum(Ring{p(1, 1), p(0, 1), p(0, 0), p(1, 0)}, square(0, 1))
+          == square(0, 2));
+
+    // Collinear input vertices leave none in the sum.
+    Ring notched{p(0, 0), P{Rat(1, 2), Rat(0)}, p(1, 0), p(1, 1), p(0, 1)};
+    CHECK(minkowski_sum(notched, square(0, 1)) == square(0, 2));
+    CHECK(minkowski_sum(square(0, 1), notched) == square(0, 2));
+
+    Ring diamond{p(1, 0), p(2, 1), p(1, 2), p(0, 1)};
+    CHECK(minkowski_sum(diamond, square(0, 1))
+          == Ring{p(1, 0), p(2, 0), p(3, 1), p(3, 2), p(2, 3), p(1, 3),
+              p(0, 2), p(0, 1)});
+
+    // Points and segments.
+    CHECK(minkowski_sum(Ring{p(2, 3)}, triangle)
+          == Ring{p(2, 3), p(3, 3), p(2, 4)});
+    CHECK(minkowski_sum(Ring{p(0, 0), p(2, 0)}, square(0, 1))
+          == Ring{p(0, 0), p(3, 0), p(3, 1), p(0, 1)});
+    CHECK(minkowski_sum(Ring{}, square(0, 1)).empty());
+  }
+
+  SUBCASE("convex polygons far from the origin")
+  {
+    // The edges' cross products are near 2^100, and differ by one.
+    typedef FixedRational<long long, 1> BigRat;
+    typedef Point<BigRat, 2> BigP;
+    const long long b = 1LL << 50;
+    auto q            = [](long long x, long long y) {
+      return BigP{BigRat(x), BigRat(y)};
+    };
+
+    std::vector<BigP> thin{q(0, 0), q(b, 1), q(b, 2)};
+    std::vector<BigP> thinner{q(0, 0), q(b + 1, 1), q(b + 1, 2)};
+    auto sum = std::vector<BigP>{
+        q(0, 0), q(b + 1, 1), q(2 * b + 1, 2), q(2 * b + 1, 4), q(b, 2)};
+    CHECK(minkowski_sum(thin, thinner) == sum);
+    CHECK(minkowski_sum(thinner, thin) == sum);
+  }
+
+  SUBCASE("convex pieces")
+  {
+    Polygon2D<Rat> clockwise{Ring{p(0, 1), p(1, 1), p(1, 0), p(0, 0)}};
+    CHECK(convex_pieces(clockwise) == std::vector<Ring>{square(0, 1)});
+
+    // A square with a hole is cut into triangles covering only its inside.
+    Polygon2D<Rat> frame{square(0, 3), square(1, 2)};
+    auto pieces = convex_pieces(frame);
+    CHECK(pieces.size() == 8);
+    Polygon2D<Rat> joined;
+    for (const auto& piece : pieces) {
+      CHECK(orient2d(piece[0], piece[1], piece[2]) > 0);
+      joined = joined | Polygon2D<Rat>{piece};
+    }
+    CHECK(joined == (frame | Polygon2D<Rat>{}));
+
+    CHECK(convex_pieces(Polygon2D<Rat>{}).empty());
+    CHECK_THROWS_AS(convex_pieces(Polygon2D<Rat>{square(0, 2),
+                        Ring{p(1, 1), p(3, 1), p(3, 3), p(1, 3)}}),
+        std::invalid_argument);
+  }
+
+  SUBCASE("other polygons")
+  {
+    Polygon2D<Rat> unit{square(0, 1)};
+
+    Polygon2D<Rat> ell{
+        Ring{p(0, 0), p(2, 0), p(2, 1), p(1, 1), p(1, 2), p(0, 2)}};
+    auto grown = minkowski_sum(ell, unit);
+    CHECK(grown
+          == Polygon2D<Rat>{Ring{
+              p(0, 0), p(3, 0), p(3, 2), p(2, 2), p(2, 3), p(0, 3)}});
+    CHECK(minkowski_sum(unit, ell) == grown);
+
+    // Growing a frame shrinks its hole, then fills it.
+    Polygon2D<Rat> frame{square(0, 4), square(1, 3)};
+    CHECK(minkowski_sum(frame, unit)
+          == (Polygon2D<Rat>{square(0, 5), square(2, 3)} | Polygon2D<Rat>{}));
+    CHECK(minkowski_sum(frame, Polygon2D<Rat>{square(0, 2)})
+          == Polygon2D<Rat>{square(0, 6)});
+
+    // Two disjoint pieces, each grown by a diamond.
+    Polygon2D<Rat> pair{square(0, 1), square(5, 6)};
+    Polygon2D<Rat> diamond{Ring{p(1, 0), p(2, 1), p(1, 2), p(0, 1)}};
+    auto sum = minkowski_sum(pair, diamond);
+    CHECK(sum.rings().size() == 2);
+    CHECK(sum.signed_area() == Rat(2 * 7));
+
+    CHECK(minkowski_sum(Polygon2D<Rat>{}, unit).empty());
+  }
+}
+
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
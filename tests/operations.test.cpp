@@ -56,6 +56,19 @@ TEST_CASE("Testing Operations.hpp")
     CHECK(j_n == cross(i, k));
     CHECK(k_n == cross(j, i));
   }
+
+  SUBCASE("constexpr")
+  {
+    typedef std::array<int, 3> IArray3;
+
+    constexpr IArray3 i{1, 0, 0};
+    constexpr IArray3 j{0, 1, 0};
+
+    static_assert(dot(IArray3{1, 2, 3}, IArray3{4, 5, 6}) == 32, "dot()");
+    static_assert(cross(i, j)[2] == 1, "cross()");
+
+    CHECK(dot(cross(i, j), IArray3{0, 0, 7}) == 7);
+  }
 }
 
 
@@ -0,0 +1,192 @@
+
+#include "../src/rational_geometry/point_location.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "../src/rational_geometry/Point.hpp"
+#include "../src/rational_geometry/Polygon2D.hpp"
+#include "../src/rational_geometry/Polyhedron.hpp"
+
+#include "doctest.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing point_location.hpp")
+{
+  typedef FixedRational<long long, 4 * 9 * 5> Rat;
+  typedef Point<Rat, 2> P2;
+  typedef Point<Rat, 3> P3;
+  typedef std::vector<Location> Locations;
+
+  auto p = [](int x, int y) { return P2{Rat(x), Rat(y)}; };
+  auto half = [](int x, int y) { return P2{Rat(x, 2), Rat(y, 2)}; };
+
+  // A square with a square hole, and a notched triangle beside it.
+  Polygon2D<Rat> polygon{{p(0, 0), p(6, 0), p(6, 6), p(0, 6)},
+      {p(2, 2), p(2, 4), p(4, 4), p(4, 2)},
+      {p(7, 0), p(10, 3), p(9, 3), p(8, 2), p(7, 3)}};
+
+  SUBCASE("polygons")
+  {
+    CHECK(locate(p(1, 1), polygon) == Location::kInside);
+    CHECK(locate(p(3, 3), polygon) == Location::kOutside);
+    CHECK(locate(p(0, 3), polygon) == Location::kBoundary);
+    CHECK(locate(p(4, 4), polygon) == Location::kBoundary);
+    CHECK(locate(p(-1, 0), polygon) == Location::kOutside);
+    CHECK(locate(half(16, 3), polygon) == Location::kInside);
+    CHECK(locate(p(8, 1), polygon) == Location::kBoundary);
+
+    // Rays through vertices and along edges count correctly.
+    CHECK(locate(p(2, 1), polygon) == Location::kInside);
+    CHECK(locate(p(6, -1), polygon) == Location::kOutside);
+    CHECK(locate(p(8, 3), polygon) == Location::kOutside);
+    CHECK(locate(half(15, 4), polygon) == Location::kInside);
+    CHECK(locate(half(15, 5), polygon) == Location::kBoundary);
+
+    std::vector<P2> ring{p(0, 0), p(2, 0), p(2, 2), p(0, 2)};
+    CHECK(winding_number(p(1, 1), ring) == 1);
+    CHECK(winding_number(p(3, 1), ring) == 0);
+    CHECK(winding_number(
+              p(1, 1), std::vector<P2>(ring.rbegin(), ring.rend()))
+          == -1);
+  }
+
+  SUBCASE("polygon locator")
+  {
+    PolygonLocator<Rat> empty{};
+    CHECK(empty.slab_count() == 0);
+    CHECK(empty.locate(p(0, 0)) == Location::kOutside);
+
+    PolygonLocator<Rat> locator{polygon};
+    CHECK(locator.slab_count() == 7);
+    CHECK(locator.locate(std::vector<P2>{p(1, 1), p(3, 3), p(0, 3)})
+          == Locations{
+              Location::kInside, Location::kOutside, Location::kBoundary});
+
+    std::vector<P2> samples;
+    for (int x = -2; x <= 22; ++x) {
+      for (int y = -2; y <= 14; ++y) {
+        samples.push_back(half(x, y));
+      }
+    }
+    samples.push_back(P2{Rat(1, 3), Rat(1, 5)});
+
+    auto located = locator.locate(samples);
+    REQUIRE(located.size() == samples.size());
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+      CHECK(located[i] == locate(samples[i], polygon));
+    }
+  }
+
+  SUBCASE("polyhedra")
+  {
+    auto box = make_box(
+        P3{Rat(0), Rat(0), Rat(0)}, P3{Rat(3), Rat(3), Rat(2)});
+    auto tunnel = make_box(
+        P3{Rat(1), Rat(1), Rat(-1)}, P3{Rat(2), Rat(2), Rat(3)});
+    auto framed = box - tunnel;
+
+    CHECK(locate(P3{Rat(1), Rat(1), Rat(1)}, box) == Location::kInside);
+    CHECK(locate(P3{Rat(3), Rat(1), Rat(1)}, box) == Location::kBoundary);
+    CHECK(locate(P3{Rat(3), Rat(3), Rat(2)}, box) == Location::kBoundary);
+    CHECK(locate(P3{Rat(-1), Rat(0), Rat(0)}, box) == Location::kOutside);
+    CHECK(locate(P3{Rat(-1), Rat(1), Rat(1)}, box) == Location::kOutside);
+
+    CHECK(locate(P3{Rat(3, 2), Rat(3, 2), Rat(1)}, framed)
+          == Location::kOutside);
+    CHECK(locate(P3{Rat(1, 2), Rat(3, 2), Rat(1)}, framed)
+          == Location::kInside);
+    CHECK(locate(P3{Rat(3, 2), Rat(1), Rat(1)}, framed)
+          == Location::kBoundary);
+    CHECK(locate(P3{Rat(3, 2), Rat(3, 2), Rat(2)}, framed)
+          == Location::kOutside);
+
+    PolyhedronLocator<Rat> empty{};
+    CHECK(empty.locate(P3{Rat(0), Rat(0), Rat(0)}) == Location::kOutside);
+
+    // The locator agrees with testing every face, on a lattice that hits
+    // faces, edges and vertices.
+    for (const auto& solid : {box, framed}) {
+      PolyhedronLocator<Rat> locator{solid};
+      CHECK(locator.polyhedron() == solid);
+
+      std::vector<P3> samples;
+      for (int x = -1; x <= 7; ++x) {
+        for (int y = -1; y <= 7; ++y) {
+          for (int z = -1; z <= 5; ++z) {
+            samples.push_back(P3{Rat(x, 2), Rat(y, 2), Rat(z, 2)});
+          }
+        }
+      }
+      auto located = locator.locate(samples);
+      REQUIRE(located.size() == samples.size());
+      std::size_t inside = 0;
+      for (std::size_t i = 0; i < samples.size(); ++i) {
+        CHECK(located[i] == locate(samples[i], solid));
+        inside += located[i] == Location::kInside;
+      }
+      CHECK(inside == (solid == box ? 25 * 3 : 16 * 3));
+
+      // More threads than points, and several points to each.
+      for (std::size_t threads : {2, 3, 8}) {
+        CHECK(locator.locate(samples, threads) == located);
+      }
+    }
+  }
+
+  SUBCASE("threaded polygon locator")
+  {
+    PolygonLocator<Rat> locator{polygon};
+    std::vector<P2> samples;
+    for (int x = -2; x <= 22; ++x) {
+      for (int y = -2; y <= 14; ++y) {
+        samples.push_back(half(x, y));
+      }
+    }
+    auto located = locator.locate(samples);
+    for (std::size_t threads : {2, 3, 8}) {
+      CHECK(locator.locate(samples, threads) == located);
+    }
+    CHECK(locator.locate(std::vector<P2>{}, 4).empty());
+  }
+
+  SUBCASE("polyhedra near the limits of int")
+  {
+    // Face normals need 62 bits, and heights along them 95, while every
+    // coordinate difference still fits in int.
+    typedef FixedRational<int, 1> IntRat;
+    typedef Point<IntRat, 3> IntP;
+    const int m = 1070000000;
+    auto q      = [](int x, int y, int z) {
+      return IntP{IntRat(x), IntRat(y), IntRat(z)};
+    };
+
+    Polyhedron<IntRat> tetrahedron{{q(-m, -m, -m + 7), q(m, -m + 3, -m),
+                                       q(-m + 5, m, -m), q(-m, -m + 1, m)},
+        {{{0, 2, 1}}, {{0, 1, 3}}, {{0, 3, 2}}, {{1, 2, 3}}}};
+    std::vector<IntP> samples{q(0, 0, 0), q(-m + 1, -m + 2, -m + 8),
+        q(-m + 1, -m + 2, -m + 7), q(m - 1, m - 1, m - 1),
+        q(-m + 1, -m + 1, -m + 10), q(-m, -m, -m + 6), q(-m, -m, -m + 7),
+        q(300000000, -600000000, -900000000), q(0, -m + 2, 0),
+        q(0, -m + 1, 0)};
+    Locations expected{Location::kOutside, Location::kInside,
+        Location::kInside, Location::kOutside, Location::kInside,
+        Location::kOutside, Location::kBoundary, Location::kInside,
+        Location::kBoundary, Location::kOutside};
+
+    PolyhedronLocator<IntRat> locator{tetrahedron};
+    CHECK(locator.locate(samples) == expected);
+    CHECK(locator.locate(samples, 3) == expected);
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+      CHECK(locate(samples[i], tetrahedron) == expected[i]);
+    }
+  }
+}
+
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
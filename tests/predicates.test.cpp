@@ -0,0 +1,222 @@
+#include "../src/rational_geometry/predicates.hpp"
+
+#include "doctest.h"
+
+#include <limits>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing predicates.hpp")
+{
+  typedef Point<int, 2> IPoint2D;
+  typedef Point<int, 3> IPoint3D;
+
+  typedef FixedRational<int, 1000> SmallRat;
+  typedef FixedRational<long long, 1000> Rat;
+
+  SUBCASE("sign()")
+  {
+    CHECK(sign(-7) == -1);
+    CHECK(sign(0) == 0);
+    CHECK(sign(7) == 1);
+    CHECK(sign(Rat(-1, 1000)) == -1);
+  }
+
+  SUBCASE("numerators and scaled_squared_distance()")
+  {
+    CHECK(numerator_of(-7) == -7);
+    CHECK(numerator_of(Rat(-3, 4)) == -750);
+    CHECK(from_numerator<int>(-7) == -7);
+    CHECK(from_numerator<Rat>(-750) == Rat(-3, 4));
+
+    CHECK(scaled_squared_distance(IPoint2D{1, 2}, IPoint2D{4, 6}) == 25);
+    CHECK(scaled_squared_distance(Point<Rat, 2>{Rat(0), Rat(0)},
+              Point<Rat, 2>{Rat(3, 1000), Rat(4, 1000)})
+          == 25);
+  }
+
+  SUBCASE("filter_bound()")
+  {
+    constexpr auto bound = filter_bound<long long>(2, 2);
+    constexpr auto max   = std::numeric_limits<long long>::max();
+
+    static_assert(bound <= max / 2 / bound, "2 * bound^2 fits");
+    static_assert(bound + 1 > max / 2 / (bound + 1), "bound is the largest");
+
+    CHECK(filter_bound<int>(1, 1) == std::numeric_limits<int>::max() / 2);
+  }
+
+  SUBCASE("orient2d()")
+  {
+    IPoint2D a{0, 0};
+    IPoint2D b{4, 0};
+
+    CHECK(orient2d(a, b, IPoint2D{1, 1}) == 1);
+    CHECK(orient2d(a, b, IPoint2D{1, -1}) == -1);
+    CHECK(orient2d(a, b, IPoint2D{9, 0}) == 0);
+    CHECK(orient2d(b, a, IPoint2D{1, 1}) == -1);
+
+    // A point nearly, but not exactly, on the line.
+    Point<Rat, 2> c{Rat(1, 4), Rat(1, 4)};
+    Point<Rat, 2> d{Rat(1, 2), Rat(1, 2)};
+    Point<Rat, 2> e{Rat(1), Rat(1)};
+    Point<Rat, 2> f{Rat(1), Rat(1001, 1000)};
+    CHECK(orient2d(c, d, e) == 0);
+    CHECK(orient2d(c, d, f) == 1);
+  }
+
+  SUBCASE("orient3d()")
+  {
+    IPoint3D a{0, 0, 0};
+    IPoint3D b{1, 0, 0};
+    IPoint3D c{0, 1, 0};
+
+    CHECK(orient3d(a, b, c, IPoint3D{0, 0, -1}) == 1);
+    CHECK(orient3d(a, b, c, IPoint3D{5, 5, 1}) == -1);
+    CHECK(orient3d(a, b, c, IPoint3D{5, -7, 0}) == 0);
+    CHECK(orient3d(b, a, c, IPoint3D{0, 0, -1}) == -1);
+  }
+
+  SUBCASE("incircle()")
+  {
+    IPoint2D a{1, 0};
+    IPoint2D b{0, 1};
+    IPoint2D c{-1, 0};
+
+    CHECK(incircle(a, b, c, IPoint2D{0, 0}) == 1);
+    CHECK(incircle(a, b, c, IPoint2D{0, -1}) == 0);
+    CHECK(incircle(a, b, c, IPoint2D{2, 2}) == -1);
+    CHECK(incircle(c, b, a, IPoint2D{0, 0}) == -1);
+  }
+
+  SUBCASE("insphere()")
+  {
+    IPoint3D a{1, 0, 0};
+    IPoint3D b{0, 1, 0};
+    IPoint3D c{-1, 0, 0};
+    IPoint3D d{0, 0, -1};
+    REQUIRE(orient3d(a, b, c, d) == 1);
+
+    CHECK(insphere(a, b, c, d, IPoint3D{0, 0, 0}) == 1);
+    CHECK(insphere(a, b, c, d, IPoint3D{0, 0, 1}) == 0);
+    CHECK(insphere(a, b, c, d, IPoint3D{0, 1, 1}) == -1);
+    CHECK(insphere(b, a, c, d, IPoint3D{0, 0, 0}) == -1);
+  }
+
+  SUBCASE("FixedRational filtering")
+  {
+    // Coordinates with non-integer products, which a FixedRational couldn't
+    // represent, are handled by the integer evaluation.
+    SUBCASE("small numerators")
+    {
+      Point<SmallRat, 2> a{SmallRat(1, 1000), SmallRat(0)};
+      Point<SmallRat, 2> b{SmallRat(0), SmallRat(1, 1000)};
+      Point<SmallRat, 2> c{SmallRat(-1, 1000), SmallRat(0)};
+
+      CHECK(orient2d(a, b, c) == 1);
+      CHECK(incircle(a, b, c, Point<SmallRat, 2>{}) == 1);
+      Point<SmallRat, 2> d{SmallRat(0), SmallRat(-1, 1000)};
+      CHECK(incircle(a, b, c, d) == 0);
+
+      Point<Rat, 3> p{Rat(1, 1000), Rat(0), Rat(0)};
+      Point<Rat, 3> q{Rat(0), Rat(1, 1000), Rat(0)};
+      Point<Rat, 3> r{Rat(-1, 1000), Rat(0), Rat(0)};
+      Point<Rat, 3> s{Rat(0), Rat(0), Rat(-1, 1000)};
+
+      CHECK(orient3d(p, q, r, s) == 1);
+      CHECK(insphere(p, q, r, s, Point<Rat, 3>{}) == 1);
+      CHECK(insphere(p, q, r, s, Point<Rat, 3>{Rat(0), Rat(0), Rat(1, 1000)})
+            == 0);
+    }
+
+    SUBCASE("large numerators")
+    {
+      // Beyond the filter's bound, so evaluated over wide numerators.
+      const long long big = 1000000;
+      Point<Rat, 3> p{Rat(big), Rat(0), Rat(0)};
+      Point<Rat, 3> q{Rat(0), Rat(big), Rat(0)};
+      Point<Rat, 3> r{Rat(-big), Rat(0), Rat(0)};
+      Point<Rat, 3> s{Rat(0), Rat(0), Rat(-big)};
+
+      CHECK(orient3d(p, q, r, s) == 1);
+      CHECK(insphere(p, q, r, s, Point<Rat, 3>{}) == 1);
+      CHECK(insphere(p, q, r, s, Point<Rat, 3>{Rat(0), Rat(0), Rat(big)})
+            == 0);
+      CHECK(insphere(p, q, r, s, Point<Rat, 3>{Rat(big), Rat(big), Rat(0)})
+            == -1);
+    }
+
+    SUBCASE("large non-integral coordinates")
+    {
+      // Beyond the filter's bound with fractional coordinates, whose products
+      // only the wide integer evaluation represents.
+      auto check_incircle = [](auto ignored) {
+        typedef decltype(ignored) R;
+        auto at = [](int x, int y) {
+          return Point<R, 2>{R(x, 1000), R(y, 1000)};
+        };
+
+        // A circle of radius 25 about (0.125, 0.375).
+        auto a = at(25125, 375);
+        auto b = at(7125, 24375);
+        auto c = at(-23875, 7375);
+
+        CHECK(incircle(a, b, c, at(125, -24625)) == 0);
+        CHECK(incircle(a, b, c, at(125, 376)) == 1);
+        CHECK(incircle(a, b, c, at(7125, 24376)) == -1);
+        CHECK(incircle(a, b, c, at(-17875, -19625)) == -1);
+        CHECK(incircle(a, b, c, at(-49999, 49999)) == -1);
+        CHECK(incircle(c, b, a, at(125, 376)) == -1);
+      };
+      check_incircle(SmallRat{});
+      check_incircle(FixedRational<int, 1000, false>{});
+
+      auto check_orient3d = [](auto ignored) {
+        typedef decltype(ignored) R;
+        auto at = [](long long x, long long y, long long z) {
+          return Point<R, 3>{R(x, 1000LL), R(y, 1000LL), R(z, 1000LL)};
+        };
+
+        // On the plane z = x/2 + y/5 + 1/8.
+        auto a = at(1999502, -1000255, 799825);
+        auto b = at(-1500004, 1999995, -349878);
+        auto c = at(-1999998, -1999005, -1399675);
+
+        CHECK(orient3d(a, b, c, at(1234566, -1777775, 261853)) == 0);
+        CHECK(orient3d(a, b, c, at(1234566, -1777775, 261854)) == -1);
+        CHECK(orient3d(a, b, c, at(1234566, -1777775, 261852)) == 1);
+        CHECK(orient3d(b, a, c, at(1234566, -1777775, 261854)) == 1);
+      };
+      check_orient3d(Rat{});
+      check_orient3d(FixedRational<long long, 1000, false>{});
+    }
+
+    SUBCASE("nearby points far from the origin")
+    {
+      // Filtered by their differences, both where those fit in long long
+      // and where the numerators are too large to subtract.
+      for (long long offset : {4000000000000000000LL,
+               std::numeric_limits<long long>::max() - 10}) {
+        typedef Point<long long, 2> P;
+        P a{offset - 5, offset};
+        P b{offset, offset - 5};
+        P c{offset - 2, offset - 9};
+
+        CHECK(orient2d(a, b, c) == -1);
+        CHECK(orient2d(a, c, b) == 1);
+        CHECK(orient2d(a, b, P{offset - 10, offset + 5}) == 0);
+
+        // a, b and c lie on the circle of radius 5 about (offset - 5,
+        // offset - 5).
+        CHECK(incircle(a, c, b, P{offset - 1, offset - 2}) == 0);
+        CHECK(incircle(a, c, b, P{offset - 2, offset - 2}) == 1);
+        CHECK(incircle(a, c, b, P{offset, offset}) == -1);
+      }
+    }
+  }
+}
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
@@ -0,0 +1,149 @@
+
+#include "../src/rational_geometry/segment_intersections.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "../src/rational_geometry/Point.hpp"
+
+#include "doctest.h"
+
+#include <array>
+#include <cstddef>
+#include <set>
+#include <vector>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing segment_intersections.hpp")
+{
+  typedef FixedRational<long long, 4 * 9 * 5 * 7> Rat;
+  typedef Point<Rat, 2> P;
+  typedef std::array<P, 2> Segment;
+  typedef std::vector<std::size_t> Indices;
+
+  auto p = [](int x, int y) { return P{Rat(x), Rat(y)}; };
+
+  SUBCASE("no meetings")
+  {
+    CHECK(segment_intersections(std::vector<Segment>{}).empty());
+    CHECK(segment_intersections(std::vector<Segment>{{p(0, 0), p(1, 1)}})
+              .empty());
+
+    std::vector<Segment> parallel{{p(0, 0), p(4, 0)}, {p(0, 1), p(4, 1)},
+        {p(5, 0), p(5, 3)}, {p(2, 3), p(0, 5)}};
+    CHECK(segment_intersections(parallel).empty());
+  }
+
+  SUBCASE("crossings")
+  {
+    std::vector<Segment> segments{{p(0, 0), p(4, 4)}, {p(4, 0), p(0, 4)},
+        {p(0, 3), p(6, 3)}, {p(1, 0), p(1, 5)}};
+    auto found = segment_intersections(segments);
+    REQUIRE(found.size() == 4);
+
+    CHECK(found[0].point_ == p(1, 1));
+    CHECK(found[0].segments_ == Indices{0, 3});
+    CHECK(found[1].point_ == p(1, 3));
+    CHECK(found[1].segments_ == Indices{1, 2, 3});
+    CHECK(found[2].point_ == p(2, 2));
+    CHECK(found[2].segments_ == Indices{0, 1});
+    CHECK(found[3].point_ == p(3, 3));
+    CHECK(found[3].segments_ == Indices{0, 2});
+  }
+
+  SUBCASE("shared ends, touching and overlaps")
+  {
+    // A star of segments from one point, given in either direction.
+    std::vector<Segment> star{{p(0, 0), p(3, 1)}, {p(0, 3), p(0, 0)},
+        {p(-2, -2), p(0, 0)}, {p(1, 1), p(2, 2)}};
+    auto found = segment_intersections(star);
+    REQUIRE(found.size() == 1);
+    CHECK(found[0].point_ == p(0, 0));
+    CHECK(found[0].segments_ == Indices{0, 1, 2});
+
+    // One segment ending on another's middle.
+    auto touching = segment_intersections(
+        std::vector<Segment>{{p(0, 0), p(4, 0)}, {p(2, 3), p(2, 0)}});
+    REQUIRE(touching.size() == 1);
+    CHECK(touching[0].point_ == p(2, 0));
+
+    // Collinear overlaps are reported at the overlap's ends.
+    std::vector<Segment> overlapping{
+        {p(0, 0), p(4, 2)}, {p(2, 1), p(6, 3)}, {p(3, 0), p(3, 4)}};
+    auto overlaps = segment_intersections(overlapping);
+    REQUIRE(overlaps.size() == 3);
+    CHECK(overlaps[0].point_ == p(2, 1));
+    CHECK(overlaps[0].segments_ == Indices{0, 1});
+    CHECK(overlaps[1].point_ == P{Rat(3), Rat(3, 2)});
+    CHECK(overlaps[1].segments_ == Indices{0, 1, 2});
+    CHECK(overlaps[2].point_ == p(4, 2));
+    CHECK(overlaps[2].segments_ == Indices{0, 1});
+  }
+
+  SUBCASE("a grid")
+  {
+    std::vector<Segment> grid;
+    for (int i = 0; i < 5; ++i) {
+      grid.push_back({p(0, i), p(4, i)});
+      grid.push_back({p(i, 0), p(i, 4)});
+    }
+    grid.push_back({p(0, 0), p(4, 4)});
+
+    auto found = segment_intersections(grid);
+    CHECK(found.size() == 25);
+    std::size_t on_diagonal = 0;
+    for (const auto& crossing : found) {
+      on_diagonal += crossing.segments_.size() == 3;
+    }
+    CHECK(on_diagonal == 5);
+  }
+
+  SUBCASE("many segments, against every pair")
+  {
+    // Enough short octilinear segments on a small lattice that the status
+    // grows tall and most events see ends shared, overlaps and crossings.
+    std::vector<Segment> segments;
+    unsigned seed = 54321;
+    auto next     = [&seed](unsigned limit) {
+      seed = seed * 1103515245u + 12345u;
+      return static_cast<int>((seed >> 16) % limit);
+    };
+    for (int i = 0; i < 600; ++i) {
+      int x = next(40), y = next(40), length = next(6) + 1;
+      int dx = next(3) - 1, dy = next(3) - 1;
+      if (dx == 0 && dy == 0) dx = 1;
+      segments.push_back({p(x, y), p(x + dx * length, y + dy * length)});
+    }
+
+    std::set<P> expected;
+    for (std::size_t i = 0; i < segments.size(); ++i) {
+      for (std::size_t j = i + 1; j < segments.size(); ++j) {
+        auto found = intersection(segments[i][0], segments[i][1],
+            segments[j][0], segments[j][1]);
+        if (found.type_ != IntersectionType::kNone) {
+          expected.insert(found.first_);
+        }
+        if (found.type_ == IntersectionType::kSegment) {
+          expected.insert(found.second_);
+        }
+      }
+    }
+
+    auto found = segment_intersections(segments);
+    std::set<P> points;
+    for (const auto& crossing : found) {
+      points.insert(crossing.point_);
+      for (auto index : crossing.segments_) {
+        CHECK(orient2d(segments[index][0], segments[index][1], crossing.point_)
+              == 0);
+      }
+    }
+    CHECK(points.size() == found.size());
+    CHECK(points == expected);
+  }
+}
+
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
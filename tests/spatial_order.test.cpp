@@ -0,0 +1,164 @@
+
+#include "../src/rational_geometry/spatial_order.hpp"
+
+#include "../src/rational_geometry/AABB.hpp"
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "../src/rational_geometry/Point.hpp"
+
+#include "doctest.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <vector>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing spatial_order.hpp")
+{
+  typedef FixedRational<long long, 4 * 9 * 5> Rat;
+  typedef Point<Rat, 2> P2;
+  typedef Point<Rat, 3> P3;
+  typedef std::vector<std::size_t> Indices;
+  typedef std::vector<unsigned long long> Keys;
+
+  SUBCASE("keys")
+  {
+    static_assert(key_bits_per_axis<1>() == 32, "");
+    static_assert(key_bits_per_axis<2>() == 32, "");
+    static_assert(key_bits_per_axis<3>() == 21, "");
+
+    // Numerators are offset from the box's corner, and shifted to fit.
+    AABB<Rat, 2> unit{P2{Rat(-1), Rat(-1)}, P2{Rat(1), Rat(1)}};
+    CHECK(grid_coordinates(P2{Rat(-1), Rat(-1)}, unit)
+          == std::array<unsigned long long, 2>{0, 0});
+    CHECK(grid_coordinates(P2{Rat(1), Rat(0)}, unit)
+          == std::array<unsigned long long, 2>{360, 180});
+
+    AABB<long long, 1> wide{Point<long long, 1>{-(1LL << 40)},
+        Point<long long, 1>{1LL << 40}};
+    CHECK(grid_coordinates(Point<long long, 1>{1LL << 40}, wide)[0]
+          == 1ULL << 31);
+    CHECK(grid_coordinates(Point<long long, 1>{0}, wide)[0] == 1ULL << 30);
+
+    CHECK(interleave_bits<2>({0, 0}) == 0);
+    CHECK(interleave_bits<2>({0, 1}) == 1);
+    CHECK(interleave_bits<2>({1, 0}) == 2);
+    CHECK(interleave_bits<2>({3, 1}) == 11);
+    CHECK(interleave_bits<3>({1, 1, 1}) == 7);
+
+    AABB<Rat, 3> box{P3{Rat(0), Rat(0), Rat(0)}, P3{Rat(1), Rat(1), Rat(1)}};
+    CHECK(morton_key(P3{Rat(0), Rat(0), Rat(0)}, box) == 0);
+    CHECK(morton_key(P3{Rat(1, 180), Rat(0), Rat(0)}, box) == 4);
+  }
+
+  SUBCASE("Hilbert curve")
+  {
+    // Walking a grid in Hilbert order takes only unit steps.
+    for (int size : {4, 8, 5}) {
+      std::vector<Point<long long, 2>> grid;
+      for (int x = 0; x < size; ++x) {
+        for (int y = 0; y < size; ++y) {
+          grid.push_back({x, y});
+        }
+      }
+
+      auto order = hilbert_order(grid);
+      REQUIRE(order.size() == grid.size());
+      auto walk = reorder(grid, order);
+      std::size_t unit_steps = 0;
+      for (std::size_t i = 1; i < walk.size(); ++i) {
+        auto step = walk[i] - walk[i - 1];
+        unit_steps += std::abs(step[0]) + std::abs(step[1]) == 1;
+      }
+      if (size != 5) {
+        CHECK(unit_steps == walk.size() - 1);
+      }
+      else {
+        CHECK(unit_steps >= walk.size() - 5);
+      }
+
+      Keys keys;
+      AABB<long long, 2> bounds{grid.front(), grid.back()};
+      for (const auto& point : walk) {
+        keys.push_back(hilbert_key(point, bounds));
+      }
+      CHECK(std::is_sorted(keys.begin(), keys.end()));
+      CHECK(std::adjacent_find(keys.begin(), keys.end()) == keys.end());
+    }
+
+    // In 3D too.
+    std::vector<Point<long long, 3>> cube;
+    for (int x = 0; x < 4; ++x) {
+      for (int y = 0; y < 4; ++y) {
+        for (int z = 0; z < 4; ++z) {
+          cube.push_back({x, y, z});
+        }
+      }
+    }
+    auto walk = reorder(cube, hilbert_order(cube));
+    for (std::size_t i = 1; i < walk.size(); ++i) {
+      auto step = walk[i] - walk[i - 1];
+      CHECK(std::abs(step[0]) + std::abs(step[1]) + std::abs(step[2]) == 1);
+    }
+  }
+
+  SUBCASE("ordering")
+  {
+    CHECK(radix_order(Keys{}).empty());
+    CHECK(radix_order(Keys{5, 5, 5}) == Indices{0, 1, 2});
+    CHECK(radix_order(Keys{300, 2, 1ULL << 60, 2, 0, 299})
+          == Indices{4, 1, 3, 5, 0, 2});
+
+    std::vector<P2> points{P2{Rat(1), Rat(1)}, P2{Rat(0), Rat(0)},
+        P2{Rat(1), Rat(0)}, P2{Rat(0), Rat(1)}, P2{Rat(0), Rat(0)}};
+    auto order = morton_order(points);
+    CHECK(order == Indices{1, 4, 3, 2, 0});
+    CHECK(reorder(points, order)
+          == std::vector<P2>{P2{Rat(0), Rat(0)}, P2{Rat(0), Rat(0)},
+              P2{Rat(0), Rat(1)}, P2{Rat(1), Rat(0)}, P2{Rat(1), Rat(1)}});
+
+    // Index buffers follow their points.
+    std::vector<unsigned> triangles{0, 1, 2, 2, 3, 4};
+    auto renumbered = reindex(triangles, order);
+    auto reordered  = reorder(points, order);
+    REQUIRE(renumbered.size() == triangles.size());
+    for (std::size_t i = 0; i < triangles.size(); ++i) {
+      CHECK(reordered[renumbered[i]] == points[triangles[i]]);
+    }
+  }
+
+  SUBCASE("threaded ordering")
+  {
+    // Small blocks, so that even a few keys are split between threads, and
+    // many repeated keys, so that stability shows.
+    Keys keys;
+    std::vector<P2> points;
+    unsigned seed = 777;
+    for (int i = 0; i < 5000; ++i) {
+      seed = seed * 1103515245u + 12345u;
+      keys.push_back((seed >> 8) % 300 * 0x0101010101ULL);
+      points.push_back(P2{Rat(static_cast<int>(seed >> 16) % 50),
+          Rat(static_cast<int>(seed >> 4) % 37)});
+    }
+
+    auto single = radix_order(keys);
+    CHECK(radix_order(keys, 4, 100) == single);
+    CHECK(radix_order(keys, 3, 1) == single);
+    for (std::size_t i = 1; i < single.size(); ++i) {
+      CHECK((keys[single[i - 1]] < keys[single[i]]
+             || (keys[single[i - 1]] == keys[single[i]]
+                 && single[i - 1] < single[i])));
+    }
+
+    CHECK(morton_order(points, 4, 100) == morton_order(points));
+    CHECK(hilbert_order(points, 4, 100) == hilbert_order(points));
+  }
+}
+
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2:
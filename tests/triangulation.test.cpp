@@ -0,0 +1,115 @@
+
+#include "../src/rational_geometry/triangulation.hpp"
+
+#include "../src/rational_geometry/FixedRational.hpp"
+#include "../src/rational_geometry/Point.hpp"
+#include "../src/rational_geometry/Polygon2D.hpp"
+
+#include "doctest.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace rational_geometry {
+
+
+TEST_CASE("Testing triangulation.hpp")
+{
+  typedef FixedRational<long long, 4 * 9 * 5> Rat;
+  typedef Point<Rat, 2> P;
+  typedef std::vector<P> Ring;
+  typedef std::vector<std::size_t> Indices;
+
+  auto p = [](int x, int y) { return P{Rat(x), Rat(y)}; };
+
+  // A triangulation covers its polygon exactly: its triangles are wound
+  // counter-clockwise, their union is the polygon, and their areas add up to
+  // the polygon's, so none overlap.
+  auto check_covers = [](const Polygon2D<Rat>& polygon,
+                          const Indices& triangles) {
+    std::vector<P> points;
+    for (const auto& ring : polygon.rings()) {
+      points.insert(points.end(), ring.begin(), ring.end());
+    }
+    REQUIRE(triangles.size() % 3 == 0);
+
+    Polygon2D<Rat> covered;
+    Rat area(0);
+    for (std::size_t i = 0; i < triangles.size(); i += 3) {
+      REQUIRE(triangles[i + 2] < points.size());
+      Polygon2D<Rat> triangle{Ring{points[triangles[i]],
+          points[triangles[i + 1]], points[triangles[i + 2]]}};
+      CHECK(Rat(0) < triangle.signed_area());
+      area += triangle.signed_area();
+      covered = covered | triangle;
+    }
+    auto normalized = polygon | Polygon2D<Rat>{};
+    CHECK(covered == normalized);
+    CHECK(area == normalized.signed_area());
+  };
+
+  // Teeth along the top and bottom give split and merge vertices.
+  Ring comb{p(0, 0)};
+  for (int i = 1; i <= 6; ++i) {
+    comb.push_back(p(2 * i - 1, 2));
+    comb.push_back(p(2 * i, 0));
+  }
+  comb.push_back(p(12, 10));
+  for (int i = 6; i >= 1; --i) {
+    comb.push_back(p(2 * i - 1, 8));
+    comb.push_back(p(2 * i - 2, 10));
+  }
+
+  SUBCASE("ear clipping")
+  {
+    Ring square{p(0, 0), p(2, 0), p(2, 2), p(0, 2)};
+    CHECK(ear_clip(square) == Indices{3, 0, 1, 1, 2, 3});
+    check_covers(Polygon2D<Rat>{square}, ear_clip(square));
+
+    // Either winding, reflex vertices, and collinear vertices.
+    Ring arrow{p(0, 0), p(2, 1), p(4, 0), p(4, 2), p(2, 2), p(0, 2)};
+    Ring clockwise(arrow.rbegin(), arrow.rend());
+    check_covers(Polygon2D<Rat>{arrow}, ear_clip(arrow));
+    check_covers(Polygon2D<Rat>{clockwise}, ear_clip(clockwise));
+    check_covers(Polygon2D<Rat>{comb}, ear_clip(comb));
+
+    CHECK(ear_clip(Ring{p(0, 0), p(1, 1)}).empty());
+    CHECK(ear_clip(Ring{p(0, 0), p(1, 1), p(2, 2)}).empty());
+  }
+
+  SUBCASE("monotone pieces")
+  {
+    for (const auto& ring : {comb, Ring(comb.rbegin(), comb.rend())}) {
+      Polygon2D<Rat> polygon{ring};
+      check_covers(polygon, monotone_triangulate(polygon));
+    }
+
+    // Holes, wound either way, and an island inside a hole.
+    Polygon2D<Rat> nested{Ring{p(0, 0), p(24, 0), p(24, 24), p(0, 24)},
+        Ring{p(4, 4), p(4, 20), p(20, 20), p(20, 4)},
+        Ring{p(8, 8), p(16, 8), p(12, 16)}, Ring{p(1, 1), p(3, 1), p(2, 3)}};
+    auto triangles = monotone_triangulate(nested);
+    check_covers(nested, triangles);
+    CHECK(triangles.size() == 3 * 14);
+
+    // Vertical edges and vertices sharing coordinates.
+    Polygon2D<Rat> steps{Ring{p(0, 0), p(3, 0), p(3, 1), p(2, 1), p(2, 2),
+        p(1, 2), p(1, 3), p(0, 3)}};
+    check_covers(steps, monotone_triangulate(steps));
+
+    CHECK(monotone_triangulate(Polygon2D<Rat>{}).empty());
+  }
+
+  SUBCASE("choosing a method")
+  {
+    Polygon2D<Rat> square{Ring{p(0, 0), p(2, 0), p(2, 2), p(0, 2)}};
+    CHECK(triangulate(square) == ear_clip(square.rings().front()));
+    CHECK(triangulate(square, 3) == monotone_triangulate(square));
+    check_covers(Polygon2D<Rat>{comb}, triangulate(Polygon2D<Rat>{comb}));
+  }
+}
+
+
+} // namespace rational_geometry
+
+// vim:set et ts=2 sw=2 sts=2: